@@ -0,0 +1,126 @@
+//=============================================================================
+//  bench/bench_data.h
+//  Synthetic bar series for the benchmarks
+//
+//  Every benchmark runs on the same bars on every machine and every commit:
+//  an H1 EURUSD-like series from a fixed SplitMix64 stream (no <random>
+//  distributions - their output differs between standard libraries), so
+//  timings of two commits measure the same work. Prices mean-revert around
+//  a slow swing so the S/R detector finds levels, and one candle in eight
+//  has a long wick for the rejection scan to look at.
+//=============================================================================
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "bridge/bar_codec.h"
+#include "bridge/signal_payload.h"
+#include "core/bar.h"
+#include "core/bar_columns.h"
+
+namespace volarix4::bench {
+
+// Wednesday 2024-03-06 09:00 UTC: the decision bar of every fixed window,
+// inside the London session
+constexpr long long kDecisionBarTime = volarix4::bridge::DaysFromCivil(2024, 3, 6) * 86400LL + 9 * 3600;
+constexpr long long kBarSeconds = 3600;
+
+class SplitMix64
+{
+public:
+    explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+    uint64_t Next()
+    {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    double Uniform() { return (double)(Next() >> 11) * 0x1.0p-53; }
+
+private:
+    uint64_t state_;
+};
+
+// count closed bars, oldest first, the newest at last_time
+inline std::vector<core::OHLCVBar> SyntheticBars(size_t count, long long last_time = kDecisionBarTime,
+                                                 uint64_t seed = 42)
+{
+    constexpr double kPip = 0.0001;
+    SplitMix64 rng(seed);
+    std::vector<core::OHLCVBar> bars(count);
+
+    double close = 1.0850;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const double anchor = 1.0850 + 40.0 * kPip * std::sin((double)i / 37.0);
+        const double open = close;
+        close = open + (rng.Uniform() - 0.5) * 16.0 * kPip + (anchor - open) * 0.08;
+
+        const double body_top = std::fmax(open, close), body_bottom = std::fmin(open, close);
+        double upper = rng.Uniform() * 5.0 * kPip, lower = rng.Uniform() * 5.0 * kPip;
+        if (rng.Next() % 8 == 0) {
+            const double wick = 3.0 * std::fabs(close - open) + 6.0 * kPip;
+            (rng.Next() % 2 ? upper : lower) += wick;
+        }
+
+        core::OHLCVBar& bar = bars[i];
+        bar.timestamp = last_time - (long long)(count - 1 - i) * kBarSeconds;
+        bar.open = open;
+        bar.high = body_top + upper;
+        bar.low = body_bottom - lower;
+        bar.close = close;
+        bar.volume = 1000 + (int)(rng.Next() % 4000);
+    }
+    return bars;
+}
+
+inline core::ColumnBuffer SyntheticColumns(size_t count, long long last_time = kDecisionBarTime,
+                                           uint64_t seed = 42)
+{
+    const std::vector<core::OHLCVBar> bars = SyntheticBars(count, last_time, seed);
+    core::ColumnBuffer columns;
+    columns.Assign(bars.data(), bars.size());
+    return columns;
+}
+
+// The same bars as VolariXBridge.dll receives them: times as MQL5
+// TimeToString text ("YYYY.MM.DD HH:MM:SS")
+inline std::vector<bridge::TimestampedBar> SyntheticTimestampedBars(size_t count)
+{
+    const std::vector<core::OHLCVBar> bars = SyntheticBars(count);
+    std::vector<bridge::TimestampedBar> out(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        // civil_from_days (Howard Hinnant), the inverse of DaysFromCivil
+        const long long days = bars[i].timestamp / 86400, seconds = bars[i].timestamp % 86400;
+        const long long z = days + 719468;
+        const long long era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = (unsigned)(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        const long long year = (long long)yoe + era * 400 + (month <= 2);
+
+        std::snprintf(out[i].timestamp, sizeof(out[i].timestamp), "%04d.%02u.%02u %02u:%02u:%02u",
+                      (int)year % 10000, month, day, (unsigned)(seconds / 3600),
+                      (unsigned)(seconds / 60 % 60), (unsigned)(seconds % 60));
+        out[i].open = bars[i].open;
+        out[i].high = bars[i].high;
+        out[i].low = bars[i].low;
+        out[i].close = bars[i].close;
+        out[i].volume = (double)bars[i].volume;
+    }
+    return out;
+}
+
+} // namespace volarix4::bench
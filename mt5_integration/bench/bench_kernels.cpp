@@ -0,0 +1,138 @@
+//=============================================================================
+//  bench/bench_kernels.cpp
+//  Native pipeline kernels: S/R detection (from scratch and incremental),
+//  the broken-level filter, rejection scanning and the EMA trend
+//=============================================================================
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <vector>
+
+#include "bench_data.h"
+#include "core/rejection.h"
+#include "core/sr_incremental.h"
+#include "core/sr_levels.h"
+#include "core/sr_validation.h"
+#include "core/trend_filter.h"
+#include "core/trend_incremental.h"
+
+namespace {
+
+using volarix4::core::BarColumns;
+using volarix4::core::ColumnBuffer;
+using volarix4::core::SRLevel;
+using volarix4::core::SRParams;
+
+constexpr size_t kStreamBars = 20000;   // Bars a streaming benchmark slides over
+
+void BM_DetectSRLevels(benchmark::State& state)
+{
+    const ColumnBuffer bars = volarix4::bench::SyntheticColumns((size_t)state.range(0));
+    const SRParams params = volarix4::core::DefaultSRParams(0.0001);
+
+    size_t levels = 0;
+    for (auto _ : state) {
+        std::vector<SRLevel> found = volarix4::core::DetectSRLevels(bars.View(), params);
+        levels = found.size();
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["levels"] = (double)levels;
+}
+BENCHMARK(BM_DetectSRLevels)->Arg(200)->Arg(400)->Arg(1000);
+
+// One new bar per iteration on a window of range(0) bars, as a bar-store
+// stream advances candle by candle (sr_incremental.h)
+void BM_IncrementalSRLevels(benchmark::State& state)
+{
+    const size_t window = (size_t)state.range(0);
+    const ColumnBuffer bars = volarix4::bench::SyntheticColumns(window + kStreamBars);
+    const SRParams params = volarix4::core::DefaultSRParams(0.0001);
+    volarix4::core::IncrementalSRLevels stream;
+
+    size_t first = 0;
+    for (auto _ : state) {
+        const std::vector<SRLevel>& levels = stream.Update(bars.View().Slice(first, window), params);
+        benchmark::DoNotOptimize(levels.data());
+        if (++first == kStreamBars)
+            first = 0;   // Rebuilds once every kStreamBars iterations
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IncrementalSRLevels)->Arg(400);
+
+// Broken-level filter as the pipeline runs it: a fresh validator per call
+// on range(0) levels spread 100 pips either side of the last close (about
+// half of them broken by the recent closes)
+void BM_ValidateLevels(benchmark::State& state)
+{
+    const ColumnBuffer bars = volarix4::bench::SyntheticColumns(400);
+    const BarColumns view = bars.View();
+    const double last_close = view.close[view.count - 1];
+    const size_t count = (size_t)state.range(0);
+
+    std::vector<SRLevel> levels;
+    for (size_t i = 0; i < count; ++i) {
+        const double offset = 0.0100 * ((double)i / (double)count - 0.5) * 2.0;
+        levels.push_back(SRLevel{ last_close + offset, 70.0,
+                                  i % 2 == 0 ? volarix4::core::kSupport : volarix4::core::kResistance });
+    }
+
+    size_t valid = 0;
+    for (auto _ : state) {
+        volarix4::core::SRLevelValidator validator(0.0001, 48.0, 15.0);
+        std::vector<SRLevel> kept = validator.ValidateLevels(levels, view);
+        valid = kept.size();
+        benchmark::DoNotOptimize(kept.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["valid"] = (double)valid;
+}
+BENCHMARK(BM_ValidateLevels)->Arg(8)->Arg(64)->Arg(1024);
+
+void BM_FindRejectionCandle(benchmark::State& state)
+{
+    const ColumnBuffer bars = volarix4::bench::SyntheticColumns((size_t)state.range(0));
+    const std::vector<SRLevel> levels =
+        volarix4::core::DetectSRLevels(bars.View(), volarix4::core::DefaultSRParams(0.0001));
+
+    for (auto _ : state) {
+        std::optional<volarix4::core::Rejection> rejection =
+            volarix4::core::FindRejectionCandle(bars.View(), levels, 0.0001);
+        benchmark::DoNotOptimize(rejection);
+    }
+    state.counters["levels"] = (double)levels.size();
+}
+BENCHMARK(BM_FindRejectionCandle)->Arg(400);
+
+void BM_DetectTrend(benchmark::State& state)
+{
+    const ColumnBuffer bars = volarix4::bench::SyntheticColumns((size_t)state.range(0));
+
+    for (auto _ : state) {
+        volarix4::core::TrendInfo trend = volarix4::core::DetectTrend(bars.View(), 20, 50);
+        benchmark::DoNotOptimize(trend);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DetectTrend)->Arg(400);
+
+void BM_IncrementalTrend(benchmark::State& state)
+{
+    const size_t window = (size_t)state.range(0);
+    const ColumnBuffer bars = volarix4::bench::SyntheticColumns(window + kStreamBars);
+    volarix4::core::IncrementalTrend stream;
+
+    size_t first = 0;
+    for (auto _ : state) {
+        volarix4::core::TrendInfo trend = stream.Update(bars.View().Slice(first, window), 20, 50);
+        benchmark::DoNotOptimize(trend);
+        if (++first == kStreamBars)
+            first = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["recompute_rate"] = (double)stream.Recomputes() / (double)state.iterations();
+}
+BENCHMARK(BM_IncrementalTrend)->Arg(400);
+
+} // namespace
@@ -0,0 +1,155 @@
+//=============================================================================
+//  bench/bench_payload.cpp
+//  Request bodies of VolariXBridge.dll: GetVolariXSignalWithBars (JSON) and
+//  GetVolariXSignalWithBarsBinary at 50, 400 and 5000 bars, plain and
+//  compressed (SetVolariXCompression)
+//=============================================================================
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_data.h"
+#include "bridge/content_encoding.h"
+#include "bridge/signal_payload.h"
+
+namespace {
+
+using volarix4::bridge::BinaryBarWriter;
+using volarix4::bridge::BodyEncoder;
+using volarix4::bridge::BodyEncoding;
+using volarix4::bridge::JsonWriter;
+using volarix4::bridge::SignalPayload;
+using volarix4::bridge::TimestampedBar;
+
+SignalPayload Payload(const std::vector<TimestampedBar>& bars)
+{
+    SignalPayload payload;
+    payload.symbol = "EURUSD";
+    payload.executionTimeframe = "H1";
+    payload.startTime = bars.front().timestamp;
+    payload.endTime = bars.back().timestamp;
+    payload.bars = bars.data();
+    payload.barCount = (int)bars.size();
+    return payload;
+}
+
+// The writer is reused across iterations like the DLL's per-thread one, so
+// this is the steady state of an EA calling once per candle
+void BM_SignalPayloadJson(benchmark::State& state)
+{
+    const std::vector<TimestampedBar> bars = volarix4::bench::SyntheticTimestampedBars((size_t)state.range(0));
+    const SignalPayload payload = Payload(bars);
+    JsonWriter json;
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        const std::string& body = volarix4::bridge::WriteSignalPayload(json, payload);
+        benchmark::DoNotOptimize(body.data());
+        bytes = body.size();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)bytes);
+    state.counters["payload_bytes"] = (double)bytes;
+}
+BENCHMARK(BM_SignalPayloadJson)->Arg(50)->Arg(400)->Arg(5000);
+
+// Same bars with a D1-sized context series, as the multi-TF EA sends them
+void BM_SignalPayloadJsonMultiTF(benchmark::State& state)
+{
+    const std::vector<TimestampedBar> bars = volarix4::bench::SyntheticTimestampedBars((size_t)state.range(0));
+    const std::vector<TimestampedBar> context = volarix4::bench::SyntheticTimestampedBars(200);
+    SignalPayload payload = Payload(bars);
+    payload.contextTimeframe = "D1";
+    payload.contextBars = context.data();
+    payload.contextBarCount = (int)context.size();
+    JsonWriter json;
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        const std::string& body = volarix4::bridge::WriteSignalPayload(json, payload);
+        benchmark::DoNotOptimize(body.data());
+        bytes = body.size();
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)bytes);
+    state.counters["payload_bytes"] = (double)bytes;
+}
+BENCHMARK(BM_SignalPayloadJsonMultiTF)->Arg(400)->Arg(5000);
+
+// The same body in kPayloadChunkBytes pieces (what VolariXBridge.dll
+// streams onto the socket for large uploads); buffer_bytes is the writer's
+// capacity afterwards - flat, unlike payload_bytes
+void BM_SignalPayloadJsonStreamed(benchmark::State& state)
+{
+    const std::vector<TimestampedBar> bars = volarix4::bench::SyntheticTimestampedBars((size_t)state.range(0));
+    const SignalPayload payload = Payload(bars);
+    JsonWriter json;
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        bytes = 0;
+        volarix4::bridge::StreamSignalPayload(json, payload, volarix4::bridge::kPayloadChunkBytes,
+                                              [&](const char* data, size_t size) {
+                                                  benchmark::DoNotOptimize(data);
+                                                  bytes += size;
+                                                  return true;
+                                              });
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)bytes);
+    state.counters["payload_bytes"] = (double)bytes;
+    state.counters["buffer_bytes"] = (double)json.str().capacity();
+}
+BENCHMARK(BM_SignalPayloadJsonStreamed)->Arg(400)->Arg(5000)->Arg(50000);
+
+void BM_SignalPayloadBinary(benchmark::State& state)
+{
+    const std::vector<TimestampedBar> bars = volarix4::bench::SyntheticTimestampedBars((size_t)state.range(0));
+    const SignalPayload payload = Payload(bars);
+    BinaryBarWriter writer;
+
+    for (auto _ : state) {
+        volarix4::bridge::WriteBinarySignalPayload(writer, payload);
+        benchmark::DoNotOptimize(writer.str().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)writer.str().size());
+    state.counters["payload_bytes"] = (double)writer.str().size();
+}
+BENCHMARK(BM_SignalPayloadBinary)->Arg(50)->Arg(400)->Arg(5000);
+
+// Serialize and compress, as GetVolariXSignalWithBars does with compression
+// on (range(1) is the BodyEncoding); what it buys is payload_bytes /
+// compressed_bytes fewer bytes on the link
+void BM_SignalPayloadJsonCompressed(benchmark::State& state)
+{
+    const std::vector<TimestampedBar> bars = volarix4::bench::SyntheticTimestampedBars((size_t)state.range(0));
+    const SignalPayload payload = Payload(bars);
+    const BodyEncoding encoding = (BodyEncoding)state.range(1);
+    JsonWriter json;
+    BodyEncoder encoder;
+    std::string compressed;
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        const std::string& body = volarix4::bridge::WriteSignalPayload(json, payload);
+        if (!volarix4::bridge::EncodeBody(encoder, encoding, body.data(), body.size(), &compressed)) {
+            state.SkipWithError("encoding failed");
+            break;
+        }
+        benchmark::DoNotOptimize(compressed.data());
+        bytes = body.size();
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)bytes);
+    state.counters["payload_bytes"] = (double)bytes;
+    state.counters["compressed_bytes"] = (double)compressed.size();
+}
+#ifdef VOLARIX4_HAVE_ZLIB
+BENCHMARK(BM_SignalPayloadJsonCompressed)->ArgNames({"bars", "encoding"})
+    ->Args({400, (int)BodyEncoding::kGzip})->Args({5000, (int)BodyEncoding::kGzip});
+#endif
+#ifdef VOLARIX4_HAVE_ZSTD
+BENCHMARK(BM_SignalPayloadJsonCompressed)->ArgNames({"bars", "encoding"})
+    ->Args({400, (int)BodyEncoding::kZstd})->Args({5000, (int)BodyEncoding::kZstd});
+#endif
+
+} // namespace
@@ -0,0 +1,73 @@
+//=============================================================================
+//  bench/bench_pipeline.cpp
+//  End-to-end local signal: the whole native /signal pipeline plus the JSON
+//  the DLL returns (GetVolarix4SignalLocal, GetVolarix4SignalFromStore)
+//=============================================================================
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_data.h"
+#include "bridge/local_signal_json.h"
+#include "core/signal_pipeline.h"
+#include "core/sr_incremental.h"
+#include "core/trend_incremental.h"
+
+namespace {
+
+using volarix4::core::ColumnBuffer;
+using volarix4::core::OHLCVBar;
+using volarix4::core::PipelineOptions;
+using volarix4::core::PipelineResult;
+using volarix4::core::StrategyParams;
+
+constexpr size_t kStreamBars = 20000;
+
+// GetVolarix4SignalLocal on range(0) packed bars (UTC session clock; no
+// signal cooldown, so every iteration does the same work)
+void BM_LocalSignal(benchmark::State& state)
+{
+    const std::vector<OHLCVBar> bars = volarix4::bench::SyntheticBars((size_t)state.range(0));
+    const StrategyParams params = volarix4::core::DefaultStrategyParams();
+
+    for (auto _ : state) {
+        PipelineResult result = volarix4::core::RunSignalPipeline("EURUSD", "H1", bars.data(), bars.size(), params);
+        const std::string& json = volarix4::bridge::LocalSignalJson(result);
+        benchmark::DoNotOptimize(json.data());
+    }
+}
+BENCHMARK(BM_LocalSignal)->Arg(400)->Arg(5000);
+
+// GetVolarix4SignalFromStore: a 400-bar window of the stored columns that
+// moves one candle per iteration, with the stream's incremental S/R and
+// EMA state - the EA's steady state. Out-of-session candles return early,
+// as they do live.
+void BM_LocalSignalStream(benchmark::State& state)
+{
+    const size_t window = (size_t)state.range(0);
+    const ColumnBuffer bars = volarix4::bench::SyntheticColumns(window + kStreamBars);
+    const StrategyParams params = volarix4::core::DefaultStrategyParams();
+    volarix4::core::IncrementalSRLevels sr_levels;
+    volarix4::core::IncrementalTrend trend;
+
+    PipelineOptions options;
+    options.srLevels = &sr_levels;
+    options.trend = &trend;
+
+    size_t first = 0, signals = 0;
+    for (auto _ : state) {
+        PipelineResult result =
+            volarix4::core::RunSignalPipeline("EURUSD", "H1", bars.View().Slice(first, window), params, options);
+        const std::string& json = volarix4::bridge::LocalSignalJson(result);
+        benchmark::DoNotOptimize(json.data());
+        signals += result.response.signal != volarix4::core::kSignalHold;
+        if (++first == kStreamBars)
+            first = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["signal_rate"] = (double)signals / (double)state.iterations();
+}
+BENCHMARK(BM_LocalSignalStream)->Arg(400);
+
+} // namespace
@@ -0,0 +1,77 @@
+"""Compare two volarix4_bench runs and flag regressions.
+
+Both files are Google Benchmark JSON output:
+
+    volarix4_bench --benchmark_repetitions=5 --benchmark_out=base.json
+    ... build the candidate commit ...
+    volarix4_bench --benchmark_repetitions=5 --benchmark_out=new.json
+    python bench/compare.py base.json new.json --threshold 10
+
+With repetitions the median of each benchmark is compared (noise from a
+single run is easily 5%); without them, the single run. Exits 1 if any
+benchmark got slower by more than the threshold, so the check can gate a
+deployment.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_times(path, metric):
+    """{benchmark name: time in ns} from a Google Benchmark JSON file."""
+    with open(path) as f:
+        report = json.load(f)
+
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    runs, medians = {}, {}
+    for bench in report.get("benchmarks", []):
+        value = bench[metric] * scale[bench.get("time_unit", "ns")]
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[bench["run_name"]] = value
+        else:
+            runs.setdefault(bench.get("run_name", bench["name"]), value)
+    runs.update(medians)
+    return runs
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two volarix4_bench JSON outputs",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument("baseline", help="JSON output of the baseline build")
+    parser.add_argument("candidate", help="JSON output of the build under test")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Slowdown in percent that counts as a regression")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="cpu_time")
+    args = parser.parse_args()
+
+    baseline = load_times(args.baseline, args.metric)
+    candidate = load_times(args.candidate, args.metric)
+
+    regressions = 0
+    print(f"{'Benchmark':<40} {'Baseline':>12} {'Candidate':>12} {'Change':>9}")
+    for name in sorted(set(baseline) | set(candidate)):
+        if name not in baseline or name not in candidate:
+            only = "baseline" if name in baseline else "candidate"
+            print(f"{name:<40} {'':>12} {'':>12}   only in {only}")
+            continue
+
+        change = (candidate[name] / baseline[name] - 1.0) * 100.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<40} {baseline[name]:>10.0f}ns {candidate[name]:>10.0f}ns "
+              f"{change:>+8.1f}%{flag}")
+
+    if regressions:
+        print(f"\n{regressions} benchmark(s) slower by more than {args.threshold:g}%")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
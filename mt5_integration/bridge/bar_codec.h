@@ -0,0 +1,177 @@
+//=============================================================================
+//  bridge/bar_codec.h
+//  Compact binary bar upload format (Content-Type: application/x-volarix-bars)
+//
+//  Layout (all little-endian, no padding):
+//      char[4]  magic "VXB1"
+//      uint8    symbol length, timeframe length, context timeframe length
+//      uint8    reserved (0)
+//      uint32   bar count, context bar count
+//      symbol, timeframe, context timeframe (ASCII)
+//      bar records, then context bar records (48 bytes each):
+//          int64 time (Unix seconds), float64 open, high, low, close, volume
+//
+//  Mirrors volarix4/utils/bar_codec.py - keep the two in sync.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace volarix4::bridge {
+
+constexpr char kBinaryBarsContentType[] = "application/x-volarix-bars";
+constexpr size_t kBinaryBarsHeaderSize = 16;
+constexpr size_t kBinaryBarRecordSize = 48;
+
+//=============================================================================
+//  Timestamp parsing
+//=============================================================================
+
+// Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's
+// days_from_civil)
+constexpr long long DaysFromCivil(int year, unsigned month, unsigned day)
+{
+    year -= month <= 2;
+    const long long era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = (unsigned)(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (long long)doe - 719468;
+}
+
+// Parse "YYYY-MM-DDTHH:MM:SS[Z]" (UTC) into a Unix timestamp. Also accepts
+// MQL5 TimeToString output ("YYYY.MM.DD HH:MM:SS"). Returns -1 if malformed.
+inline long long ParseIsoTimestamp(std::string_view text)
+{
+    auto digits = [&](size_t pos, size_t count, int& value) {
+        if (pos + count > text.size())
+            return false;
+        value = 0;
+        for (size_t i = pos; i < pos + count; ++i) {
+            if (text[i] < '0' || text[i] > '9')
+                return false;
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    };
+
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    if (!digits(0, 4, year) || !digits(5, 2, month) || !digits(8, 2, day))
+        return -1;
+    if (month < 1 || month > 12 || day < 1 || day > 31)
+        return -1;
+    if (text.size() > 10 && (!digits(11, 2, hour) || !digits(14, 2, minute)))
+        return -1;
+    if (text.size() > 16 && text[16] == ':' && !digits(17, 2, second))
+        return -1;
+
+    return DaysFromCivil(year, (unsigned)month, (unsigned)day) * 86400LL +
+           hour * 3600LL + minute * 60LL + second;
+}
+
+//=============================================================================
+//  BinaryBarWriter
+//
+//  Same per-thread buffer reuse as JsonWriter: after the first candle the
+//  payload is built without allocating.
+//=============================================================================
+class BinaryBarWriter
+{
+public:
+    static BinaryBarWriter& ThreadLocal()
+    {
+        thread_local BinaryBarWriter writer;
+        return writer;
+    }
+
+    // The names fit the header's 1-byte length fields
+    static bool Fits(std::string_view symbol, std::string_view timeframe,
+                     std::string_view context_timeframe)
+    {
+        return symbol.size() <= 255 && timeframe.size() <= 255 && context_timeframe.size() <= 255;
+    }
+
+    // Bytes of the whole payload for these names and counts
+    static size_t PayloadBytes(std::string_view symbol, std::string_view timeframe,
+                               std::string_view context_timeframe,
+                               uint32_t bar_count, uint32_t context_bar_count)
+    {
+        return kBinaryBarsHeaderSize + symbol.size() + timeframe.size() + context_timeframe.size() +
+            ((size_t)bar_count + context_bar_count) * kBinaryBarRecordSize;
+    }
+
+    // Start a payload and write its header. Returns false if a name does not
+    // fit the 1-byte length fields.
+    bool Begin(std::string_view symbol, std::string_view timeframe,
+               std::string_view context_timeframe,
+               uint32_t bar_count, uint32_t context_bar_count)
+    {
+        return Begin(symbol, timeframe, context_timeframe, bar_count, context_bar_count,
+                     PayloadBytes(symbol, timeframe, context_timeframe, bar_count, context_bar_count));
+    }
+
+    // Same, reserving only reserve_bytes - for a payload handed on in pieces
+    // (Consume between them)
+    bool Begin(std::string_view symbol, std::string_view timeframe,
+               std::string_view context_timeframe,
+               uint32_t bar_count, uint32_t context_bar_count, size_t reserve_bytes)
+    {
+        if (!Fits(symbol, timeframe, context_timeframe))
+            return false;
+
+        buffer_.clear();
+        if (reserve_bytes > buffer_.capacity())
+            buffer_.reserve(reserve_bytes);
+
+        buffer_.append("VXB1", 4);
+        buffer_ += (char)symbol.size();
+        buffer_ += (char)timeframe.size();
+        buffer_ += (char)context_timeframe.size();
+        buffer_ += '\0';
+        AppendLE(bar_count, 4);
+        AppendLE(context_bar_count, 4);
+        buffer_.append(symbol.data(), symbol.size());
+        buffer_.append(timeframe.data(), timeframe.size());
+        buffer_.append(context_timeframe.data(), context_timeframe.size());
+        return true;
+    }
+
+    void AppendBar(long long time, double open, double high, double low,
+                   double close, double volume)
+    {
+        AppendLE((uint64_t)time, 8);
+        AppendDouble(open);
+        AppendDouble(high);
+        AppendDouble(low);
+        AppendDouble(close);
+        AppendDouble(volume);
+    }
+
+    const std::string& str() const { return buffer_; }
+    size_t size() const { return buffer_.size(); }
+
+    // Drop the bytes written so far; the payload continues
+    void Consume() { buffer_.clear(); }
+
+private:
+    void AppendLE(uint64_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; ++i)
+            buffer_ += (char)((value >> (8 * i)) & 0xFF);
+    }
+
+    void AppendDouble(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        AppendLE(bits, 8);
+    }
+
+    std::string buffer_;
+};
+
+} // namespace volarix4::bridge
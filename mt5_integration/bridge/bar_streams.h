@@ -0,0 +1,86 @@
+//=============================================================================
+//  bridge/bar_streams.h
+//  Per-(symbol, timeframe) cursor for incremental bar push (/signal/stream)
+//
+//  Remembers the newest bar time the server has acknowledged and the last
+//  sequence number used, so each candle only the bars after that time are
+//  sent. A stream that was never synced, or that the server reported out of
+//  step, is resent in full with reset=true and sequence 1.
+//
+//  The server keys its windows by (client_id, symbol, timeframe), so two
+//  terminals pushing the same symbol and timeframe keep separate streams.
+//  The client id is random per loaded DLL and sent with every push.
+//=============================================================================
+#pragma once
+
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace volarix4::bridge {
+
+class BarStreamTracker
+{
+public:
+    struct Cursor
+    {
+        long long last_time = 0;   // Newest bar time acknowledged by the server
+        long long seq = 0;         // Sequence number of that push
+        bool synced = false;       // False until a push has been acknowledged
+    };
+
+    static BarStreamTracker& Instance()
+    {
+        static BarStreamTracker tracker;
+        return tracker;
+    }
+
+    // 16 hex digits, fixed for the life of the DLL
+    const std::string& ClientId() const { return client_id_; }
+
+    static std::string Key(const std::string& symbol, const std::string& timeframe)
+    {
+        return symbol + "|" + timeframe;
+    }
+
+    Cursor Get(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cursors_.find(key);
+        return it != cursors_.end() ? it->second : Cursor();
+    }
+
+    // Server accepted push `seq` whose newest bar is `last_time`
+    void Commit(const std::string& key, long long last_time, long long seq)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cursors_[key] = Cursor{ last_time, seq, true };
+    }
+
+    // Force the next push for this stream to be a full resync
+    void Invalidate(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cursors_.erase(key);
+    }
+
+private:
+    BarStreamTracker()
+    {
+        std::random_device random;
+        const unsigned long long id = ((unsigned long long)random() << 32) ^ random();
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", id);
+        client_id_ = text;
+    }
+    BarStreamTracker(const BarStreamTracker&) = delete;
+    BarStreamTracker& operator=(const BarStreamTracker&) = delete;
+
+    std::string client_id_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, Cursor> cursors_;
+};
+
+} // namespace volarix4::bridge
@@ -0,0 +1,317 @@
+//=============================================================================
+//  bridge/debug_log.h
+//  Asynchronous debug log (bounded lock-free MPSC queue + pool writer)
+//
+//  Callers copy the line into a fixed slot of a bounded ring (Vyukov-style
+//  sequence numbers, lock-free for any number of producers) and return; a
+//  single drain job on a private thread pool writes whatever is queued in
+//  one WriteFile per batch and keeps the file open between batches. When
+//  the ring is full the line is dropped and counted - logging never blocks
+//  an EA. Below the configured level, Enabled() is one relaxed atomic load,
+//  so call sites guard any message formatting with it.
+//
+//  The drain pool is bound to the DLL module with SetThreadpoolCallbackLibrary,
+//  like SignalJobQueue, so the DLL cannot unload mid-write; Flush() (from
+//  ShutdownVolarix4Bridge, where the bridge has one) writes the rest
+//  synchronously. The pool lives as long as the process: closing it would
+//  race with producers on other threads, and DllMain must not wait for it.
+//=============================================================================
+#pragma once
+
+#include <windows.h>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace volarix4::bridge {
+
+enum class LogLevel : int
+{
+    kOff = 0,
+    kError = 1,
+    kInfo = 2,
+    kDebug = 3
+};
+
+class DebugLog
+{
+public:
+    static constexpr size_t kSlotCount = 1024;       // Power of two
+    static constexpr size_t kSlotBytes = 1024;       // Longer lines are truncated
+    static constexpr size_t kBatchBytes = 64 * 1024;
+
+    static DebugLog& Instance()
+    {
+        static DebugLog log;
+        return log;
+    }
+
+    static bool Enabled(LogLevel level)
+    {
+        return (int)level <= Instance().level_.load(std::memory_order_relaxed);
+    }
+
+    // Path used until Configure() is called (the bridge's historical
+    // location). module may be NULL: the module containing this code is
+    // looked up when the writer starts.
+    void Initialize(HMODULE module, const char* default_path)
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        module_ = module;
+        path_ = default_path;
+        path_generation_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Empty path keeps the current file; level kOff disables logging
+    void Configure(const std::string& path, LogLevel level)
+    {
+        {
+            std::lock_guard<std::mutex> lock(config_mutex_);
+            if (!path.empty() && path != path_) {
+                path_ = path;
+                path_generation_.fetch_add(1, std::memory_order_release);
+            }
+        }
+        level_.store((int)level, std::memory_order_relaxed);
+    }
+
+    LogLevel Level() const { return (LogLevel)level_.load(std::memory_order_relaxed); }
+
+    // Queue one line (a newline is appended). Never blocks; returns false if
+    // the line was dropped (level filtered, ring full, or no writer).
+    bool Write(LogLevel level, const char* message)
+    {
+        if (!Enabled(level) || message == nullptr)
+            return false;
+
+        if (!ready_.load(std::memory_order_acquire) && !Start())
+            return false;
+
+        size_t position = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;)
+        {
+            slot = &slots_[position & (kSlotCount - 1)];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        size_t length = std::strlen(message);
+        if (length > kSlotBytes)
+            length = kSlotBytes;
+        std::memcpy(slot->text, message, length);
+        slot->length = (unsigned)length;
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        if (!scheduled_.exchange(true, std::memory_order_seq_cst))
+            SubmitThreadpoolWork(work_);
+        return true;
+    }
+
+    unsigned long long DroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // Called from ShutdownVolarix4Bridge (the EA's OnDeinit), never from
+    // DllMain: writes what is queued plus last_line on the calling thread
+    // and closes the file. The writer stays usable - a later Write() opens
+    // the file again.
+    void Flush(const char* last_line = nullptr)
+    {
+        std::lock_guard<std::mutex> lock(start_mutex_);
+        if (!ready_.load(std::memory_order_acquire))
+            return;
+
+        // Take the consumer role the way a producer schedules the drain
+        // job: while scheduled_ is ours no job is queued or running
+        while (scheduled_.exchange(true, std::memory_order_seq_cst))
+            WaitForThreadpoolWorkCallbacks(work_, FALSE);
+
+        Drain();
+        if (last_line && Enabled(LogLevel::kInfo)) {
+            batch_.assign(last_line);
+            batch_ += '\n';
+            WriteBatch();
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+
+        // Lines queued meanwhile did not submit the job; hand them to it
+        scheduled_.store(false, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (HasPending() && !scheduled_.exchange(true, std::memory_order_seq_cst))
+            SubmitThreadpoolWork(work_);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        unsigned length;
+        char text[kSlotBytes];
+    };
+
+    DebugLog() = default;
+    DebugLog(const DebugLog&) = delete;
+    DebugLog& operator=(const DebugLog&) = delete;
+
+    // First Write() allocates the ring and creates the drain pool
+    bool Start()
+    {
+        std::lock_guard<std::mutex> lock(start_mutex_);
+        if (ready_.load(std::memory_order_relaxed))
+            return true;
+
+        if (!slots_) {
+            slots_.reset(new Slot[kSlotCount]);
+            for (size_t i = 0; i < kSlotCount; ++i)
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            enqueue_pos_.store(0, std::memory_order_relaxed);
+            dequeue_pos_ = 0;
+            batch_.reserve(kBatchBytes + kSlotBytes + 1);
+        }
+
+        if (!module_) {
+            GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                               GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                               (LPCSTR)&DebugLog::RunDrain, &module_);
+        }
+
+        pool_ = CreateThreadpool(NULL);
+        if (!pool_)
+            return false;
+        SetThreadpoolThreadMaximum(pool_, 1);
+
+        InitializeThreadpoolEnvironment(&environment_);
+        SetThreadpoolCallbackPool(&environment_, pool_);
+        if (module_)
+            SetThreadpoolCallbackLibrary(&environment_, module_);
+
+        work_ = CreateThreadpoolWork(&DebugLog::RunDrain, this, &environment_);
+        if (!work_) {
+            DestroyThreadpoolEnvironment(&environment_);
+            CloseThreadpool(pool_);
+            pool_ = NULL;
+            return false;
+        }
+
+        ready_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    static void CALLBACK RunDrain(PTP_CALLBACK_INSTANCE, PVOID context, PTP_WORK)
+    {
+        DebugLog* log = static_cast<DebugLog*>(context);
+        for (;;)
+        {
+            log->Drain();
+            log->scheduled_.store(false, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // A producer that saw scheduled_ == true just before the reset
+            // did not submit; pick its line up here
+            if (!log->HasPending() || log->scheduled_.exchange(true, std::memory_order_seq_cst))
+                return;
+        }
+    }
+
+    bool HasPending() const
+    {
+        const Slot& slot = slots_[dequeue_pos_ & (kSlotCount - 1)];
+        return slot.sequence.load(std::memory_order_acquire) == dequeue_pos_ + 1;
+    }
+
+    // Single consumer: the drain job, or Flush() while it holds scheduled_
+    void Drain()
+    {
+        for (;;)
+        {
+            batch_.clear();
+
+            unsigned long long dropped = dropped_.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0)
+                batch_ += "[debug log: " + std::to_string(dropped) + " lines dropped]\n";
+
+            while (batch_.size() < kBatchBytes)
+            {
+                Slot& slot = slots_[dequeue_pos_ & (kSlotCount - 1)];
+                if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+                    break;
+
+                batch_.append(slot.text, slot.length);
+                batch_ += '\n';
+                slot.sequence.store(dequeue_pos_ + kSlotCount, std::memory_order_release);
+                ++dequeue_pos_;
+            }
+
+            if (batch_.empty())
+                return;
+            WriteBatch();
+        }
+    }
+
+    void WriteBatch()
+    {
+        unsigned generation = path_generation_.load(std::memory_order_acquire);
+        if (file_ == INVALID_HANDLE_VALUE || generation != file_generation_) {
+            std::string path;
+            {
+                std::lock_guard<std::mutex> lock(config_mutex_);
+                path = path_;
+            }
+            if (file_ != INVALID_HANDLE_VALUE)
+                CloseHandle(file_);
+            file_ = CreateFileA(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+            file_generation_ = generation;
+        }
+
+        // An unwritable path is retried on the next batch
+        if (file_ == INVALID_HANDLE_VALUE)
+            return;
+
+        DWORD written = 0;
+        if (!WriteFile(file_, batch_.data(), (DWORD)batch_.size(), &written, NULL)) {
+            CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+    }
+
+    // Producers
+    std::atomic<int> level_{ (int)LogLevel::kInfo };
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t> enqueue_pos_{ 0 };
+    std::atomic<unsigned long long> dropped_{ 0 };
+    std::atomic<bool> scheduled_{ false };
+    std::atomic<bool> ready_{ false };
+
+    // Consumer
+    size_t dequeue_pos_ = 0;
+    std::string batch_;
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    unsigned file_generation_ = 0;
+
+    // Configuration and lifetime
+    std::mutex config_mutex_;
+    std::string path_;
+    std::atomic<unsigned> path_generation_{ 0 };
+    std::mutex start_mutex_;
+    HMODULE module_ = NULL;
+    PTP_POOL pool_ = NULL;
+    TP_CALLBACK_ENVIRON environment_;
+    PTP_WORK work_ = NULL;
+};
+
+} // namespace volarix4::bridge
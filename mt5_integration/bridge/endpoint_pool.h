@@ -0,0 +1,409 @@
+//=============================================================================
+//  bridge/endpoint_pool.h
+//  Several API replicas behind one apiUrl: health-tracked endpoint order
+//  with failover, plus optional hedged requests
+//
+//  apiUrl may list endpoints separated by commas (mixing http:// and
+//  shm:// is fine). A call fails over along its plan on a transport error
+//  or a 5xx answer (see IsEndpointFailure). An endpoint that fails is
+//  skipped for an exponentially growing backoff (1 s .. 30 s) and only
+//  tried again - last - while it is still backing off.
+//
+//  /signal is not stateless: each replica keeps its own per-symbol signal
+//  cooldown and its own /signal/stream windows. So a call with an affinity
+//  key (the symbol) is pinned: its plan always starts at the same endpoint
+//  (FNV-1a of the key over the list) and fails over in the same order, and
+//  returns to that endpoint once it is healthy again. Only calls without a
+//  key rotate round-robin.
+//
+//  With hedging on, a call runs on the pool and waits up to the primary
+//  endpoint's p95 latency; if no answer arrived by then the same request is
+//  fired at the next endpoint. The primary's answer is used whenever it
+//  succeeds; a hedge answer wins outright only if the caller accepts it
+//  (a HOLD, which cannot start a cooldown), otherwise it is held back
+//  until the primary fails. The slower request runs to completion in the
+//  background (its latency still feeds the p95) and its answer is dropped.
+//  The pool is bound to the DLL module like SignalJobQueue, so the DLL
+//  cannot be unloaded under a running one.
+//=============================================================================
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "http_session.h"
+#include "json_writer.h"
+#include "latency_stats.h"
+
+namespace volarix4::bridge {
+
+// One POST to one endpoint, possibly on a pool thread
+struct PostAttempt
+{
+    std::string url;
+    HttpError error = HttpError::None;
+    DWORD lastError = 0;
+    DWORD status = 0;            // HTTP status of the response
+    std::string response;
+    CallTimings timings;         // Network phases of this attempt only
+};
+
+// A replica that crashed mid-request or is overloaded answers 5xx: that
+// counts against it like a transport error, for failover, hedging and
+// health. So does an answer whose status could not be read (0).
+inline bool IsEndpointFailure(HttpError error, DWORD status)
+{
+    return error != HttpError::None || status == 0 || status >= 500;
+}
+
+// Performs attempt.url's POST, filling error, lastError, status and response
+using PostFn = std::function<void(PostAttempt& attempt)>;
+
+// Whether a successful hedge answer may be used before the primary's
+using AcceptFn = std::function<bool(const PostAttempt& attempt)>;
+
+class EndpointPool
+{
+public:
+    static constexpr unsigned long long kBaseBackoffMs = 1000;
+    static constexpr unsigned long long kMaxBackoffMs = 30000;
+    static constexpr unsigned long long kMinHedgeSamples = 20;   // Before the p95 is trusted
+    static constexpr double kHedgePercentile = 0.95;
+    static constexpr uint64_t kNoAffinity = 0;                   // Plan: round-robin
+
+    static EndpointPool& Instance()
+    {
+        static EndpointPool pool;
+        return pool;
+    }
+
+    // Called from DllMain(DLL_PROCESS_ATTACH) - only records the module
+    void Initialize(HMODULE module)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        module_ = module;
+    }
+
+    // Called from ShutdownVolarix4Bridge (the EA's OnDeinit), never from
+    // DllMain. A hedged attempt still running keeps the closed pool alive
+    // until it returns; the next hedged call creates a new one.
+    void Shutdown()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pool_) {
+            DestroyThreadpoolEnvironment(&environment_);
+            CloseThreadpool(pool_);
+            pool_ = NULL;
+        }
+        endpoints_.clear();
+        cursors_.clear();
+    }
+
+    // min_delay_ms is a floor under the p95 so a fast, noisy endpoint does
+    // not hedge nearly every call
+    void SetHedging(bool enabled, double min_delay_ms)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        hedging_ = enabled;
+        min_hedge_ms_ = min_delay_ms > 0.0 ? min_delay_ms : 0.0;
+    }
+
+    // The endpoints of a list in the order to try them: the healthy ones,
+    // then the ones in backoff, soonest retry first. With an affinity hash
+    // the healthy ones keep the list order from urls[affinity % size] on,
+    // so a key always lands on the same endpoint while it is healthy;
+    // without one the start moves by one per call (round-robin).
+    std::vector<std::string> Plan(const std::string& api_url, const std::vector<std::string>& urls,
+                                  uint64_t affinity = kNoAffinity)
+    {
+        const unsigned long long now = GetTickCount64();
+        std::vector<std::string> healthy;
+        std::vector<std::pair<unsigned long long, std::string>> backing_off;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t first = affinity != kNoAffinity && !urls.empty() ? (size_t)(affinity % urls.size()) : 0;
+        for (size_t i = 0; i < urls.size(); ++i)
+        {
+            const std::string& url = urls[(first + i) % urls.size()];
+            const Endpoint& endpoint = FindLocked(url);
+            if (endpoint.retryAt <= now)
+                healthy.push_back(url);
+            else
+                backing_off.emplace_back(endpoint.retryAt, url);
+        }
+
+        std::vector<std::string> plan;
+        plan.reserve(urls.size());
+        if (!healthy.empty()) {
+            size_t start = affinity != kNoAffinity ? 0 : (size_t)(cursors_[api_url]++ % healthy.size());
+            for (size_t i = 0; i < healthy.size(); ++i)
+                plan.push_back(healthy[(start + i) % healthy.size()]);
+        }
+        std::stable_sort(backing_off.begin(), backing_off.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto& entry : backing_off)
+            plan.push_back(std::move(entry.second));
+        return plan;
+    }
+
+    void ReportSuccess(const std::string& url, long long elapsed_ticks)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Endpoint& endpoint = FindLocked(url);
+        endpoint.consecutiveFailures = 0;
+        endpoint.retryAt = 0;
+        endpoint.successes++;
+        endpoint.latency->Record(QpcToMicros(elapsed_ticks));
+    }
+
+    void ReportFailure(const std::string& url)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Endpoint& endpoint = FindLocked(url);
+        endpoint.failures++;
+        int shift = (std::min)(endpoint.consecutiveFailures++, 5);
+        endpoint.retryAt = GetTickCount64() + (std::min)(kBaseBackoffMs << shift, kMaxBackoffMs);
+    }
+
+    // Milliseconds to wait on url before hedging, or 0 when hedging is off or
+    // url has too few answered calls for a p95 yet
+    double HedgeDelayMs(const std::string& url)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!hedging_)
+            return 0.0;
+
+        unsigned long long samples = 0;
+        double p95_ms = FindLocked(url).latency->Percentile(kHedgePercentile, &samples) / 1000.0;
+        if (samples < kMinHedgeSamples)
+            return 0.0;
+        return (std::max)(p95_ms, min_hedge_ms_);
+    }
+
+    // Post to primary; if it has not answered after delay_ms, post the same
+    // request to secondary too. Returns the primary's answer if it
+    // succeeds, an earlier secondary answer that accept_hedge accepts, the
+    // secondary's answer if the primary fails, or else the last failure.
+    // *attempted gets the number of endpoints used (1 or 2), so the caller
+    // knows where to continue failing over. Falls back to a plain call on
+    // this thread if the pool cannot be used.
+    PostAttempt Hedge(const std::string& primary, const std::string& secondary,
+                      double delay_ms, PostFn post, AcceptFn accept_hedge, size_t* attempted)
+    {
+        auto race = std::make_shared<Race>();
+        race->post = std::move(post);
+        race->acceptHedge = std::move(accept_hedge);
+        race->attempts[0].url = primary;
+        race->attempts[1].url = secondary;
+
+        *attempted = 1;
+        if (!Launch(race, 0)) {
+            PostAttempt attempt;
+            attempt.url = primary;
+            Run(attempt, race->post);
+            return attempt;
+        }
+
+        std::unique_lock<std::mutex> lock(race->mutex);
+        const auto delay = std::chrono::microseconds((long long)(delay_ms * 1000.0));
+        if (race->done.wait_for(lock, delay, [&] { return race->finished[0]; }))
+            return race->attempts[0];
+
+        lock.unlock();
+        bool hedged = Launch(race, 1);
+        lock.lock();
+        if (hedged) {
+            *attempted = 2;
+            hedged_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        race->done.wait(lock, [&] {
+            return race->winner >= 0 || (race->finished[0] && (!hedged || race->finished[1]));
+        });
+        if (race->winner == 1)
+            hedge_wins_.fetch_add(1, std::memory_order_relaxed);
+        int index = race->winner >= 0 ? race->winner : (hedged ? 1 : 0);
+        return race->attempts[index];
+    }
+
+    // {"hedging":{...},"endpoints":{"<url>":{"healthy":..,"consecutive_failures":..,
+    //  "successes":..,"failures":..,"retry_in_ms":..,"samples":..,"p95_ms":..}}}
+    std::string Json()
+    {
+        const unsigned long long now = GetTickCount64();
+        JsonWriter json;
+        std::lock_guard<std::mutex> lock(mutex_);
+        json.Reset(128 + endpoints_.size() * 200);
+        json.BeginObject().Key("hedging").BeginObject()
+            .Key("enabled").Bool(hedging_)
+            .Field("min_delay_ms", min_hedge_ms_, 1)
+            .Field("hedged", (long long)hedged_.load(std::memory_order_relaxed))
+            .Field("hedge_wins", (long long)hedge_wins_.load(std::memory_order_relaxed))
+            .EndObject()
+            .Key("endpoints").BeginObject();
+        for (const auto& [url, endpoint] : endpoints_)
+        {
+            unsigned long long samples = 0;
+            double p95 = endpoint.latency->Percentile(kHedgePercentile, &samples);
+            json.Key(url).BeginObject()
+                .Key("healthy").Bool(endpoint.retryAt <= now)
+                .Field("consecutive_failures", endpoint.consecutiveFailures)
+                .Field("successes", (long long)endpoint.successes)
+                .Field("failures", (long long)endpoint.failures)
+                .Field("retry_in_ms", (long long)(endpoint.retryAt > now ? endpoint.retryAt - now : 0))
+                .Field("samples", (long long)samples)
+                .Field("p95_ms", p95 / 1000.0, 3)
+                .EndObject();
+        }
+        json.EndObject().EndObject();
+        return json.str();
+    }
+
+private:
+    static constexpr DWORD kMaxWorkers = 8;
+
+    struct Endpoint
+    {
+        int consecutiveFailures = 0;
+        unsigned long long retryAt = 0;           // GetTickCount64(); 0 = healthy
+        unsigned long long successes = 0;
+        unsigned long long failures = 0;
+        std::shared_ptr<LatencyHistogram> latency = std::make_shared<LatencyHistogram>();
+    };
+
+    // Shared by the caller and both attempts; outlives whichever finishes last
+    struct Race
+    {
+        std::mutex mutex;
+        std::condition_variable done;
+        PostFn post;
+        AcceptFn acceptHedge;
+        PostAttempt attempts[2];
+        bool finished[2] = {};
+        int winner = -1;
+    };
+
+    struct RaceContext
+    {
+        EndpointPool* pool;
+        std::shared_ptr<Race> race;
+        int index;
+    };
+
+    EndpointPool() = default;
+    EndpointPool(const EndpointPool&) = delete;
+    EndpointPool& operator=(const EndpointPool&) = delete;
+
+    Endpoint& FindLocked(const std::string& url) { return endpoints_[url]; }
+
+    // Runs one attempt with its own CallTimings and records the endpoint's
+    // health
+    void Run(PostAttempt& attempt, const PostFn& post)
+    {
+        CallTimings& call = CallTimings::Current();
+        CallTimings saved = call;
+        call.Begin();
+
+        const long long start = QpcNow();
+        post(attempt);
+        const long long elapsed = QpcNow() - start;
+        attempt.timings = call;
+        call = saved;
+
+        if (!IsEndpointFailure(attempt.error, attempt.status))
+            ReportSuccess(attempt.url, elapsed);
+        else
+            ReportFailure(attempt.url);
+    }
+
+    bool Launch(const std::shared_ptr<Race>& race, int index)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!EnsurePool())
+            return false;
+
+        RaceContext* context = new RaceContext{ this, race, index };
+        if (!TrySubmitThreadpoolCallback(&EndpointPool::RunAttempt, context, &environment_)) {
+            delete context;
+            return false;
+        }
+        return true;
+    }
+
+    static void CALLBACK RunAttempt(PTP_CALLBACK_INSTANCE, PVOID parameter)
+    {
+        RaceContext* context = static_cast<RaceContext*>(parameter);
+        std::shared_ptr<Race> race = std::move(context->race);
+        EndpointPool* pool = context->pool;
+        int index = context->index;
+        delete context;
+
+        PostAttempt attempt;
+        {
+            std::lock_guard<std::mutex> lock(race->mutex);
+            attempt.url = race->attempts[index].url;
+        }
+        pool->Run(attempt, race->post);
+
+        std::lock_guard<std::mutex> lock(race->mutex);
+        race->attempts[index] = std::move(attempt);
+        race->finished[index] = true;
+        if (race->winner < 0) {
+            auto succeeded = [&](int i) {
+                return race->finished[i] && !IsEndpointFailure(race->attempts[i].error, race->attempts[i].status);
+            };
+            const bool primary_failed = race->finished[0] && !succeeded(0);
+            if (succeeded(0))
+                race->winner = 0;
+            // A hedge answer the caller does not accept waits for the
+            // primary and is used only if that fails
+            else if (succeeded(1) && (primary_failed ||
+                                      (race->acceptHedge && race->acceptHedge(race->attempts[1]))))
+                race->winner = 1;
+        }
+        race->done.notify_all();
+    }
+
+    bool EnsurePool()
+    {
+        if (pool_)
+            return true;
+
+        pool_ = CreateThreadpool(NULL);
+        if (!pool_)
+            return false;
+
+        SetThreadpoolThreadMaximum(pool_, kMaxWorkers);
+        SetThreadpoolThreadMinimum(pool_, 1);
+
+        InitializeThreadpoolEnvironment(&environment_);
+        SetThreadpoolCallbackPool(&environment_, pool_);
+        if (module_)
+            SetThreadpoolCallbackLibrary(&environment_, module_);
+
+        return true;
+    }
+
+    std::mutex mutex_;
+    HMODULE module_ = NULL;
+    PTP_POOL pool_ = NULL;
+    TP_CALLBACK_ENVIRON environment_{};
+    bool hedging_ = false;
+    double min_hedge_ms_ = 0.0;
+    std::atomic<unsigned long long> hedged_{ 0 };
+    std::atomic<unsigned long long> hedge_wins_{ 0 };
+    std::unordered_map<std::string, Endpoint> endpoints_;
+    std::unordered_map<std::string, unsigned long long> cursors_;
+};
+
+} // namespace volarix4::bridge
@@ -0,0 +1,347 @@
+//=============================================================================
+//  bridge/http_session.h
+//  Process-wide WinINet session shared by every export in the bridge
+//
+//  One InternetOpen session for the whole process plus one InternetConnect
+//  handle per host:port. Requests are sent as HTTP/1.1 with keep-alive so
+//  WinINet reuses the pooled socket between candles instead of doing a new
+//  TCP handshake (and session setup) on every call from every chart.
+//
+//  Each Post() fills the connect/send/ttfb/read phases of the calling
+//  thread's CallTimings (see latency_stats.h); the socket-level split comes
+//  from the WinINet status callback.
+//=============================================================================
+#pragma once
+
+#include <windows.h>
+#include <wininet.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "latency_stats.h"
+
+namespace volarix4::bridge {
+
+//=============================================================================
+//  API endpoint parsed from the EA's apiUrl (expected format: http://host:port)
+//=============================================================================
+struct ApiEndpoint
+{
+    std::string host = "localhost";
+    INTERNET_PORT port = 8000;
+
+    std::string Key() const { return host + ":" + std::to_string(port); }
+};
+
+inline ApiEndpoint ParseApiUrl(const std::string& api_url)
+{
+    ApiEndpoint endpoint;
+
+    size_t proto_end = api_url.find("://");
+    if (proto_end == std::string::npos)
+        return endpoint;
+
+    std::string url_part = api_url.substr(proto_end + 3);
+
+    // Drop any path component (http://host:port/...)
+    size_t path_pos = url_part.find('/');
+    if (path_pos != std::string::npos)
+        url_part.resize(path_pos);
+
+    size_t port_pos = url_part.find(':');
+    if (port_pos != std::string::npos) {
+        endpoint.host = url_part.substr(0, port_pos);
+        long port = std::strtol(url_part.c_str() + port_pos + 1, nullptr, 10);
+        if (port > 0 && port <= 65535)
+            endpoint.port = (INTERNET_PORT)port;
+    } else if (!url_part.empty()) {
+        endpoint.host = url_part;
+    }
+
+    return endpoint;
+}
+
+//=============================================================================
+//  Error codes (mapped to the JSON error strings the EAs already handle)
+//=============================================================================
+enum class HttpError
+{
+    None,
+    InternetOpen,
+    InternetConnect,
+    HttpOpenRequest,
+    HttpSendRequest,
+    InternetReadFile,       // request sent, response cut off - never re-sent
+    SharedMemoryOpen,       // shm:// endpoint: no server mapping with that name
+    SharedMemoryTimeout,    // shm:// endpoint: no free slot or no answer in time
+    SharedMemoryTooLarge    // shm:// endpoint: request does not fit a slot
+};
+
+inline const char* HttpErrorJson(HttpError error)
+{
+    switch (error)
+    {
+    case HttpError::InternetOpen:         return "{\"error\":\"InternetOpen failed\"}";
+    case HttpError::InternetConnect:      return "{\"error\":\"InternetConnect failed\"}";
+    case HttpError::HttpOpenRequest:      return "{\"error\":\"HttpOpenRequest failed\"}";
+    case HttpError::HttpSendRequest:      return "{\"error\":\"HttpSendRequest failed\"}";
+    case HttpError::InternetReadFile:     return "{\"error\":\"InternetReadFile failed\"}";
+    case HttpError::SharedMemoryOpen:     return "{\"error\":\"Shared memory endpoint not available\"}";
+    case HttpError::SharedMemoryTimeout:  return "{\"error\":\"Shared memory request timed out\"}";
+    case HttpError::SharedMemoryTooLarge: return "{\"error\":\"Request too large for shared memory slot\"}";
+    default:                              return "{\"error\":\"Unknown error\"}";
+    }
+}
+
+//=============================================================================
+//  HttpSessionPool
+//
+//  Connection handles are reference counted so a handle that is dropped after
+//  a stale-socket error stays valid for requests still in flight on other
+//  threads, and is closed once the last of them finishes. Every connection
+//  also holds a reference to its session, so Shutdown() never closes the
+//  session under a request still using it.
+//=============================================================================
+class HttpSessionPool
+{
+public:
+    static HttpSessionPool& Instance()
+    {
+        static HttpSessionPool pool;
+        return pool;
+    }
+
+    // Called from DllMain(DLL_PROCESS_ATTACH). WinINet must not be called
+    // under the loader lock, so this only records the user agent - the
+    // session itself is opened by the first request.
+    void Initialize(const char* user_agent)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        user_agent_ = user_agent;
+    }
+
+    // Called from ShutdownVolarix4Bridge (the EA's OnDeinit), never from
+    // DllMain. Drops the pool's handles; requests in flight keep theirs and
+    // the next request opens a new session.
+    void Shutdown()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connections_.clear();
+        session_.reset();
+    }
+
+    // POST body to endpoint+path and read the full response; its HTTP
+    // status goes to *status_code when given (0 if it could not be read).
+    // Retries once on a fresh connection if sending failed because the
+    // server dropped the idle keep-alive socket; a failure while reading
+    // the response is returned as InternetReadFile, never retried.
+    HttpError Post(const ApiEndpoint& endpoint,
+                   const char* path,
+                   const char* headers,
+                   const char* body,
+                   DWORD body_length,
+                   std::string& response,
+                   DWORD* last_error = nullptr,
+                   DWORD* status_code = nullptr)
+    {
+        CallTimings& call = CallTimings::Current();
+        call.endpoint = endpoint.Key();
+        call.endpoint += path;
+
+        const long long post_start = QpcNow();
+        HttpError error = HttpError::None;
+
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            std::shared_ptr<void> connection = AcquireConnection(endpoint, error);
+            if (!connection) {
+                call.failed = true;
+                return error;
+            }
+
+            RequestTimeline timeline;
+            LPCSTR acceptTypes[] = { "application/json", NULL };
+            HINTERNET hRequest = HttpOpenRequestA(connection.get(),
+                "POST",
+                path,
+                "HTTP/1.1",
+                NULL,
+                acceptTypes,
+                INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE |
+                INTERNET_FLAG_KEEP_CONNECTION | INTERNET_FLAG_NO_UI,
+                (DWORD_PTR)&timeline);
+
+            if (!hRequest) {
+                if (last_error) *last_error = GetLastError();
+                DropConnection(endpoint.Key(), connection);
+                error = HttpError::HttpOpenRequest;
+                continue;
+            }
+
+            const long long opened = QpcNow();
+            BOOL bSent = HttpSendRequestA(hRequest,
+                headers,
+                headers ? (DWORD)strlen(headers) : 0,
+                (LPVOID)body,
+                body_length);
+            const long long headers_received = QpcNow();
+
+            if (!bSent) {
+                DWORD code = GetLastError();
+                InternetCloseHandle(hRequest);
+                if (last_error) *last_error = code;
+
+                error = HttpError::HttpSendRequest;
+                if (IsStaleConnectionError(code)) {
+                    DropConnection(endpoint.Key(), connection);
+                    continue;
+                }
+                call.failed = true;
+                return error;
+            }
+
+            response.clear();
+            char buffer[4096];
+            DWORD bytesRead = 0;
+            BOOL bRead = FALSE;
+
+            while ((bRead = InternetReadFile(hRequest, buffer, sizeof(buffer), &bytesRead)) && bytesRead > 0)
+                response.append(buffer, bytesRead);
+
+            DWORD read_error = bRead ? ERROR_SUCCESS : GetLastError();
+            if (status_code) {
+                DWORD code = 0, code_size = sizeof(code);
+                *status_code = HttpQueryInfoA(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER,
+                                              &code, &code_size, NULL) ? code : 0;
+            }
+            InternetCloseHandle(hRequest);
+
+            // The POST is not idempotent: once HttpSendRequestA succeeded the
+            // server may have acted on it, so a failed read is returned to
+            // the caller rather than sent again on a fresh connection
+            if (!bRead) {
+                if (last_error) *last_error = read_error;
+                DropConnection(endpoint.Key(), connection);
+                call.failed = true;
+                return HttpError::InternetReadFile;
+            }
+
+            // Without status callbacks (none fired) the send time is counted
+            // as time to first byte
+            const long long send_start = timeline.sending ? timeline.sending : opened;
+            const long long send_end = timeline.sent ? timeline.sent : send_start;
+            long long connect = opened - post_start;
+            if (timeline.connecting && timeline.connected)
+                connect += timeline.connected - timeline.connecting;
+
+            call.Add(LatencyPhase::kConnect, connect);
+            call.Add(LatencyPhase::kSend, send_end - send_start);
+            call.Add(LatencyPhase::kFirstByte, headers_received - send_end);
+            call.Add(LatencyPhase::kRead, QpcNow() - headers_received);
+            return HttpError::None;
+        }
+
+        call.failed = true;
+        return error;
+    }
+
+private:
+    // QPC stamps of one request, written by StatusCallback (WinINet calls it
+    // on the requesting thread in synchronous mode)
+    struct RequestTimeline
+    {
+        long long connecting = 0;
+        long long connected = 0;
+        long long sending = 0;
+        long long sent = 0;
+    };
+
+    static void CALLBACK StatusCallback(HINTERNET, DWORD_PTR context, DWORD status, LPVOID, DWORD)
+    {
+        if (!context)
+            return;
+
+        RequestTimeline* timeline = reinterpret_cast<RequestTimeline*>(context);
+        switch (status)
+        {
+        case INTERNET_STATUS_CONNECTING_TO_SERVER: timeline->connecting = QpcNow(); break;
+        case INTERNET_STATUS_CONNECTED_TO_SERVER:  timeline->connected = QpcNow(); break;
+        case INTERNET_STATUS_SENDING_REQUEST:      timeline->sending = QpcNow(); break;
+        case INTERNET_STATUS_REQUEST_SENT:         timeline->sent = QpcNow(); break;
+        default: break;
+        }
+    }
+
+    HttpSessionPool() = default;
+    HttpSessionPool(const HttpSessionPool&) = delete;
+    HttpSessionPool& operator=(const HttpSessionPool&) = delete;
+
+    std::shared_ptr<void> AcquireConnection(const ApiEndpoint& endpoint, HttpError& error)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (!session_) {
+            HINTERNET hSession = InternetOpenA(user_agent_.c_str(),
+                INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
+            if (!hSession) {
+                error = HttpError::InternetOpen;
+                return nullptr;
+            }
+            InternetSetStatusCallbackA(hSession, &HttpSessionPool::StatusCallback);
+            session_.reset(hSession, [](HINTERNET h) { InternetCloseHandle(h); });
+        }
+
+        std::string key = endpoint.Key();
+        auto it = connections_.find(key);
+        if (it != connections_.end())
+            return it->second;
+
+        HINTERNET hConnect = InternetConnectA(session_.get(),
+            endpoint.host.c_str(),
+            endpoint.port,
+            NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
+
+        if (!hConnect) {
+            error = HttpError::InternetConnect;
+            return nullptr;
+        }
+
+        std::shared_ptr<void> connection(hConnect, [session = session_](HINTERNET h) {
+            InternetCloseHandle(h);
+        });
+        connections_[key] = connection;
+        return connection;
+    }
+
+    void DropConnection(const std::string& key, const std::shared_ptr<void>& connection)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = connections_.find(key);
+        if (it != connections_.end() && it->second == connection)
+            connections_.erase(it);
+    }
+
+    static bool IsStaleConnectionError(DWORD code)
+    {
+        switch (code)
+        {
+        case ERROR_INTERNET_CONNECTION_RESET:
+        case ERROR_INTERNET_CONNECTION_ABORTED:
+        case ERROR_HTTP_INVALID_SERVER_RESPONSE:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    std::mutex mutex_;
+    std::string user_agent_ = "Volarix4Bridge";
+    std::shared_ptr<void> session_;
+    std::unordered_map<std::string, std::shared_ptr<void>> connections_;
+};
+
+} // namespace volarix4::bridge
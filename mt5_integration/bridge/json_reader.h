@@ -0,0 +1,309 @@
+//=============================================================================
+//  bridge/json_reader.h
+//  Minimal non-allocating JSON reader for API responses
+//
+//  A single forward pass over the response bytes: values are handed out as
+//  views into the input (strings with their escapes intact), numbers are
+//  converted with std::from_chars and nested objects/arrays are skipped
+//  without being decoded. Nothing is copied unless the caller asks for a
+//  string's decoded text in its own buffer (CopyString). Only what the
+//  bridges need: objects are read member by member, and input that is not
+//  well-formed makes the reader stop and report failure.
+//=============================================================================
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+
+namespace volarix4::bridge {
+
+enum class JsonType
+{
+    kNull,
+    kBool,
+    kNumber,
+    kString,
+    kObject,
+    kArray
+};
+
+struct JsonValue
+{
+    JsonType type = JsonType::kNull;
+    std::string_view raw;      // Number/literal text, string contents without quotes,
+                               // or the whole object/array including brackets
+
+    bool IsString() const { return type == JsonType::kString; }
+    bool IsNumber() const { return type == JsonType::kNumber; }
+
+    bool String(std::string_view text) const { return type == JsonType::kString && raw == text; }
+
+    // Numbers only; anything else (or an unparseable number) gives fallback
+    double AsDouble(double fallback = 0.0) const
+    {
+        if (type != JsonType::kNumber)
+            return fallback;
+        double value = fallback;
+        auto result = std::from_chars(raw.data(), raw.data() + raw.size(), value);
+        return result.ec == std::errc() ? value : fallback;
+    }
+
+    // Decode a string value into out (NUL-terminated, truncated to fit, \uXXXX
+    // as UTF-8); returns the number of bytes written without the NUL
+    size_t CopyString(char* out, size_t capacity) const
+    {
+        if (capacity == 0)
+            return 0;
+        size_t written = 0;
+        auto put = [&](char c) {
+            if (written + 1 < capacity)
+                out[written++] = c;
+        };
+
+        if (type == JsonType::kString)
+        {
+            for (size_t i = 0; i < raw.size(); ++i)
+            {
+                char c = raw[i];
+                if (c != '\\' || i + 1 >= raw.size()) {
+                    put(c);
+                    continue;
+                }
+
+                char escape = raw[++i];
+                switch (escape)
+                {
+                case 'b': put('\b'); break;
+                case 'f': put('\f'); break;
+                case 'n': put('\n'); break;
+                case 'r': put('\r'); break;
+                case 't': put('\t'); break;
+                case 'u':
+                {
+                    unsigned code = 0;
+                    if (i + 4 >= raw.size() || !ParseHex4(raw.substr(i + 1, 4), &code)) {
+                        put('?');
+                        break;
+                    }
+                    i += 4;
+                    // Surrogate pairs (outside the BMP) are not needed for
+                    // the API's messages and come out as '?'
+                    if (code >= 0xD800 && code <= 0xDFFF)
+                        put('?');
+                    else if (code < 0x80)
+                        put((char)code);
+                    else if (code < 0x800) {
+                        put((char)(0xC0 | (code >> 6)));
+                        put((char)(0x80 | (code & 0x3F)));
+                    } else {
+                        put((char)(0xE0 | (code >> 12)));
+                        put((char)(0x80 | ((code >> 6) & 0x3F)));
+                        put((char)(0x80 | (code & 0x3F)));
+                    }
+                    break;
+                }
+                default: put(escape); break;   // \" \\ \/
+                }
+            }
+        }
+
+        out[written] = '\0';
+        return written;
+    }
+
+private:
+    static bool ParseHex4(std::string_view digits, unsigned* code)
+    {
+        unsigned value = 0;
+        for (char c : digits) {
+            value <<= 4;
+            if (c >= '0' && c <= '9')      value |= (unsigned)(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= (unsigned)(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= (unsigned)(c - 'A' + 10);
+            else return false;
+        }
+        *code = value;
+        return true;
+    }
+};
+
+class JsonReader
+{
+public:
+    explicit JsonReader(std::string_view text) : text_(text) {}
+
+    // Call fn(std::string_view key, const JsonValue& value) for every member
+    // of the top-level object, in document order (keys as raw views - the
+    // API's keys have no escapes). fn returns false to stop early. Returns
+    // false if the text is not an object or is malformed before the end.
+    template <typename Fn>
+    bool ForEachMember(Fn&& fn)
+    {
+        pos_ = 0;
+        SkipSpace();
+        if (!Consume('{'))
+            return false;
+
+        SkipSpace();
+        if (Consume('}'))
+            return true;
+
+        for (;;)
+        {
+            JsonValue key;
+            SkipSpace();
+            if (!ReadString(&key))
+                return false;
+            SkipSpace();
+            if (!Consume(':'))
+                return false;
+
+            JsonValue value;
+            SkipSpace();
+            if (!ReadValue(&value))
+                return false;
+            if (!fn(key.raw, value))
+                return true;
+
+            SkipSpace();
+            if (Consume(','))
+                continue;
+            return Consume('}');
+        }
+    }
+
+    // Call fn(const JsonValue& element) for every element of the top-level
+    // array, in order (nested objects come out as kObject views - read them
+    // with a JsonReader of their own). fn returns false to stop early.
+    // Returns false if the text is not an array or is malformed before the
+    // end.
+    template <typename Fn>
+    bool ForEachElement(Fn&& fn)
+    {
+        pos_ = 0;
+        SkipSpace();
+        if (!Consume('['))
+            return false;
+
+        SkipSpace();
+        if (Consume(']'))
+            return true;
+
+        for (;;)
+        {
+            JsonValue value;
+            SkipSpace();
+            if (!ReadValue(&value))
+                return false;
+            if (!fn(value))
+                return true;
+
+            SkipSpace();
+            if (Consume(','))
+                continue;
+            return Consume(']');
+        }
+    }
+
+private:
+    bool AtEnd() const { return pos_ >= text_.size(); }
+    char Peek() const { return text_[pos_]; }
+
+    bool Consume(char c)
+    {
+        if (AtEnd() || Peek() != c)
+            return false;
+        ++pos_;
+        return true;
+    }
+
+    void SkipSpace()
+    {
+        while (!AtEnd() && (Peek() == ' ' || Peek() == '\t' || Peek() == '\n' || Peek() == '\r'))
+            ++pos_;
+    }
+
+    bool ReadString(JsonValue* value)
+    {
+        if (!Consume('"'))
+            return false;
+        size_t start = pos_;
+        while (!AtEnd())
+        {
+            char c = text_[pos_++];
+            if (c == '\\') {
+                if (AtEnd())
+                    return false;
+                ++pos_;
+            } else if (c == '"') {
+                value->type = JsonType::kString;
+                value->raw = text_.substr(start, pos_ - 1 - start);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReadValue(JsonValue* value)
+    {
+        if (AtEnd())
+            return false;
+
+        char c = Peek();
+        if (c == '"')
+            return ReadString(value);
+        if (c == '{' || c == '[')
+            return SkipContainer(value);
+
+        size_t start = pos_;
+        while (!AtEnd() && Peek() != ',' && Peek() != '}' && Peek() != ']' &&
+               Peek() != ' ' && Peek() != '\t' && Peek() != '\n' && Peek() != '\r')
+            ++pos_;
+        value->raw = text_.substr(start, pos_ - start);
+
+        if (value->raw == "null")
+            value->type = JsonType::kNull;
+        else if (value->raw == "true" || value->raw == "false")
+            value->type = JsonType::kBool;
+        else if (!value->raw.empty() && (c == '-' || (c >= '0' && c <= '9')))
+            value->type = JsonType::kNumber;
+        else
+            return false;
+        return true;
+    }
+
+    // Bracket matching that steps over strings; contents are not validated
+    bool SkipContainer(JsonValue* value)
+    {
+        size_t start = pos_;
+        int depth = 0;
+        while (!AtEnd())
+        {
+            char c = text_[pos_];
+            if (c == '"') {
+                JsonValue ignored;
+                if (!ReadString(&ignored))
+                    return false;
+                continue;
+            }
+
+            ++pos_;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    value->type = text_[start] == '{' ? JsonType::kObject : JsonType::kArray;
+                    value->raw = text_.substr(start, pos_ - start);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+} // namespace volarix4::bridge
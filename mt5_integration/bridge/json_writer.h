@@ -0,0 +1,183 @@
+//=============================================================================
+//  bridge/json_writer.h
+//  Minimal JSON payload writer for the bridges
+//
+//  Formats straight into a per-thread buffer with std::to_chars - no
+//  iostreams and no locale. The buffer keeps its capacity between calls, so
+//  after the first candle building a payload does not allocate at all.
+//=============================================================================
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace volarix4::bridge {
+
+class JsonWriter
+{
+public:
+    // Writer owned by the calling thread (MT5 terminal thread or a worker
+    // thread of the async pool)
+    static JsonWriter& ThreadLocal()
+    {
+        thread_local JsonWriter writer;
+        return writer;
+    }
+
+    // Start a new document, growing the buffer to at least reserve_bytes
+    void Reset(size_t reserve_bytes = 0)
+    {
+        buffer_.clear();
+        if (reserve_bytes > buffer_.capacity())
+            buffer_.reserve(reserve_bytes);
+        needs_comma_ = false;
+        after_key_ = false;
+    }
+
+    const std::string& str() const { return buffer_; }
+    size_t size() const { return buffer_.size(); }
+
+    // Drop the text written so far but stay inside the document, for a
+    // payload handed on in pieces (see StreamSignalPayload)
+    void Consume() { buffer_.clear(); }
+
+    JsonWriter& BeginObject() { Separator(); buffer_ += '{'; needs_comma_ = false; return *this; }
+    JsonWriter& EndObject()   { buffer_ += '}'; needs_comma_ = true; return *this; }
+    JsonWriter& BeginArray()  { Separator(); buffer_ += '['; needs_comma_ = false; return *this; }
+    JsonWriter& EndArray()    { buffer_ += ']'; needs_comma_ = true; return *this; }
+
+    JsonWriter& Key(std::string_view key)
+    {
+        if (needs_comma_)
+            buffer_ += ',';
+        AppendQuoted(key);
+        buffer_ += ':';
+        after_key_ = true;
+        needs_comma_ = false;
+        return *this;
+    }
+
+    JsonWriter& String(std::string_view value)
+    {
+        Separator();
+        AppendQuoted(value);
+        needs_comma_ = true;
+        return *this;
+    }
+
+    JsonWriter& Int(long long value)
+    {
+        Separator();
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer_.append(digits, result.ptr);
+        needs_comma_ = true;
+        return *this;
+    }
+
+    JsonWriter& Bool(bool value)
+    {
+        Separator();
+        buffer_ += value ? "true" : "false";
+        needs_comma_ = true;
+        return *this;
+    }
+
+    // Shortest representation that round-trips to the same double
+    JsonWriter& Double(double value)
+    {
+        Separator();
+        if (!std::isfinite(value)) {
+            buffer_ += "null";
+        } else {
+            char digits[32];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            buffer_.append(digits, result.ptr);
+        }
+        needs_comma_ = true;
+        return *this;
+    }
+
+    // Fixed notation with the given number of decimals (like std::fixed)
+    JsonWriter& Fixed(double value, int precision)
+    {
+        Separator();
+        if (!std::isfinite(value)) {
+            buffer_ += "null";
+        } else {
+            char digits[64];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value,
+                                        std::chars_format::fixed, precision);
+            if (result.ec == std::errc())
+                buffer_.append(digits, result.ptr);
+            else
+                buffer_ += "null";
+        }
+        needs_comma_ = true;
+        return *this;
+    }
+
+    // Pre-formatted JSON value, written verbatim
+    JsonWriter& Raw(std::string_view value)
+    {
+        Separator();
+        buffer_.append(value.data(), value.size());
+        needs_comma_ = true;
+        return *this;
+    }
+
+    // Convenience: "key":value pairs
+    JsonWriter& Field(std::string_view key, std::string_view value) { return Key(key).String(value); }
+    JsonWriter& Field(std::string_view key, const char* value)      { return Key(key).String(value); }
+    JsonWriter& Field(std::string_view key, long long value)        { return Key(key).Int(value); }
+    JsonWriter& Field(std::string_view key, int value)              { return Key(key).Int(value); }
+    JsonWriter& Field(std::string_view key, double value)           { return Key(key).Double(value); }
+    JsonWriter& Field(std::string_view key, double value, int precision) { return Key(key).Fixed(value, precision); }
+
+private:
+    void Separator()
+    {
+        if (after_key_) {
+            after_key_ = false;
+            return;
+        }
+        if (needs_comma_)
+            buffer_ += ',';
+    }
+
+    void AppendQuoted(std::string_view text)
+    {
+        static const char kHex[] = "0123456789abcdef";
+
+        buffer_ += '"';
+        for (char c : text)
+        {
+            switch (c)
+            {
+            case '"':  buffer_ += "\\\""; break;
+            case '\\': buffer_ += "\\\\"; break;
+            case '\n': buffer_ += "\\n"; break;
+            case '\r': buffer_ += "\\r"; break;
+            case '\t': buffer_ += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    buffer_ += "\\u00";
+                    buffer_ += kHex[(c >> 4) & 0xF];
+                    buffer_ += kHex[c & 0xF];
+                } else {
+                    buffer_ += c;
+                }
+            }
+        }
+        buffer_ += '"';
+    }
+
+    std::string buffer_;
+    bool needs_comma_ = false;
+    bool after_key_ = false;
+};
+
+} // namespace volarix4::bridge
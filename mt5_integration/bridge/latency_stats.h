@@ -0,0 +1,383 @@
+//=============================================================================
+//  bridge/latency_stats.h
+//  Per-phase call latency (QPC) with HDR-style histograms per endpoint
+//
+//  Every HTTP call is broken into serialize -> connect -> send -> time to
+//  first byte -> read -> BSTR conversion. The phases of the call in flight
+//  on a thread are collected in CallTimings::Current() and committed to the
+//  endpoint's histograms when the call finishes; GetVolarix4BridgeStats()
+//  reports count/p50/p90/p99/max per phase.
+//
+//  Histograms are log-linear in microseconds: exact below 64 us, then 32
+//  sub-buckets per power of two (< 3.2% relative error), like HdrHistogram
+//  with 2 significant digits. Recording is a handful of relaxed atomic adds,
+//  so concurrent EAs never wait on each other here.
+//=============================================================================
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "json_writer.h"
+
+namespace volarix4::bridge {
+
+enum class LatencyPhase : int
+{
+    kSerialize = 0,   // Request payload build
+    kConnect,         // Connection handle + request handle (+ TCP connect)
+    kSend,            // Request headers and body on the wire
+    kFirstByte,       // Request sent -> response headers (server compute)
+    kRead,            // Response body
+    kBstr,            // UTF-16 conversion for MQL5
+    kTotal            // Whole call as seen by the bridge
+};
+
+constexpr int kLatencyPhaseCount = 7;
+
+inline const char* LatencyPhaseName(LatencyPhase phase)
+{
+    switch (phase)
+    {
+    case LatencyPhase::kSerialize: return "serialize";
+    case LatencyPhase::kConnect:   return "connect";
+    case LatencyPhase::kSend:      return "send";
+    case LatencyPhase::kFirstByte: return "ttfb";
+    case LatencyPhase::kRead:      return "read";
+    case LatencyPhase::kBstr:      return "bstr";
+    default:                       return "total";
+    }
+}
+
+//=============================================================================
+//  QueryPerformanceCounter helpers
+//=============================================================================
+inline long long QpcNow()
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart;
+}
+
+inline double QpcToMicros(long long ticks)
+{
+    static const double micros_per_tick = [] {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        return 1e6 / (double)frequency.QuadPart;
+    }();
+    return (double)ticks * micros_per_tick;
+}
+
+//=============================================================================
+//  LatencyHistogram
+//=============================================================================
+class LatencyHistogram
+{
+public:
+    struct Summary
+    {
+        unsigned long long count = 0;
+        double p50 = 0, p90 = 0, p99 = 0, max = 0;   // Microseconds
+    };
+
+    void Record(double micros)
+    {
+        unsigned long long value = micros <= 0 ? 0 : (unsigned long long)(micros + 0.5);
+        buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+
+        unsigned long long seen = max_.load(std::memory_order_relaxed);
+        while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+    }
+
+    // Percentiles report the upper edge of the bucket holding the rank (as
+    // HdrHistogram's highest equivalent value), capped at the exact max
+    Summary Summarize() const
+    {
+        Summary summary;
+        std::vector<unsigned long long> counts = Snapshot(summary.count);
+        if (summary.count == 0)
+            return summary;
+
+        const double max = (double)max_.load(std::memory_order_relaxed);
+        summary.p50 = Percentile(counts, summary.count, max, 0.50);
+        summary.p90 = Percentile(counts, summary.count, max, 0.90);
+        summary.p99 = Percentile(counts, summary.count, max, 0.99);
+        summary.max = max;
+        return summary;
+    }
+
+    // One percentile (0 < q <= 1) in microseconds; *count gets the number of
+    // recorded values (0 = no data, result 0)
+    double Percentile(double q, unsigned long long* count = nullptr) const
+    {
+        unsigned long long total = 0;
+        std::vector<unsigned long long> counts = Snapshot(total);
+        if (count)
+            *count = total;
+        if (total == 0)
+            return 0.0;
+        return Percentile(counts, total, (double)max_.load(std::memory_order_relaxed), q);
+    }
+
+    void Reset()
+    {
+        for (auto& bucket : buckets_)
+            bucket.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr int kLinearBits = 6;                        // Exact below 64 us
+    static constexpr unsigned long long kLinear = 1ull << kLinearBits;
+    static constexpr unsigned long long kSubBuckets = kLinear / 2;
+    static constexpr int kMaxMagnitude = 40;                     // ~12 days in us
+    static constexpr size_t kBucketCount =
+        (size_t)(kLinear + (kMaxMagnitude - kLinearBits + 1) * kSubBuckets);
+
+    std::vector<unsigned long long> Snapshot(unsigned long long& total) const
+    {
+        std::vector<unsigned long long> counts(kBucketCount);
+        total = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            counts[i] = buckets_[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        return counts;
+    }
+
+    static double Percentile(const std::vector<unsigned long long>& counts,
+                             unsigned long long total, double max, double q)
+    {
+        unsigned long long rank = (unsigned long long)(q * (double)total + 0.5);
+        if (rank < 1)
+            rank = 1;
+        unsigned long long seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= rank)
+                return (std::min)((double)BucketUpperEdge(i), max);
+        }
+        return max;
+    }
+
+    static int Magnitude(unsigned long long value)
+    {
+        int msb = 0;
+        while (value >>= 1)
+            ++msb;
+        return msb;
+    }
+
+    static size_t BucketIndex(unsigned long long value)
+    {
+        if (value < kLinear)
+            return (size_t)value;
+
+        int msb = Magnitude(value);
+        if (msb > kMaxMagnitude)
+            return kBucketCount - 1;
+
+        unsigned long long sub = value >> (msb - kLinearBits + 1);   // [32, 64)
+        return (size_t)(kLinear + (msb - kLinearBits) * kSubBuckets + (sub - kSubBuckets));
+    }
+
+    static unsigned long long BucketUpperEdge(size_t index)
+    {
+        if (index < kLinear)
+            return index;
+
+        size_t offset = index - kLinear;
+        int msb = (int)(offset / kSubBuckets) + kLinearBits;
+        unsigned long long sub = offset % kSubBuckets + kSubBuckets;
+        int shift = msb - kLinearBits + 1;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::atomic<unsigned long long> buckets_[kBucketCount] = {};
+    std::atomic<unsigned long long> max_{ 0 };
+};
+
+//=============================================================================
+//  CallTimings - phases of the call in flight on this thread
+//=============================================================================
+struct CallTimings
+{
+    std::string endpoint;                       // "host:port/path", set by the HTTP layer
+    long long start = 0;
+    long long ticks[kLatencyPhaseCount] = {};   // Accumulated QPC ticks per phase
+    bool measured[kLatencyPhaseCount] = {};
+    bool active = false;
+    bool failed = false;
+
+    static CallTimings& Current()
+    {
+        thread_local CallTimings timings;
+        return timings;
+    }
+
+    // Start a new call (drops an unfinished one)
+    void Begin()
+    {
+        endpoint.clear();
+        start = QpcNow();
+        for (int i = 0; i < kLatencyPhaseCount; ++i) {
+            ticks[i] = 0;
+            measured[i] = false;
+        }
+        active = true;
+        failed = false;
+    }
+
+    void Add(LatencyPhase phase, long long elapsed)
+    {
+        if (!active)
+            return;
+        ticks[(int)phase] += elapsed;
+        measured[(int)phase] = true;
+    }
+
+    // Take over the endpoint and network phases of an attempt made with its
+    // own timings (e.g. a hedged request on a pool thread)
+    void Absorb(const CallTimings& attempt)
+    {
+        if (!active)
+            return;
+        endpoint = attempt.endpoint;
+        failed = attempt.failed;
+        for (int i = (int)LatencyPhase::kConnect; i <= (int)LatencyPhase::kRead; ++i) {
+            if (attempt.measured[i])
+                Add((LatencyPhase)i, attempt.ticks[i]);
+        }
+    }
+};
+
+// Times a scope into the current call's phase
+class ScopedPhase
+{
+public:
+    explicit ScopedPhase(LatencyPhase phase) : phase_(phase), start_(QpcNow()) {}
+    ~ScopedPhase() { CallTimings::Current().Add(phase_, QpcNow() - start_); }
+
+private:
+    LatencyPhase phase_;
+    long long start_;
+};
+
+//=============================================================================
+//  BridgeStats - histograms per endpoint
+//=============================================================================
+class BridgeStats
+{
+public:
+    static BridgeStats& Instance()
+    {
+        static BridgeStats stats;
+        return stats;
+    }
+
+    // Record the current call (if one is active and reached an endpoint) and
+    // close it
+    void Commit(CallTimings& call)
+    {
+        if (!call.active)
+            return;
+        call.active = false;
+        if (call.endpoint.empty())
+            return;
+
+        call.ticks[(int)LatencyPhase::kTotal] = QpcNow() - call.start;
+        call.measured[(int)LatencyPhase::kTotal] = true;
+
+        EndpointStats& stats = Find(call.endpoint);
+        stats.calls.fetch_add(1, std::memory_order_relaxed);
+        if (call.failed)
+            stats.errors.fetch_add(1, std::memory_order_relaxed);
+
+        for (int i = 0; i < kLatencyPhaseCount; ++i) {
+            if (call.measured[i])
+                stats.phases[i].Record(QpcToMicros(call.ticks[i]));
+        }
+    }
+
+    // {"unit":"ms","endpoints":{"host:port/path":{"calls":..,"errors":..,
+    //  "serialize":{"count":..,"p50":..,"p90":..,"p99":..,"max":..},..}}}
+    std::string Json() const
+    {
+        std::vector<std::pair<std::string, EndpointStats*>> endpoints;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& entry : endpoints_)
+                endpoints.emplace_back(entry.first, entry.second.get());
+        }
+
+        JsonWriter json;
+        json.Reset(256 + endpoints.size() * 900);
+        json.BeginObject().Field("unit", "ms").Key("endpoints").BeginObject();
+        for (const auto& [key, stats] : endpoints)
+        {
+            json.Key(key).BeginObject()
+                .Field("calls", (long long)stats->calls.load(std::memory_order_relaxed))
+                .Field("errors", (long long)stats->errors.load(std::memory_order_relaxed));
+            for (int i = 0; i < kLatencyPhaseCount; ++i)
+            {
+                LatencyHistogram::Summary summary = stats->phases[i].Summarize();
+                json.Key(LatencyPhaseName((LatencyPhase)i)).BeginObject()
+                    .Field("count", (long long)summary.count)
+                    .Field("p50", summary.p50 / 1000.0, 3)
+                    .Field("p90", summary.p90 / 1000.0, 3)
+                    .Field("p99", summary.p99 / 1000.0, 3)
+                    .Field("max", summary.max / 1000.0, 3)
+                    .EndObject();
+            }
+            json.EndObject();
+        }
+        json.EndObject().EndObject();
+        return json.str();
+    }
+
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : endpoints_) {
+            entry.second->calls.store(0, std::memory_order_relaxed);
+            entry.second->errors.store(0, std::memory_order_relaxed);
+            for (auto& phase : entry.second->phases)
+                phase.Reset();
+        }
+    }
+
+private:
+    struct EndpointStats
+    {
+        std::atomic<unsigned long long> calls{ 0 };
+        std::atomic<unsigned long long> errors{ 0 };
+        LatencyHistogram phases[kLatencyPhaseCount];
+    };
+
+    BridgeStats() = default;
+    BridgeStats(const BridgeStats&) = delete;
+    BridgeStats& operator=(const BridgeStats&) = delete;
+
+    // Entries are never removed, so the reference stays valid
+    EndpointStats& Find(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<EndpointStats>& slot = endpoints_[key];
+        if (!slot)
+            slot = std::make_unique<EndpointStats>();
+        return *slot;
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<EndpointStats>> endpoints_;
+};
+
+} // namespace volarix4::bridge
@@ -0,0 +1,89 @@
+//=============================================================================
+//  bridge/local_signal_json.h
+//  JSON for a local pipeline result (GetVolarix4SignalLocal and the
+//  bar-store exports of Volarix4Bridge.dll)
+//
+//  Serializes a result exactly like the API would - the SignalResponse
+//  fields in order with Python float formatting, or the 422 body for bars
+//  that violate the Parity Contract. A higher-TF context is appended as a
+//  "context" object after the server's fields. Portable, so the local
+//  signal path can be benchmarked end to end (bench/bench_pipeline.cpp).
+//=============================================================================
+#pragma once
+
+#include <string>
+
+#include "json_writer.h"
+#include "../core/helpers.h"
+#include "../core/htf_context.h"
+#include "../core/signal_pipeline.h"
+
+namespace volarix4::bridge {
+
+inline const std::string& LocalSignalJson(const core::PipelineResult& result,
+                                          const core::HtfContext* context = nullptr)
+{
+    JsonWriter& json = JsonWriter::ThreadLocal();
+    json.Reset(512);
+
+    if (!result.barsValid) {
+        json.BeginObject()
+            .Field("error", "Bar Validation Failed")
+            .Field("message", result.validationError)
+            .Field("details", "Bars violate Parity Contract. Ensure MT5 EA sends only closed "
+                              "bars with strictly increasing timestamps.")
+            .EndObject();
+        return json.str();
+    }
+
+    std::string number;
+    auto py_float = [&](const char* key, double value) {
+        number.clear();
+        core::AppendPyRepr(number, value);
+        json.Key(key).Raw(number);
+    };
+
+    const core::SignalResponse& response = result.response;
+    json.BeginObject().Field("signal", core::SignalName(response.signal));
+    py_float("confidence", response.confidence);
+    py_float("entry", response.entry);
+    py_float("sl", response.sl);
+    py_float("tp1", response.tp1);
+    py_float("tp2", response.tp2);
+    py_float("tp3", response.tp3);
+    py_float("tp1_percent", response.tp1Percent);
+    py_float("tp2_percent", response.tp2Percent);
+    py_float("tp3_percent", response.tp3Percent);
+    json.Field("reason", response.reason);
+
+    if (context) {
+        const core::TrendInfo& trend = context->trend;
+        json.Key("context").BeginObject()
+            .Field("timeframe", context->timeframe)
+            .Field("bar_time", context->barTime)
+            .Field("bars", (long long)context->barCount)
+            .Key("valid").Bool(context->valid)
+            .Field("trend", core::TrendName(trend.trend));
+        py_float("strength", trend.strength);
+        py_float("ema_fast", trend.emaFast);
+        py_float("ema_slow", trend.emaSlow);
+        json.Key("allow_buy").Bool(trend.allowBuy)
+            .Key("allow_sell").Bool(trend.allowSell)
+            .Field("trend_reason", trend.reason)
+            .Key("levels").BeginArray();
+        for (const core::SRLevel& level : context->levels)
+        {
+            json.BeginObject();
+            py_float("level", level.level);
+            py_float("score", level.score);
+            json.Field("type", level.type == core::kSupport ? "support" : "resistance")
+                .EndObject();
+        }
+        json.EndArray().EndObject();
+    }
+
+    json.EndObject();
+    return json.str();
+}
+
+} // namespace volarix4::bridge
@@ -0,0 +1,472 @@
+//=============================================================================
+//  bridge/response_cache.h
+//  Bounded LRU cache of /signal responses, optionally backed by a
+//  memory-mapped file
+//
+//  The signal for a closed bar is deterministic (the bridge only caches
+//  HOLD answers: a BUY/SELL starts the server's signal cooldown), so a
+//  request that repeats
+//  (symbol, timeframe, bar_time, strategy params) - Strategy Tester
+//  optimization passes, EA restarts - can be answered without an HTTP call.
+//  The in-memory LRU holds up to `capacity` responses. With a file, every
+//  insert is also written to a direct-mapped slot (hash % slots) of the
+//  mapping, and an LRU miss looks there before going to the API; the file
+//  outlives the process and can be shared by several terminals or tester
+//  agents at once.
+//
+//  Slots are guarded by a per-slot sequence number (odd while a writer owns
+//  the slot) that shares one 64-bit word with the time of the claim:
+//  writers claim a slot with a compare-exchange and skip it if another
+//  process holds it, readers retry nothing and treat a torn read as a miss.
+//  A slot still claimed kStaleClaimSeconds later belongs to a writer that
+//  died mid-write (a killed terminal or tester agent); the next writer takes
+//  it over. A writer that was only stalled finds its claim gone and does
+//  not publish, and a checksum of the response turns any bytes it still
+//  wrote into a miss. The cache is best effort - it never blocks a call and
+//  never fails one.
+//=============================================================================
+#pragma once
+
+#include <windows.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace volarix4::bridge {
+
+// FNV-1a, 64-bit (stable across processes and builds, unlike std::hash)
+inline uint64_t Fnv1a64(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+class ResponseCache
+{
+public:
+    // Off until the EA sizes it (SetVolarix4ResponseCache)
+    static constexpr size_t kDefaultCapacity = 0;
+
+    struct Key
+    {
+        std::string symbol;
+        std::string timeframe;
+        long long barTime = 0;
+        uint64_t paramsHash = 0;     // Strategy/cost params and endpoint
+
+        bool operator==(const Key& other) const
+        {
+            return barTime == other.barTime && paramsHash == other.paramsHash &&
+                   symbol == other.symbol && timeframe == other.timeframe;
+        }
+
+        uint64_t Hash() const
+        {
+            uint64_t hash = Fnv1a64(symbol.data(), symbol.size());
+            hash = Fnv1a64("|", 1, hash);
+            hash = Fnv1a64(timeframe.data(), timeframe.size(), hash);
+            hash = Fnv1a64(&barTime, sizeof(barTime), hash);
+            return Fnv1a64(&paramsHash, sizeof(paramsHash), hash);
+        }
+    };
+
+    struct Stats
+    {
+        unsigned long long hits = 0;
+        unsigned long long fileHits = 0;    // Included in hits
+        unsigned long long misses = 0;
+        size_t entries = 0;
+        size_t capacity = 0;
+        size_t fileSlots = 0;               // 0 = no file
+    };
+
+    static ResponseCache& Instance()
+    {
+        static ResponseCache cache;
+        return cache;
+    }
+
+    bool Enabled() const { return capacity_.load(std::memory_order_relaxed) > 0; }
+
+    // capacity 0 disables the cache (and drops it); an empty path keeps it
+    // in memory only. The file gets one slot per entry of capacity; an
+    // existing cache file keeps its own slot count.
+    bool Configure(size_t capacity, const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_.store(capacity, std::memory_order_relaxed);
+        while (entries_.size() > capacity)
+            Evict();
+
+        if (path != file_path_ || capacity == 0) {
+            CloseFile();
+            if (capacity > 0 && !path.empty() && !OpenFile(path, capacity))
+                return false;
+        }
+        return true;
+    }
+
+    bool Find(const Key& key, std::string* response)
+    {
+        const uint64_t hash = key.Hash();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_.load(std::memory_order_relaxed) == 0)
+            return false;
+
+        auto entry = FindEntry(key, hash);
+        if (entry != entries_.end()) {
+            entries_.splice(entries_.begin(), entries_, entry);
+            *response = entry->response;
+            ++hits_;
+            return true;
+        }
+
+        if (FileRead(key, hash, response)) {
+            Store(key, hash, *response);
+            ++hits_;
+            ++file_hits_;
+            return true;
+        }
+
+        ++misses_;
+        return false;
+    }
+
+    void Insert(const Key& key, const std::string& response)
+    {
+        const uint64_t hash = key.Hash();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_.load(std::memory_order_relaxed) == 0)
+            return;
+
+        Store(key, hash, response);
+        FileWrite(key, hash, response);
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        index_.clear();
+        hits_ = file_hits_ = misses_ = 0;
+    }
+
+    Stats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats;
+        stats.hits = hits_;
+        stats.fileHits = file_hits_;
+        stats.misses = misses_;
+        stats.entries = entries_.size();
+        stats.capacity = capacity_.load(std::memory_order_relaxed);
+        stats.fileSlots = file_slots_;
+        return stats;
+    }
+
+    // Called from ShutdownVolarix4Bridge (the EA's OnDeinit), never from
+    // DllMain. Unmaps the file; the in-memory entries stay.
+    void Shutdown()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CloseFile();
+    }
+
+private:
+    struct Entry
+    {
+        Key key;
+        uint64_t hash;
+        std::string response;
+    };
+
+    //-------------------------------------------------------------------------
+    //  File layout: FileHeader, then file_slots_ FileSlot records
+    //-------------------------------------------------------------------------
+    static constexpr uint32_t kFileMagic = 0x43523456;     // "V4RC"
+    static constexpr uint32_t kFileVersion = 2;            // 2: claim time, response checksum
+    static constexpr size_t kSlotBytes = 1024;
+    static constexpr size_t kSymbolBytes = 32;
+    static constexpr size_t kTimeframeBytes = 8;
+    static constexpr uint32_t kStaleClaimSeconds = 2;      // A 1 KB write takes microseconds
+
+    struct FileHeader
+    {
+        std::atomic<uint32_t> magic;     // Written last
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t slotBytes;
+        uint8_t reserved[48];
+    };
+
+    struct FileSlot
+    {
+        std::atomic<uint64_t> state;     // Low half: sequence, odd while being written, 0 = empty;
+                                         // high half: Unix second of the last claim
+        uint32_t length;
+        uint32_t reserved;
+        uint64_t responseHash;           // Fnv1a64 of the response bytes
+        uint64_t hash;
+        long long barTime;
+        uint64_t paramsHash;
+        char symbol[kSymbolBytes];
+        char timeframe[kTimeframeBytes];
+        char response[1];                // length bytes (up to kMaxFileResponse)
+    };
+
+    static constexpr size_t kMaxFileResponse = kSlotBytes - offsetof(FileSlot, response);
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+                  "shared mapping needs address-free atomics");
+    static_assert(sizeof(FileHeader) == 64, "FileHeader layout");
+
+    ResponseCache() = default;
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    using EntryList = std::list<Entry>;
+
+    // Held under mutex_
+    EntryList::iterator FindEntry(const Key& key, uint64_t hash)
+    {
+        auto range = index_.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->key == key)
+                return it->second;
+        }
+        return entries_.end();
+    }
+
+    void Store(const Key& key, uint64_t hash, const std::string& response)
+    {
+        auto entry = FindEntry(key, hash);
+        if (entry != entries_.end()) {
+            entry->response = response;
+            entries_.splice(entries_.begin(), entries_, entry);
+            return;
+        }
+
+        entries_.push_front(Entry{ key, hash, response });
+        index_.emplace(hash, entries_.begin());
+        while (entries_.size() > capacity_.load(std::memory_order_relaxed))
+            Evict();
+    }
+
+    void Evict()
+    {
+        auto last = std::prev(entries_.end());
+        auto range = index_.equal_range(last->hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == last) {
+                index_.erase(it);
+                break;
+            }
+        }
+        entries_.pop_back();
+    }
+
+    bool OpenFile(const std::string& path, size_t capacity)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            return false;
+        }
+
+        // A new file is sized for `capacity` slots; an existing one is
+        // mapped as it is and its header decides the geometry
+        const bool fresh = size.QuadPart == 0;
+        unsigned long long bytes = fresh
+            ? sizeof(FileHeader) + (unsigned long long)capacity * kSlotBytes
+            : (unsigned long long)size.QuadPart;
+        if (bytes < sizeof(FileHeader)) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE,
+                                            (DWORD)(bytes >> 32), (DWORD)bytes, NULL);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, (size_t)bytes) : NULL;
+        if (!view) {
+            if (mapping)
+                CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        FileHeader* header = static_cast<FileHeader*>(view);
+        if (fresh) {
+            header->version = kFileVersion;
+            header->slotCount = (uint32_t)capacity;
+            header->slotBytes = (uint32_t)kSlotBytes;
+            header->magic.store(kFileMagic, std::memory_order_release);
+        }
+
+        bool valid = header->magic.load(std::memory_order_acquire) == kFileMagic &&
+                     header->version == kFileVersion &&
+                     header->slotBytes == kSlotBytes && header->slotCount > 0 &&
+                     sizeof(FileHeader) + (unsigned long long)header->slotCount * kSlotBytes <= bytes;
+        if (!valid) {
+            UnmapViewOfFile(view);
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        file_ = file;
+        mapping_ = mapping;
+        view_ = static_cast<char*>(view);
+        file_slots_ = header->slotCount;
+        file_path_ = path;
+        return true;
+    }
+
+    void CloseFile()
+    {
+        if (view_)
+            UnmapViewOfFile(view_);
+        if (mapping_)
+            CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+        view_ = nullptr;
+        mapping_ = NULL;
+        file_ = INVALID_HANDLE_VALUE;
+        file_slots_ = 0;
+        file_path_.clear();
+    }
+
+    FileSlot* SlotFor(uint64_t hash) const
+    {
+        return reinterpret_cast<FileSlot*>(view_ + sizeof(FileHeader) +
+                                           (size_t)(hash % file_slots_) * kSlotBytes);
+    }
+
+    // Text fields are NUL-padded; a slot from a damaged file may not be
+    static std::string_view FieldText(const char* field, size_t bytes)
+    {
+        const void* end = std::memchr(field, '\0', bytes);
+        return std::string_view(field, end ? (size_t)(static_cast<const char*>(end) - field) : bytes);
+    }
+
+    static bool KeyMatches(const FileSlot* slot, const Key& key, uint64_t hash)
+    {
+        return slot->hash == hash && slot->barTime == key.barTime &&
+               slot->paramsHash == key.paramsHash &&
+               FieldText(slot->symbol, kSymbolBytes) == key.symbol &&
+               FieldText(slot->timeframe, kTimeframeBytes) == key.timeframe;
+    }
+
+    static uint32_t SequenceOf(uint64_t state) { return (uint32_t)state; }
+    static uint32_t ClaimSecondOf(uint64_t state) { return (uint32_t)(state >> 32); }
+    static uint64_t SlotState(uint32_t claim_second, uint32_t sequence)
+    {
+        return ((uint64_t)claim_second << 32) | sequence;
+    }
+
+    // Unix seconds from the system clock, which every process on the machine
+    // shares (GetTickCount64 would restart with the next boot, the file not)
+    static uint32_t UnixSecondsNow()
+    {
+        FILETIME now;
+        GetSystemTimeAsFileTime(&now);
+        const uint64_t ticks = ((uint64_t)now.dwHighDateTime << 32) | now.dwLowDateTime;
+        return (uint32_t)(ticks / 10000000ull - 11644473600ull);
+    }
+
+    bool FileRead(const Key& key, uint64_t hash, std::string* response) const
+    {
+        if (!view_)
+            return false;
+
+        FileSlot* slot = SlotFor(hash);
+        uint64_t before = slot->state.load(std::memory_order_acquire);
+        if (SequenceOf(before) == 0 || (SequenceOf(before) & 1) || !KeyMatches(slot, key, hash) ||
+            slot->length > kMaxFileResponse)
+            return false;
+
+        const uint64_t response_hash = slot->responseHash;
+        std::string copy(slot->response, slot->length);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->state.load(std::memory_order_relaxed) != before ||
+            Fnv1a64(copy.data(), copy.size()) != response_hash)
+            return false;
+
+        *response = std::move(copy);
+        return true;
+    }
+
+    void FileWrite(const Key& key, uint64_t hash, const std::string& response)
+    {
+        if (!view_ || response.size() > kMaxFileResponse ||
+            key.symbol.size() >= kSymbolBytes || key.timeframe.size() >= kTimeframeBytes)
+            return;
+
+        FileSlot* slot = SlotFor(hash);
+        const uint32_t now = UnixSecondsNow();
+        uint64_t state = slot->state.load(std::memory_order_relaxed);
+        uint32_t sequence = SequenceOf(state);
+        if (sequence & 1) {
+            // Another writer (maybe another process) has the slot - unless
+            // its claim is stale (or from a clock set back since), in which
+            // case the slot is taken over with the next odd sequence
+            const uint32_t claimed = ClaimSecondOf(state);
+            if (now >= claimed && now - claimed < kStaleClaimSeconds)
+                return;
+            ++sequence;
+        }
+        const uint64_t claim = SlotState(now, sequence + 1);
+        if (!slot->state.compare_exchange_strong(state, claim, std::memory_order_acquire))
+            return;   // Claimed by someone else in between
+
+        slot->length = (uint32_t)response.size();
+        slot->responseHash = Fnv1a64(response.data(), response.size());
+        slot->hash = hash;
+        slot->barTime = key.barTime;
+        slot->paramsHash = key.paramsHash;
+        std::memset(slot->symbol, 0, kSymbolBytes);
+        std::memcpy(slot->symbol, key.symbol.data(), key.symbol.size());
+        std::memset(slot->timeframe, 0, kTimeframeBytes);
+        std::memcpy(slot->timeframe, key.timeframe.data(), key.timeframe.size());
+        std::memcpy(slot->response, response.data(), response.size());
+
+        // Publish only if the claim is still ours - a writer stalled past
+        // kStaleClaimSeconds may have been taken over
+        uint64_t expected = claim;
+        slot->state.compare_exchange_strong(expected, SlotState(now, sequence + 2),
+                                            std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    mutable std::mutex mutex_;
+    std::atomic<size_t> capacity_{ kDefaultCapacity };
+    EntryList entries_;                                          // Most recent first
+    std::unordered_multimap<uint64_t, EntryList::iterator> index_;
+    unsigned long long hits_ = 0;
+    unsigned long long file_hits_ = 0;
+    unsigned long long misses_ = 0;
+
+    std::string file_path_;
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+    char* view_ = nullptr;
+    size_t file_slots_ = 0;
+};
+
+} // namespace volarix4::bridge
@@ -0,0 +1,339 @@
+//=============================================================================
+//  bridge/shm_transport.h
+//  Shared-memory transport to a Volarix 4 API on the same host
+//  (apiUrl = "shm://<name>")
+//
+//  The API (volarix4/utils/shm_transport.py) creates a named mapping with a
+//  ring of request slots plus named events. A call claims a free slot,
+//  writes path and JSON body into it, bumps the slot's request sequence and
+//  sets the server's request event; the server answers in the same slot,
+//  publishes the response sequence and sets the slot's response event. No
+//  sockets, no HTTP framing, no WinINet - a round trip costs two event
+//  signals and two copies.
+//
+//  Each sequence field has exactly one writer (request_seq: the client that
+//  owns the slot, response_seq: the server), so the Python side needs plain
+//  aligned stores only; clients - possibly in several terminals - claim
+//  slots among themselves with a compare-exchange on `owner`. A slot is
+//  claimable once the server has answered its last request, so a call that
+//  times out simply leaves the slot to be freed by the late answer.
+//
+//  Layout (little endian, must match volarix4/utils/shm_transport.py):
+//
+//    header (64 bytes): magic "V4SM", version, slot_count, slot_bytes,
+//                       server heartbeat (GetTickCount64 ms, u64)
+//    slot_count slots of slot_bytes: ShmSlot header (128 bytes) + data
+//
+//  Names: Local\Volarix4Shm_<name> (mapping), <mapping>_req (server event),
+//  <mapping>_resp<i> (slot i's response event).
+//=============================================================================
+#pragma once
+
+#include <windows.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "http_session.h"
+#include "latency_stats.h"
+
+namespace volarix4::bridge {
+
+constexpr const char* kShmUrlScheme = "shm://";
+
+inline bool IsShmUrl(const std::string& api_url)
+{
+    return api_url.compare(0, std::strlen(kShmUrlScheme), kShmUrlScheme) == 0;
+}
+
+// "shm://volarix4" -> "volarix4" (anything after a '/' is ignored)
+inline std::string ShmEndpointName(const std::string& api_url)
+{
+    std::string name = api_url.substr(std::strlen(kShmUrlScheme));
+    size_t slash = name.find('/');
+    if (slash != std::string::npos)
+        name.resize(slash);
+    return name.empty() ? std::string("volarix4") : name;
+}
+
+class ShmTransport
+{
+public:
+    static constexpr uint32_t kMagic = 0x4D533456;       // "V4SM"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderBytes = 64;
+    static constexpr size_t kSlotHeaderBytes = 128;
+    static constexpr size_t kPathBytes = 96;
+    static constexpr DWORD kTimeoutMs = 30000;
+    static constexpr DWORD kWaitSliceMs = 250;            // Heartbeat check interval
+    static constexpr unsigned long long kHeartbeatStaleMs = 2000;
+
+    static ShmTransport& Instance()
+    {
+        static ShmTransport transport;
+        return transport;
+    }
+
+    // Called from ShutdownVolarix4Bridge (the EA's OnDeinit), never from
+    // DllMain; the next request maps its channel again
+    void Shutdown()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        channels_.clear();
+    }
+
+    // Same contract as HttpSessionPool::Post: the full response body in
+    // `response`, its HTTP status in *status_code, phases recorded in the
+    // thread's CallTimings
+    HttpError Post(const std::string& name,
+                   const char* path,
+                   const char* body,
+                   DWORD body_length,
+                   std::string& response,
+                   DWORD* last_error = nullptr,
+                   DWORD* status_code = nullptr)
+    {
+        CallTimings& call = CallTimings::Current();
+        call.endpoint = kShmUrlScheme + name + path;
+
+        const long long post_start = QpcNow();
+        std::shared_ptr<Channel> channel = Acquire(name, last_error);
+        if (!channel) {
+            call.failed = true;
+            return HttpError::SharedMemoryOpen;
+        }
+
+        const size_t path_length = std::strlen(path);
+        if (path_length >= kPathBytes || body_length > channel->data_bytes) {
+            call.failed = true;
+            return HttpError::SharedMemoryTooLarge;
+        }
+
+        const unsigned long long deadline = GetTickCount64() + kTimeoutMs;
+        int index = Claim(*channel, deadline);
+        if (index < 0) {
+            call.failed = true;
+            return HttpError::SharedMemoryTimeout;
+        }
+
+        // Write the request, then publish it
+        const long long claimed = QpcNow();
+        ShmSlot* slot = channel->Slot(index);
+        char* data = channel->Data(index);
+        std::memcpy(slot->path, path, path_length + 1);
+        slot->path_length = (uint32_t)path_length;
+        std::memcpy(data, body, body_length);
+        slot->request_length = body_length;
+
+        const uint32_t sequence = slot->request_seq.load(std::memory_order_relaxed) + 1;
+        slot->request_seq.store(sequence, std::memory_order_release);
+        SetEvent(channel->request_event);
+        const long long sent = QpcNow();
+
+        // Wait for the answer, giving up early if the server stopped beating
+        bool answered = false;
+        for (;;)
+        {
+            if (slot->response_seq.load(std::memory_order_acquire) == sequence) {
+                answered = true;
+                break;
+            }
+            unsigned long long now = GetTickCount64();
+            if (now >= deadline || !channel->ServerAlive(now))
+                break;
+            DWORD wait = (DWORD)(deadline - now < kWaitSliceMs ? deadline - now : kWaitSliceMs);
+            WaitForSingleObject(channel->response_events[index], wait);
+        }
+        const long long received = QpcNow();
+
+        if (answered) {
+            uint32_t length = slot->response_length;
+            if (length > channel->data_bytes)
+                length = (uint32_t)channel->data_bytes;
+            response.assign(data, length);
+            if (status_code)
+                *status_code = slot->status;
+        }
+
+        // A timed-out slot stays unclaimable until the server answers it
+        slot->owner.store(0, std::memory_order_release);
+
+        call.Add(LatencyPhase::kConnect, claimed - post_start);
+        call.Add(LatencyPhase::kSend, sent - claimed);
+        call.Add(LatencyPhase::kFirstByte, received - sent);
+        call.Add(LatencyPhase::kRead, QpcNow() - received);
+
+        if (!answered) {
+            call.failed = true;
+            return HttpError::SharedMemoryTimeout;
+        }
+        return HttpError::None;
+    }
+
+private:
+    struct ShmHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t slot_count;
+        uint32_t slot_bytes;
+        std::atomic<uint64_t> heartbeat_ms;     // Server's GetTickCount64()
+        uint8_t reserved[40];
+    };
+
+    struct ShmSlot
+    {
+        std::atomic<uint32_t> owner;            // 0 = free (clients only)
+        std::atomic<uint32_t> request_seq;      // Written by the owning client
+        std::atomic<uint32_t> response_seq;     // Written by the server
+        uint32_t request_length;
+        uint32_t response_length;
+        uint32_t status;                        // HTTP status of the answer
+        uint32_t path_length;
+        uint32_t reserved;
+        char path[kPathBytes];
+    };
+
+    static_assert(sizeof(ShmHeader) == kHeaderBytes, "ShmHeader layout");
+    static_assert(sizeof(ShmSlot) == kSlotHeaderBytes, "ShmSlot layout");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+                  "shared mapping needs address-free atomics");
+
+    struct Channel
+    {
+        HANDLE mapping = NULL;
+        char* view = nullptr;
+        HANDLE request_event = NULL;
+        std::vector<HANDLE> response_events;
+        size_t slot_count = 0;
+        size_t slot_bytes = 0;
+        size_t data_bytes = 0;
+        std::atomic<unsigned> next_slot{ 0 };
+
+        ~Channel()
+        {
+            for (HANDLE event : response_events)
+                CloseHandle(event);
+            if (request_event)
+                CloseHandle(request_event);
+            if (view)
+                UnmapViewOfFile(view);
+            if (mapping)
+                CloseHandle(mapping);
+        }
+
+        ShmHeader* Header() const { return reinterpret_cast<ShmHeader*>(view); }
+        ShmSlot* Slot(int index) const
+        {
+            return reinterpret_cast<ShmSlot*>(view + kHeaderBytes + (size_t)index * slot_bytes);
+        }
+        char* Data(int index) const { return reinterpret_cast<char*>(Slot(index)) + kSlotHeaderBytes; }
+
+        bool ServerAlive(unsigned long long now) const
+        {
+            unsigned long long beat = Header()->heartbeat_ms.load(std::memory_order_relaxed);
+            return beat + kHeartbeatStaleMs >= now;
+        }
+    };
+
+    ShmTransport() = default;
+    ShmTransport(const ShmTransport&) = delete;
+    ShmTransport& operator=(const ShmTransport&) = delete;
+
+    static std::string MappingName(const std::string& name) { return "Local\\Volarix4Shm_" + name; }
+
+    // Channels are opened on first use and kept; a server restart re-creates
+    // the objects under the same names, so a failed open is retried per call
+    std::shared_ptr<Channel> Acquire(const std::string& name, DWORD* last_error)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = channels_.find(name);
+        if (it != channels_.end())
+            return it->second;
+
+        std::shared_ptr<Channel> channel = Open(name, last_error);
+        if (channel)
+            channels_[name] = channel;
+        return channel;
+    }
+
+    static std::shared_ptr<Channel> Open(const std::string& name, DWORD* last_error)
+    {
+        const std::string mapping_name = MappingName(name);
+        auto channel = std::make_shared<Channel>();
+
+        channel->mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mapping_name.c_str());
+        if (channel->mapping)
+            channel->view = static_cast<char*>(MapViewOfFile(channel->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        if (!channel->view) {
+            if (last_error) *last_error = GetLastError();
+            return nullptr;
+        }
+
+        const ShmHeader* header = channel->Header();
+        if (header->magic != kMagic || header->version != kVersion ||
+            header->slot_count == 0 || header->slot_bytes <= kSlotHeaderBytes) {
+            if (last_error) *last_error = ERROR_SUCCESS;
+            return nullptr;
+        }
+        channel->slot_count = header->slot_count;
+        channel->slot_bytes = header->slot_bytes;
+        channel->data_bytes = header->slot_bytes - kSlotHeaderBytes;
+
+        const DWORD access = EVENT_MODIFY_STATE | SYNCHRONIZE;
+        channel->request_event = OpenEventA(access, FALSE, (mapping_name + "_req").c_str());
+        if (!channel->request_event) {
+            if (last_error) *last_error = GetLastError();
+            return nullptr;
+        }
+        for (size_t i = 0; i < channel->slot_count; ++i)
+        {
+            HANDLE event = OpenEventA(access, FALSE, (mapping_name + "_resp" + std::to_string(i)).c_str());
+            if (!event) {
+                if (last_error) *last_error = GetLastError();
+                return nullptr;
+            }
+            channel->response_events.push_back(event);
+        }
+        return channel;
+    }
+
+    // Claim a slot whose last request has been answered; yields while every
+    // slot is busy
+    static int Claim(Channel& channel, unsigned long long deadline)
+    {
+        const size_t count = channel.slot_count;
+        for (;;)
+        {
+            unsigned start = channel.next_slot.fetch_add(1, std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i)
+            {
+                int index = (int)((start + i) % count);
+                ShmSlot* slot = channel.Slot(index);
+                uint32_t expected = 0;
+                if (!slot->owner.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+                    continue;
+                if (slot->response_seq.load(std::memory_order_acquire) ==
+                    slot->request_seq.load(std::memory_order_relaxed))
+                    return index;
+                slot->owner.store(0, std::memory_order_release);
+            }
+
+            unsigned long long now = GetTickCount64();
+            if (now >= deadline || !channel.ServerAlive(now))
+                return -1;
+            Sleep(0);
+        }
+    }
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Channel>> channels_;
+};
+
+} // namespace volarix4::bridge
@@ -0,0 +1,190 @@
+//=============================================================================
+//  bridge/signal_jobs.h
+//  Worker pool for asynchronous signal requests (Submit/Poll exports)
+//
+//  The terminal thread only enqueues a job and gets a request id back; the
+//  HTTP round-trip runs on a private Windows thread pool and the result is
+//  parked until the EA polls for it. The pool is bound to the DLL module
+//  with SetThreadpoolCallbackLibrary so the DLL cannot be unloaded while a
+//  job is still running.
+//=============================================================================
+#pragma once
+
+#include <windows.h>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace volarix4::bridge {
+
+class SignalJobQueue
+{
+public:
+    // Poll() outcome
+    enum class PollState
+    {
+        Pending,   // Job queued or running
+        Ready,     // Result copied out, job removed
+        Unknown    // Never submitted, already collected, or evicted
+    };
+
+    static SignalJobQueue& Instance()
+    {
+        static SignalJobQueue queue;
+        return queue;
+    }
+
+    // Called from DllMain(DLL_PROCESS_ATTACH) - only records the module,
+    // the pool itself is created by the first Submit()
+    void Initialize(HMODULE module)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        module_ = module;
+    }
+
+    // Called from ShutdownVolarix4Bridge (the EA's OnDeinit), never from
+    // DllMain. A job still running finishes on the closed pool, which is
+    // released once it returns, and its result is dropped; the next
+    // Submit() creates a new pool.
+    void Shutdown()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pool_) {
+            DestroyThreadpoolEnvironment(&environment_);
+            CloseThreadpool(pool_);
+            pool_ = NULL;
+        }
+        jobs_.clear();
+        completed_.clear();
+    }
+
+    // Queue work on the pool. Returns the request id (> 0), or -1 if the
+    // pool could not be created or the callback could not be submitted.
+    long long Submit(std::function<std::string()> work)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (!EnsurePool())
+            return -1;
+
+        long long id = ++last_id_;
+        jobs_[id].work = std::move(work);
+
+        JobContext* context = new JobContext{ this, id };
+        if (!TrySubmitThreadpoolCallback(&SignalJobQueue::RunJob, context, &environment_)) {
+            delete context;
+            jobs_.erase(id);
+            return -1;
+        }
+
+        return id;
+    }
+
+    PollState Poll(long long id, std::string& result)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = jobs_.find(id);
+        if (it == jobs_.end())
+            return PollState::Unknown;
+
+        if (!it->second.done)
+            return PollState::Pending;
+
+        result = std::move(it->second.result);
+        jobs_.erase(it);
+        return PollState::Ready;
+    }
+
+private:
+    static constexpr DWORD kMaxWorkers = 4;
+    static constexpr size_t kMaxUncollected = 256;  // Results never polled (e.g. EA removed)
+
+    struct Job
+    {
+        std::function<std::string()> work;
+        std::string result;
+        bool done = false;
+    };
+
+    struct JobContext
+    {
+        SignalJobQueue* queue;
+        long long id;
+    };
+
+    SignalJobQueue() = default;
+    SignalJobQueue(const SignalJobQueue&) = delete;
+    SignalJobQueue& operator=(const SignalJobQueue&) = delete;
+
+    bool EnsurePool()
+    {
+        if (pool_)
+            return true;
+
+        pool_ = CreateThreadpool(NULL);
+        if (!pool_)
+            return false;
+
+        SetThreadpoolThreadMaximum(pool_, kMaxWorkers);
+        SetThreadpoolThreadMinimum(pool_, 1);
+
+        InitializeThreadpoolEnvironment(&environment_);
+        SetThreadpoolCallbackPool(&environment_, pool_);
+        if (module_)
+            SetThreadpoolCallbackLibrary(&environment_, module_);
+
+        return true;
+    }
+
+    static void CALLBACK RunJob(PTP_CALLBACK_INSTANCE, PVOID parameter)
+    {
+        JobContext* context = static_cast<JobContext*>(parameter);
+        SignalJobQueue* queue = context->queue;
+        long long id = context->id;
+        delete context;
+
+        std::function<std::string()> work;
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex_);
+            auto it = queue->jobs_.find(id);
+            if (it == queue->jobs_.end())
+                return;
+            work = std::move(it->second.work);
+        }
+
+        std::string result = work();
+
+        std::lock_guard<std::mutex> lock(queue->mutex_);
+        auto it = queue->jobs_.find(id);
+        if (it == queue->jobs_.end())
+            return;
+
+        it->second.result = std::move(result);
+        it->second.done = true;
+        queue->completed_.push_back(id);
+        queue->EvictUncollected();
+    }
+
+    // Drop the oldest finished results nobody collected so an EA that
+    // resubmits without polling cannot grow the table without bound
+    void EvictUncollected()
+    {
+        while (completed_.size() > kMaxUncollected) {
+            jobs_.erase(completed_.front());
+            completed_.pop_front();
+        }
+    }
+
+    std::mutex mutex_;
+    HMODULE module_ = NULL;
+    PTP_POOL pool_ = NULL;
+    TP_CALLBACK_ENVIRON environment_{};
+    long long last_id_ = 0;
+    std::unordered_map<long long, Job> jobs_;
+    std::deque<long long> completed_;
+};
+
+} // namespace volarix4::bridge
@@ -0,0 +1,226 @@
+//=============================================================================
+//  bridge/signal_payload.h
+//  /signal and /signal/bars request bodies for VolariXBridge.dll
+//  (GetVolariXSignalWithBars and GetVolariXSignalWithBarsBinary)
+//
+//  Kept free of WinINet and BSTRs so the serialization the EA pays for on
+//  every candle can be built and benchmarked on any platform (see
+//  bench/bench_payload.cpp); volarix.cpp only converts the MQL5 strings
+//  and posts the result.
+//
+//  Each body can be written whole (Write*) or handed to a sink in pieces of
+//  about kPayloadChunkBytes (Stream*) - the same bytes in the same order,
+//  but the writer's buffer stays one chunk long however many bars are sent,
+//  so large uploads go onto the socket as they are serialized.
+//=============================================================================
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "bar_codec.h"
+#include "json_writer.h"
+
+namespace volarix4::bridge {
+
+// MQL5's bar struct for VolariXBridge.dll: the time as text
+// ("YYYY.MM.DD HH:MM:SS" or ISO), then OHLCV
+struct TimestampedBar
+{
+    char timestamp[32];
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+};
+
+struct SignalPayload
+{
+    std::string_view symbol;
+    std::string_view executionTimeframe;
+    std::string_view contextTimeframe;      // Empty = single-TF
+    std::string_view startTime;
+    std::string_view endTime;
+    const TimestampedBar* bars = nullptr;
+    int barCount = 0;
+    const TimestampedBar* contextBars = nullptr;   // Can be NULL
+    int contextBarCount = 0;
+
+    // The JSON payload sends context fields for a context timeframe with a
+    // positive count, even if contextBars is NULL (an empty array)
+    bool IsMultiTF() const { return !contextTimeframe.empty() && contextBarCount > 0; }
+};
+
+inline std::string_view BarTimestamp(const TimestampedBar& bar)
+{
+    return std::string_view(bar.timestamp, strnlen(bar.timestamp, sizeof(bar.timestamp)));
+}
+
+// Payload pieces StreamSignalPayload hands on (one bar's JSON over)
+constexpr size_t kPayloadChunkBytes = 64 * 1024;
+
+// Append bars as a JSON array of {timestamp, open, high, low, close, volume};
+// after_bar() runs after every bar and stops the array by returning false
+template <typename AfterBar>
+bool AppendJsonBars(JsonWriter& json, const TimestampedBar* bars, int count, AfterBar&& after_bar)
+{
+    json.BeginArray();
+    for (int i = 0; i < count; ++i)
+    {
+        const TimestampedBar& bar = bars[i];
+        json.BeginObject()
+            .Field("timestamp", BarTimestamp(bar))
+            .Field("open", bar.open)
+            .Field("high", bar.high)
+            .Field("low", bar.low)
+            .Field("close", bar.close)
+            .Field("volume", bar.volume)
+            .EndObject();
+        if (!after_bar())
+            return false;
+    }
+    json.EndArray();
+    return true;
+}
+
+// The /signal document, written into json as it stands (no Reset)
+template <typename AfterBar>
+bool AppendSignalPayload(JsonWriter& json, const SignalPayload& payload, AfterBar&& after_bar)
+{
+    json.BeginObject()
+        .Field("symbol", payload.symbol)
+        .Field("timeframe", payload.executionTimeframe)             // Backward compat
+        .Field("execution_timeframe", payload.executionTimeframe)
+        .Key("data");
+    if (!AppendJsonBars(json, payload.bars, payload.barCount, after_bar))
+        return false;
+    json.Field("start_time", payload.startTime)
+        .Field("end_time", payload.endTime)
+        .Field("model_type", "statistical");
+
+    if (payload.IsMultiTF())
+    {
+        json.Field("context_timeframe", payload.contextTimeframe).Key("context_data");
+        if (!AppendJsonBars(json, payload.contextBars,
+                            payload.contextBars != nullptr ? payload.contextBarCount : 0, after_bar))
+            return false;
+    }
+
+    json.EndObject();
+    return true;
+}
+
+// POST /signal body (~140 bytes per bar; the writer keeps its capacity
+// afterwards)
+inline const std::string& WriteSignalPayload(JsonWriter& json, const SignalPayload& payload)
+{
+    const bool multi_tf = payload.IsMultiTF();
+    size_t bar_count = (size_t)(payload.barCount > 0 ? payload.barCount : 0) +
+        (size_t)(multi_tf && payload.contextBars != nullptr ? payload.contextBarCount : 0);
+    json.Reset(1024 + bar_count * 140);
+
+    AppendSignalPayload(json, payload, [] { return true; });
+    return json.str();
+}
+
+// The same body in pieces of about chunk_bytes, in order, to
+// sink(const char* data, size_t size) - the writer never holds more than a
+// chunk and a bar, whatever the bar count. False as soon as sink returns
+// false.
+template <typename Sink>
+bool StreamSignalPayload(JsonWriter& json, const SignalPayload& payload, size_t chunk_bytes, Sink&& sink)
+{
+    json.Reset(chunk_bytes + 1024);
+    auto flush = [&] {
+        if (json.size() < chunk_bytes)
+            return true;
+        if (!sink(json.str().data(), json.size()))
+            return false;
+        json.Consume();
+        return true;
+    };
+
+    if (!AppendSignalPayload(json, payload, flush))
+        return false;
+    return json.size() == 0 || sink(json.str().data(), json.size());
+}
+
+template <typename AfterBar>
+bool AppendBinaryBars(BinaryBarWriter& writer, const TimestampedBar* bars, int count, AfterBar&& after_bar)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const TimestampedBar& bar = bars[i];
+        long long time = ParseIsoTimestamp(BarTimestamp(bar));
+        // Bad timestamps go out as 0 so the server's bar validation rejects them
+        writer.AppendBar(time < 0 ? 0 : time, bar.open, bar.high, bar.low, bar.close, bar.volume);
+        if (!after_bar())
+            return false;
+    }
+    return true;
+}
+
+// Context bars of the binary payload: only with a context timeframe, a
+// non-NULL array and a positive count
+inline int BinaryContextBarCount(const SignalPayload& payload)
+{
+    return payload.IsMultiTF() && payload.contextBars != nullptr ? payload.contextBarCount : 0;
+}
+
+// Exact size of the POST /signal/bars body (its Content-Length)
+inline size_t BinarySignalPayloadBytes(const SignalPayload& payload)
+{
+    const int context_count = BinaryContextBarCount(payload);
+    return BinaryBarWriter::PayloadBytes(payload.symbol, payload.executionTimeframe,
+                                         context_count ? payload.contextTimeframe : std::string_view(),
+                                         (uint32_t)(payload.barCount > 0 ? payload.barCount : 0),
+                                         (uint32_t)context_count);
+}
+
+template <typename AfterBar>
+bool AppendBinarySignalPayload(BinaryBarWriter& writer, const SignalPayload& payload, size_t reserve_bytes,
+                               AfterBar&& after_bar)
+{
+    const int bar_count = payload.barCount > 0 ? payload.barCount : 0;
+    const int context_count = BinaryContextBarCount(payload);
+
+    if (!writer.Begin(payload.symbol, payload.executionTimeframe,
+                      context_count ? payload.contextTimeframe : std::string_view(),
+                      (uint32_t)bar_count, (uint32_t)context_count, reserve_bytes))
+        return false;
+
+    return AppendBinaryBars(writer, payload.bars, bar_count, after_bar) &&
+           AppendBinaryBars(writer, payload.contextBars, context_count, after_bar);
+}
+
+// POST /signal/bars body (bridge/bar_codec.h). False if a name does not fit
+// the header.
+inline bool WriteBinarySignalPayload(BinaryBarWriter& writer, const SignalPayload& payload)
+{
+    return AppendBinarySignalPayload(writer, payload, BinarySignalPayloadBytes(payload), [] { return true; });
+}
+
+// The same body in pieces of about chunk_bytes (see StreamSignalPayload).
+// False if a name does not fit the header or sink returns false.
+template <typename Sink>
+bool StreamBinarySignalPayload(BinaryBarWriter& writer, const SignalPayload& payload, size_t chunk_bytes,
+                               Sink&& sink)
+{
+    auto flush = [&] {
+        if (writer.size() < chunk_bytes)
+            return true;
+        if (!sink(writer.str().data(), writer.size()))
+            return false;
+        writer.Consume();
+        return true;
+    };
+
+    if (!AppendBinarySignalPayload(writer, payload, chunk_bytes + kBinaryBarRecordSize, flush))
+        return false;
+    return writer.size() == 0 || sink(writer.str().data(), writer.size());
+}
+
+} // namespace volarix4::bridge
@@ -0,0 +1,159 @@
+//=============================================================================
+//  bridge/signal_result.h
+//  Fixed-layout /signal result for MQL5 (GetVolarix4SignalStruct)
+//
+//  The /signal JSON is parsed in the DLL (bridge/json_reader.h) straight
+//  into a packed struct the EA passes by reference, so the hot path has no
+//  BSTR, no UTF-16 widening and no string parsing in MQL5. The reason text
+//  is kept (truncated) as UTF-8 bytes for logging; reasonCode classifies it
+//  so the EA can branch without comparing strings.
+//=============================================================================
+#pragma once
+
+#include <cstring>
+#include <string_view>
+
+#include "json_reader.h"
+
+namespace volarix4::bridge {
+
+// What the reason text says (prefixes of the API's reason strings)
+enum SignalReasonCode : int
+{
+    kReasonSignal = 0,             // BUY/SELL: "Support/Resistance bounce at ..."
+    kReasonOutsideSession = 1,     // "Outside trading session ..."
+    kReasonNoLevels = 2,           // "No significant S/R levels detected"
+    kReasonLevelsBroken = 3,       // "All S/R levels broken or in cooldown period"
+    kReasonNoRejection = 4,        // "No rejection pattern at S/R levels"
+    kReasonLowConfidence = 5,      // "Confidence too low (...)"
+    kReasonTrendRejected = 6,      // "BUY/SELL signal rejected - ..."
+    kReasonSignalCooldown = 7,     // "Signal cooldown active (...)"
+    kReasonRiskExceeded = 8,       // "Risk parameters exceeded (...)"
+    kReasonInsufficientEdge = 9,   // "Insufficient edge after costs (...)"
+    kReasonDataUnavailable = 10,   // Server could not get the bars
+    kReasonBarsInvalid = 11,       // 422 bar validation ({"error", "message"})
+    kReasonServerError = 12,       // "Error: ..." or a rejected request ({"detail"})
+    kReasonTransportError = 13,    // Bridge HTTP failure (no response)
+    kReasonMalformed = 14,         // Response could not be parsed
+    kReasonOther = 15              // Any other HOLD reason
+};
+
+constexpr size_t kSignalReasonBytes = 128;
+
+#pragma pack(push, 1)
+struct SignalResult
+{
+    int    signal;                      // core::SignalType: 0 HOLD, 1 BUY, 2 SELL
+    double confidence;
+    double entry;
+    double sl;
+    double tp1;
+    double tp2;
+    double tp3;
+    int    reasonCode;                  // SignalReasonCode
+    char   reason[kSignalReasonBytes];  // UTF-8, NUL-terminated, truncated
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SignalResult) == 184, "SignalResult layout must match the EA's struct");
+
+inline int ClassifySignalReason(std::string_view reason)
+{
+    auto starts = [reason](std::string_view prefix) {
+        return reason.substr(0, prefix.size()) == prefix;
+    };
+
+    if (starts("Support bounce") || starts("Resistance bounce"))  return kReasonSignal;
+    if (starts("Outside trading session"))                        return kReasonOutsideSession;
+    if (starts("No significant S/R levels"))                      return kReasonNoLevels;
+    if (starts("All S/R levels broken"))                          return kReasonLevelsBroken;
+    if (starts("No rejection pattern"))                           return kReasonNoRejection;
+    if (starts("Confidence too low"))                             return kReasonLowConfidence;
+    if (starts("BUY signal rejected") || starts("SELL signal rejected"))
+        return kReasonTrendRejected;
+    if (starts("Signal cooldown active"))                         return kReasonSignalCooldown;
+    if (starts("Risk parameters exceeded"))                       return kReasonRiskExceeded;
+    if (starts("Insufficient edge after costs"))                  return kReasonInsufficientEdge;
+    if (starts("Failed to fetch bars") || starts("No bar_time or data"))
+        return kReasonDataUnavailable;
+    if (starts("Error: "))                                        return kReasonServerError;
+    return kReasonOther;
+}
+
+// HOLD with the given code and reason text (error paths)
+inline void SetSignalResultHold(SignalResult* result, int reason_code, std::string_view reason)
+{
+    std::memset(result, 0, sizeof(SignalResult));
+    result->signal = 0;
+    result->reasonCode = reason_code;
+    size_t length = reason.size() < kSignalReasonBytes - 1 ? reason.size() : kSignalReasonBytes - 1;
+    std::memcpy(result->reason, reason.data(), length);
+}
+
+// Fill *result from a /signal response body. Returns false for anything
+// else - error bodies (422 bar validation, request schema errors) or text
+// that does not parse - leaving a HOLD with the matching code and, where
+// the body has one, its message.
+inline bool ParseSignalResult(std::string_view json, SignalResult* result)
+{
+    SetSignalResultHold(result, kReasonMalformed, "");
+
+    bool has_signal = false;
+    bool has_error = false;
+    bool has_message = false;
+    bool has_detail = false;
+    JsonValue error;
+
+    bool parsed = JsonReader(json).ForEachMember([&](std::string_view key, const JsonValue& value) {
+        if (key == "signal") {
+            has_signal = true;
+            if (value.String("BUY"))       result->signal = 1;
+            else if (value.String("SELL")) result->signal = 2;
+            else if (value.String("HOLD")) result->signal = 0;
+            else has_signal = false;
+        }
+        else if (key == "confidence") result->confidence = value.AsDouble();
+        else if (key == "entry")      result->entry = value.AsDouble();
+        else if (key == "sl")         result->sl = value.AsDouble();
+        else if (key == "tp1")        result->tp1 = value.AsDouble();
+        else if (key == "tp2")        result->tp2 = value.AsDouble();
+        else if (key == "tp3")        result->tp3 = value.AsDouble();
+        else if (key == "reason" && value.IsString()) {
+            value.CopyString(result->reason, kSignalReasonBytes);
+            result->reasonCode = ClassifySignalReason(result->reason);
+        }
+        else if (key == "error") {
+            has_error = true;
+            error = value;
+        }
+        else if (key == "message" && value.IsString()) {
+            has_message = true;
+            value.CopyString(result->reason, kSignalReasonBytes);
+        }
+        else if (key == "detail") {
+            has_detail = true;
+        }
+        return true;
+    });
+
+    if (parsed && has_signal) {
+        if (result->reasonCode == kReasonMalformed)
+            result->reasonCode = kReasonOther;
+        return true;
+    }
+
+    // Anything else is a HOLD without a trade setup
+    const int reason_code = !parsed ? kReasonMalformed
+                          : has_error && has_message ? kReasonBarsInvalid
+                          : has_error || has_detail ? kReasonServerError
+                          : kReasonMalformed;
+    result->signal = 0;
+    result->confidence = result->entry = result->sl = 0.0;
+    result->tp1 = result->tp2 = result->tp3 = 0.0;
+    result->reasonCode = reason_code;
+    if (!has_message && has_error)
+        error.CopyString(result->reason, kSignalReasonBytes);
+    return false;
+}
+
+} // namespace volarix4::bridge
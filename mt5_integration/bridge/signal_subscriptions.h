@@ -0,0 +1,430 @@
+//=============================================================================
+//  bridge/signal_subscriptions.h
+//  Long-poll client for pushed signals (SubscribeVolarix4Signal /
+//  TryGetPushedSignal / UnsubscribeVolarix4Signal)
+//
+//  One poller per process serves every subscribed chart: it registers new
+//  streams with POST /signal/subscribe and keeps a single POST /signal/poll
+//  open on its own keep-alive connection, so the server answers the moment
+//  a candle's signal is ready and the EA only picks it up from the
+//  SubscriptionTable - no request on the terminal thread at all.
+//
+//  The poller is a work item on a private thread pool bound to the DLL
+//  module (like SignalJobQueue) and runs while there are streams: removing
+//  the last one aborts the poll in flight and the loop exits. Transport
+//  failures back off from 1 s to 30 s; with several endpoints in the apiUrl
+//  the poller moves to the next one and registers its streams there.
+//  shm:// endpoints are skipped - a shared-memory slot is not meant to be
+//  held open for a long poll.
+//=============================================================================
+#pragma once
+
+#include <windows.h>
+#include <wininet.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "http_session.h"
+#include "json_writer.h"
+#include "subscription_table.h"
+
+namespace volarix4::bridge {
+
+class SignalSubscriptions
+{
+public:
+    static constexpr DWORD kPollTimeoutMs = 20000;      // Server-side wait of one poll
+    static constexpr DWORD kRequestTimeoutMs = 10000;   // Subscribe/unsubscribe, and slack on a poll
+
+    static SignalSubscriptions& Instance()
+    {
+        static SignalSubscriptions subscriptions;
+        return subscriptions;
+    }
+
+    // Called from DllMain(DLL_PROCESS_ATTACH) - only records the module,
+    // the pool, event and WinINet session are created by the first Subscribe()
+    void Initialize(HMODULE module)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        module_ = module;
+    }
+
+    // Called from ShutdownVolarix4Bridge (the EA's OnDeinit), never from
+    // DllMain: aborts the poll in flight and waits for the poller to exit.
+    // Streams another chart still has subscribed keep the poller running;
+    // EAs must unsubscribe in OnDeinit, before this, or the DLL stays loaded.
+    void Shutdown()
+    {
+        PTP_WORK work;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!table_.Empty() || stopping_)
+                return;
+            stopping_ = true;
+            AbortRequestLocked();
+            if (wake_)
+                SetEvent(wake_);
+            work = work_;
+        }
+        if (work)
+            WaitForThreadpoolWorkCallbacks(work, FALSE);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        CloseConnection();
+        if (work_) {
+            CloseThreadpoolWork(work_);
+            work_ = NULL;
+        }
+        if (pool_) {
+            DestroyThreadpoolEnvironment(&environment_);
+            CloseThreadpool(pool_);
+            pool_ = NULL;
+        }
+        if (wake_) {
+            CloseHandle(wake_);
+            wake_ = NULL;
+        }
+        stopping_ = false;   // The next Subscribe() starts a new poller
+    }
+
+    // urls: the http:// endpoints of api_url, in order. Returns the stream
+    // handle (> 0), -1 if the poller could not be started, -2 if no
+    // endpoint is usable or the poller is serving another api_url.
+    int Subscribe(const std::string& api_url, std::vector<std::string> urls, std::string stream_json)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_)
+            return -1;
+        if (urls.empty() || (running_ && api_url != api_url_))
+            return -2;
+        if (!EnsurePool())
+            return -1;
+
+        const int handle = table_.Add(std::move(stream_json));
+        if (!running_) {
+            if (api_url != api_url_) {
+                api_url_ = api_url;
+                urls_ = std::move(urls);
+                url_index_ = 0;
+                table_.Reset();
+            }
+            running_ = true;
+            SubmitThreadpoolWork(work_);
+        }
+        SetEvent(wake_);   // Register now rather than after a backoff
+        return handle;
+    }
+
+    // False for an unknown handle. The last stream stops the poller.
+    bool Unsubscribe(int handle)
+    {
+        if (!table_.Remove(handle))
+            return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (wake_)
+            SetEvent(wake_);
+        if (table_.Empty())
+            AbortRequestLocked();
+        return true;
+    }
+
+    SubscriptionTable::TakeState TryGet(int handle, std::string* response, long long* bar_time)
+    {
+        return table_.Take(handle, response, bar_time);
+    }
+
+    std::string Json()
+    {
+        SubscriptionTable::Stats stats = table_.GetStats();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        JsonWriter json;
+        json.Reset(384);
+        json.BeginObject()
+            .Key("active").Bool(running_)
+            .Field("endpoint", urls_.empty() ? std::string() : urls_[url_index_])
+            .Field("subscriber_id", stats.subscriberId)
+            .Field("streams", (long long)stats.streams)
+            .Field("registered", (long long)stats.registered)
+            .Field("after_seq", stats.afterSeq)
+            .Field("pushed", stats.pushed)
+            .Field("taken", stats.taken)
+            .Field("overwritten", stats.overwritten)
+            .Field("resubscribes", stats.resubscribes)
+            .Field("polls", polls_)
+            .Field("failures", failures_)
+            .Field("last_error", last_error_)
+            .EndObject();
+        return json.str();
+    }
+
+private:
+    static constexpr DWORD kMinBackoffMs = 1000;
+    static constexpr DWORD kMaxBackoffMs = 30000;
+
+    // Cycle() outcome
+    enum class CycleResult
+    {
+        kOk,
+        kRejected,     // Server answered, but not as expected
+        kTransport     // No answer (endpoint down, timeout, aborted)
+    };
+
+    SignalSubscriptions() = default;
+    SignalSubscriptions(const SignalSubscriptions&) = delete;
+    SignalSubscriptions& operator=(const SignalSubscriptions&) = delete;
+
+    bool EnsurePool()
+    {
+        if (work_)
+            return true;
+        if (stopping_)
+            return false;
+
+        if (!wake_ && !(wake_ = CreateEventA(NULL, FALSE, FALSE, NULL)))
+            return false;
+
+        if (!pool_) {
+            pool_ = CreateThreadpool(NULL);
+            if (!pool_)
+                return false;
+            SetThreadpoolThreadMaximum(pool_, 1);
+
+            InitializeThreadpoolEnvironment(&environment_);
+            SetThreadpoolCallbackPool(&environment_, pool_);
+            if (module_)
+                SetThreadpoolCallbackLibrary(&environment_, module_);
+        }
+
+        work_ = CreateThreadpoolWork(&SignalSubscriptions::RunPoller, this, &environment_);
+        return work_ != NULL;
+    }
+
+    static void CALLBACK RunPoller(PTP_CALLBACK_INSTANCE, PVOID context, PTP_WORK)
+    {
+        static_cast<SignalSubscriptions*>(context)->PollLoop();
+    }
+
+    void PollLoop()
+    {
+        DWORD backoff_ms = 0;
+        for (;;)
+        {
+            if (backoff_ms > 0)
+                WaitForSingleObject(wake_, backoff_ms);
+
+            // Best effort: the server also drops subscribers that stop polling
+            std::string body, response;
+            while (table_.NextUnsubscribe(&body))
+                Post("/signal/unsubscribe", body, kRequestTimeoutMs, false, &response);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_ || table_.Empty()) {
+                    CloseConnection();
+                    running_ = false;
+                    return;
+                }
+            }
+
+            CycleResult result = Cycle();
+            if (result == CycleResult::kOk) {
+                backoff_ms = 0;
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                failures_++;
+                if (result == CycleResult::kTransport && urls_.size() > 1) {
+                    // The next endpoint has its own subscribers
+                    url_index_ = (url_index_ + 1) % urls_.size();
+                    table_.Reset();
+                }
+            }
+            backoff_ms = backoff_ms ? (backoff_ms * 2 < kMaxBackoffMs ? backoff_ms * 2 : kMaxBackoffMs)
+                                    : kMinBackoffMs;
+        }
+    }
+
+    // Register every unregistered stream, then one long poll
+    CycleResult Cycle()
+    {
+        std::string body, response;
+        int handle = 0;
+        while (table_.NextRegistration(&handle, &body))
+        {
+            if (!Post("/signal/subscribe", body, kRequestTimeoutMs, true, &response))
+                return CycleResult::kTransport;
+            if (!table_.ApplySubscribeResponse(handle, response)) {
+                RecordError("subscribe rejected: " + response.substr(0, 160));
+                return CycleResult::kRejected;
+            }
+        }
+
+        body = table_.PollBody((int)kPollTimeoutMs);
+        if (body.empty())
+            return CycleResult::kOk;   // Last stream removed meanwhile
+
+        if (!Post("/signal/poll", body, kPollTimeoutMs + kRequestTimeoutMs, true, &response))
+            return CycleResult::kTransport;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            polls_++;
+        }
+
+        if (table_.ApplyPollResponse(response) == SubscriptionTable::PollOutcome::kMalformed) {
+            RecordError("poll rejected: " + response.substr(0, 160));
+            return CycleResult::kRejected;
+        }
+        return CycleResult::kOk;
+    }
+
+    // One POST on the poller's connection; false if no complete answer came
+    // back. An abortable request is not sent once the last stream is gone,
+    // and its handle is published so Unsubscribe can abort a poll that
+    // would otherwise hold the loop for kPollTimeoutMs.
+    bool Post(const char* path, const std::string& body, DWORD timeout_ms, bool abortable,
+              std::string* response)
+    {
+        response->clear();
+        if (!EnsureConnection())
+            return false;
+
+        LPCSTR accept_types[] = { "application/json", NULL };
+        HINTERNET request = HttpOpenRequestA(connect_, "POST", path, "HTTP/1.1", NULL, accept_types,
+            INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE |
+            INTERNET_FLAG_KEEP_CONNECTION | INTERNET_FLAG_NO_UI, 0);
+        if (!request) {
+            RecordError("HttpOpenRequest failed", GetLastError());
+            CloseConnection();
+            return false;
+        }
+        InternetSetOptionA(request, INTERNET_OPTION_RECEIVE_TIMEOUT, &timeout_ms, sizeof(timeout_ms));
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ || (abortable && table_.Empty())) {
+                InternetCloseHandle(request);
+                return false;
+            }
+            active_request_ = request;
+            aborted_ = false;
+        }
+
+        static const char kHeaders[] = "Content-Type: application/json\r\n";
+        BOOL ok = HttpSendRequestA(request, kHeaders, (DWORD)(sizeof(kHeaders) - 1),
+                                   (LPVOID)body.data(), (DWORD)body.size());
+        DWORD error = ok ? ERROR_SUCCESS : GetLastError();
+        if (ok) {
+            char buffer[4096];
+            DWORD bytes_read = 0;
+            while ((ok = InternetReadFile(request, buffer, sizeof(buffer), &bytes_read)) && bytes_read > 0)
+                response->append(buffer, bytes_read);
+            if (!ok)
+                error = GetLastError();
+        }
+
+        bool aborted;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            aborted = aborted_;
+            if (!aborted)
+                InternetCloseHandle(request);
+            active_request_ = NULL;
+        }
+
+        if (!ok) {
+            if (!aborted)
+                RecordError(path, error);
+            CloseConnection();
+            return false;
+        }
+        return true;
+    }
+
+    // Poller thread only (and Shutdown, once it has exited)
+    bool EnsureConnection()
+    {
+        if (connect_)
+            return true;
+
+        if (!session_) {
+            session_ = InternetOpenA("Volarix4Bridge", INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
+            if (!session_) {
+                RecordError("InternetOpen failed", GetLastError());
+                return false;
+            }
+        }
+
+        ApiEndpoint endpoint;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            endpoint = ParseApiUrl(urls_[url_index_]);
+        }
+        connect_ = InternetConnectA(session_, endpoint.host.c_str(), endpoint.port,
+                                    NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
+        if (!connect_) {
+            RecordError("InternetConnect failed", GetLastError());
+            return false;
+        }
+        return true;
+    }
+
+    void CloseConnection()
+    {
+        if (connect_) {
+            InternetCloseHandle(connect_);
+            connect_ = NULL;
+        }
+        if (session_) {
+            InternetCloseHandle(session_);
+            session_ = NULL;
+        }
+    }
+
+    // Closing the handle makes the blocked HttpSendRequest/InternetReadFile
+    // of the poller return at once
+    void AbortRequestLocked()
+    {
+        if (active_request_ && !aborted_) {
+            InternetCloseHandle(active_request_);
+            aborted_ = true;
+        }
+    }
+
+    void RecordError(const std::string& what, DWORD code = 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_error_ = code ? what + " (error code " + std::to_string(code) + ")" : what;
+    }
+
+    SubscriptionTable table_;
+
+    std::mutex mutex_;
+    HMODULE module_ = NULL;
+    PTP_POOL pool_ = NULL;
+    TP_CALLBACK_ENVIRON environment_{};
+    PTP_WORK work_ = NULL;
+    HANDLE wake_ = NULL;
+    bool running_ = false;
+    bool stopping_ = false;
+
+    std::string api_url_;
+    std::vector<std::string> urls_;
+    size_t url_index_ = 0;
+
+    HINTERNET session_ = NULL;          // Poller thread only
+    HINTERNET connect_ = NULL;          // Poller thread only
+    HINTERNET active_request_ = NULL;
+    bool aborted_ = false;
+
+    long long polls_ = 0;
+    long long failures_ = 0;
+    std::string last_error_;
+};
+
+} // namespace volarix4::bridge
@@ -0,0 +1,341 @@
+//=============================================================================
+//  bridge/subscription_table.h
+//  Pushed-signal streams of Volarix4Bridge.dll (SubscribeVolarix4Signal)
+//
+//  The EA side adds a stream (symbol, timeframe and params as the "stream"
+//  object of POST /signal/subscribe) and gets a local handle back; the
+//  poller (signal_subscriptions.h) registers the streams with the server,
+//  long-polls POST /signal/poll and hands every answer to the table, which
+//  keeps the newest unread /signal response per stream until
+//  TryGetPushedSignal takes it. An answer the EA never took is replaced by
+//  the next candle's (counted as overwritten) - a late signal is worth
+//  less than the current one.
+//
+//  The server knows the streams by (subscriber_id, stream_id). Both are
+//  forgotten on a server restart: "Unknown subscriber", or a different
+//  subscriber_id coming back from a subscribe, puts every stream back into
+//  the unregistered state and the poller subscribes them again.
+//
+//  Kept free of WinINet so the protocol can be built and checked on any
+//  platform; every method takes the table's own lock.
+//=============================================================================
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json_reader.h"
+#include "json_writer.h"
+
+namespace volarix4::bridge {
+
+class SubscriptionTable
+{
+public:
+    // Take() outcome
+    enum class TakeState
+    {
+        kNone,      // Nothing new since the last Take
+        kReady,     // Response copied out
+        kUnknown    // Never added, or removed
+    };
+
+    // ApplyPollResponse() outcome
+    enum class PollOutcome
+    {
+        kOk,            // Events (possibly none) applied
+        kResubscribe,   // Server does not know the subscriber: all streams reset
+        kMalformed      // Not a poll answer (error page, old server, ...)
+    };
+
+    struct Stats
+    {
+        size_t streams = 0;
+        size_t registered = 0;
+        long long pushed = 0;        // Responses received for a live stream
+        long long taken = 0;         // Responses handed to the EA
+        long long overwritten = 0;   // Replaced before the EA took them
+        long long resubscribes = 0;  // Server forgot the subscriber
+        long long afterSeq = 0;
+        std::string subscriberId;
+    };
+
+    // EA side -------------------------------------------------------------
+
+    // stream_json: the {"symbol", "timeframe", "lookback_bars", ...} object.
+    // Returns the local handle (> 0).
+    int Add(std::string stream_json)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const int handle = ++last_handle_;
+        streams_[handle].json = std::move(stream_json);
+        return handle;
+    }
+
+    // False for an unknown handle. A registered stream is queued for
+    // POST /signal/unsubscribe.
+    bool Remove(int handle)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(handle);
+        if (it == streams_.end())
+            return false;
+        if (it->second.serverId > 0)
+            unsubscribes_.push_back(it->second.serverId);
+        streams_.erase(it);
+        return true;
+    }
+
+    TakeState Take(int handle, std::string* response, long long* bar_time)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(handle);
+        if (it == streams_.end())
+            return TakeState::kUnknown;
+        if (!it->second.unread)
+            return TakeState::kNone;
+
+        it->second.unread = false;
+        *response = std::move(it->second.response);
+        it->second.response.clear();
+        if (bar_time)
+            *bar_time = it->second.barTime;
+        taken_++;
+        return TakeState::kReady;
+    }
+
+    bool Empty() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return streams_.empty();
+    }
+
+    // Poller side ---------------------------------------------------------
+
+    // The next POST /signal/unsubscribe body, if any. Once the last stream
+    // is gone the whole subscriber is dropped in one call instead.
+    bool NextUnsubscribe(std::string* body)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscriber_id_.empty()) {
+            unsubscribes_.clear();
+            return false;
+        }
+
+        JsonWriter json;
+        json.Reset(96);
+        json.BeginObject().Field("subscriber_id", subscriber_id_);
+        if (streams_.empty()) {
+            unsubscribes_.clear();
+            subscriber_id_.clear();
+            after_seq_ = 0;
+        } else if (!unsubscribes_.empty()) {
+            json.Field("stream_id", unsubscribes_.back());
+            unsubscribes_.pop_back();
+        } else {
+            return false;
+        }
+        json.EndObject();
+        *body = json.str();
+        return true;
+    }
+
+    // The next stream to register and its POST /signal/subscribe body
+    bool NextRegistration(int* handle, std::string* body)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, stream] : streams_)
+        {
+            if (stream.serverId > 0)
+                continue;
+
+            JsonWriter json;
+            json.Reset(stream.json.size() + 64);
+            json.BeginObject();
+            if (!subscriber_id_.empty())
+                json.Field("subscriber_id", subscriber_id_);
+            json.Key("stream").Raw(stream.json).EndObject();
+
+            *handle = id;
+            *body = json.str();
+            return true;
+        }
+        return false;
+    }
+
+    // {"subscriber_id": "...", "stream_id": n}. False if the answer is not
+    // one (the stream stays unregistered).
+    bool ApplySubscribeResponse(int handle, std::string_view response)
+    {
+        std::string subscriber_id;
+        long long stream_id = 0;
+        bool ok = JsonReader(response).ForEachMember([&](std::string_view key, const JsonValue& value) {
+            if (key == "subscriber_id" && value.IsString())
+                subscriber_id.assign(value.raw);
+            else if (key == "stream_id")
+                stream_id = (long long)value.AsDouble(0.0);
+            return true;
+        });
+        if (!ok || subscriber_id.empty() || stream_id <= 0)
+            return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscriber_id != subscriber_id_) {
+            // A new subscriber: whatever was registered under the old id is
+            // gone from the server
+            if (!subscriber_id_.empty())
+                resubscribes_++;
+            ResetLocked();
+            subscriber_id_ = std::move(subscriber_id);
+        }
+
+        auto it = streams_.find(handle);
+        if (it != streams_.end())
+            it->second.serverId = stream_id;
+        else
+            unsubscribes_.push_back(stream_id);   // Removed while registering
+        return true;
+    }
+
+    // Empty until a subscriber exists
+    std::string PollBody(int timeout_ms) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscriber_id_.empty())
+            return std::string();
+
+        JsonWriter json;
+        json.Reset(96);
+        json.BeginObject()
+            .Field("subscriber_id", subscriber_id_)
+            .Field("after_seq", after_seq_)
+            .Field("timeout_ms", timeout_ms)
+            .EndObject();
+        return json.str();
+    }
+
+    // {"subscriber_id", "signals": [{seq, stream_id, bar_time, response}, ...]}
+    // or the server's {"error": "Unknown subscriber", ...}
+    PollOutcome ApplyPollResponse(std::string_view response)
+    {
+        std::string_view signals;
+        bool have_signals = false;
+        bool unknown_subscriber = false;
+        bool ok = JsonReader(response).ForEachMember([&](std::string_view key, const JsonValue& value) {
+            if (key == "signals" && value.type == JsonType::kArray) {
+                signals = value.raw;
+                have_signals = true;
+            } else if (key == "error" && value.String("Unknown subscriber")) {
+                unknown_subscriber = true;
+            }
+            return true;
+        });
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ok && unknown_subscriber) {
+            resubscribes_++;
+            ResetLocked();
+            subscriber_id_.clear();
+            return PollOutcome::kResubscribe;
+        }
+        if (!ok || !have_signals)
+            return PollOutcome::kMalformed;
+
+        ok = JsonReader(signals).ForEachElement([&](const JsonValue& element) {
+            if (element.type != JsonType::kObject)
+                return false;
+            long long seq = 0, stream_id = 0, bar_time = 0;
+            std::string_view pushed;
+            bool event_ok = JsonReader(element.raw).ForEachMember([&](std::string_view key, const JsonValue& value) {
+                if (key == "seq")
+                    seq = (long long)value.AsDouble(0.0);
+                else if (key == "stream_id")
+                    stream_id = (long long)value.AsDouble(0.0);
+                else if (key == "bar_time")
+                    bar_time = (long long)value.AsDouble(0.0);
+                else if (key == "response" && value.type == JsonType::kObject)
+                    pushed = value.raw;
+                return true;
+            });
+            if (!event_ok || seq <= 0)
+                return false;
+            if (seq <= after_seq_)
+                return true;   // Already taken (repeated after a lost poll answer)
+            after_seq_ = seq;
+
+            for (auto& [id, stream] : streams_)
+            {
+                if (stream.serverId != stream_id || pushed.empty())
+                    continue;
+                if (stream.unread)
+                    overwritten_++;
+                stream.response.assign(pushed);
+                stream.barTime = bar_time;
+                stream.unread = true;
+                pushed_++;
+                break;
+            }
+            return true;
+        });
+        return ok ? PollOutcome::kOk : PollOutcome::kMalformed;
+    }
+
+    // Forget the server side (another endpoint, or its session is gone):
+    // every stream registers again, unread responses are kept
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ResetLocked();
+        subscriber_id_.clear();
+    }
+
+    Stats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats;
+        stats.streams = streams_.size();
+        for (const auto& entry : streams_)
+            stats.registered += entry.second.serverId > 0 ? 1 : 0;
+        stats.pushed = pushed_;
+        stats.taken = taken_;
+        stats.overwritten = overwritten_;
+        stats.resubscribes = resubscribes_;
+        stats.afterSeq = after_seq_;
+        stats.subscriberId = subscriber_id_;
+        return stats;
+    }
+
+private:
+    struct Stream
+    {
+        std::string json;           // The subscribe "stream" object
+        long long serverId = 0;     // stream_id on the server, 0 = unregistered
+        std::string response;       // Newest pushed /signal response
+        long long barTime = 0;
+        bool unread = false;
+    };
+
+    void ResetLocked()
+    {
+        for (auto& entry : streams_)
+            entry.second.serverId = 0;
+        unsubscribes_.clear();
+        after_seq_ = 0;
+    }
+
+    mutable std::mutex mutex_;
+    std::map<int, Stream> streams_;
+    std::vector<long long> unsubscribes_;   // Server stream ids to drop
+    std::string subscriber_id_;
+    long long after_seq_ = 0;
+    int last_handle_ = 0;
+    long long pushed_ = 0;
+    long long taken_ = 0;
+    long long overwritten_ = 0;
+    long long resubscribes_ = 0;
+};
+
+} // namespace volarix4::bridge
@@ -0,0 +1,385 @@
+//=============================================================================
+//  core/backtest_engine.cpp
+//  Native backtest loop over the signal pipeline (mirrors
+//  volarix4_backtest/engine.py and walk_forward.py)
+//=============================================================================
+#include "backtest_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "bar_validation.h"
+#include "helpers.h"
+#include "sr_incremental.h"
+#include "trend_incremental.h"
+#include "work_stealing_pool.h"
+
+namespace volarix4::core {
+
+namespace {
+
+// Trades' net P&L split into wins and losses (engine.py's sums, in order)
+struct TradeTotals
+{
+    size_t winning = 0;
+    size_t losing = 0;
+    double grossProfit = 0.0;
+    double grossLoss = 0.0;
+};
+
+TradeTotals SumTrades(const std::vector<Trade>& trades, TradeTotals totals = TradeTotals())
+{
+    double loss_sum = -totals.grossLoss;
+    for (const Trade& trade : trades) {
+        if (trade.netPnlUsd > 0) {
+            ++totals.winning;
+            totals.grossProfit += trade.netPnlUsd;
+        }
+        else if (trade.netPnlUsd < 0) {
+            ++totals.losing;
+            loss_sum += trade.netPnlUsd;
+        }
+    }
+    totals.grossLoss = std::fabs(loss_sum);
+    return totals;
+}
+
+} // namespace
+
+//=============================================================================
+//  PipelineFeatureCache
+//=============================================================================
+PipelineFeatureCache::PipelineFeatureCache(const BarColumns& bars, std::string symbol,
+                                           std::string timeframe)
+    : bars_(bars), symbol_(std::move(symbol)), timeframe_(std::move(timeframe)),
+      shards_(new Shard[kShards])
+{
+}
+
+const PipelineFeatures& PipelineFeatureCache::Get(const BarColumns& window,
+                                                  IncrementalSRLevels* sr_levels, IncrementalTrend* trend)
+{
+    const uint64_t first = (uint64_t)(window.time - bars_.time);
+    const uint64_t key = (first << 32) | (uint64_t)window.count;
+
+    Slot* slot;
+    {
+        Shard& shard = shards_[(first + window.count) % kShards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::unique_ptr<Slot>& entry = shard.slots[key];
+        if (!entry)
+            entry = std::make_unique<Slot>();
+        slot = entry.get();
+    }
+
+    // Concurrent callers for the same window wait for the first one
+    std::call_once(slot->once, [&]() {
+        slot->features = ComputePipelineFeatures(symbol_, timeframe_, window, nullptr, sr_levels, trend);
+        computations_.fetch_add(1, std::memory_order_relaxed);
+    });
+    return slot->features;
+}
+
+//=============================================================================
+//  Backtest
+//=============================================================================
+BacktestConfig DefaultBacktestConfig()
+{
+    BacktestConfig config;
+    config.symbol = "EURUSD";
+    config.timeframe = "H1";
+    config.params = DefaultStrategyParams();
+    config.params.spreadPips = 1.5;
+    config.params.slippagePips = 0.5;
+    config.params.commissionPerSidePerLot = 3.5;
+    config.params.usdPerPipPerLot = 10.0;
+    config.params.lotSize = 0.01;
+    config.lookbackBars = 400;
+    config.warmupBars = 400;
+    config.fillAt = kFillNextOpen;
+    config.initialBalanceUsd = 10000.0;
+    config.exitModel = kExitBarRange;
+    config.pathModel = kPathByDirection;
+    return config;
+}
+
+BacktestMetrics ComputeBacktestMetrics(const std::vector<Trade>& trades,
+                                       const std::vector<EquityPoint>& equity_curve,
+                                       double initial_balance, double final_balance)
+{
+    BacktestMetrics metrics;
+    metrics.finalBalance = final_balance;
+    if (trades.empty())
+        return metrics;
+
+    const TradeTotals totals = SumTrades(trades);
+    metrics.totalTrades = trades.size();
+    metrics.winningTrades = totals.winning;
+    metrics.losingTrades = totals.losing;
+    metrics.grossProfitUsd = totals.grossProfit;
+    metrics.grossLossUsd = totals.grossLoss;
+    metrics.netProfitUsd = totals.grossProfit - totals.grossLoss;
+    metrics.winRate = (double)totals.winning / (double)trades.size();
+    metrics.profitFactor = totals.grossLoss > 0 ? totals.grossProfit / totals.grossLoss
+                                                : std::numeric_limits<double>::infinity();
+
+    double peak = initial_balance;
+    for (const EquityPoint& point : equity_curve) {
+        if (point.equity > peak)
+            peak = point.equity;
+        double drawdown = peak - point.equity;
+        if (drawdown > metrics.maxDrawdownUsd) {
+            metrics.maxDrawdownUsd = drawdown;
+            metrics.maxDrawdownPct = peak > 0 ? (drawdown / peak) * 100 : 0.0;
+        }
+    }
+
+    metrics.returnPct = ((final_balance - initial_balance) / initial_balance) * 100;
+    return metrics;
+}
+
+bool RunBacktest(const BarColumns& bars, const BacktestConfig& config,
+                 const BacktestOptions& options, BacktestResult* result,
+                 std::string* error, size_t history_bars)
+{
+    *result = BacktestResult();
+    history_bars = std::min(history_bars, bars.count);
+    const size_t period_bars = bars.count - history_bars;
+    if (period_bars < config.warmupBars) {
+        *error = "Insufficient bars: " + std::to_string(period_bars) + " < warmup_bars (" +
+                 std::to_string(config.warmupBars) + ")";
+        return false;
+    }
+
+    if (config.exitModel == kExitTicks && !options.ticks) {
+        *error = "Tick exits need a tick file";
+        return false;
+    }
+
+    const BrokerSimulator broker(CostModelFor(config.params, CalculatePipValue(config.symbol)));
+    ExitSimulator exits(broker, config.exitModel, config.pathModel, options.ticks);
+    const long long bar_seconds = TimeframeSeconds(config.timeframe);
+    IncrementalSRLevels sr_levels;
+    IncrementalTrend trend;
+    PipelineOptions pipeline;
+    pipeline.cooldown = options.cooldown;
+    pipeline.srLevels = &sr_levels;
+    pipeline.trend = &trend;
+
+    const size_t lookback = std::max<size_t>(config.lookbackBars, 1);
+    double balance = config.initialBalanceUsd;
+    Trade open_trade;
+    bool has_trade = false;
+
+    result->equityCurve.reserve(period_bars - config.warmupBars);
+
+    for (size_t i = history_bars + config.warmupBars; i < bars.count; ++i)
+    {
+        if (has_trade) {
+            exits.Update(open_trade, bars, i, bar_seconds);
+            if (open_trade.IsClosed()) {
+                balance += open_trade.netPnlUsd;
+                result->trades.push_back(std::move(open_trade));
+                has_trade = false;
+            }
+        }
+
+        if (!has_trade) {
+            const size_t first = i + 1 > lookback ? i + 1 - lookback : 0;
+            const BarColumns window = bars.Slice(first, i + 1 - first);
+            PipelineResult signal = options.features
+                ? RunSignalPipeline(config.symbol, window, options.features->Get(window, &sr_levels, &trend), config.params, pipeline)
+                : RunSignalPipeline(config.symbol, config.timeframe, window, config.params, pipeline);
+            if (!signal.barsValid) {
+                *error = "Signal request for bar " + FormatDateTime(bars.time[i]) +
+                         " rejected: " + signal.validationError;
+                return false;
+            }
+
+            ++result->totalSignals;
+            const SignalType direction = signal.response.signal;
+            if (direction == kSignalHold) {
+                ++result->holdSignals;
+            }
+            else {
+                ++(direction == kSignalBuy ? result->buySignals : result->sellSignals);
+
+                size_t entry = i;
+                double entry_price = bars.close[i];
+                if (config.fillAt == kFillNextOpen) {
+                    entry = i + 1;
+                    entry_price = entry < bars.count ? bars.open[entry] : 0.0;
+                }
+                if (entry < bars.count) {
+                    open_trade = broker.OpenTrade(direction, bars.time[entry], entry_price,
+                                                  config.params.lotSize, signal.response);
+                    has_trade = true;
+                }
+            }
+        }
+
+        // Balance plus the open trade's realized partials
+        const double unrealized = has_trade && !open_trade.IsClosed() ? open_trade.netPnlUsd : 0.0;
+        result->equityCurve.push_back(EquityPoint{ bars.time[i], balance, unrealized, balance + unrealized });
+    }
+
+    if (has_trade) {
+        const size_t last = bars.count - 1;
+        broker.CloseTrade(open_trade, bars.time[last], bars.close[last], kExitManual);
+        balance += open_trade.netPnlUsd;
+        result->trades.push_back(std::move(open_trade));
+    }
+
+    result->ticksReplayed = exits.TicksReplayed();
+    result->barsWithoutTicks = exits.BarsWithoutTicks();
+    result->metrics = ComputeBacktestMetrics(result->trades, result->equityCurve,
+                                             config.initialBalanceUsd, balance);
+    return true;
+}
+
+int BarYear(long long unix_time)
+{
+    // Civil date from days since 1970-01-01 (Howard Hinnant's algorithm)
+    long long days = unix_time / 86400;
+    if (unix_time % 86400 < 0)
+        --days;
+    days += 719468;
+    const long long era = (days >= 0 ? days : days - 146096) / 146097;
+    const long long doe = days - era * 146097;
+    const long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const long long mp = (5 * doy + 2) / 153;
+    const long long month = mp < 10 ? mp + 3 : mp - 9;
+    return (int)(yoe + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+bool RunWalkForward(const BarColumns& bars, const BacktestConfig& config,
+                    const std::vector<int>& test_years, int train_years_lookback,
+                    bool history_windows, const BacktestOptions& options,
+                    WalkForwardResult* result, std::string* error)
+{
+    *result = WalkForwardResult();
+
+    struct Fold
+    {
+        WalkForwardYear entry;
+        size_t first = 0;           // Slice of bars the year's backtest runs on
+        size_t count = 0;
+        size_t history = 0;
+        bool ok = false;
+        std::string error;
+        bool signalled = false;     // Its own tracker's last signal, if any
+        long long lastSignal = 0;
+    };
+
+    std::vector<Fold> folds;
+    for (int year : test_years)
+    {
+        // Bars are sorted, so each year is one contiguous range
+        size_t train_bars = 0, test_first = bars.count, test_end = bars.count;
+        const int train_start = year - train_years_lookback;
+        for (size_t i = 0; i < bars.count; ++i) {
+            const int bar_year = BarYear(bars.time[i]);
+            if (bar_year >= train_start && bar_year < year)
+                ++train_bars;
+            else if (bar_year == year && test_first == bars.count)
+                test_first = i;
+            else if (bar_year > year && test_first != bars.count) {
+                test_end = i;
+                break;
+            }
+        }
+        if (train_bars == 0 || test_first == bars.count)
+            continue;
+
+        const size_t history = history_windows ? std::min(test_first, config.lookbackBars) : 0;
+        Fold fold;
+        fold.entry.year = year;
+        fold.entry.trainBars = train_bars;
+        fold.entry.testBars = test_end - test_first;
+        fold.first = test_first - history;
+        fold.count = test_end - test_first + history;
+        fold.history = history;
+        folds.push_back(std::move(fold));
+    }
+
+    // Runs a fold with a tracker holding `carried` (nullptr = none)
+    auto run_fold = [&](Fold& fold, const long long* carried) {
+        SignalCooldownTracker cooldown;
+        if (carried)
+            cooldown.Record(config.symbol, *carried);
+        BacktestOptions fold_options = options;
+        fold_options.cooldown = options.cooldown ? &cooldown : nullptr;
+        fold.entry.result = BacktestResult();
+        fold.ok = RunBacktest(bars.Slice(fold.first, fold.count), config, fold_options,
+                              &fold.entry.result, &fold.error, fold.history);
+        fold.signalled = options.cooldown && cooldown.LastSignal(config.symbol, &fold.lastSignal);
+        if (fold.signalled && carried && fold.lastSignal == *carried)
+            fold.signalled = false;
+    };
+
+    long long carried = 0;
+    bool has_carried = options.cooldown && options.cooldown->LastSignal(config.symbol, &carried);
+    const bool concurrent = options.workers > 1 && folds.size() > 1;
+    if (concurrent) {
+        WorkStealingPool::Run(folds.size(), options.workers,
+                              [&](size_t index, size_t) { run_fold(folds[index], nullptr); });
+    }
+
+    for (Fold& fold : folds)
+    {
+        if (!concurrent) {
+            run_fold(fold, has_carried ? &carried : nullptr);
+        }
+        else if (has_carried && fold.ok) {
+            // The earliest cooldown check is on the first decision bar
+            const size_t first_decision = fold.first + fold.history + config.warmupBars;
+            if (first_decision < fold.first + fold.count &&
+                (double)(bars.time[first_decision] - carried) / 3600.0 < kSignalCooldownHours)
+                run_fold(fold, &carried);
+        }
+
+        if (!fold.ok) {
+            *error = std::to_string(fold.entry.year) + ": " + fold.error;
+            return false;
+        }
+        if (fold.signalled) {
+            carried = fold.lastSignal;
+            has_carried = true;
+        }
+        result->years.push_back(std::move(fold.entry));
+    }
+    if (has_carried && options.cooldown)
+        options.cooldown->Record(config.symbol, carried);
+
+    WalkForwardAggregate& aggregate = result->aggregate;
+    aggregate.totalYears = result->years.size();
+    if (result->years.empty())
+        return true;
+
+    TradeTotals totals;
+    for (const WalkForwardYear& year : result->years) {
+        aggregate.yearsTested.push_back(year.year);
+        aggregate.totalTrades += year.result.trades.size();
+        totals = SumTrades(year.result.trades, totals);
+    }
+    if (aggregate.totalTrades == 0)
+        return true;
+
+    const double years = (double)aggregate.totalYears;
+    aggregate.avgTradesPerYear = (double)aggregate.totalTrades / years;
+    aggregate.winningTrades = totals.winning;
+    aggregate.losingTrades = totals.losing;
+    aggregate.winRate = (double)totals.winning / (double)aggregate.totalTrades;
+    aggregate.grossProfitUsd = totals.grossProfit;
+    aggregate.grossLossUsd = totals.grossLoss;
+    aggregate.netProfitUsd = totals.grossProfit - totals.grossLoss;
+    aggregate.profitFactor = totals.grossLoss > 0 ? totals.grossProfit / totals.grossLoss
+                                                  : std::numeric_limits<double>::infinity();
+    aggregate.returnPct = (aggregate.netProfitUsd / config.initialBalanceUsd) * 100;
+    aggregate.avgNetProfitPerYear = aggregate.netProfitUsd / years;
+    return true;
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,210 @@
+//=============================================================================
+//  core/backtest_engine.h
+//  Native backtest loop over the signal pipeline (mirrors
+//  volarix4_backtest/engine.py and walk_forward.py)
+//
+//  Bar by bar after the warmup: update the open trade with the bar, ask the
+//  pipeline for a signal on the lookback window ending at the bar when no
+//  trade is open, fill it at the next bar's open (or the bar's close), and
+//  record balance plus realized partial P&L as equity. The pipeline call is
+//  the API's /signal in process, so a run over years of bars needs no
+//  server and no HTTP round trip per bar. Consecutive windows differ by a
+//  bar at each end, so each run keeps incremental S/R state across them
+//  (sr_incremental.h) rather than detecting the levels per window. Exits
+//  are resolved from the bar's range like broker_sim.py, or along an
+//  intrabar price path or the bar's real ticks (tick_path.h).
+//=============================================================================
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bar_columns.h"
+#include "broker_sim.h"
+#include "signal_pipeline.h"
+#include "tick_path.h"
+
+namespace volarix4::core {
+
+enum FillAt : int
+{
+    kFillNextOpen = 0,          // Next bar's open (no peeking)
+    kFillSignalClose = 1        // Signal bar's close
+};
+
+struct BacktestConfig
+{
+    std::string symbol;
+    std::string timeframe;
+    StrategyParams params;      // Sent to the pipeline; costs also drive the broker
+    size_t lookbackBars;
+    size_t warmupBars;
+    FillAt fillAt;
+    double initialBalanceUsd;
+    ExitModel exitModel;
+    PathModel pathModel;        // kExitPricePath, and kExitTicks bars without ticks
+};
+
+// BacktestConfig's defaults: EURUSD H1, the API's strategy defaults with the
+// backtest's cost model (1.5 spread, 0.5 slippage, 3.5 commission, 0.01 lots),
+// exits from the bar range
+BacktestConfig DefaultBacktestConfig();
+
+struct EquityPoint
+{
+    long long time;
+    double balance;
+    double unrealizedPnl;
+    double equity;
+};
+
+struct BacktestMetrics
+{
+    size_t totalTrades = 0;
+    size_t winningTrades = 0;
+    size_t losingTrades = 0;
+    double netProfitUsd = 0.0;
+    double grossProfitUsd = 0.0;
+    double grossLossUsd = 0.0;
+    double winRate = 0.0;
+    double profitFactor = 0.0;     // inf without a losing trade
+    double maxDrawdownUsd = 0.0;
+    double maxDrawdownPct = 0.0;
+    double finalBalance = 0.0;
+    double returnPct = 0.0;
+};
+
+struct BacktestResult
+{
+    std::vector<Trade> trades;
+    std::vector<EquityPoint> equityCurve;
+    size_t totalSignals = 0;
+    size_t buySignals = 0;
+    size_t sellSignals = 0;
+    size_t holdSignals = 0;
+    size_t ticksReplayed = 0;       // kExitTicks
+    size_t barsWithoutTicks = 0;
+    BacktestMetrics metrics;
+};
+
+// Pipeline features (steps 1-4, see signal_pipeline.h) per signal window of
+// one bar array. A window's features are computed by the first run that
+// needs them and shared read-only by every later run: the windows - and so
+// the trend and S/R levels - of a grid search's combinations are the same
+// whatever their strategy parameters. Safe to share between threads.
+class PipelineFeatureCache
+{
+public:
+    PipelineFeatureCache(const BarColumns& bars, std::string symbol, std::string timeframe);
+
+    // Features of window, which must be a slice of the cache's bars. A
+    // window computed here advances the caller's sr_levels and trend, if
+    // given.
+    const PipelineFeatures& Get(const BarColumns& window, IncrementalSRLevels* sr_levels = nullptr,
+                                IncrementalTrend* trend = nullptr);
+
+    // Windows computed so far
+    size_t Computations() const { return computations_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kShards = 64;
+
+    struct Slot
+    {
+        std::once_flag once;
+        PipelineFeatures features;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, std::unique_ptr<Slot>> slots;
+    };
+
+    BarColumns bars_;
+    std::string symbol_;
+    std::string timeframe_;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<size_t> computations_{ 0 };
+};
+
+struct BacktestOptions
+{
+    SignalCooldownTracker* cooldown = nullptr;      // The server's tracker (nullptr = no cooldown)
+    PipelineFeatureCache* features = nullptr;       // Shared features (nullptr = compute per window)
+    size_t workers = 1;                             // Walk-forward years run at once
+    const TickColumns* ticks = nullptr;             // Real ticks for kExitTicks
+};
+
+// _compute_results()
+BacktestMetrics ComputeBacktestMetrics(const std::vector<Trade>& trades,
+                                       const std::vector<EquityPoint>& equity_curve,
+                                       double initial_balance, double final_balance);
+
+// Backtest the bars (oldest first) after the first history_bars: those are
+// only seen through signal windows, the way the API's optimized mode reads
+// bars before the test period from MT5. The warmup starts after them.
+// False with *error set when there are fewer bars than the warmup or the
+// pipeline rejects a window (the API's 422, which stops the Python run), or
+// when kExitTicks has no options.ticks.
+bool RunBacktest(const BarColumns& bars, const BacktestConfig& config,
+                 const BacktestOptions& options, BacktestResult* result,
+                 std::string* error, size_t history_bars = 0);
+
+struct WalkForwardYear
+{
+    int year;
+    size_t trainBars;
+    size_t testBars;
+    BacktestResult result;
+};
+
+struct WalkForwardAggregate
+{
+    size_t totalTrades = 0;
+    size_t totalYears = 0;
+    double avgTradesPerYear = 0.0;
+    size_t winningTrades = 0;
+    size_t losingTrades = 0;
+    double winRate = 0.0;
+    double netProfitUsd = 0.0;
+    double grossProfitUsd = 0.0;
+    double grossLossUsd = 0.0;
+    double profitFactor = 0.0;
+    double returnPct = 0.0;
+    double avgNetProfitPerYear = 0.0;
+    std::vector<int> yearsTested;
+};
+
+struct WalkForwardResult
+{
+    std::vector<WalkForwardYear> years;
+    WalkForwardAggregate aggregate;
+};
+
+// Calendar year (UTC) of a bar time
+int BarYear(long long unix_time);
+
+// WalkForwardEngine.run(): each test year is backtested on its own bars
+// (years without bars, or without bars in the train_years_lookback years
+// before it, are skipped). history_windows lets signal windows reach into
+// the bars before each test year (optimized mode). The cooldown carries
+// over from year to year like the server's.
+//
+// With options.workers > 1 the years run concurrently, each with its own
+// cooldown tracker. A year's result only depends on the cooldown carried
+// into it if the previous years' last signal lies within
+// kSignalCooldownHours of its first decision bar; such a year is run again
+// with the carried tracker, so the result is the sequential one either way.
+bool RunWalkForward(const BarColumns& bars, const BacktestConfig& config,
+                    const std::vector<int>& test_years, int train_years_lookback,
+                    bool history_windows, const BacktestOptions& options,
+                    WalkForwardResult* result, std::string* error);
+
+} // namespace volarix4::core
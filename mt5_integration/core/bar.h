@@ -0,0 +1,25 @@
+//=============================================================================
+//  core/bar.h
+//  Bar record shared by the bridge exports and the native strategy core
+//=============================================================================
+#pragma once
+
+namespace volarix4::core {
+
+// OHLCV Bar structure (must match MT5 definition)
+// CRITICAL: MQL5 uses tight packing with NO PADDING (total: 44 bytes)
+#pragma pack(push, 1)  // No padding - tight packing to match MQL5
+struct OHLCVBar
+{
+    long long timestamp; // Unix timestamp (8 bytes) - use long long to ensure 8 bytes
+    double open;         // 8 bytes
+    double high;         // 8 bytes
+    double low;          // 8 bytes
+    double close;        // 8 bytes
+    int volume;          // 4 bytes
+};                       // Total: exactly 44 bytes (no padding)
+#pragma pack(pop)
+
+static_assert(sizeof(OHLCVBar) == 44, "OHLCVBar must match the packed MQL5 layout");
+
+} // namespace volarix4::core
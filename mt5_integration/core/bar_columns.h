@@ -0,0 +1,159 @@
+//=============================================================================
+//  core/bar_columns.h
+//  Structure-of-arrays bar data for the native kernels
+//
+//  BarColumns is a non-owning view (one pointer per field); ColumnBuffer owns
+//  columns whose allocations are 64-byte aligned. A view that starts inside
+//  a buffer (a lookback slice, the bar store after a trim) starts wherever
+//  its first bar falls, so the AVX2 kernels use unaligned loads; what the
+//  columns guarantee is that each double is naturally aligned and the
+//  fields are contiguous. The packed 44-byte OHLCVBar layout MQL5 passes in
+//  leaves every double misaligned, which is why the kernels do not run on it
+//  directly.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "bar.h"
+
+namespace volarix4::core {
+
+constexpr size_t kColumnAlignment = 64;
+
+// std::allocator with over-aligned storage (C++17 aligned operator new)
+template <typename T, size_t Alignment = kColumnAlignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* ptr, size_t)
+    {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Read-only view of count bars, oldest first
+struct BarColumns
+{
+    const long long* time = nullptr;
+    const double* open = nullptr;
+    const double* high = nullptr;
+    const double* low = nullptr;
+    const double* close = nullptr;
+    const double* volume = nullptr;
+    size_t count = 0;
+
+    // Bars [first, first + length)
+    BarColumns Slice(size_t first, size_t length) const
+    {
+        return BarColumns{ time + first, open + first, high + first, low + first,
+                           close + first, volume + first, length };
+    }
+
+    // The newest length bars (all of them if there are fewer)
+    BarColumns Tail(size_t length) const
+    {
+        return length >= count ? *this : Slice(count - length, length);
+    }
+};
+
+// Owned, aligned columns
+class ColumnBuffer
+{
+public:
+    size_t size() const { return time_.size(); }
+    bool empty() const { return time_.empty(); }
+
+    void Clear()
+    {
+        time_.clear();
+        open_.clear();
+        high_.clear();
+        low_.clear();
+        close_.clear();
+        volume_.clear();
+    }
+
+    void Reserve(size_t count)
+    {
+        time_.reserve(count);
+        open_.reserve(count);
+        high_.reserve(count);
+        low_.reserve(count);
+        close_.reserve(count);
+        volume_.reserve(count);
+    }
+
+    void Append(const OHLCVBar& bar)
+    {
+        time_.push_back(bar.timestamp);
+        open_.push_back(bar.open);
+        high_.push_back(bar.high);
+        low_.push_back(bar.low);
+        close_.push_back(bar.close);
+        volume_.push_back((double)bar.volume);
+    }
+
+    // Replace the contents with a packed bar array (keeps capacity)
+    void Assign(const OHLCVBar* bars, size_t count)
+    {
+        Clear();
+        Reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            Append(bars[i]);
+    }
+
+    // Drop the oldest count bars
+    void EraseFront(size_t count)
+    {
+        if (count == 0)
+            return;
+        time_.erase(time_.begin(), time_.begin() + count);
+        open_.erase(open_.begin(), open_.begin() + count);
+        high_.erase(high_.begin(), high_.begin() + count);
+        low_.erase(low_.begin(), low_.begin() + count);
+        close_.erase(close_.begin(), close_.begin() + count);
+        volume_.erase(volume_.begin(), volume_.begin() + count);
+    }
+
+    long long LastTime() const { return time_.empty() ? 0 : time_.back(); }
+
+    BarColumns View() const
+    {
+        return BarColumns{ time_.data(), open_.data(), high_.data(), low_.data(),
+                           close_.data(), volume_.data(), time_.size() };
+    }
+
+private:
+    AlignedVector<long long> time_;
+    AlignedVector<double> open_;
+    AlignedVector<double> high_;
+    AlignedVector<double> low_;
+    AlignedVector<double> close_;
+    AlignedVector<double> volume_;
+};
+
+} // namespace volarix4::core
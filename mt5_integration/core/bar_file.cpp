@@ -0,0 +1,211 @@
+//=============================================================================
+//  core/bar_file.cpp
+//  Columnar bar history file (.v4bars): written from bar columns, read
+//  through a read-only memory mapping
+//=============================================================================
+#include "bar_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace volarix4::core {
+
+namespace {
+
+uint64_t AlignColumn(uint64_t offset)
+{
+    return (offset + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+}
+
+uint64_t IndexCount(uint64_t bars, uint64_t stride)
+{
+    return (bars + stride - 1) / stride;
+}
+
+void CopyName(char* out, size_t size, std::string_view name)
+{
+    std::memset(out, 0, size);
+    std::memcpy(out, name.data(), std::min(name.size(), size - 1));
+}
+
+std::string NameOf(const char* text, size_t size)
+{
+    return std::string(text, std::find(text, text + size, '\0'));
+}
+
+} // namespace
+
+bool WriteBarFile(const std::string& path, std::string_view symbol, std::string_view timeframe,
+                  const BarColumns& bars, std::string* error)
+{
+    for (size_t i = 1; i < bars.count; ++i) {
+        if (bars.time[i] <= bars.time[i - 1]) {
+            *error = "Bars are not in ascending time order at bar " + std::to_string(i);
+            return false;
+        }
+    }
+
+    BarFileHeader header{};
+    header.magic = kBarFileMagic;
+    header.version = kBarFileVersion;
+    header.headerBytes = sizeof(BarFileHeader);
+    header.indexStride = kBarFileIndexStride;
+    header.barCount = bars.count;
+    header.firstTime = bars.count ? bars.time[0] : 0;
+    header.lastTime = bars.count ? bars.time[bars.count - 1] : 0;
+    CopyName(header.symbol, sizeof(header.symbol), symbol);
+    CopyName(header.timeframe, sizeof(header.timeframe), timeframe);
+
+    uint64_t offset = AlignColumn(sizeof(BarFileHeader));
+    for (int c = 0; c < kBarFileColumns; ++c) {
+        header.columnOffset[c] = offset;
+        offset = AlignColumn(offset + bars.count * sizeof(double));
+    }
+    header.indexOffset = offset;
+    header.indexCount = IndexCount(bars.count, kBarFileIndexStride);
+    header.fileBytes = offset + header.indexCount * sizeof(int64_t);
+
+    std::vector<int64_t> index(header.indexCount);
+    for (size_t k = 0; k < index.size(); ++k)
+        index[k] = bars.time[k * kBarFileIndexStride];
+
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            *error = "Cannot write bar file: " + temp;
+            return false;
+        }
+
+        static const char kPadding[kColumnAlignment] = {};
+        uint64_t written = 0;
+        auto write = [&](const void* data, uint64_t size, uint64_t at) {
+            out.write(kPadding, (std::streamsize)(at - written));
+            out.write(static_cast<const char*>(data), (std::streamsize)size);
+            written = at + size;
+        };
+
+        const void* columns[kBarFileColumns] = { bars.time, bars.open, bars.high,
+                                                 bars.low, bars.close, bars.volume };
+        write(&header, sizeof(header), 0);
+        for (int c = 0; c < kBarFileColumns; ++c)
+            write(columns[c], bars.count * sizeof(double), header.columnOffset[c]);
+        write(index.data(), index.size() * sizeof(int64_t), header.indexOffset);
+
+        out.close();
+        if (!out) {
+            *error = "Cannot write bar file: " + temp;
+            std::error_code ec;
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        *error = "Cannot replace bar file " + path + ": " + ec.message();
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+MappedBarFile& MappedBarFile::operator=(MappedBarFile&& other) noexcept
+{
+    if (this != &other) {
+        Close();
+        file_ = std::move(other.file_);
+        bars_ = other.bars_;
+        index_ = other.index_;
+        index_count_ = other.index_count_;
+        index_stride_ = other.index_stride_;
+        symbol_ = std::move(other.symbol_);
+        timeframe_ = std::move(other.timeframe_);
+        other.bars_ = BarColumns();
+    }
+    return *this;
+}
+
+bool MappedBarFile::Open(const std::string& path, std::string* error)
+{
+    Close();
+
+    if (!file_.Open(path, sizeof(BarFileHeader), "bar file", error))
+        return false;
+    const uint8_t* base = file_.Data();
+    const size_t bytes = file_.Size();
+
+    // Everything the views point at must lie inside the mapping
+    BarFileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    const uint64_t column_bytes = header.barCount * sizeof(double);
+    bool valid = header.magic == kBarFileMagic && header.version == kBarFileVersion &&
+                 header.headerBytes == sizeof(BarFileHeader) && header.indexStride > 0 &&
+                 header.fileBytes == bytes && header.barCount <= bytes / sizeof(double) &&
+                 header.indexCount == IndexCount(header.barCount, header.indexStride) &&
+                 header.indexOffset % sizeof(int64_t) == 0 &&
+                 header.indexOffset <= bytes &&
+                 header.indexCount <= (bytes - header.indexOffset) / sizeof(int64_t);
+    for (int c = 0; c < kBarFileColumns && valid; ++c)
+        valid = header.columnOffset[c] % sizeof(double) == 0 && header.columnOffset[c] <= bytes &&
+                column_bytes <= bytes - header.columnOffset[c];
+    if (!valid) {
+        Close();
+        *error = "Not a bar file (bad header): " + path;
+        return false;
+    }
+
+    bars_.time = reinterpret_cast<const long long*>(base + header.columnOffset[kBarFileTime]);
+    bars_.open = reinterpret_cast<const double*>(base + header.columnOffset[kBarFileOpen]);
+    bars_.high = reinterpret_cast<const double*>(base + header.columnOffset[kBarFileHigh]);
+    bars_.low = reinterpret_cast<const double*>(base + header.columnOffset[kBarFileLow]);
+    bars_.close = reinterpret_cast<const double*>(base + header.columnOffset[kBarFileClose]);
+    bars_.volume = reinterpret_cast<const double*>(base + header.columnOffset[kBarFileVolume]);
+    bars_.count = (size_t)header.barCount;
+    index_ = reinterpret_cast<const int64_t*>(base + header.indexOffset);
+    index_count_ = (size_t)header.indexCount;
+    index_stride_ = header.indexStride;
+    symbol_ = NameOf(header.symbol, sizeof(header.symbol));
+    timeframe_ = NameOf(header.timeframe, sizeof(header.timeframe));
+
+    if (bars_.count > 0 && (bars_.time[0] != header.firstTime ||
+                            bars_.time[bars_.count - 1] != header.lastTime)) {
+        Close();
+        *error = "Not a bar file (time range does not match): " + path;
+        return false;
+    }
+    return true;
+}
+
+void MappedBarFile::Close()
+{
+    file_.Close();
+    bars_ = BarColumns();
+    index_ = nullptr;
+    index_count_ = 0;
+    symbol_.clear();
+    timeframe_.clear();
+}
+
+size_t MappedBarFile::LowerBound(long long unix_time) const
+{
+    // The index entry at or before unix_time picks the block; only that
+    // block of the time column is searched
+    const size_t entry = (size_t)(std::upper_bound(index_, index_ + index_count_, (int64_t)unix_time) - index_);
+    const size_t first = entry == 0 ? 0 : (entry - 1) * index_stride_;
+    const size_t end = std::min(bars_.count, entry * index_stride_);
+    return (size_t)(std::lower_bound(bars_.time + first, bars_.time + end, unix_time) - bars_.time);
+}
+
+BarColumns MappedBarFile::Range(long long from, long long to) const
+{
+    const size_t first = from ? LowerBound(from) : 0;
+    const size_t end = to ? std::max(first, LowerBound(to + 1)) : bars_.count;
+    return bars_.Slice(first, end - first);
+}
+
+} // namespace volarix4::core
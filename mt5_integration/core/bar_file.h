@@ -0,0 +1,120 @@
+//=============================================================================
+//  core/bar_file.h
+//  Columnar bar history file (.v4bars): written from bar columns, read
+//  through a read-only memory mapping
+//
+//  The file is the bar store's layout on disk, so a reader hands the
+//  mapped columns to the native code as a BarColumns view - nothing is
+//  parsed or copied, and only the pages a run touches are read. Layout
+//  (little-endian):
+//
+//    BarFileHeader                 256 bytes
+//    time    int64[barCount]       each column starts on a 64-byte boundary
+//    open    double[barCount]
+//    high    double[barCount]
+//    low     double[barCount]
+//    close   double[barCount]
+//    volume  double[barCount]
+//    index   int64[indexCount]     time of bar k * indexStride
+//
+//  Times are the bars' unix seconds (MT5 server time, like the bar store),
+//  ascending and unique. The sparse index finds a time without touching
+//  more than one indexStride block of the time column. Files are written
+//  to a temporary name and renamed into place, so a reader never maps a
+//  half-written file.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "bar_columns.h"
+#include "mapped_file.h"
+
+namespace volarix4::core {
+
+constexpr uint32_t kBarFileMagic = 0x46423456;      // "V4BF"
+constexpr uint32_t kBarFileVersion = 1;
+constexpr uint32_t kBarFileIndexStride = 256;
+
+enum BarFileColumn : int
+{
+    kBarFileTime = 0,
+    kBarFileOpen,
+    kBarFileHigh,
+    kBarFileLow,
+    kBarFileClose,
+    kBarFileVolume,
+    kBarFileColumns
+};
+
+struct BarFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerBytes;                       // sizeof(BarFileHeader)
+    uint32_t indexStride;
+    uint64_t barCount;
+    int64_t firstTime;                          // 0 for an empty file
+    int64_t lastTime;
+    uint64_t columnOffset[kBarFileColumns];     // Byte offsets from the file start
+    uint64_t indexOffset;
+    uint64_t indexCount;
+    uint64_t fileBytes;
+    char symbol[32];                            // NUL-padded
+    char timeframe[16];
+    uint8_t reserved[96];
+};
+
+static_assert(sizeof(BarFileHeader) == 256, "BarFileHeader is part of the file format");
+
+// Write bars (oldest first, ascending times) to path. False with *error on
+// unsorted bars or an I/O failure; an existing file is only replaced once
+// the new one is complete.
+bool WriteBarFile(const std::string& path, std::string_view symbol, std::string_view timeframe,
+                  const BarColumns& bars, std::string* error);
+
+// Read-only mapping of a bar file. Move-only; the view returned by Bars()
+// lives as long as the object.
+class MappedBarFile
+{
+public:
+    MappedBarFile() = default;
+    ~MappedBarFile() { Close(); }
+
+    MappedBarFile(MappedBarFile&& other) noexcept { *this = std::move(other); }
+    MappedBarFile& operator=(MappedBarFile&& other) noexcept;
+    MappedBarFile(const MappedBarFile&) = delete;
+    MappedBarFile& operator=(const MappedBarFile&) = delete;
+
+    // Map path and check its header against the file size. False with
+    // *error for a missing, truncated or foreign file.
+    bool Open(const std::string& path, std::string* error);
+    void Close();
+
+    bool IsOpen() const { return file_.IsOpen(); }
+
+    const BarColumns& Bars() const { return bars_; }
+    std::string_view Symbol() const { return symbol_; }
+    std::string_view Timeframe() const { return timeframe_; }
+
+    // Index of the first bar at or after unix_time (Bars().count if none)
+    size_t LowerBound(long long unix_time) const;
+
+    // Bars with from <= time <= to (0 = unbounded)
+    BarColumns Range(long long from, long long to) const;
+
+private:
+    MappedFile file_;
+    BarColumns bars_;
+    const int64_t* index_ = nullptr;
+    size_t index_count_ = 0;
+    size_t index_stride_ = kBarFileIndexStride;
+    std::string symbol_;
+    std::string timeframe_;
+};
+
+} // namespace volarix4::core
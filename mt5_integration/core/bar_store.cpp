@@ -0,0 +1,105 @@
+//=============================================================================
+//  core/bar_store.cpp
+//  Process-wide bar history per (symbol, timeframe) in SoA columns
+//=============================================================================
+#include "bar_store.h"
+
+namespace volarix4::core {
+
+bool BarSeries::Takes(long long timestamp) const
+{
+    return columns_.size() == first_ || timestamp > columns_.LastTime();
+}
+
+size_t BarSeries::Append(const OHLCVBar* bars, size_t count)
+{
+    size_t stored = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!Takes(bars[i].timestamp))
+            continue;
+        columns_.Append(bars[i]);
+        ++stored;
+    }
+    Trim();
+    return stored;
+}
+
+size_t BarSeries::Append(const BarColumns& columns)
+{
+    // Anything older than the newest max_bars would be trimmed right away
+    const BarColumns bars = columns.Tail(max_bars_);
+    size_t stored = 0;
+    for (size_t i = 0; i < bars.count; ++i)
+    {
+        if (!Takes(bars.time[i]))
+            continue;
+        columns_.Append(OHLCVBar{ bars.time[i], bars.open[i], bars.high[i], bars.low[i],
+                                  bars.close[i], (int)bars.volume[i] });
+        ++stored;
+    }
+    Trim();
+    return stored;
+}
+
+// Trim lazily: let up to max_bars dead bars pile up in front, then compact
+// once
+void BarSeries::Trim()
+{
+    size_t live = columns_.size() - first_;
+    if (live > max_bars_)
+        first_ += live - max_bars_;
+    if (first_ >= max_bars_) {
+        columns_.EraseFront(first_);
+        first_ = 0;
+    }
+}
+
+void BarSeries::Clear()
+{
+    columns_.Clear();
+    first_ = 0;
+}
+
+BarColumns BarSeries::View() const
+{
+    BarColumns all = columns_.View();
+    return all.Slice(first_, all.count - first_);
+}
+
+std::shared_ptr<BarSeries> BarStore::FindOrCreate(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<BarSeries>& slot = series_[key];
+    if (!slot)
+        slot = std::make_shared<BarSeries>(kDefaultMaxBars);
+    return slot;
+}
+
+size_t BarStore::Append(const std::string& key, const OHLCVBar* bars, size_t count)
+{
+    std::shared_ptr<BarSeries> series = FindOrCreate(key);
+    std::unique_lock<std::shared_mutex> lock(series->mutex_);
+    series->Append(bars, count);
+    return series->View().count;
+}
+
+size_t BarStore::Append(const std::string& key, const BarColumns& bars)
+{
+    std::shared_ptr<BarSeries> series = FindOrCreate(key);
+    std::unique_lock<std::shared_mutex> lock(series->mutex_);
+    series->Append(bars);
+    return series->View().count;
+}
+
+void BarStore::Clear(const std::string& key)
+{
+    std::shared_ptr<BarSeries> series = Find(key);
+    if (!series)
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(series->mutex_);
+    series->Clear();
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,122 @@
+//=============================================================================
+//  core/bar_store.h
+//  Process-wide bar history per (symbol, timeframe) in SoA columns
+//
+//  MT5 appends closed bars (AppendBars export); native features read the
+//  columns in place through Read(), under a shared lock, without copying.
+//  Appends only take bars newer than the newest stored one, so an EA can
+//  pass its whole window every candle and only the new bar is stored.
+//  The column allocations are 64-byte aligned, but old bars are dropped
+//  lazily from the front, so View() starts at an arbitrary bar - readers
+//  must not assume an aligned first element.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "bar.h"
+#include "bar_columns.h"
+
+namespace volarix4::core {
+
+class BarSeries
+{
+public:
+    explicit BarSeries(size_t max_bars) : max_bars_(max_bars) {}
+
+    // Append bars (oldest first) newer than the newest stored bar; returns
+    // the number stored. The oldest bars are dropped beyond max_bars (in
+    // batches, so the amortized cost per bar stays O(1)).
+    size_t Append(const OHLCVBar* bars, size_t count);
+
+    // Same from columns (e.g. a mapped bar file, see bar_file.h)
+    size_t Append(const BarColumns& bars);
+
+    void Clear();
+
+    size_t max_bars() const { return max_bars_; }
+
+    // Held under the caller's lock (see BarStore::Read). Starts at the
+    // oldest live bar, which need not be on a cache line.
+    BarColumns View() const;
+
+private:
+    friend class BarStore;
+
+    bool Takes(long long timestamp) const;
+    void Trim();
+
+    size_t max_bars_;
+    size_t first_ = 0;            // Index of the oldest live bar in columns_
+    ColumnBuffer columns_;
+    mutable std::shared_mutex mutex_;
+};
+
+class BarStore
+{
+public:
+    static constexpr size_t kDefaultMaxBars = 65536;
+
+    static BarStore& Instance()
+    {
+        static BarStore store;
+        return store;
+    }
+
+    static std::string Key(const std::string& symbol, const std::string& timeframe)
+    {
+        return symbol + "|" + timeframe;
+    }
+
+    // Append to the series (created on first use); returns the number of
+    // bars the series holds afterwards
+    size_t Append(const std::string& key, const OHLCVBar* bars, size_t count);
+    size_t Append(const std::string& key, const BarColumns& bars);
+
+    // Drop every bar of the series (e.g. after a history reload)
+    void Clear(const std::string& key);
+
+    // Run fn(const BarColumns&) on the series under a shared lock. Returns
+    // false (fn not called) for an unknown series.
+    template <typename Fn>
+    bool Read(const std::string& key, Fn&& fn) const
+    {
+        std::shared_ptr<BarSeries> series = Find(key);
+        if (!series)
+            return false;
+
+        std::shared_lock<std::shared_mutex> lock(series->mutex_);
+        fn(series->View());
+        return true;
+    }
+
+    size_t SeriesCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return series_.size();
+    }
+
+private:
+    BarStore() = default;
+    BarStore(const BarStore&) = delete;
+    BarStore& operator=(const BarStore&) = delete;
+
+    std::shared_ptr<BarSeries> FindOrCreate(const std::string& key);
+
+    std::shared_ptr<BarSeries> Find(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = series_.find(key);
+        return it != series_.end() ? it->second : nullptr;
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<BarSeries>> series_;
+};
+
+} // namespace volarix4::core
@@ -0,0 +1,182 @@
+//=============================================================================
+//  core/bar_validation.cpp
+//  Parity Contract bar validation (mirrors volarix4/utils/bar_validation.py)
+//=============================================================================
+#include "bar_validation.h"
+
+#include <cctype>
+#include <cstdio>
+
+namespace volarix4::core {
+
+namespace {
+
+struct TimeframePeriod
+{
+    const char* name;
+    long long seconds;
+};
+
+constexpr TimeframePeriod kTimeframes[] = {
+    { "M1", 60 }, { "M5", 300 }, { "M15", 900 }, { "M30", 1800 },
+    { "H1", 3600 }, { "H4", 14400 }, { "D1", 86400 }, { "W1", 604800 },
+};
+
+bool EqualsUpper(std::string_view text, const char* upper)
+{
+    size_t i = 0;
+    for (; i < text.size() && upper[i]; ++i)
+        if (std::toupper((unsigned char)text[i]) != upper[i])
+            return false;
+    return i == text.size() && upper[i] == '\0';
+}
+
+// Inverse of days_from_civil (Howard Hinnant's civil_from_days)
+void CivilFromDays(long long days, int& year, unsigned& month, unsigned& day)
+{
+    days += 719468;
+    const long long era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = (unsigned)(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = (int)(yoe + era * 400) + (month <= 2);
+}
+
+long long ToLocal(LocalTimeFn local_time, long long unix_time)
+{
+    return local_time ? local_time(unix_time) : unix_time;
+}
+
+} // namespace
+
+long long TimeframeSeconds(std::string_view timeframe)
+{
+    for (const TimeframePeriod& tf : kTimeframes)
+        if (EqualsUpper(timeframe, tf.name))
+            return tf.seconds;
+    return -1;
+}
+
+std::string FormatDateTime(long long wall_seconds)
+{
+    long long days = wall_seconds / 86400;
+    long long seconds = wall_seconds % 86400;
+    if (seconds < 0) {
+        seconds += 86400;
+        --days;
+    }
+
+    int year;
+    unsigned month, day;
+    CivilFromDays(days, year, month, day);
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%04d-%02u-%02u %02d:%02d:%02d", year, month, day,
+                  (int)(seconds / 3600), (int)(seconds / 60 % 60), (int)(seconds % 60));
+    return text;
+}
+
+namespace {
+
+// Shared by the packed and the columnar overloads; time_at(i) is bar i's time
+template <typename TimeAt>
+bool ValidateBarTimes(TimeAt time_at, size_t count, std::string_view timeframe,
+                      size_t min_bars, long long max_gap_multiplier,
+                      LocalTimeFn local_time, std::string* error)
+{
+    const std::string tf(timeframe);
+
+    long long tf_seconds = TimeframeSeconds(timeframe);
+    if (tf_seconds < 0) {
+        *error = "Invalid timeframe '" + tf + "'. Must be one of: ";
+        for (size_t i = 0; i < sizeof(kTimeframes) / sizeof(kTimeframes[0]); ++i) {
+            if (i > 0)
+                *error += ", ";
+            *error += kTimeframes[i].name;
+        }
+        return false;
+    }
+
+    // Rule 1: Minimum bar count
+    if (count < min_bars) {
+        *error = "Insufficient bars: got " + std::to_string(count) + ", required " +
+                 std::to_string(min_bars) + " for lookback. Parity Contract requires at least " +
+                 std::to_string(min_bars) + " closed bars.";
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const std::string index = std::to_string(i);
+
+        // Rule 2: No time == 0
+        if (time_at(i) == 0) {
+            *error = "Invalid bar at index " + index + ": time == 0. "
+                     "All bars must have valid timestamps.";
+            return false;
+        }
+
+        if (i == 0)
+            continue;
+
+        // Rule 3: Strictly increasing
+        long long prev_time = time_at(i - 1);
+        long long curr_time = time_at(i);
+        long long time_delta = curr_time - prev_time;
+
+        if (curr_time <= prev_time) {
+            *error = "Bars not strictly increasing at index " + index + ": "
+                     "bar[" + std::to_string(i - 1) + "].time=" + std::to_string(prev_time) +
+                     " (" + FormatDateTime(ToLocal(local_time, prev_time)) + "), "
+                     "bar[" + index + "].time=" + std::to_string(curr_time) +
+                     " (" + FormatDateTime(ToLocal(local_time, curr_time)) + "). "
+                     "Delta: " + std::to_string(time_delta) + " seconds. "
+                     "Bars must be ordered oldest \xE2\x86\x92 newest with no duplicates.";
+            return false;
+        }
+
+        // Rule 5: Timeframe alignment, gaps up to max_gap_multiplier periods
+        if (time_delta % tf_seconds != 0) {
+            *error = "Timeframe misalignment at index " + index + ": gap of " +
+                     std::to_string(time_delta) + " seconds is not a multiple of " +
+                     std::to_string(tf_seconds) + ". Expected multiples of " +
+                     std::to_string(tf_seconds) + " (" + tf + ") but got " +
+                     std::to_string(time_delta) + ".";
+            return false;
+        }
+
+        long long gap_multiplier = time_delta / tf_seconds;
+        if (gap_multiplier > max_gap_multiplier) {
+            *error = "Excessive gap at index " + index + ": gap of " +
+                     std::to_string(gap_multiplier) + " periods (" + std::to_string(time_delta) +
+                     " seconds) exceeds max allowed " + std::to_string(max_gap_multiplier) +
+                     " periods. This suggests missing data or discontinuous history.";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool ValidateBars(const OHLCVBar* bars, size_t count, std::string_view timeframe,
+                  size_t min_bars, long long max_gap_multiplier,
+                  LocalTimeFn local_time, std::string* error)
+{
+    return ValidateBarTimes([bars](size_t i) { return bars[i].timestamp; }, count, timeframe,
+                            min_bars, max_gap_multiplier, local_time, error);
+}
+
+bool ValidateBars(const long long* times, size_t count, std::string_view timeframe,
+                  size_t min_bars, long long max_gap_multiplier,
+                  LocalTimeFn local_time, std::string* error)
+{
+    return ValidateBarTimes([times](size_t i) { return times[i]; }, count, timeframe,
+                            min_bars, max_gap_multiplier, local_time, error);
+}
+
+} // namespace volarix4::core
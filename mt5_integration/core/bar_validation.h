@@ -0,0 +1,39 @@
+//=============================================================================
+//  core/bar_validation.h
+//  Parity Contract bar validation (mirrors volarix4/utils/bar_validation.py)
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "bar.h"
+
+namespace volarix4::core {
+
+// Maps a Unix timestamp to local wall-clock seconds since 1970-01-01. The
+// API formats and session-checks bar times with datetime.fromtimestamp(),
+// i.e. in the server's local time zone; nullptr means UTC.
+using LocalTimeFn = long long (*)(long long unix_time);
+
+// Period in seconds for M1 .. W1 (case-insensitive), or -1 if unknown
+long long TimeframeSeconds(std::string_view timeframe);
+
+// "YYYY-MM-DD HH:MM:SS" for wall-clock seconds (str(datetime))
+std::string FormatDateTime(long long wall_seconds);
+
+// normalize_and_validate_bars(): at least min_bars bars, no time == 0,
+// strictly increasing times, gaps a multiple of the timeframe period and
+// no longer than max_gap_multiplier periods. On failure returns false and
+// sets *error to the same message the API reports.
+bool ValidateBars(const OHLCVBar* bars, size_t count, std::string_view timeframe,
+                  size_t min_bars, long long max_gap_multiplier,
+                  LocalTimeFn local_time, std::string* error);
+
+// Same checks on a column of bar times (see bar_columns.h)
+bool ValidateBars(const long long* times, size_t count, std::string_view timeframe,
+                  size_t min_bars, long long max_gap_multiplier,
+                  LocalTimeFn local_time, std::string* error);
+
+} // namespace volarix4::core
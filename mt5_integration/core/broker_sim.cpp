@@ -0,0 +1,222 @@
+//=============================================================================
+//  core/broker_sim.cpp
+//  Fill and exit simulation with costs (mirrors
+//  volarix4_backtest/broker_sim.py)
+//=============================================================================
+#include "broker_sim.h"
+
+#include <algorithm>
+
+namespace volarix4::core {
+
+const char* ExitReasonName(ExitReason reason)
+{
+    switch (reason) {
+        case kExitTp1: return "TP1";
+        case kExitTp2: return "TP2";
+        case kExitTp3: return "TP3";
+        case kExitSl: return "SL";
+        case kExitManual: return "MANUAL";
+        default: return "";
+    }
+}
+
+CostModel CostModelFor(const StrategyParams& params, double pip_value)
+{
+    CostModel costs;
+    costs.spreadPips = params.spreadPips;
+    costs.slippagePips = params.slippagePips;
+    costs.commissionPerSidePerLot = params.commissionPerSidePerLot;
+    costs.usdPerPipPerLot = params.usdPerPipPerLot;
+    costs.pipValue = pip_value;
+    return costs;
+}
+
+Trade BrokerSimulator::OpenTrade(SignalType direction, long long entry_time, double entry_price,
+                                 double lot_size, const SignalResponse& signal) const
+{
+    Trade trade;
+    trade.direction = direction;
+    trade.entryTime = entry_time;
+    trade.entryPrice = direction == kSignalBuy
+        ? entry_price + (costs_.slippagePips * costs_.pipValue)
+        : entry_price - (costs_.slippagePips * costs_.pipValue);
+    trade.lotSize = lot_size;
+    trade.confidence = signal.confidence;
+    trade.reason = signal.reason;
+
+    trade.sl = signal.sl;
+    trade.tp1 = signal.tp1;
+    trade.tp2 = signal.tp2;
+    trade.tp3 = signal.tp3;
+    trade.tp1Percent = signal.tp1Percent;
+    trade.tp2Percent = signal.tp2Percent;
+    trade.tp3Percent = signal.tp3Percent;
+
+    // Recorded only; exit commission is added as lots are closed
+    trade.entryCostUsd = (costs_.spreadPips + costs_.slippagePips) * lot_size * costs_.usdPerPipPerLot;
+    trade.commissionUsd = costs_.commissionPerSidePerLot * lot_size;
+
+    trade.remainingLots = lot_size;
+    return trade;
+}
+
+bool BrokerSimulator::UpdateTrade(Trade& trade, long long time, double high, double low,
+                                  double close) const
+{
+    (void)close;
+    if (trade.IsClosed())
+        return false;
+
+    bool updated = false;
+    if (trade.direction == kSignalBuy) {
+        if (low <= trade.sl) {
+            CloseTrade(trade, time, trade.sl, kExitSl);
+            return true;
+        }
+        if (!trade.tp3Hit && high >= trade.tp3) {
+            PartialClose(trade, time, trade.tp3, kExitTp3);
+            updated = true;
+        }
+        if (!trade.tp2Hit && high >= trade.tp2) {
+            PartialClose(trade, time, trade.tp2, kExitTp2);
+            updated = true;
+        }
+        if (!trade.tp1Hit && high >= trade.tp1) {
+            PartialClose(trade, time, trade.tp1, kExitTp1);
+            updated = true;
+        }
+    }
+    else {
+        if (high >= trade.sl) {
+            CloseTrade(trade, time, trade.sl, kExitSl);
+            return true;
+        }
+        if (!trade.tp3Hit && low <= trade.tp3) {
+            PartialClose(trade, time, trade.tp3, kExitTp3);
+            updated = true;
+        }
+        if (!trade.tp2Hit && low <= trade.tp2) {
+            PartialClose(trade, time, trade.tp2, kExitTp2);
+            updated = true;
+        }
+        if (!trade.tp1Hit && low <= trade.tp1) {
+            PartialClose(trade, time, trade.tp1, kExitTp1);
+            updated = true;
+        }
+    }
+    return updated;
+}
+
+bool BrokerSimulator::UpdateTradeAtPrice(Trade& trade, long long time, double price,
+                                         bool continuous) const
+{
+    if (trade.IsClosed())
+        return false;
+
+    const bool is_buy = trade.direction == kSignalBuy;
+    auto fill = [&](double level) { return continuous ? level : price; };
+    if (is_buy ? price <= trade.sl : price >= trade.sl) {
+        CloseTrade(trade, time, fill(trade.sl), kExitSl);
+        return true;
+    }
+
+    bool updated = false;
+    auto take = [&](bool hit, double level, ExitReason reason) {
+        if (!hit && (is_buy ? price >= level : price <= level)) {
+            PartialClose(trade, time, fill(level), reason);
+            updated = true;
+        }
+    };
+    take(trade.tp3Hit, trade.tp3, kExitTp3);
+    take(trade.tp2Hit, trade.tp2, kExitTp2);
+    take(trade.tp1Hit, trade.tp1, kExitTp1);
+    return updated;
+}
+
+double BrokerSimulator::ExitFill(const Trade& trade, double exit_price) const
+{
+    return trade.direction == kSignalBuy
+        ? exit_price - (costs_.slippagePips * costs_.pipValue)
+        : exit_price + (costs_.slippagePips * costs_.pipValue);
+}
+
+double BrokerSimulator::ExitPips(const Trade& trade, double actual_exit) const
+{
+    return trade.direction == kSignalBuy
+        ? (actual_exit - trade.entryPrice) / costs_.pipValue
+        : (trade.entryPrice - actual_exit) / costs_.pipValue;
+}
+
+void BrokerSimulator::PartialClose(Trade& trade, long long exit_time, double exit_price,
+                                   ExitReason reason) const
+{
+    double lots_to_close;
+    if (reason == kExitTp1) {
+        lots_to_close = trade.lotSize * trade.tp1Percent;
+        trade.tp1Hit = true;
+        trade.tp1ExitTime = exit_time;
+    }
+    else if (reason == kExitTp2) {
+        lots_to_close = trade.lotSize * trade.tp2Percent;
+        trade.tp2Hit = true;
+        trade.tp2ExitTime = exit_time;
+    }
+    else if (reason == kExitTp3) {
+        lots_to_close = trade.lotSize * trade.tp3Percent;
+        trade.tp3Hit = true;
+        trade.tp3ExitTime = exit_time;
+    }
+    else {
+        return;
+    }
+
+    lots_to_close = std::min(lots_to_close, trade.remainingLots);
+    if (lots_to_close <= 0)
+        return;
+
+    const double actual_exit = ExitFill(trade, exit_price);
+    const double gross_pnl = ExitPips(trade, actual_exit) * lots_to_close * costs_.usdPerPipPerLot;
+    const double exit_cost = costs_.slippagePips * lots_to_close * costs_.usdPerPipPerLot;
+    const double commission_exit = costs_.commissionPerSidePerLot * lots_to_close;
+    const double net_pnl = gross_pnl - exit_cost - commission_exit;
+
+    trade.remainingLots -= lots_to_close;
+    trade.closedLots += lots_to_close;
+    trade.grossPnlUsd += gross_pnl;
+    trade.exitCostUsd += exit_cost;
+    trade.commissionUsd += commission_exit;
+    trade.netPnlUsd += net_pnl;
+
+    if (trade.remainingLots <= 0.0) {
+        trade.exitTime = exit_time;
+        trade.exitReason = reason;
+        trade.exitPrice = actual_exit;
+        trade.remainingLots = 0.0;
+    }
+}
+
+void BrokerSimulator::CloseTrade(Trade& trade, long long exit_time, double exit_price,
+                                 ExitReason reason) const
+{
+    if (trade.remainingLots <= 0)
+        return;
+
+    const double actual_exit = ExitFill(trade, exit_price);
+    const double gross_pnl = ExitPips(trade, actual_exit) * trade.remainingLots * costs_.usdPerPipPerLot;
+    const double exit_cost = costs_.slippagePips * trade.remainingLots * costs_.usdPerPipPerLot;
+    const double commission_exit = costs_.commissionPerSidePerLot * trade.remainingLots;
+    const double net_pnl = gross_pnl - exit_cost - commission_exit;
+
+    trade.closedLots += trade.remainingLots;
+    trade.remainingLots = 0.0;
+    trade.grossPnlUsd += gross_pnl;
+    trade.exitCostUsd += exit_cost;
+    trade.commissionUsd += commission_exit;
+    trade.netPnlUsd += net_pnl;
+    trade.exitTime = exit_time;
+    trade.exitReason = reason;
+    trade.exitPrice = actual_exit;
+}
+
+} // namespace volarix4::core
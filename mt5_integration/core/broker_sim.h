@@ -0,0 +1,112 @@
+//=============================================================================
+//  core/broker_sim.h
+//  Fill and exit simulation with costs (mirrors
+//  volarix4_backtest/broker_sim.py)
+//
+//  Same arithmetic in the same order as the Python simulator, so trades and
+//  P&L come out bit-identical: entry slippage and the entry commission are
+//  recorded on the trade but - like the Python version - not deducted from
+//  its net P&L; each exit pays its own slippage and commission.
+//=============================================================================
+#pragma once
+
+#include <string>
+
+#include "signal_pipeline.h"
+
+namespace volarix4::core {
+
+enum ExitReason : int
+{
+    kExitNone = 0,
+    kExitTp1,
+    kExitTp2,
+    kExitTp3,
+    kExitSl,
+    kExitManual
+};
+
+// "TP1" .. "MANUAL" (ExitReason.value); "" for kExitNone
+const char* ExitReasonName(ExitReason reason);
+
+struct CostModel
+{
+    double spreadPips;
+    double slippagePips;
+    double commissionPerSidePerLot;
+    double usdPerPipPerLot;
+    double pipValue;
+};
+
+// Cost model of the strategy parameters sent to the pipeline
+CostModel CostModelFor(const StrategyParams& params, double pip_value);
+
+// Times are bar open times (Unix seconds; a real-tick exit has the tick's
+// second); 0 = not set
+struct Trade
+{
+    SignalType direction = kSignalHold;
+    long long entryTime = 0;
+    double entryPrice = 0.0;          // After entry slippage
+    double lotSize = 0.0;
+    double confidence = 0.0;
+    std::string reason;
+
+    double sl = 0.0;
+    double tp1 = 0.0, tp2 = 0.0, tp3 = 0.0;
+    double tp1Percent = 0.0, tp2Percent = 0.0, tp3Percent = 0.0;
+
+    double entryCostUsd = 0.0;
+    double exitCostUsd = 0.0;
+    double commissionUsd = 0.0;
+
+    double remainingLots = 0.0;
+    double closedLots = 0.0;
+
+    long long exitTime = 0;
+    ExitReason exitReason = kExitNone;
+    double exitPrice = 0.0;
+
+    bool tp1Hit = false, tp2Hit = false, tp3Hit = false;
+    long long tp1ExitTime = 0, tp2ExitTime = 0, tp3ExitTime = 0;
+
+    double grossPnlUsd = 0.0;
+    double netPnlUsd = 0.0;
+
+    bool IsClosed() const { return remainingLots <= 0.0; }
+};
+
+class BrokerSimulator
+{
+public:
+    explicit BrokerSimulator(const CostModel& costs) : costs_(costs) {}
+
+    // open_trade(): fill at entry_price plus slippage against the trade, SL
+    // and TPs as the signal gave them
+    Trade OpenTrade(SignalType direction, long long entry_time, double entry_price,
+                    double lot_size, const SignalResponse& signal) const;
+
+    // update_trade(): SL first (closes everything), then TP3, TP2, TP1 -
+    // several TPs can fill on the same bar. True if anything was closed.
+    bool UpdateTrade(Trade& trade, long long time, double high, double low, double close) const;
+
+    // The same checks against one price of a tick path (tick_path.h). A
+    // level the price reached is filled at the level when the path moved
+    // there continuously (synthetic path points after the bar's open), and
+    // at the price itself after a jump (a bar's open, a real tick).
+    bool UpdateTradeAtPrice(Trade& trade, long long time, double price, bool continuous) const;
+
+    // _close_trade(): close the remaining lots at exit_price less slippage
+    void CloseTrade(Trade& trade, long long exit_time, double exit_price, ExitReason reason) const;
+
+    const CostModel& Costs() const { return costs_; }
+
+private:
+    void PartialClose(Trade& trade, long long exit_time, double exit_price, ExitReason reason) const;
+    double ExitFill(const Trade& trade, double exit_price) const;
+    double ExitPips(const Trade& trade, double actual_exit) const;
+
+    CostModel costs_;
+};
+
+} // namespace volarix4::core
@@ -0,0 +1,249 @@
+//=============================================================================
+//  core/candle_kernels.cpp
+//  Vectorized rejection candle kernels (AVX2 with a scalar fallback)
+//=============================================================================
+#include "candle_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cpu_features.h"
+#include "helpers.h"
+
+#if defined(VOLARIX4_X86)
+#include <immintrin.h>
+#endif
+
+namespace volarix4::core {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+//  Scalar path (also handles the tail of the AVX2 loops)
+//
+//  Rejection tests are written as !(a < b) rather than a >= b to keep the
+//  Python semantics ("reject if a < b") for every input, NaN included.
+//-----------------------------------------------------------------------------
+void MetricsScalar(const double* open, const double* high, const double* low,
+                   const double* close, size_t first, size_t count,
+                   const RejectionParams& params, CandleMetricsColumns& out)
+{
+    for (size_t i = first; i < count; ++i)
+    {
+        const double o = open[i], h = high[i], l = low[i], c = close[i];
+
+        const double body = std::fabs(c - o);
+        const bool bullish = c > o;
+        const double upper = bullish ? h - c : h - o;
+        const double lower = bullish ? o - l : c - l;
+        const double max_wick = lower > upper ? lower : upper;
+        const double ratio = body > 0 ? max_wick / body : 0.0;
+        const double range = h - l;
+        const double position = range > 0 ? (c - l) / range : 0.5;
+
+        out.body[i] = body;
+        out.upperWick[i] = upper;
+        out.lowerWick[i] = lower;
+        out.wickBodyRatio[i] = ratio;
+        out.closePosition[i] = position;
+
+        const bool ratio_ok = !(ratio < params.minWickBodyRatio);
+        out.supportShape[i] = ratio_ok && !(lower < upper) &&
+                              !(position < params.minClosePositionBuy);
+        out.resistanceShape[i] = ratio_ok && !(upper < lower) &&
+                                 !(position > params.maxClosePositionSell);
+    }
+}
+
+int FirstLevelScalar(const LevelColumns& levels, size_t first, double low, double high,
+                     bool support_shape, bool resistance_shape, double threshold_price)
+{
+    for (size_t i = first; i < levels.size(); ++i)
+    {
+        if (levels.support[i] == 1.0) {
+            if (support_shape && !(std::fabs(low - levels.price[i]) > threshold_price))
+                return (int)i;
+        } else {
+            if (resistance_shape && !(std::fabs(high - levels.price[i]) > threshold_price))
+                return (int)i;
+        }
+    }
+    return -1;
+}
+
+#if defined(VOLARIX4_X86)
+
+//-----------------------------------------------------------------------------
+//  AVX2 path: 4 doubles per step, unaligned loads (columns may come from
+//  std::vector or from the aligned bar store)
+//-----------------------------------------------------------------------------
+VOLARIX4_TARGET_AVX2
+size_t MetricsAvx2(const double* open, const double* high, const double* low,
+                   const double* close, size_t count,
+                   const RejectionParams& params, CandleMetricsColumns& out)
+{
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d min_ratio = _mm256_set1_pd(params.minWickBodyRatio);
+    const __m256d min_buy = _mm256_set1_pd(params.minClosePositionBuy);
+    const __m256d max_sell = _mm256_set1_pd(params.maxClosePositionSell);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d o = _mm256_loadu_pd(open + i);
+        const __m256d h = _mm256_loadu_pd(high + i);
+        const __m256d l = _mm256_loadu_pd(low + i);
+        const __m256d c = _mm256_loadu_pd(close + i);
+
+        const __m256d body = _mm256_andnot_pd(sign_mask, _mm256_sub_pd(c, o));
+        const __m256d bullish = _mm256_cmp_pd(c, o, _CMP_GT_OQ);
+        const __m256d upper = _mm256_blendv_pd(_mm256_sub_pd(h, o), _mm256_sub_pd(h, c), bullish);
+        const __m256d lower = _mm256_blendv_pd(_mm256_sub_pd(c, l), _mm256_sub_pd(o, l), bullish);
+        const __m256d max_wick = _mm256_blendv_pd(upper, lower, _mm256_cmp_pd(lower, upper, _CMP_GT_OQ));
+
+        // Masked lanes (doji / zero range) take the Python defaults
+        const __m256d ratio = _mm256_and_pd(_mm256_div_pd(max_wick, body),
+                                            _mm256_cmp_pd(body, zero, _CMP_GT_OQ));
+        const __m256d range = _mm256_sub_pd(h, l);
+        const __m256d position = _mm256_blendv_pd(half, _mm256_div_pd(_mm256_sub_pd(c, l), range),
+                                                  _mm256_cmp_pd(range, zero, _CMP_GT_OQ));
+
+        _mm256_storeu_pd(&out.body[i], body);
+        _mm256_storeu_pd(&out.upperWick[i], upper);
+        _mm256_storeu_pd(&out.lowerWick[i], lower);
+        _mm256_storeu_pd(&out.wickBodyRatio[i], ratio);
+        _mm256_storeu_pd(&out.closePosition[i], position);
+
+        const __m256d ratio_ok = _mm256_cmp_pd(ratio, min_ratio, _CMP_NLT_UQ);
+        const __m256d support = _mm256_and_pd(ratio_ok, _mm256_and_pd(
+            _mm256_cmp_pd(lower, upper, _CMP_NLT_UQ), _mm256_cmp_pd(position, min_buy, _CMP_NLT_UQ)));
+        const __m256d resistance = _mm256_and_pd(ratio_ok, _mm256_and_pd(
+            _mm256_cmp_pd(upper, lower, _CMP_NLT_UQ), _mm256_cmp_pd(position, max_sell, _CMP_NGT_UQ)));
+
+        const int support_bits = _mm256_movemask_pd(support);
+        const int resistance_bits = _mm256_movemask_pd(resistance);
+        for (int k = 0; k < 4; ++k) {
+            out.supportShape[i + k] = (uint8_t)((support_bits >> k) & 1);
+            out.resistanceShape[i + k] = (uint8_t)((resistance_bits >> k) & 1);
+        }
+    }
+    return i;
+}
+
+VOLARIX4_TARGET_AVX2
+int FirstLevelAvx2(const LevelColumns& levels, double low, double high,
+                   bool support_shape, bool resistance_shape, double threshold_price,
+                   size_t* scanned)
+{
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d threshold = _mm256_set1_pd(threshold_price);
+    const __m256d low_v = _mm256_set1_pd(low);
+    const __m256d high_v = _mm256_set1_pd(high);
+    const __m256d support_on = support_shape ? _mm256_castsi256_pd(_mm256_set1_epi64x(-1)) : _mm256_setzero_pd();
+    const __m256d resistance_on = resistance_shape ? _mm256_castsi256_pd(_mm256_set1_epi64x(-1)) : _mm256_setzero_pd();
+
+    const size_t n = levels.size();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256d price = _mm256_loadu_pd(&levels.price[i]);
+        const __m256d is_support = _mm256_cmp_pd(_mm256_loadu_pd(&levels.support[i]), one, _CMP_EQ_OQ);
+
+        const __m256d low_near = _mm256_cmp_pd(
+            _mm256_andnot_pd(sign_mask, _mm256_sub_pd(low_v, price)), threshold, _CMP_NGT_UQ);
+        const __m256d high_near = _mm256_cmp_pd(
+            _mm256_andnot_pd(sign_mask, _mm256_sub_pd(high_v, price)), threshold, _CMP_NGT_UQ);
+
+        const __m256d hit = _mm256_or_pd(
+            _mm256_and_pd(_mm256_and_pd(is_support, support_on), low_near),
+            _mm256_and_pd(_mm256_andnot_pd(is_support, resistance_on), high_near));
+
+        const int bits = _mm256_movemask_pd(hit);
+        if (bits) {
+            for (int k = 0; k < 4; ++k)
+                if ((bits >> k) & 1)
+                    return (int)(i + k);
+        }
+    }
+    *scanned = i;
+    return -1;
+}
+
+#endif // VOLARIX4_X86
+
+} // namespace
+
+void ComputeCandleMetrics(const double* open, const double* high, const double* low,
+                          const double* close, size_t count, const RejectionParams& params,
+                          CandleMetricsColumns& out)
+{
+    out.Resize(count);
+
+    size_t done = 0;
+#if defined(VOLARIX4_X86)
+    if (HasAvx2())
+        done = MetricsAvx2(open, high, low, close, count, params, out);
+#endif
+    MetricsScalar(open, high, low, close, done, count, params, out);
+}
+
+int FirstRejectedLevel(const LevelColumns& levels, double low, double high,
+                       bool support_shape, bool resistance_shape, double threshold_price)
+{
+    if (!support_shape && !resistance_shape)
+        return -1;
+
+    size_t scanned = 0;
+#if defined(VOLARIX4_X86)
+    if (HasAvx2()) {
+        int found = FirstLevelAvx2(levels, low, high, support_shape, resistance_shape,
+                                   threshold_price, &scanned);
+        if (found >= 0)
+            return found;
+    }
+#endif
+    return FirstLevelScalar(levels, scanned, low, high, support_shape, resistance_shape,
+                            threshold_price);
+}
+
+std::optional<Rejection> FindRejectionCandle(const CandleMetricsColumns& metrics,
+                                             const double* low, const double* high,
+                                             const double* close, size_t end,
+                                             const LevelColumns& levels, double pip_value,
+                                             const RejectionParams& params)
+{
+    const size_t lookback = (size_t)(params.lookbackCandles > 0 ? params.lookbackCandles : 0);
+    if (levels.size() == 0 || end < lookback)
+        return std::nullopt;
+
+    const double threshold_price = params.maxDistancePips * pip_value;
+
+    for (size_t i = end; i-- > end - lookback;)
+    {
+        int k = FirstRejectedLevel(levels, low[i], high[i], metrics.supportShape[i] != 0,
+                                   metrics.resistanceShape[i] != 0, threshold_price);
+        if (k < 0)
+            continue;
+
+        const bool support = levels.support[k] == 1.0;
+        const double score = levels.score[k];
+        const double confidence = std::min((score / 100.0 + metrics.wickBodyRatio[i] / 10.0) / 2.0, 1.0);
+
+        Rejection rejection;
+        rejection.direction = support ? kDirectionBuy : kDirectionSell;
+        rejection.level = levels.price[k];
+        rejection.levelType = support ? kSupport : kResistance;
+        rejection.levelScore = score;
+        rejection.entry = close[i];
+        rejection.candleIndex = i;
+        rejection.confidence = RoundTo(confidence, 2);
+        return rejection;
+    }
+
+    return std::nullopt;
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,98 @@
+//=============================================================================
+//  core/candle_kernels.h
+//  Vectorized rejection candle kernels (AVX2 with a scalar fallback)
+//
+//  find_rejection_candle() costs (lookback candles x levels) row-by-row
+//  checks on every decision bar. Here the work is split in two passes that
+//  both run on structure-of-arrays data:
+//  - ComputeCandleMetrics: body / wicks / wick-body ratio / close position
+//    and the level-independent half of the rejection test (wick ratio,
+//    dominant wick, close position) for a whole bar column, 4 bars per step
+//  - FirstRejectedLevel: the touch-distance test of one candle against every
+//    level, 4 levels per step
+//  A backtest computes the metrics once for its whole history and each bar
+//  then costs one level pass for the few candles whose shape qualifies.
+//
+//  Both paths do the same IEEE operations in the same order, so results are
+//  bit-identical to CalculateCandleMetrics / IsSupportRejection.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "rejection.h"
+#include "sr_levels.h"
+
+namespace volarix4::core {
+
+// Per-bar metrics, one column per field. Resize() keeps capacity, so a
+// reused instance does not allocate once it has grown to the window size.
+struct CandleMetricsColumns
+{
+    std::vector<double> body;
+    std::vector<double> upperWick;
+    std::vector<double> lowerWick;
+    std::vector<double> wickBodyRatio;
+    std::vector<double> closePosition;
+    std::vector<uint8_t> supportShape;      // Wick/close half of IsSupportRejection
+    std::vector<uint8_t> resistanceShape;   // Wick/close half of IsResistanceRejection
+
+    size_t size() const { return body.size(); }
+
+    void Resize(size_t count)
+    {
+        body.resize(count);
+        upperWick.resize(count);
+        lowerWick.resize(count);
+        wickBodyRatio.resize(count);
+        closePosition.resize(count);
+        supportShape.resize(count);
+        resistanceShape.resize(count);
+    }
+};
+
+// S/R levels as columns for the level pass (original order kept)
+struct LevelColumns
+{
+    std::vector<double> price;
+    std::vector<double> score;
+    std::vector<double> support;            // 1.0 support, 0.0 resistance
+
+    size_t size() const { return price.size(); }
+
+    void Assign(const std::vector<SRLevel>& levels)
+    {
+        price.resize(levels.size());
+        score.resize(levels.size());
+        support.resize(levels.size());
+        for (size_t i = 0; i < levels.size(); ++i) {
+            price[i] = levels[i].level;
+            score[i] = levels[i].score;
+            support[i] = levels[i].type == kSupport ? 1.0 : 0.0;
+        }
+    }
+};
+
+// Metrics and shape flags for bars [0, count) of the given columns
+void ComputeCandleMetrics(const double* open, const double* high, const double* low,
+                          const double* close, size_t count, const RejectionParams& params,
+                          CandleMetricsColumns& out);
+
+// Index of the first level the candle rejects (support levels tested with
+// the low when support_shape is set, resistance levels with the high when
+// resistance_shape is set), or -1
+int FirstRejectedLevel(const LevelColumns& levels, double low, double high,
+                       bool support_shape, bool resistance_shape, double threshold_price);
+
+// find_rejection_candle() over precomputed metrics: candles [end - lookback,
+// end), most recent first. metrics, low, high and close are indexed alike.
+std::optional<Rejection> FindRejectionCandle(const CandleMetricsColumns& metrics,
+                                             const double* low, const double* high,
+                                             const double* close, size_t end,
+                                             const LevelColumns& levels, double pip_value,
+                                             const RejectionParams& params = RejectionParams());
+
+} // namespace volarix4::core
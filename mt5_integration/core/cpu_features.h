@@ -0,0 +1,56 @@
+//=============================================================================
+//  core/cpu_features.h
+//  Runtime CPU feature detection for the SIMD kernels
+//
+//  Kernels are compiled for AVX2 per function (no global /arch:AVX2 or
+//  -mavx2), so the DLL still loads on older CPUs and picks the scalar path.
+//=============================================================================
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define VOLARIX4_X86 1
+#endif
+
+#if defined(VOLARIX4_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Marks a function compiled with AVX2 enabled (MSVC accepts the intrinsics
+// without a flag)
+#if defined(VOLARIX4_X86) && (defined(__GNUC__) || defined(__clang__))
+#define VOLARIX4_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define VOLARIX4_TARGET_AVX2
+#endif
+
+namespace volarix4::core {
+
+// CPU and OS (saved YMM state) support AVX2; evaluated once
+inline bool HasAvx2()
+{
+#if defined(VOLARIX4_X86) && defined(_MSC_VER)
+    static const bool supported = [] {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+    return supported;
+#elif defined(VOLARIX4_X86) && (defined(__GNUC__) || defined(__clang__))
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,127 @@
+//=============================================================================
+//  core/grid_search.cpp
+//  Parameter grid search over the native walk-forward (mirrors
+//  volarix4_backtest/grid_search.py)
+//=============================================================================
+#include "grid_search.h"
+
+#include <limits>
+#include <mutex>
+
+#include "work_stealing_pool.h"
+
+namespace volarix4::core {
+
+bool SetBacktestParam(BacktestConfig* config, std::string_view name, double value)
+{
+    StrategyParams& params = config->params;
+    if (name == "min_confidence")                      params.minConfidence = value;
+    else if (name == "broken_level_cooldown_hours")    params.brokenLevelCooldownHours = value;
+    else if (name == "broken_level_break_pips")        params.brokenLevelBreakPips = value;
+    else if (name == "min_edge_pips")                  params.minEdgePips = value;
+    else if (name == "spread_pips")                    params.spreadPips = value;
+    else if (name == "slippage_pips")                  params.slippagePips = value;
+    else if (name == "commission_per_side_per_lot")    params.commissionPerSidePerLot = value;
+    else if (name == "usd_per_pip_per_lot")            params.usdPerPipPerLot = value;
+    else if (name == "lot_size")                       params.lotSize = value;
+    else if (name == "lookback_bars")                  config->lookbackBars = (size_t)value;
+    else if (name == "warmup_bars")                    config->warmupBars = (size_t)value;
+    else if (name == "initial_balance_usd")            config->initialBalanceUsd = value;
+    else return false;
+    return true;
+}
+
+size_t GridCombinationCount(const std::vector<GridAxis>& grid)
+{
+    size_t count = 1;
+    for (const GridAxis& axis : grid)
+        count *= axis.values.size();
+    return count;
+}
+
+std::vector<size_t> GridCombination(const std::vector<GridAxis>& grid, size_t index)
+{
+    std::vector<size_t> choice(grid.size());
+    for (size_t a = grid.size(); a-- > 0;) {
+        const size_t size = grid[a].values.size();
+        choice[a] = index % size;
+        index /= size;
+    }
+    return choice;
+}
+
+bool RunGridSearch(const BarColumns& bars, const BacktestConfig& base,
+                   const std::vector<GridAxis>& grid, const GridSearchSettings& settings,
+                   const GridResultFn& on_result, std::vector<GridResult>* results,
+                   std::string* error, size_t* feature_computations)
+{
+    BacktestConfig probe = base;
+    for (const GridAxis& axis : grid) {
+        if (!SetBacktestParam(&probe, axis.name, 0.0)) {
+            *error = "Grid parameter not supported by the native backtest: " + axis.name;
+            return false;
+        }
+    }
+
+    const size_t total = GridCombinationCount(grid);
+    results->assign(total, GridResult());
+
+    PipelineFeatureCache features(bars, base.symbol, base.timeframe);
+    std::mutex report_mutex;
+    size_t completed = 0;
+
+    WorkStealingPool::Run(total, settings.workers, [&](size_t index, size_t) {
+        GridResult& result = (*results)[index];
+        result.index = index;
+        result.choice = GridCombination(grid, index);
+
+        BacktestConfig config = base;
+        for (size_t a = 0; a < grid.size(); ++a)
+            SetBacktestParam(&config, grid[a].name, grid[a].values[result.choice[a]]);
+
+        SignalCooldownTracker cooldown;
+        BacktestOptions options;
+        options.cooldown = &cooldown;
+        options.features = &features;
+        options.ticks = settings.ticks;
+
+        WalkForwardResult walk_forward;
+        result.ok = RunWalkForward(bars, config, settings.testYears, settings.trainYearsLookback,
+                                   settings.historyWindows, options, &walk_forward, &result.error);
+        if (result.ok)
+            result.aggregate = std::move(walk_forward.aggregate);
+
+        std::lock_guard<std::mutex> lock(report_mutex);
+        ++completed;
+        if (on_result)
+            on_result(result, completed, total);
+    });
+
+    if (feature_computations)
+        *feature_computations = features.Computations();
+    return true;
+}
+
+double GridObjective(const WalkForwardAggregate& aggregate, std::string_view objective)
+{
+    // Keys of the aggregate with and without trades
+    if (objective == "total_trades")            return (double)aggregate.totalTrades;
+    if (objective == "total_years")             return (double)aggregate.totalYears;
+    if (objective == "avg_trades_per_year")     return aggregate.avgTradesPerYear;
+    if (objective == "aggregate_net_profit")    return aggregate.netProfitUsd;
+    if (objective == "aggregate_return_pct")    return aggregate.returnPct;
+
+    const bool listed = aggregate.totalTrades > 0 || aggregate.totalYears == 0;
+    double value;
+    if (objective == "winning_trades")               value = (double)aggregate.winningTrades;
+    else if (objective == "losing_trades")           value = (double)aggregate.losingTrades;
+    else if (objective == "win_rate")                value = aggregate.winRate;
+    else if (objective == "aggregate_gross_profit")  value = aggregate.grossProfitUsd;
+    else if (objective == "aggregate_gross_loss")    value = aggregate.grossLossUsd;
+    else if (objective == "profit_factor")           value = aggregate.profitFactor;
+    else if (objective == "avg_net_profit_per_year") value = aggregate.avgNetProfitPerYear;
+    else return -std::numeric_limits<double>::infinity();
+    return listed ? value : -std::numeric_limits<double>::infinity();
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,79 @@
+//=============================================================================
+//  core/grid_search.h
+//  Parameter grid search over the native walk-forward (mirrors
+//  volarix4_backtest/grid_search.py)
+//
+//  Every combination of the grid is scored by RunWalkForward on the same
+//  read-only bar columns - loaded once, shared by all workers - on a
+//  work-stealing pool. One PipelineFeatureCache serves the whole search, so
+//  each signal window's trend and S/R levels are detected once however many
+//  combinations evaluate it; only the parameter-dependent steps (broken
+//  levels onwards) run per combination.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "backtest_engine.h"
+#include "bar_columns.h"
+
+namespace volarix4::core {
+
+// One grid parameter (a config.py field) and the values to try
+struct GridAxis
+{
+    std::string name;
+    std::vector<double> values;
+    std::vector<std::string> labels;    // Values as written in the config
+};
+
+// Set a config.py field a grid may vary (strategy and cost parameters,
+// lookback_bars, warmup_bars, initial_balance_usd); false if name is not one
+bool SetBacktestParam(BacktestConfig* config, std::string_view name, double value);
+
+// Product of the axis sizes
+size_t GridCombinationCount(const std::vector<GridAxis>& grid);
+
+// Value index per axis of combination `index`, in itertools.product order
+// (last axis fastest)
+std::vector<size_t> GridCombination(const std::vector<GridAxis>& grid, size_t index);
+
+struct GridSearchSettings
+{
+    std::vector<int> testYears;
+    int trainYearsLookback = 2;
+    bool historyWindows = true;         // use_optimized_mode
+    size_t workers = 1;
+    const TickColumns* ticks = nullptr; // Real ticks for kExitTicks
+};
+
+struct GridResult
+{
+    size_t index = 0;                   // Combination index
+    std::vector<size_t> choice;         // Value index per axis
+    bool ok = false;
+    std::string error;                  // Why the walk-forward failed
+    WalkForwardAggregate aggregate;
+};
+
+// Called once per finished combination, in completion order, never
+// concurrently
+using GridResultFn = std::function<void(const GridResult& result, size_t completed, size_t total)>;
+
+// Evaluate every combination (each with its own signal cooldown, as in a
+// fresh API process); results come back in combination order. False with
+// *error if a grid parameter is unknown.
+bool RunGridSearch(const BarColumns& bars, const BacktestConfig& base,
+                   const std::vector<GridAxis>& grid, const GridSearchSettings& settings,
+                   const GridResultFn& on_result, std::vector<GridResult>* results,
+                   std::string* error, size_t* feature_computations = nullptr);
+
+// The aggregate metric named objective (walk_forward.py's key names);
+// -inf for an unknown name or one the aggregate leaves out without trades
+double GridObjective(const WalkForwardAggregate& aggregate, std::string_view objective);
+
+} // namespace volarix4::core
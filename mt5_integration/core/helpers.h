@@ -0,0 +1,125 @@
+//=============================================================================
+//  core/helpers.h
+//  Pip, rounding and number formatting helpers (mirrors
+//  volarix4/utils/helpers.py)
+//=============================================================================
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <string_view>
+
+namespace volarix4::core {
+
+// 0.01 for JPY pairs, 0.0001 for everything else
+inline double CalculatePipValue(std::string_view symbol)
+{
+    for (size_t i = 0; i + 3 <= symbol.size(); ++i) {
+        if ((symbol[i] == 'J' || symbol[i] == 'j') &&
+            (symbol[i + 1] == 'P' || symbol[i + 1] == 'p') &&
+            (symbol[i + 2] == 'Y' || symbol[i + 2] == 'y'))
+            return 0.01;
+    }
+    return 0.0001;
+}
+
+inline double PipsToPrice(double pips, double pip_value) { return pips * pip_value; }
+inline double PriceToPips(double price_diff, double pip_value) { return price_diff / pip_value; }
+
+// Python round(value, decimals): round the exact binary value half-to-even
+// in decimal, then take the nearest double. Goes through to_chars/from_chars
+// so results are bit-identical to the Python pipeline - use on outputs, not
+// in inner loops.
+inline double RoundTo(double value, int decimals)
+{
+    if (!std::isfinite(value))
+        return value;
+
+    char digits[64];
+    auto written = std::to_chars(digits, digits + sizeof(digits), value,
+                                 std::chars_format::fixed, decimals);
+    if (written.ec != std::errc())
+        return value;
+
+    double rounded = value;
+    std::from_chars(digits, written.ptr, rounded);
+    return rounded;
+}
+
+// Python f"{value:.{decimals}f}" (exact binary value, half-to-even)
+inline void AppendFixed(std::string& out, double value, int decimals)
+{
+    char digits[64];
+    auto written = std::to_chars(digits, digits + sizeof(digits), value,
+                                 std::chars_format::fixed, decimals);
+    if (written.ec == std::errc())
+        out.append(digits, written.ptr);
+}
+
+// Python repr(float) / str(float), which is also how the API's JSON encoder
+// writes floats: shortest round-trip digits, scientific notation only when
+// the decimal exponent is below -4 or at least 16, and integral values keep
+// a trailing ".0" (80.0, 1e-05, 1e+16)
+inline void AppendPyRepr(std::string& out, double value)
+{
+    if (!std::isfinite(value)) {
+        out += std::isnan(value) ? "nan" : (value > 0 ? "inf" : "-inf");
+        return;
+    }
+
+    char buffer[32];
+    auto written = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                 std::chars_format::scientific);
+    std::string_view sci(buffer, (size_t)(written.ptr - buffer));
+
+    size_t e = sci.find('e');
+    std::string_view mantissa = sci.substr(0, e);
+    std::string_view exp_text = sci.substr(e + 1);
+    if (!exp_text.empty() && exp_text[0] == '+')
+        exp_text.remove_prefix(1);
+    int exponent = 0;
+    std::from_chars(exp_text.data(), exp_text.data() + exp_text.size(), exponent);
+
+    if (!mantissa.empty() && mantissa[0] == '-') {
+        out += '-';
+        mantissa.remove_prefix(1);
+    }
+
+    // Significant digits without the decimal point
+    char digits[24];
+    size_t length = 0;
+    for (char c : mantissa)
+        if (c != '.')
+            digits[length++] = c;
+
+    if (exponent < -4 || exponent >= 16) {
+        out += digits[0];
+        if (length > 1) {
+            out += '.';
+            out.append(digits + 1, length - 1);
+        }
+        out += exponent < 0 ? "e-" : "e+";
+        int magnitude = exponent < 0 ? -exponent : exponent;
+        if (magnitude < 10)
+            out += '0';
+        out += std::to_string(magnitude);
+    } else if (exponent < 0) {
+        out += "0.";
+        out.append((size_t)(-exponent - 1), '0');
+        out.append(digits, length);
+    } else {
+        size_t integer_digits = (size_t)exponent + 1;
+        if (length <= integer_digits) {
+            out.append(digits, length);
+            out.append(integer_digits - length, '0');
+            out += ".0";
+        } else {
+            out.append(digits, integer_digits);
+            out += '.';
+            out.append(digits + integer_digits, length - integer_digits);
+        }
+    }
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,195 @@
+//=============================================================================
+//  core/htf_context.cpp
+//  Higher-timeframe context built from the execution bars already held in
+//  the DLL
+//=============================================================================
+#include "htf_context.h"
+
+#include <algorithm>
+#include <climits>
+
+#include "bar_validation.h"
+#include "helpers.h"
+
+namespace volarix4::core {
+
+namespace {
+
+constexpr long long kWeekSeconds = 604800;
+constexpr long long kSundayOffset = 3 * 86400;   // 1970-01-01 was a Thursday
+constexpr int kContextEmaFast = 20;
+constexpr int kContextEmaSlow = 50;
+
+} // namespace
+
+long long HtfBucketStart(long long unix_time, long long context_seconds)
+{
+    const long long offset = context_seconds == kWeekSeconds ? kSundayOffset : 0;
+    long long shifted = unix_time - offset;
+    long long bucket = shifted / context_seconds;
+    if (shifted % context_seconds < 0)
+        --bucket;
+    return bucket * context_seconds + offset;
+}
+
+//=============================================================================
+//  HtfResampler
+//=============================================================================
+HtfResampler::HtfResampler(long long exec_seconds, long long context_seconds, size_t max_bars)
+    : exec_seconds_(exec_seconds), context_seconds_(context_seconds), max_bars_(max_bars)
+{
+}
+
+void HtfResampler::Clear()
+{
+    closed_.Clear();
+    first_ = 0;
+    has_forming_ = false;
+    skip_forming_ = false;
+    forming_volume_ = 0.0;
+    last_exec_time_ = 0;
+}
+
+void HtfResampler::Update(const BarColumns& exec)
+{
+    if (exec.count == 0)
+        return;
+    if (exec.time[exec.count - 1] < last_exec_time_)
+        Clear();
+
+    // Only the bars appended since the last call are folded
+    const long long* start = std::upper_bound(exec.time, exec.time + exec.count, last_exec_time_);
+    for (size_t i = (size_t)(start - exec.time); i < exec.count; ++i)
+        Fold(exec, i);
+
+    // The forming candle is complete once its last execution bar has closed
+    if (has_forming_ && last_exec_time_ + exec_seconds_ >= forming_.timestamp + context_seconds_)
+        CloseForming();
+}
+
+void HtfResampler::Fold(const BarColumns& exec, size_t index)
+{
+    const long long time = exec.time[index];
+    const long long bucket = HtfBucketStart(time, context_seconds_);
+
+    if (has_forming_ && bucket != forming_.timestamp)
+        CloseForming();
+
+    if (!has_forming_) {
+        // The very first candle only counts if it starts at its open time
+        skip_forming_ = closed_.empty() && last_exec_time_ == 0 && time != bucket;
+        forming_.timestamp = bucket;
+        forming_.open = exec.open[index];
+        forming_.high = exec.high[index];
+        forming_.low = exec.low[index];
+        forming_.close = exec.close[index];
+        forming_volume_ = exec.volume[index];
+        has_forming_ = true;
+    } else {
+        forming_.high = std::max(forming_.high, exec.high[index]);
+        forming_.low = std::min(forming_.low, exec.low[index]);
+        forming_.close = exec.close[index];
+        forming_volume_ += exec.volume[index];
+    }
+    last_exec_time_ = time;
+}
+
+void HtfResampler::CloseForming()
+{
+    has_forming_ = false;
+    if (skip_forming_) {
+        skip_forming_ = false;
+        return;
+    }
+
+    forming_.volume = (int)std::min(forming_volume_, (double)INT_MAX);
+    closed_.Append(forming_);
+
+    // Trim like BarSeries: let dead candles pile up, then compact once
+    size_t live = closed_.size() - first_;
+    if (live > max_bars_)
+        first_ += live - max_bars_;
+    if (first_ >= max_bars_) {
+        closed_.EraseFront(first_);
+        first_ = 0;
+    }
+}
+
+//=============================================================================
+//  HtfContextCache
+//=============================================================================
+std::shared_ptr<const HtfContext> HtfContextCache::Get(std::string_view symbol,
+                                                       std::string_view exec_timeframe,
+                                                       std::string_view context_timeframe,
+                                                       const BarColumns& exec,
+                                                       size_t context_bars)
+{
+    const long long exec_seconds = TimeframeSeconds(exec_timeframe);
+    const long long context_seconds = TimeframeSeconds(context_timeframe);
+    if (exec_seconds <= 0 || context_seconds <= exec_seconds || context_seconds % exec_seconds != 0)
+        return nullptr;
+
+    std::shared_ptr<Entry> entry;
+    {
+        std::string key = Key(std::string(symbol), std::string(exec_timeframe),
+                              std::string(context_timeframe));
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_ptr<Entry>& slot = entries_[key];
+        if (!slot)
+            slot = std::make_shared<Entry>(exec_seconds, context_seconds);
+        entry = slot;
+    }
+
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    entry->resampler.Update(exec);
+
+    BarColumns closed = entry->resampler.Closed().Tail(context_bars);
+    const long long newest = closed.count > 0 ? closed.time[closed.count - 1] : 0;
+    if (entry->context && entry->context->barTime == newest && entry->contextBars == context_bars)
+        return entry->context;
+
+    auto context = std::make_shared<HtfContext>();
+    context->timeframe = std::string(context_timeframe);
+    context->barTime = newest;
+    context->barCount = closed.count;
+    context->trend = DetectTrend(closed, kContextEmaFast, kContextEmaSlow);
+    context->valid = closed.count >= (size_t)(kContextEmaSlow + 10);
+    if (closed.count > 0)
+        context->levels = DetectSRLevels(closed, DefaultSRParams(CalculatePipValue(symbol)));
+
+    entry->context = context;
+    entry->contextBars = context_bars;
+    computations_.fetch_add(1, std::memory_order_relaxed);
+    return entry->context;
+}
+
+void HtfContextCache::Clear(const std::string& symbol, const std::string& exec_timeframe)
+{
+    const std::string prefix = symbol + "|" + exec_timeframe + "|";
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (it->first.compare(0, prefix.size(), prefix) == 0)
+            it = entries_.erase(it);
+        else
+            ++it;
+    }
+}
+
+TrendValidation ValidateSignalWithContext(SignalDirection direction, const HtfContext& context)
+{
+    TrendValidation result;
+    const char* name = direction == kDirectionBuy ? "BUY" : "SELL";
+    const Trend against = direction == kDirectionBuy ? kDowntrend : kUptrend;
+
+    result.valid = !context.valid || context.trend.trend != against;
+    if (result.valid)
+        result.reason = std::string(name) + " signal allowed by " + context.timeframe + " context " +
+                        TrendName(context.trend.trend);
+    else
+        result.reason = std::string(name) + " signal rejected - " + context.timeframe + " context " +
+                        TrendName(context.trend.trend) + ": " + context.trend.reason;
+    return result;
+}
+
+} // namespace volarix4::core
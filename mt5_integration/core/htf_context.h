@@ -0,0 +1,140 @@
+//=============================================================================
+//  core/htf_context.h
+//  Higher-timeframe context built from the execution bars already held in
+//  the DLL
+//
+//  HtfResampler folds execution bars (e.g. H1 from the bar store) into
+//  context candles (e.g. D1) as they arrive, so the context timeframe is
+//  never fetched or sent separately; each call only folds the bars appended
+//  since the last one. HtfContextCache keeps one resampler per (symbol,
+//  execution TF, context TF) and recomputes the context trend and S/R levels
+//  only when a new context candle closes - every execution-TF call inside
+//  the same context candle reuses the cached result.
+//=============================================================================
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "bar.h"
+#include "bar_columns.h"
+#include "sr_levels.h"
+#include "trend_filter.h"
+
+namespace volarix4::core {
+
+// Context trend and levels as of the newest closed context candle
+struct HtfContext
+{
+    std::string timeframe;           // Context timeframe ("H4", "D1", ...)
+    long long barTime = 0;           // Open time of the newest closed context candle
+    size_t barCount = 0;             // Closed context candles the context was computed on
+    bool valid = false;              // False: not enough candles for the trend filter
+    TrendInfo trend;
+    std::vector<SRLevel> levels;
+};
+
+// Open time of the context candle holding unix_time. W1 candles open on
+// Sunday 00:00 like MT5's; shorter periods are aligned to the epoch.
+long long HtfBucketStart(long long unix_time, long long context_seconds);
+
+class HtfResampler
+{
+public:
+    HtfResampler(long long exec_seconds, long long context_seconds, size_t max_bars);
+
+    // Fold the execution bars newer than the last folded one (oldest first).
+    // Bars older than that mean the series was cleared or reloaded - the
+    // resampler then starts over from these bars.
+    void Update(const BarColumns& exec);
+
+    void Clear();
+
+    // Closed context candles, oldest first; the forming one is not included
+    BarColumns Closed() const { return closed_.View().Slice(first_, closed_.size() - first_); }
+
+    long long LastExecTime() const { return last_exec_time_; }
+
+private:
+    void Fold(const BarColumns& exec, size_t index);
+    void CloseForming();
+
+    long long exec_seconds_;
+    long long context_seconds_;
+    size_t max_bars_;
+    size_t first_ = 0;               // Oldest live closed candle (trimmed lazily)
+    ColumnBuffer closed_;
+    OHLCVBar forming_{};
+    double forming_volume_ = 0.0;
+    bool has_forming_ = false;
+    bool skip_forming_ = false;      // First candle starts mid-period: incomplete
+    long long last_exec_time_ = 0;
+};
+
+class HtfContextCache
+{
+public:
+    static constexpr size_t kMaxContextBars = 4096;
+
+    static HtfContextCache& Instance()
+    {
+        static HtfContextCache cache;
+        return cache;
+    }
+
+    static std::string Key(const std::string& symbol, const std::string& exec_timeframe,
+                           const std::string& context_timeframe)
+    {
+        return symbol + "|" + exec_timeframe + "|" + context_timeframe;
+    }
+
+    // Context for the execution bars (the whole stored series, read under the
+    // store's lock), from the newest context_bars closed context candles.
+    // Returns the cached context unless a context candle closed since it was
+    // computed (or context_bars changed). nullptr for an unknown timeframe.
+    std::shared_ptr<const HtfContext> Get(std::string_view symbol,
+                                          std::string_view exec_timeframe,
+                                          std::string_view context_timeframe,
+                                          const BarColumns& exec,
+                                          size_t context_bars);
+
+    // Drop the context of every series of symbol/exec_timeframe (with its
+    // bars, see ClearBars)
+    void Clear(const std::string& symbol, const std::string& exec_timeframe);
+
+    // Context recomputations since load (one per closed context candle)
+    size_t Computations() const { return computations_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry
+    {
+        Entry(long long exec_seconds, long long context_seconds)
+            : resampler(exec_seconds, context_seconds, kMaxContextBars) {}
+
+        std::mutex mutex;
+        HtfResampler resampler;
+        std::shared_ptr<const HtfContext> context;
+        size_t contextBars = 0;
+    };
+
+    HtfContextCache() = default;
+    HtfContextCache(const HtfContextCache&) = delete;
+    HtfContextCache& operator=(const HtfContextCache&) = delete;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries_;
+    std::atomic<size_t> computations_{ 0 };
+};
+
+// Counter-trend check against the context: a BUY is rejected in a context
+// DOWNTREND and a SELL in a context UPTREND; a SIDEWAYS or invalid context
+// lets everything through. The reason reads like ValidateSignalWithTrend's.
+TrendValidation ValidateSignalWithContext(SignalDirection direction, const HtfContext& context);
+
+} // namespace volarix4::core
@@ -0,0 +1,96 @@
+//=============================================================================
+//  core/mapped_file.cpp
+//  Read-only memory mapping of a whole file (mmap / MapViewOfFile)
+//=============================================================================
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace volarix4::core {
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        Close();
+        base_ = other.base_;
+        bytes_ = other.bytes_;
+        other.base_ = nullptr;
+        other.bytes_ = 0;
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::string& path, size_t min_bytes, const char* what, std::string* error)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        *error = std::string("Cannot open ") + what + ": " + path;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)min_bytes) {
+        CloseHandle(file);
+        *error = std::string("Not a ") + what + " (too short): " + path;
+        return false;
+    }
+    // The view keeps the file mapped after both handles are closed
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (mapping)
+        CloseHandle(mapping);
+    CloseHandle(file);
+    if (!view) {
+        *error = std::string("Cannot map ") + what + ": " + path;
+        return false;
+    }
+    base_ = static_cast<const uint8_t*>(view);
+    bytes_ = (size_t)size.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        *error = std::string("Cannot open ") + what + ": " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)min_bytes) {
+        close(fd);
+        *error = std::string("Not a ") + what + " (too short): " + path;
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        *error = std::string("Cannot map ") + what + ": " + path;
+        return false;
+    }
+    base_ = static_cast<const uint8_t*>(view);
+    bytes_ = (size_t)info.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (base_) {
+#ifdef _WIN32
+        UnmapViewOfFile(base_);
+#else
+        munmap(const_cast<uint8_t*>(base_), bytes_);
+#endif
+    }
+    base_ = nullptr;
+    bytes_ = 0;
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,44 @@
+//=============================================================================
+//  core/mapped_file.h
+//  Read-only memory mapping of a whole file (mmap / MapViewOfFile)
+//
+//  The columnar history files (bar_file.h, tick_file.h) are read in place
+//  through one of these: the mapping holds no copy of the data, and pages
+//  are only read from disk when a run touches them.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace volarix4::core {
+
+// Move-only; the mapped bytes live as long as the object
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map path. False with *error ("Cannot open <what>: path", ...) if it is
+    // missing, shorter than min_bytes or cannot be mapped.
+    bool Open(const std::string& path, size_t min_bytes, const char* what, std::string* error);
+    void Close();
+
+    bool IsOpen() const { return base_ != nullptr; }
+    const uint8_t* Data() const { return base_; }
+    size_t Size() const { return bytes_; }
+
+private:
+    const uint8_t* base_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+} // namespace volarix4::core
@@ -0,0 +1,243 @@
+//=============================================================================
+//  core/monte_carlo.cpp
+//  Monte Carlo robustness analysis of a backtest's trade list (mirrors
+//  monte_carlo_reshuffle in tests/backtest.py)
+//=============================================================================
+#include "monte_carlo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "work_stealing_pool.h"
+
+namespace volarix4::core {
+
+namespace {
+
+constexpr size_t kSimulationsPerTask = 64;
+constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ull;
+
+enum Method : uint64_t
+{
+    kPermutation = 0,
+    kBootstrap = 1
+};
+
+// SplitMix64's finalizer: a bijection that scatters neighbouring inputs
+uint64_t Mix(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Counter-based stream: draw n is Mix(key + n * golden), the key a hash of
+// (seed, stream); nothing is shared between streams
+class CounterRng
+{
+public:
+    CounterRng(uint64_t seed, uint64_t stream) : key_(Mix(seed ^ Mix(stream + kGolden))) {}
+
+    uint64_t Next() { return Mix(key_ + kGolden * ++counter_); }
+
+    // Uniform in [0, bound): draws below 2^64 mod bound are rejected
+    uint64_t Below(uint64_t bound)
+    {
+        const uint64_t threshold = (0 - bound) % bound;
+        for (;;) {
+            const uint64_t x = Next();
+            if (x >= threshold)
+                return x % bound;
+        }
+    }
+
+private:
+    uint64_t key_;
+    uint64_t counter_ = 0;
+};
+
+// SortedPercentile of each percent without sorting column: the ranks the
+// interpolation reads are selected in ascending order, each over what is
+// left above the previous one
+void SelectPercentiles(std::vector<double>& column, const std::vector<double>& percentiles,
+                       std::vector<size_t>& ranks, double* out, size_t stride)
+{
+    const size_t n = column.size();
+    ranks.clear();
+    for (double percent : percentiles)
+        ranks.push_back((size_t)std::floor(percent / 100.0 * (double)(n - 1)));
+    std::sort(ranks.begin(), ranks.end());
+
+    // The rank above a selected one is the minimum of what lies above it
+    size_t first = 0;
+    for (size_t rank : ranks) {
+        if (rank >= first) {
+            std::nth_element(column.begin() + (std::ptrdiff_t)first, column.begin() + (std::ptrdiff_t)rank, column.end());
+            first = rank + 1;
+        }
+        if (rank + 1 == first && first < n) {
+            std::iter_swap(column.begin() + (std::ptrdiff_t)first,
+                           std::min_element(column.begin() + (std::ptrdiff_t)first, column.end()));
+            ++first;
+        }
+    }
+
+    // column[rank] now holds the value sorting would put there
+    for (size_t p = 0; p < percentiles.size(); ++p) {
+        const double rank = percentiles[p] / 100.0 * (double)(n - 1);
+        const size_t lower = (size_t)std::floor(rank);
+        const size_t upper = std::min(lower + 1, n - 1);
+        out[p * stride] = column[lower] + (column[upper] - column[lower]) * (rank - (double)lower);
+    }
+}
+
+void Simulate(const std::vector<double>& pnl, const MonteCarloSettings& settings, Method method,
+              size_t simulations, const MonteCarloResult& result, MonteCarloDistribution* distribution)
+{
+    const size_t n = pnl.size();
+    const size_t points = result.bandTrades.size();
+    const size_t workers = std::max<size_t>(settings.workers, 1);
+
+    std::vector<double> max_drawdown(simulations), final_pnl(simulations);
+    std::vector<double> equity(simulations * points), drawdown(simulations * points);
+    std::vector<std::vector<double>> scratch(workers);
+
+    const size_t tasks = (simulations + kSimulationsPerTask - 1) / kSimulationsPerTask;
+    WorkStealingPool::Run(tasks, workers, [&](size_t task, size_t worker) {
+        std::vector<double>& draw = scratch[worker];
+        draw.resize(n);
+        const size_t end = std::min(simulations, (task + 1) * kSimulationsPerTask);
+        for (size_t s = task * kSimulationsPerTask; s < end; ++s)
+        {
+            CounterRng rng(settings.seed, s * 2 + method);
+            if (method == kPermutation) {
+                // Fisher-Yates
+                std::copy(pnl.begin(), pnl.end(), draw.begin());
+                for (size_t i = n - 1; i > 0; --i)
+                    std::swap(draw[i], draw[(size_t)rng.Below(i + 1)]);
+            }
+            else {
+                for (size_t i = 0; i < n; ++i)
+                    draw[i] = pnl[(size_t)rng.Below(n)];
+            }
+
+            double cumulative = 0.0, peak = 0.0, worst = 0.0;
+            size_t point = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                cumulative += draw[i];
+                if (i == 0 || cumulative > peak)
+                    peak = cumulative;
+                const double dd = peak - cumulative;
+                worst = std::max(worst, dd);
+                if (point < points && i + 1 == result.bandTrades[point]) {
+                    equity[point * simulations + s] = settings.initialBalance + cumulative;
+                    drawdown[point * simulations + s] = dd;
+                    ++point;
+                }
+            }
+            max_drawdown[s] = worst;
+            final_pnl[s] = cumulative;
+        }
+    });
+
+    MonteCarloDistribution& d = *distribution;
+    d.simulations = simulations;
+    size_t losses = 0, exceeds = 0;
+    for (size_t s = 0; s < simulations; ++s) {
+        losses += final_pnl[s] < 0 ? 1 : 0;
+        exceeds += max_drawdown[s] > result.observedMaxDrawdown ? 1 : 0;
+    }
+    d.probLoss = (double)losses / (double)simulations;
+    d.probDrawdownExceedsObserved = (double)exceeds / (double)simulations;
+
+    std::sort(max_drawdown.begin(), max_drawdown.end());
+    std::sort(final_pnl.begin(), final_pnl.end());
+    d.medianMaxDrawdown = SortedPercentile(max_drawdown, 50);
+    d.p95MaxDrawdown = SortedPercentile(max_drawdown, 95);
+    d.maxMaxDrawdown = max_drawdown.back();
+    d.medianFinalPnl = SortedPercentile(final_pnl, 50);
+    d.p5FinalPnl = SortedPercentile(final_pnl, 5);
+    d.p95FinalPnl = SortedPercentile(final_pnl, 95);
+
+    // Bands: one task per band point selects from that point's column
+    const std::vector<double>& percentiles = settings.bandPercentiles;
+    std::vector<double> equity_bands(percentiles.size() * points), drawdown_bands(percentiles.size() * points);
+    std::vector<std::vector<size_t>> ranks(workers);
+    WorkStealingPool::Run(points, workers, [&](size_t point, size_t worker) {
+        std::vector<double>& column = scratch[worker];
+        const auto first = (std::ptrdiff_t)(point * simulations);
+        column.assign(equity.begin() + first, equity.begin() + first + (std::ptrdiff_t)simulations);
+        SelectPercentiles(column, percentiles, ranks[worker], &equity_bands[point], points);
+        column.assign(drawdown.begin() + first, drawdown.begin() + first + (std::ptrdiff_t)simulations);
+        SelectPercentiles(column, percentiles, ranks[worker], &drawdown_bands[point], points);
+    });
+    d.equityBands.resize(percentiles.size());
+    d.drawdownBands.resize(percentiles.size());
+    for (size_t p = 0; p < percentiles.size(); ++p) {
+        d.equityBands[p].assign(equity_bands.begin() + (std::ptrdiff_t)(p * points),
+                                equity_bands.begin() + (std::ptrdiff_t)((p + 1) * points));
+        d.drawdownBands[p].assign(drawdown_bands.begin() + (std::ptrdiff_t)(p * points),
+                                  drawdown_bands.begin() + (std::ptrdiff_t)((p + 1) * points));
+    }
+}
+
+} // namespace
+
+double TradeSequenceMaxDrawdown(const double* pnl, size_t count)
+{
+    double cumulative = 0.0, peak = 0.0, worst = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        cumulative += pnl[i];
+        if (i == 0 || cumulative > peak)
+            peak = cumulative;
+        worst = std::max(worst, peak - cumulative);
+    }
+    return worst;
+}
+
+double SortedPercentile(const std::vector<double>& values, double percent)
+{
+    if (values.empty())
+        return 0.0;
+    const double rank = percent / 100.0 * (double)(values.size() - 1);
+    const size_t lower = (size_t)std::floor(rank);
+    const size_t upper = std::min(lower + 1, values.size() - 1);
+    return values[lower] + (values[upper] - values[lower]) * (rank - (double)lower);
+}
+
+bool RunMonteCarlo(const std::vector<double>& pnl, const MonteCarloSettings& settings,
+                   MonteCarloResult* result, std::string* error)
+{
+    *result = MonteCarloResult();
+    for (double percent : settings.bandPercentiles) {
+        if (!(percent >= 0.0 && percent <= 100.0)) {
+            *error = "Band percentiles must lie in [0, 100]";
+            return false;
+        }
+    }
+
+    const size_t n = pnl.size();
+    result->trades = n;
+    if (n == 0)
+        return true;
+
+    result->observedMaxDrawdown = TradeSequenceMaxDrawdown(pnl.data(), n);
+    for (double value : pnl)
+        result->observedFinalPnl += value;
+
+    const size_t points = std::min(n, std::max<size_t>(settings.maxBandPoints, 1));
+    for (size_t p = 0; p < points; ++p)
+        result->bandTrades.push_back((p + 1) * n / points);
+
+    if (settings.permutations > 0)
+        Simulate(pnl, settings, kPermutation, settings.permutations, *result, &result->permutation);
+    if (settings.bootstraps > 0)
+        Simulate(pnl, settings, kBootstrap, settings.bootstraps, *result, &result->bootstrap);
+    return true;
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,83 @@
+//=============================================================================
+//  core/monte_carlo.h
+//  Monte Carlo robustness analysis of a backtest's trade list (mirrors
+//  monte_carlo_reshuffle in tests/backtest.py)
+//
+//  Re-running a backtest per resample is not needed to ask how much its
+//  result owes to the order and the luck of its trades: both questions are
+//  answered from the trades' net P&L alone. Trade-order permutations keep
+//  every trade and shuffle the sequence (final P&L fixed, drawdown varies);
+//  bootstrap resamples draw as many trades with replacement (both vary).
+//  Each simulation rebuilds the cumulative P&L curve and its drawdown with
+//  tests/backtest.py's definition - the peak starts at the first trade's
+//  P&L, not at zero.
+//
+//  Simulations run on a work-stealing pool. Every simulation draws from its
+//  own counter-based stream - the n-th number of simulation s is a fixed
+//  hash of (seed, s, n) - so the results are the same for any worker count
+//  and schedule. Equity and drawdown bands are percentiles across the
+//  simulations after each trade; storing the paths costs 16 bytes per
+//  simulation per band point, which is why bands are taken at most at
+//  maxBandPoints evenly spaced trades.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace volarix4::core {
+
+struct MonteCarloSettings
+{
+    size_t permutations = 1000;         // Trade-order reshuffles (0 = none)
+    size_t bootstraps = 0;              // Resamples with replacement (0 = none)
+    uint64_t seed = 42;
+    size_t workers = 1;
+    double initialBalance = 0.0;        // Added to the equity bands
+    std::vector<double> bandPercentiles = { 5, 25, 50, 75, 95 };
+    size_t maxBandPoints = 200;
+};
+
+struct MonteCarloDistribution
+{
+    size_t simulations = 0;
+    double medianMaxDrawdown = 0.0;
+    double p95MaxDrawdown = 0.0;
+    double maxMaxDrawdown = 0.0;
+    double medianFinalPnl = 0.0;
+    double p5FinalPnl = 0.0;
+    double p95FinalPnl = 0.0;
+    double probLoss = 0.0;                      // P(final P&L < 0)
+    double probDrawdownExceedsObserved = 0.0;   // P(max drawdown > observed)
+
+    // [percentile][point]: bandPercentiles across the simulations of the
+    // balance / the drawdown from the running peak after trade bandTrades[point]
+    std::vector<std::vector<double>> equityBands;
+    std::vector<std::vector<double>> drawdownBands;
+};
+
+struct MonteCarloResult
+{
+    size_t trades = 0;
+    double observedMaxDrawdown = 0.0;   // Of the chronological order
+    double observedFinalPnl = 0.0;
+    std::vector<size_t> bandTrades;     // Trades taken (1-based) at each band point
+    MonteCarloDistribution permutation;
+    MonteCarloDistribution bootstrap;
+};
+
+// Max drawdown of the cumulative P&L of pnl[0..count) (peak starts at pnl[0])
+double TradeSequenceMaxDrawdown(const double* pnl, size_t count);
+
+// np.percentile (linear interpolation) of values, which must be sorted
+double SortedPercentile(const std::vector<double>& values, double percent);
+
+// Run the settings' simulations over the trades' net P&L (chronological).
+// False with *error for a band percentile outside [0, 100]; no trades give
+// an all-zero result, like monte_carlo_reshuffle.
+bool RunMonteCarlo(const std::vector<double>& pnl, const MonteCarloSettings& settings,
+                   MonteCarloResult* result, std::string* error);
+
+} // namespace volarix4::core
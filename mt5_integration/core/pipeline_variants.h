@@ -0,0 +1,143 @@
+//=============================================================================
+//  core/pipeline_variants.h
+//  Compile-time parameter sets for the signal pipeline's kernels and the
+//  dispatcher that picks one at run time
+//
+//  The pipeline runs with the same parameters almost every time - EMA 20/50
+//  and DefaultSRParams, whose only variable is the pip value (JPY or not) -
+//  yet the kernels read them from memory in their inner loops. The EMA and
+//  S/R kernels are templates over a parameter policy instead: a Fixed* set
+//  holds the values as constants, so trip counts (swing window, recent
+//  bars) are known and the thresholds and EMA weights are folded; the
+//  Runtime* set carries any other values and runs the same code.
+//
+//  Folding changes no arithmetic. Constants are the same IEEE operations
+//  evaluated by the compiler, so every variant is bit-identical to the
+//  generic one; for the EMA periods in use the recurrence's normaliser
+//  old_wt + alpha is exactly 1.0, and with constant weights its division
+//  drops out of the loop-carried chain.
+//=============================================================================
+#pragma once
+
+#include <cstring>
+
+#include "sr_levels.h"
+
+namespace volarix4::core {
+
+enum PipelineVariant : int
+{
+    kVariantGeneric = 0,        // Parameters read at run time
+    kVariantDefault,            // Compile-time defaults, pip value 0.0001
+    kVariantDefaultJpy          // Compile-time defaults, pip value 0.01
+};
+
+//-----------------------------------------------------------------------------
+//  EMA weights: pandas ewm(span=period, adjust=False)
+//-----------------------------------------------------------------------------
+template <int Period>
+struct FixedEmaWeights
+{
+    static constexpr bool fixed = true;
+    static constexpr int period = Period;
+    static constexpr double alpha = 1.0 / (1.0 + (Period - 1) / 2.0);
+    static constexpr double oldWeight = 1.0 - alpha;
+    static constexpr double norm = oldWeight + alpha;
+};
+
+struct RuntimeEmaWeights
+{
+    static constexpr bool fixed = false;
+
+    explicit RuntimeEmaWeights(int period_)
+        : period(period_), alpha(1.0 / (1.0 + (period_ - 1) / 2.0)), oldWeight(1.0 - alpha),
+          norm(oldWeight + alpha)
+    {
+    }
+
+    int period;
+    double alpha;
+    double oldWeight;
+    double norm;
+};
+
+static_assert(FixedEmaWeights<20>::norm == 1.0 && FixedEmaWeights<50>::norm == 1.0,
+              "EMA 20/50 fold the normalising division");
+
+// fn(fast weights, slow weights) with EMA 20/50 as constants, any other
+// pair at run time
+template <typename Fn>
+auto DispatchTrend(int ema_fast, int ema_slow, Fn&& fn)
+{
+    if (ema_fast == 20 && ema_slow == 50)
+        return fn(FixedEmaWeights<20>(), FixedEmaWeights<50>());
+    return fn(RuntimeEmaWeights(ema_fast), RuntimeEmaWeights(ema_slow));
+}
+
+//-----------------------------------------------------------------------------
+//  S/R parameters: DefaultSRParams with the pip value fixed
+//-----------------------------------------------------------------------------
+template <int SwingWindow, bool Jpy>
+struct FixedSRParams
+{
+    static constexpr bool fixed = true;
+    static constexpr int swingWindow = SwingWindow;
+    static constexpr double pipValue = Jpy ? 0.01 : 0.0001;
+    static constexpr double clusterPips = 10.0;
+    static constexpr double touchPips = 10.0;
+    static constexpr double minScore = 60.0;
+    static constexpr int recentBars = 20;
+    static constexpr double wickBodyRatio = 1.5;
+    static constexpr double clusterPrice = clusterPips * pipValue;
+    static constexpr double touchPrice = touchPips * pipValue;
+};
+
+struct RuntimeSRParams
+{
+    static constexpr bool fixed = false;
+
+    explicit RuntimeSRParams(const SRParams& params)
+        : swingWindow(params.swingWindow), pipValue(params.pipValue), clusterPips(params.clusterPips),
+          touchPips(params.touchPips), minScore(params.minScore), recentBars(params.recentBars),
+          wickBodyRatio(params.wickBodyRatio), clusterPrice(params.clusterPips * params.pipValue),
+          touchPrice(params.touchPips * params.pipValue)
+    {
+    }
+
+    int swingWindow;
+    double pipValue;
+    double clusterPips;
+    double touchPips;
+    double minScore;
+    int recentBars;
+    double wickBodyRatio;
+    double clusterPrice;
+    double touchPrice;
+};
+
+using DefaultSRParamSet = FixedSRParams<5, false>;
+using DefaultJpySRParamSet = FixedSRParams<5, true>;
+
+// The compile-time set params equals field for field (kVariantGeneric if none)
+inline PipelineVariant SelectSRVariant(const SRParams& params)
+{
+    for (PipelineVariant variant : { kVariantDefault, kVariantDefaultJpy }) {
+        const SRParams fixed = DefaultSRParams(variant == kVariantDefaultJpy ? 0.01 : 0.0001);
+        if (std::memcmp(&fixed, &params, sizeof(SRParams)) == 0)
+            return variant;
+    }
+    return kVariantGeneric;
+}
+
+// fn(parameter set) for a variant SelectSRVariant(params) returned
+template <typename Fn>
+auto DispatchSR(PipelineVariant variant, const SRParams& params, Fn&& fn)
+{
+    switch (variant) {
+        case kVariantDefault:    return fn(DefaultSRParamSet());
+        case kVariantDefaultJpy: return fn(DefaultJpySRParamSet());
+        default:                 return fn(RuntimeSRParams(params));
+    }
+}
+
+} // namespace volarix4::core
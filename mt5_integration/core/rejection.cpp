@@ -0,0 +1,119 @@
+//=============================================================================
+//  core/rejection.cpp
+//  Rejection candle detection (mirrors volarix4/core/rejection.py)
+//=============================================================================
+#include "rejection.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "candle_kernels.h"
+
+namespace volarix4::core {
+
+CandleMetrics CalculateCandleMetrics(const OHLCVBar& bar)
+{
+    CandleMetrics metrics;
+    metrics.body = std::fabs(bar.close - bar.open);
+
+    if (bar.close > bar.open) {   // Bullish candle
+        metrics.upperWick = bar.high - bar.close;
+        metrics.lowerWick = bar.open - bar.low;
+    } else {                      // Bearish candle
+        metrics.upperWick = bar.high - bar.open;
+        metrics.lowerWick = bar.close - bar.low;
+    }
+
+    double max_wick = std::max(metrics.upperWick, metrics.lowerWick);
+    metrics.wickBodyRatio = metrics.body > 0 ? max_wick / metrics.body : 0.0;
+
+    double range = bar.high - bar.low;
+    metrics.closePosition = range > 0 ? (bar.close - bar.low) / range : 0.5;
+    return metrics;
+}
+
+bool IsSupportRejection(const OHLCVBar& bar, double level, double pip_value,
+                        const RejectionParams& params)
+{
+    if (std::fabs(bar.low - level) > params.maxDistancePips * pip_value)
+        return false;
+
+    CandleMetrics metrics = CalculateCandleMetrics(bar);
+    return !(metrics.wickBodyRatio < params.minWickBodyRatio) &&
+           !(metrics.lowerWick < metrics.upperWick) &&
+           !(metrics.closePosition < params.minClosePositionBuy);
+}
+
+bool IsResistanceRejection(const OHLCVBar& bar, double level, double pip_value,
+                           const RejectionParams& params)
+{
+    if (std::fabs(bar.high - level) > params.maxDistancePips * pip_value)
+        return false;
+
+    CandleMetrics metrics = CalculateCandleMetrics(bar);
+    return !(metrics.wickBodyRatio < params.minWickBodyRatio) &&
+           !(metrics.upperWick < metrics.lowerWick) &&
+           !(metrics.closePosition > params.maxClosePositionSell);
+}
+
+std::optional<Rejection> FindRejectionCandle(const OHLCVBar* bars, size_t count,
+                                             const std::vector<SRLevel>& levels,
+                                             double pip_value,
+                                             const RejectionParams& params)
+{
+    size_t lookback = (size_t)std::max(params.lookbackCandles, 0);
+    if (levels.empty() || count < lookback)
+        return std::nullopt;
+
+    // Scratch columns for the kernels, reused across calls on this thread
+    thread_local std::vector<double> open, high, low, close;
+    thread_local CandleMetricsColumns metrics;
+    thread_local LevelColumns level_columns;
+
+    const OHLCVBar* recent = bars + (count - lookback);
+    open.resize(lookback);
+    high.resize(lookback);
+    low.resize(lookback);
+    close.resize(lookback);
+    for (size_t i = 0; i < lookback; ++i) {
+        open[i] = recent[i].open;
+        high[i] = recent[i].high;
+        low[i] = recent[i].low;
+        close[i] = recent[i].close;
+    }
+
+    ComputeCandleMetrics(open.data(), high.data(), low.data(), close.data(), lookback, params, metrics);
+    level_columns.Assign(levels);
+
+    std::optional<Rejection> rejection = FindRejectionCandle(
+        metrics, low.data(), high.data(), close.data(), lookback, level_columns, pip_value, params);
+    if (rejection)
+        rejection->candleIndex += count - lookback;
+    return rejection;
+}
+
+std::optional<Rejection> FindRejectionCandle(const BarColumns& bars,
+                                             const std::vector<SRLevel>& levels,
+                                             double pip_value,
+                                             const RejectionParams& params)
+{
+    size_t lookback = (size_t)std::max(params.lookbackCandles, 0);
+    if (levels.empty() || bars.count < lookback)
+        return std::nullopt;
+
+    // The kernels read the window straight from the columns
+    thread_local CandleMetricsColumns metrics;
+    thread_local LevelColumns level_columns;
+
+    const BarColumns recent = bars.Tail(lookback);
+    ComputeCandleMetrics(recent.open, recent.high, recent.low, recent.close, lookback, params, metrics);
+    level_columns.Assign(levels);
+
+    std::optional<Rejection> rejection = FindRejectionCandle(
+        metrics, recent.low, recent.high, recent.close, lookback, level_columns, pip_value, params);
+    if (rejection)
+        rejection->candleIndex += bars.count - lookback;
+    return rejection;
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,69 @@
+//=============================================================================
+//  core/rejection.h
+//  Rejection candle detection (mirrors volarix4/core/rejection.py)
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "bar.h"
+#include "bar_columns.h"
+#include "sr_levels.h"
+#include "trend_filter.h"
+
+namespace volarix4::core {
+
+struct CandleMetrics
+{
+    double body;
+    double upperWick;
+    double lowerWick;
+    double wickBodyRatio;     // Larger wick / body (0 for a doji)
+    double closePosition;     // 0 = close at low, 1 = close at high
+};
+
+// REJECTION_CONFIG
+struct RejectionParams
+{
+    double maxDistancePips = 10.0;
+    double minWickBodyRatio = 1.5;
+    double minClosePositionBuy = 0.60;
+    double maxClosePositionSell = 0.40;
+    int lookbackCandles = 5;
+};
+
+struct Rejection
+{
+    SignalDirection direction;
+    double level;
+    LevelType levelType;
+    double levelScore;
+    double entry;             // Close of the rejection candle
+    size_t candleIndex;
+    double confidence;        // Rounded to 2 decimals
+};
+
+CandleMetrics CalculateCandleMetrics(const OHLCVBar& bar);
+
+// Low within maxDistancePips of level, dominant lower wick, close in the top
+bool IsSupportRejection(const OHLCVBar& bar, double level, double pip_value,
+                        const RejectionParams& params = RejectionParams());
+
+// High within maxDistancePips of level, dominant upper wick, close in the bottom
+bool IsResistanceRejection(const OHLCVBar& bar, double level, double pip_value,
+                           const RejectionParams& params = RejectionParams());
+
+// Most recent candle (of the last lookbackCandles) rejecting any level, levels
+// tried in order; confidence = (score / 100 + wick_body_ratio / 10) / 2, max 1
+std::optional<Rejection> FindRejectionCandle(const OHLCVBar* bars, size_t count,
+                                             const std::vector<SRLevel>& levels,
+                                             double pip_value,
+                                             const RejectionParams& params = RejectionParams());
+std::optional<Rejection> FindRejectionCandle(const BarColumns& bars,
+                                             const std::vector<SRLevel>& levels,
+                                             double pip_value,
+                                             const RejectionParams& params = RejectionParams());
+
+} // namespace volarix4::core
@@ -0,0 +1,258 @@
+//=============================================================================
+//  core/signal_pipeline.cpp
+//  Native /signal pipeline (mirrors run_signal_pipeline in volarix4/api/main.py)
+//=============================================================================
+#include "signal_pipeline.h"
+
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include "helpers.h"
+#include "htf_context.h"
+#include "rejection.h"
+#include "sr_incremental.h"
+#include "sr_levels.h"
+#include "sr_validation.h"
+#include "trade_setup.h"
+#include "trend_filter.h"
+#include "trend_incremental.h"
+
+namespace volarix4::core {
+
+namespace {
+
+constexpr size_t kMinBars = 200;                 // Parity Contract: exec200 lookback
+constexpr long long kMaxGapMultiplier = 168;     // 1 week of H1 bars
+constexpr int kLondonStart = 3, kLondonEnd = 11; // SESSIONS (server local time)
+constexpr int kNyStart = 8, kNyEnd = 22;
+constexpr double kHighConfidence = 0.75;         // Counter-trend override
+constexpr double kHighConfidenceLevelScore = 80.0;
+
+bool IsValidSession(long long wall_seconds)
+{
+    long long seconds_of_day = wall_seconds % 86400;
+    if (seconds_of_day < 0)
+        seconds_of_day += 86400;
+    int hour = (int)(seconds_of_day / 3600);
+
+    return (kLondonStart <= hour && hour < kLondonEnd) ||
+           (kNyStart <= hour && hour < kNyEnd);
+}
+
+PipelineResult Hold(std::string reason, double confidence = 0.0)
+{
+    PipelineResult result;
+    result.response.confidence = confidence;
+    result.response.reason = std::move(reason);
+    return result;
+}
+
+} // namespace
+
+const char* SignalName(SignalType signal)
+{
+    switch (signal)
+    {
+    case kSignalBuy:  return "BUY";
+    case kSignalSell: return "SELL";
+    default:          return "HOLD";
+    }
+}
+
+StrategyParams DefaultStrategyParams()
+{
+    StrategyParams params;
+    params.minConfidence = 0.60;
+    params.brokenLevelCooldownHours = 48.0;
+    params.brokenLevelBreakPips = 15.0;
+    params.minEdgePips = 4.0;
+    params.spreadPips = 1.0;
+    params.slippagePips = 0.5;
+    params.commissionPerSidePerLot = 7.0;
+    params.usdPerPipPerLot = 10.0;
+    params.lotSize = 1.0;
+    return params;
+}
+
+PipelineResult RunSignalPipeline(std::string_view symbol, std::string_view timeframe,
+                                 const OHLCVBar* bars, size_t count,
+                                 const StrategyParams& params,
+                                 const PipelineOptions& options)
+{
+    thread_local ColumnBuffer columns;
+    columns.Assign(bars, count);
+    return RunSignalPipeline(symbol, timeframe, columns.View(), params, options);
+}
+
+PipelineFeatures ComputePipelineFeatures(std::string_view symbol, std::string_view timeframe,
+                                         const BarColumns& bars, LocalTimeFn local_time,
+                                         IncrementalSRLevels* sr_levels, IncrementalTrend* trend)
+{
+    PipelineFeatures features;
+
+    // 1. Bar validation (Parity Contract)
+    if (!ValidateBars(bars.time, bars.count, timeframe, kMinBars, kMaxGapMultiplier,
+                      local_time, &features.validationError)) {
+        features.barsValid = false;
+        return features;
+    }
+
+    // 2. Session filter on the decision bar
+    const long long decision_time = bars.time[bars.count - 1];
+    features.inSession = IsValidSession(local_time ? local_time(decision_time) : decision_time);
+    if (!features.inSession)
+        return features;
+
+    // 3. Trend filter (EMA 20/50)
+    features.trend = trend ? trend->Update(bars, 20, 50) : DetectTrend(bars, 20, 50);
+
+    // 4. S/R levels (real-time detection)
+    const SRParams sr_params = DefaultSRParams(CalculatePipValue(symbol));
+    features.levels = sr_levels ? sr_levels->Update(bars, sr_params) : DetectSRLevels(bars, sr_params);
+    return features;
+}
+
+PipelineResult RunSignalPipeline(std::string_view symbol, std::string_view timeframe,
+                                 const BarColumns& bars,
+                                 const StrategyParams& params,
+                                 const PipelineOptions& options)
+{
+    return RunSignalPipeline(symbol, bars,
+                             ComputePipelineFeatures(symbol, timeframe, bars, options.localTime, options.srLevels,
+                                                     options.trend),
+                             params, options);
+}
+
+PipelineResult RunSignalPipeline(std::string_view symbol, const BarColumns& bars,
+                                 const PipelineFeatures& features,
+                                 const StrategyParams& params,
+                                 const PipelineOptions& options)
+{
+    if (!features.barsValid) {
+        PipelineResult result;
+        result.barsValid = false;
+        result.validationError = features.validationError;
+        return result;
+    }
+    if (!features.inSession)
+        return Hold("Outside trading session (London/NY only)");
+
+    const long long decision_time = bars.time[bars.count - 1];
+    const TrendInfo& trend = features.trend;
+    const double pip_value = CalculatePipValue(symbol);
+    if (features.levels.empty())
+        return Hold("No significant S/R levels detected");
+
+    // 5. Broken level filter (fresh validator per request, like the API)
+    SRLevelValidator validator(pip_value, params.brokenLevelCooldownHours, params.brokenLevelBreakPips);
+    std::vector<SRLevel> levels = validator.ValidateLevels(features.levels, bars);
+    if (levels.empty())
+        return Hold("All S/R levels broken or in cooldown period");
+
+    // 6. Rejection candle
+    std::optional<Rejection> rejection = FindRejectionCandle(bars, levels, pip_value);
+    if (!rejection)
+        return Hold("No rejection pattern at S/R levels");
+
+    // 7. Minimum confidence
+    if (rejection->confidence < params.minConfidence) {
+        std::string reason = "Confidence too low (";
+        AppendFixed(reason, rejection->confidence, 2);
+        reason += " < ";
+        AppendPyRepr(reason, params.minConfidence);
+        reason += ")";
+        return Hold(std::move(reason), rejection->confidence);
+    }
+
+    // 8. Trend alignment, unless a high confidence setup at a strong level
+    TrendValidation trend_validation = ValidateSignalWithTrend(rejection->direction, trend);
+    bool high_confidence_override = rejection->confidence > kHighConfidence &&
+                                    rejection->levelScore >= kHighConfidenceLevelScore;
+    if (!trend_validation.valid && !high_confidence_override)
+        return Hold(std::move(trend_validation.reason));
+
+    // 8b. Higher-timeframe context: no counter-trend trades (no override)
+    if (options.context) {
+        TrendValidation context_validation = ValidateSignalWithContext(rejection->direction, *options.context);
+        if (!context_validation.valid)
+            return Hold(std::move(context_validation.reason));
+    }
+
+    // 9. Signal cooldown per symbol (bar time, not wall clock)
+    const std::string symbol_key(symbol);
+    long long last_signal_time;
+    if (options.cooldown && options.cooldown->LastSignal(symbol_key, &last_signal_time)) {
+        double hours_since = (double)(decision_time - last_signal_time) / 3600.0;
+        if (hours_since < kSignalCooldownHours) {
+            std::string reason = "Signal cooldown active (";
+            AppendFixed(reason, kSignalCooldownHours - hours_since, 1);
+            reason += "h remaining)";
+            return Hold(std::move(reason));
+        }
+    }
+
+    // 10. Trade setup with risk validation
+    RiskParams risk;
+    TradeLevels trade = CalculateSlTp(rejection->entry, rejection->level, rejection->direction,
+                                      pip_value, risk);
+    const bool is_buy = rejection->direction == kDirectionBuy;
+
+    if (!PassesRiskLimits(trade, risk)) {
+        double sl_price = is_buy ? rejection->level - risk.slPipsBeyond * pip_value
+                                 : rejection->level + risk.slPipsBeyond * pip_value;
+        double sl_pips = std::fabs(rejection->entry - sl_price) / pip_value;
+
+        std::string reason = "Risk parameters exceeded (SL: ";
+        AppendFixed(reason, sl_pips, 1);
+        reason += " pips, max: ";
+        AppendPyRepr(reason, risk.maxSlPips);
+        reason += ", min R:R: ";
+        AppendPyRepr(reason, risk.minRiskReward);
+        reason += ")";
+        return Hold(std::move(reason));
+    }
+
+    // 11. Minimum edge after round-trip costs
+    double commission_pips = (2 * params.commissionPerSidePerLot * params.lotSize) / params.usdPerPipPerLot;
+    double total_cost_pips = params.spreadPips + (2 * params.slippagePips) + commission_pips;
+    double tp1_distance_pips = is_buy ? (trade.tp1 - rejection->entry) / pip_value
+                                      : (rejection->entry - trade.tp1) / pip_value;
+
+    if (tp1_distance_pips <= total_cost_pips + params.minEdgePips) {
+        std::string reason = "Insufficient edge after costs (TP1: ";
+        AppendFixed(reason, tp1_distance_pips, 1);
+        reason += " pips, costs: ";
+        AppendFixed(reason, total_cost_pips, 1);
+        reason += ", min edge: ";
+        AppendFixed(reason, params.minEdgePips, 1);
+        reason += ")";
+        return Hold(std::move(reason));
+    }
+
+    // Signal
+    PipelineResult result;
+    SignalResponse& response = result.response;
+    response.signal = is_buy ? kSignalBuy : kSignalSell;
+    response.confidence = rejection->confidence;
+    response.entry = rejection->entry;
+    response.sl = trade.sl;
+    response.tp1 = trade.tp1;
+    response.tp2 = trade.tp2;
+    response.tp3 = trade.tp3;
+    response.tp1Percent = risk.tpPercents[0];
+    response.tp2Percent = risk.tpPercents[1];
+    response.tp3Percent = risk.tpPercents[2];
+
+    response.reason = is_buy ? "Support bounce at " : "Resistance bounce at ";
+    AppendFixed(response.reason, rejection->level, 5);
+    response.reason += ", score ";
+    AppendPyRepr(response.reason, rejection->levelScore);
+
+    if (options.cooldown)
+        options.cooldown->Record(symbol_key, decision_time);
+
+    return result;
+}
+
+} // namespace volarix4::core
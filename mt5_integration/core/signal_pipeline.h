@@ -0,0 +1,161 @@
+//=============================================================================
+//  core/signal_pipeline.h
+//  Native /signal pipeline (mirrors run_signal_pipeline in volarix4/api/main.py)
+//
+//  Bar validation -> session -> EMA trend -> S/R detection -> broken level
+//  filter -> rejection candle -> confidence -> trend alignment -> optional
+//  higher-TF context (see htf_context.h) -> signal cooldown -> SL/TP risk gate -> minimum edge after costs. Every HOLD
+//  carries the same reason text as the API, so responses can be compared
+//  field by field with the server's.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "bar.h"
+#include "bar_columns.h"
+#include "bar_validation.h"
+#include "sr_levels.h"
+#include "trend_filter.h"
+
+namespace volarix4::core {
+
+struct HtfContext;
+class IncrementalSRLevels;
+class IncrementalTrend;
+
+enum SignalType : int
+{
+    kSignalHold = 0,
+    kSignalBuy = 1,
+    kSignalSell = 2
+};
+
+const char* SignalName(SignalType signal);
+
+// Strategy and cost model parameters sent with every /signal request
+struct StrategyParams
+{
+    double minConfidence;
+    double brokenLevelCooldownHours;
+    double brokenLevelBreakPips;
+    double minEdgePips;
+    double spreadPips;
+    double slippagePips;
+    double commissionPerSidePerLot;
+    double usdPerPipPerLot;
+    double lotSize;
+};
+
+// BACKTEST_PARITY_CONFIG
+StrategyParams DefaultStrategyParams();
+
+// Same fields as the API's SignalResponse
+struct SignalResponse
+{
+    SignalType signal = kSignalHold;
+    double confidence = 0.0;
+    double entry = 0.0;
+    double sl = 0.0;
+    double tp1 = 0.0;
+    double tp2 = 0.0;
+    double tp3 = 0.0;
+    double tp1Percent = 0.50;
+    double tp2Percent = 0.30;
+    double tp3Percent = 0.20;
+    std::string reason;
+};
+
+// A symbol's BUY/SELL is held back until this long (bar time) after its last
+constexpr double kSignalCooldownHours = 2.0;
+
+// Bar time of the last BUY/SELL per symbol (_signal_cooldown_tracker). Lives
+// as long as its owner - the server keeps it for the process lifetime.
+class SignalCooldownTracker
+{
+public:
+    bool LastSignal(const std::string& symbol, long long* bar_time)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = last_signal_.find(symbol);
+        if (it == last_signal_.end())
+            return false;
+        *bar_time = it->second;
+        return true;
+    }
+
+    void Record(const std::string& symbol, long long bar_time)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_signal_[symbol] = bar_time;
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, long long> last_signal_;
+};
+
+struct PipelineOptions
+{
+    LocalTimeFn localTime = nullptr;                // Session clock (nullptr = UTC)
+    SignalCooldownTracker* cooldown = nullptr;      // nullptr = no signal cooldown
+    const HtfContext* context = nullptr;            // Higher-TF filter (nullptr = single-TF)
+    IncrementalSRLevels* srLevels = nullptr;        // Stream's S/R state (nullptr = detect per call)
+    IncrementalTrend* trend = nullptr;              // Stream's EMA state (nullptr = recompute per call)
+};
+
+struct PipelineResult
+{
+    bool barsValid = true;         // False: the API would answer 422
+    std::string validationError;   // BarValidationError message
+    SignalResponse response;
+};
+
+// Steps 1-4 - bar validation, session, EMA trend and S/R detection - depend
+// on the bars alone, not on StrategyParams or the cooldown, so runs that
+// evaluate several parameter sets on the same window (grid search) compute
+// them once and pass them to the overload below
+struct PipelineFeatures
+{
+    bool barsValid = true;
+    std::string validationError;
+    bool inSession = false;        // False: trend and levels are not computed
+    TrendInfo trend;
+    std::vector<SRLevel> levels;
+};
+
+// With sr_levels, step 4 advances that stream's incremental S/R state to
+// bars (see sr_incremental.h) instead of detecting the levels from scratch,
+// and with trend step 3 advances its EMAs (trend_incremental.h); the
+// features are the same either way
+PipelineFeatures ComputePipelineFeatures(std::string_view symbol, std::string_view timeframe,
+                                         const BarColumns& bars, LocalTimeFn local_time = nullptr,
+                                         IncrementalSRLevels* sr_levels = nullptr,
+                                         IncrementalTrend* trend = nullptr);
+
+// Bars are closed bars, oldest first; the last one is the decision bar
+PipelineResult RunSignalPipeline(std::string_view symbol, std::string_view timeframe,
+                                 const OHLCVBar* bars, size_t count,
+                                 const StrategyParams& params,
+                                 const PipelineOptions& options = PipelineOptions());
+
+// Same, reading the bars in place (e.g. a BarStore window); the packed
+// overload transposes into per-thread columns and calls this one
+PipelineResult RunSignalPipeline(std::string_view symbol, std::string_view timeframe,
+                                 const BarColumns& bars,
+                                 const StrategyParams& params,
+                                 const PipelineOptions& options = PipelineOptions());
+
+// Steps 5-11 on features computed for the same bars (options.localTime is
+// not used - the features were computed with a session clock already)
+PipelineResult RunSignalPipeline(std::string_view symbol, const BarColumns& bars,
+                                 const PipelineFeatures& features,
+                                 const StrategyParams& params,
+                                 const PipelineOptions& options = PipelineOptions());
+
+} // namespace volarix4::core
@@ -0,0 +1,246 @@
+//=============================================================================
+//  core/sr_incremental.cpp
+//  S/R levels of a sliding window, maintained bar by bar instead of
+//  detected from scratch
+//=============================================================================
+#include "sr_incremental.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "helpers.h"
+#include "pipeline_variants.h"
+
+namespace volarix4::core {
+
+namespace {
+
+constexpr size_t kMinTrim = 64;      // Dead bars in front before compacting
+
+bool Touches(double level, double high, double low, double threshold_price)
+{
+    return std::fabs(high - level) <= threshold_price || std::fabs(low - level) <= threshold_price;
+}
+
+} // namespace
+
+void IncrementalSRLevels::Reset()
+{
+    bars_.Clear();
+    first_ = 0;
+    sequence_ = 0;
+    highs_ = Side();
+    lows_ = Side();
+    levels_.clear();
+}
+
+const std::vector<SRLevel>& IncrementalSRLevels::Update(const BarColumns& window, const SRParams& params)
+{
+    if (!has_params_ || std::memcmp(&params_, &params, sizeof(SRParams)) != 0) {
+        Reset();
+        params_ = params;
+        variant_ = SelectSRVariant(params);
+        has_params_ = true;
+    }
+
+    size_t overlap = 0;
+    if (Bars() > 0 && !Continues(window, &overlap))
+        Reset();
+    if (Bars() == 0) {
+        if (window.count == 0)
+            return levels_;
+        ++rebuilds_;
+    }
+
+    // Oldest bars out first, so every swing candidate sees the window's
+    // real left edge
+    while (Bars() > overlap)
+        EvictOldest();
+    for (size_t i = overlap; i < window.count; ++i)
+        Append(window, i);
+
+    if (highs_.changed)
+        Recluster(highs_);
+    if (lows_.changed)
+        Recluster(lows_);
+
+    const BarColumns live = Live();
+    const BarColumns recent = live.Tail((size_t)std::max(params_.recentBars, 0));
+
+    levels_.clear();
+    auto add_levels = [&](const Side& side, LevelType type) {
+        for (const Cluster& cluster : side.clusters)
+        {
+            double score = ScoreLevel(cluster.mean, cluster.touches, recent, type, params_, variant_);
+            if (score >= params_.minScore)
+                levels_.push_back(SRLevel{ RoundTo(cluster.mean, 5), RoundTo(score, 1), type });
+        }
+    };
+    add_levels(lows_, kSupport);
+    add_levels(highs_, kResistance);
+
+    std::stable_sort(levels_.begin(), levels_.end(),
+                     [](const SRLevel& a, const SRLevel& b) { return a.score > b.score; });
+    return levels_;
+}
+
+// True if window is the live bars with zero or more of the oldest dropped
+// and zero or more new bars appended; *overlap = live bars window keeps
+bool IncrementalSRLevels::Continues(const BarColumns& window, size_t* overlap) const
+{
+    const BarColumns live = Live();
+    if (window.count == 0)
+        return false;
+
+    const size_t last = live.count - 1;
+    const long long* end = window.time + window.count;
+    const size_t kept = (size_t)(std::upper_bound(window.time, end, live.time[last]) - window.time);
+    if (kept == 0 || window.time[kept - 1] != live.time[last])
+        return false;
+
+    const size_t dropped = (size_t)(std::lower_bound(live.time, live.time + live.count, window.time[0]) - live.time);
+    if (live.count - dropped != kept || live.time[dropped] != window.time[0])
+        return false;
+
+    // Same newest bar (a reloaded history with equal times but other prices
+    // starts over)
+    const size_t k = kept - 1;
+    if (window.open[k] != live.open[last] || window.high[k] != live.high[last] ||
+        window.low[k] != live.low[last] || window.close[k] != live.close[last])
+        return false;
+
+    *overlap = kept;
+    return true;
+}
+
+void IncrementalSRLevels::AdjustTouches(const BarColumns& bars, size_t index, int delta)
+{
+    const double threshold_price = params_.touchPips * params_.pipValue;
+    const double high = bars.high[index], low = bars.low[index];
+    for (Side* side : { &highs_, &lows_ })
+        for (Cluster& cluster : side->clusters)
+            if (Touches(cluster.mean, high, low, threshold_price))
+                cluster.touches += delta;
+}
+
+void IncrementalSRLevels::Append(const BarColumns& window, size_t index)
+{
+    bars_.Append(OHLCVBar{ window.time[index], window.open[index], window.high[index],
+                           window.low[index], window.close[index], (int)window.volume[index] });
+    AdjustTouches(bars_.View(), bars_.size() - 1, +1);
+
+    // The bar swingWindow back now has all its right-hand neighbours; it is
+    // a swing if it also has all its left-hand ones and beats every one
+    if (params_.swingWindow <= 0)
+        return;
+    const size_t w = (size_t)params_.swingWindow;
+    if (Bars() < 2 * w + 1)
+        return;
+
+    const BarColumns all = bars_.View();
+    const size_t candidate = all.count - 1 - w;
+    bool high_swing = true, low_swing = true;
+    for (size_t j = candidate - w; j <= candidate + w && (high_swing || low_swing); ++j)
+    {
+        if (j == candidate)
+            continue;
+        high_swing = high_swing && all.high[candidate] > all.high[j];
+        low_swing = low_swing && all.low[candidate] < all.low[j];
+    }
+    if (high_swing)
+        AddSwing(highs_, sequence_ + candidate, all.high[candidate]);
+    if (low_swing)
+        AddSwing(lows_, sequence_ + candidate, all.low[candidate]);
+}
+
+void IncrementalSRLevels::EvictOldest()
+{
+    AdjustTouches(bars_.View(), first_, -1);
+    ++first_;
+
+    // A swing needs swingWindow bars to its left inside the window
+    const size_t w = (size_t)std::max(params_.swingWindow, 0);
+    const size_t oldest = sequence_ + first_;
+    for (Side* side : { &highs_, &lows_ })
+    {
+        while (!side->swings.empty() && side->swings.front().first < oldest + w)
+        {
+            const double price = side->swings.front().second;
+            side->prices.erase(std::lower_bound(side->prices.begin(), side->prices.end(), price));
+            side->swings.pop_front();
+            side->changed = true;
+        }
+    }
+
+    if (first_ >= kMinTrim && first_ >= Bars()) {
+        bars_.EraseFront(first_);
+        sequence_ += first_;
+        first_ = 0;
+    }
+}
+
+void IncrementalSRLevels::AddSwing(Side& side, size_t sequence, double price)
+{
+    side.swings.emplace_back(sequence, price);
+    side.prices.insert(std::upper_bound(side.prices.begin(), side.prices.end(), price), price);
+    side.changed = true;
+}
+
+void IncrementalSRLevels::Recluster(Side& side)
+{
+    const std::vector<double> means = ClusterLevels(side.prices, params_.clusterPips * params_.pipValue);
+    const double threshold_price = params_.touchPips * params_.pipValue;
+    const BarColumns live = Live();
+
+    // Both lists ascend: a mean that survived the re-chaining keeps its
+    // (already current) touch count, a new one is counted over the window
+    std::vector<Cluster> clusters;
+    clusters.reserve(means.size());
+    size_t old = 0;
+    for (double mean : means)
+    {
+        while (old < side.clusters.size() && side.clusters[old].mean < mean)
+            ++old;
+        if (old < side.clusters.size() && side.clusters[old].mean == mean) {
+            clusters.push_back(side.clusters[old++]);
+            continue;
+        }
+
+        int touches = 0;
+        for (size_t i = 0; i < live.count; ++i)
+            touches += Touches(mean, live.high[i], live.low[i], threshold_price) ? 1 : 0;
+        clusters.push_back(Cluster{ mean, touches });
+        ++recounts_;
+    }
+
+    side.clusters = std::move(clusters);
+    side.changed = false;
+}
+
+//=============================================================================
+//  SRLevelsCache
+//=============================================================================
+std::shared_ptr<SRLevelsCache::Stream> SRLevelsCache::Get(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<Stream>& slot = streams_[key];
+    if (!slot)
+        slot = std::make_shared<Stream>();
+    return slot;
+}
+
+void SRLevelsCache::Clear(const std::string& symbol, const std::string& timeframe)
+{
+    const std::string prefix = symbol + "|" + timeframe + "|";
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = streams_.begin(); it != streams_.end();)
+    {
+        if (it->first.compare(0, prefix.size(), prefix) == 0)
+            it = streams_.erase(it);
+        else
+            ++it;
+    }
+}
+
+} // namespace volarix4::core
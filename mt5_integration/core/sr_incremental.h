@@ -0,0 +1,128 @@
+//=============================================================================
+//  core/sr_incremental.h
+//  S/R levels of a sliding window, maintained bar by bar instead of
+//  detected from scratch
+//
+//  DetectSRLevels rescans the whole lookback for every signal: swings,
+//  clustering, and one pass over all bars per level for the touch counts.
+//  Between two candles only the newest bar arrives and the oldest leaves,
+//  so IncrementalSRLevels keeps that state per stream instead:
+//  - swings: the candidate window bars back is checked once, when its last
+//    right-hand neighbour arrives; swings are evicted with their left-hand
+//    neighbours
+//  - clusters: re-chained only when a swing came or went; clusters whose
+//    mean did not change keep their touch counts
+//  - touches: each arriving or evicted bar adjusts every cluster's count
+//  Only a cluster whose mean changed is recounted over the window, and the
+//  recent-touch and wick bonuses read just the newest recentBars bars. The
+//  levels are bit-identical to DetectSRLevels on the same window.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bar_columns.h"
+#include "sr_levels.h"
+#include "trend_incremental.h"
+
+namespace volarix4::core {
+
+class IncrementalSRLevels
+{
+public:
+    // Levels of window (oldest first) - DetectSRLevels(window, params). A
+    // window that continues the previous one (same bars up to its newest,
+    // new bars after it, oldest bars possibly dropped) is applied bar by
+    // bar; any other window, or new params, rebuilds the state from it.
+    const std::vector<SRLevel>& Update(const BarColumns& window, const SRParams& params);
+
+    void Reset();
+
+    size_t Bars() const { return bars_.size() - first_; }
+
+    // Full rebuilds and per-cluster touch recounts since construction
+    size_t Rebuilds() const { return rebuilds_; }
+    size_t Recounts() const { return recounts_; }
+
+private:
+    struct Cluster
+    {
+        double mean;
+        int touches;                 // Bars of the window touching mean
+    };
+
+    struct Side
+    {
+        std::deque<std::pair<size_t, double>> swings;  // (bar sequence, price), oldest first
+        std::vector<double> prices;                    // Swing prices, ascending
+        std::vector<Cluster> clusters;                 // Ascending by mean
+        bool changed = false;
+    };
+
+    BarColumns Live() const { return bars_.View().Slice(first_, Bars()); }
+    bool Continues(const BarColumns& window, size_t* overlap) const;
+    void Append(const BarColumns& window, size_t index);
+    void EvictOldest();
+    void AddSwing(Side& side, size_t sequence, double price);
+    void Recluster(Side& side);
+    void AdjustTouches(const BarColumns& bars, size_t index, int delta);
+
+    SRParams params_{};
+    PipelineVariant variant_{};      // SelectSRVariant(params_)
+    bool has_params_ = false;
+    ColumnBuffer bars_;
+    size_t first_ = 0;               // Oldest live bar in bars_ (trimmed lazily)
+    size_t sequence_ = 0;            // Sequence number of bars_[0]; kept across trims
+    Side highs_;                     // Resistance side
+    Side lows_;                      // Support side
+    std::vector<SRLevel> levels_;
+    size_t rebuilds_ = 0;
+    size_t recounts_ = 0;
+};
+
+// One IncrementalSRLevels (and IncrementalTrend) per live stream (symbol,
+// timeframe, lookback) for the bar store exports
+class SRLevelsCache
+{
+public:
+    struct Stream
+    {
+        std::mutex mutex;            // Held while levels and trend are updated and read
+        IncrementalSRLevels levels;
+        IncrementalTrend trend;
+    };
+
+    static SRLevelsCache& Instance()
+    {
+        static SRLevelsCache cache;
+        return cache;
+    }
+
+    static std::string Key(const std::string& symbol, const std::string& timeframe, size_t lookback)
+    {
+        return symbol + "|" + timeframe + "|" + std::to_string(lookback);
+    }
+
+    // The stream's state, created empty on first use
+    std::shared_ptr<Stream> Get(const std::string& key);
+
+    // Drop every stream of symbol/timeframe (with its bars, see ClearBars)
+    void Clear(const std::string& symbol, const std::string& timeframe);
+
+private:
+    SRLevelsCache() = default;
+    SRLevelsCache(const SRLevelsCache&) = delete;
+    SRLevelsCache& operator=(const SRLevelsCache&) = delete;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Stream>> streams_;
+};
+
+} // namespace volarix4::core
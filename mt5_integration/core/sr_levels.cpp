@@ -0,0 +1,346 @@
+//=============================================================================
+//  core/sr_levels.cpp
+//  Native Support/Resistance detection (mirrors volarix4/core/sr_levels.py)
+//=============================================================================
+#include "sr_levels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+#include "helpers.h"
+#include "pipeline_variants.h"
+
+namespace volarix4::core {
+
+namespace {
+
+// Bar access shared by the packed (OHLCVBar*) and columnar (BarColumns)
+// entry points, so both run the same code and give identical levels
+struct PackedBars
+{
+    const OHLCVBar* bars;
+    size_t count;
+
+    double Open(size_t i) const { return bars[i].open; }
+    double High(size_t i) const { return bars[i].high; }
+    double Low(size_t i) const { return bars[i].low; }
+    double Close(size_t i) const { return bars[i].close; }
+    PackedBars Tail(size_t length) const { return PackedBars{ bars + (count - length), length }; }
+};
+
+struct ColumnBars
+{
+    BarColumns columns;
+    size_t count;
+
+    double Open(size_t i) const { return columns.open[i]; }
+    double High(size_t i) const { return columns.high[i]; }
+    double Low(size_t i) const { return columns.low[i]; }
+    double Close(size_t i) const { return columns.close[i]; }
+    ColumnBars Tail(size_t length) const { return ColumnBars{ columns.Tail(length), length }; }
+};
+
+// out[j] = max (or min) of values[j] .. values[j + width - 1], for every full
+// window, using a monotonic deque of candidate indices
+template <typename Value, typename Better>
+std::vector<double> SlidingExtreme(size_t count, size_t width, Value value, Better better)
+{
+    std::vector<double> out;
+    if (width == 0 || count < width)
+        return out;
+    out.resize(count - width + 1);
+
+    std::deque<size_t> candidates;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double v = value(i);
+        while (!candidates.empty() && !better(value(candidates.back()), v))
+            candidates.pop_back();
+        candidates.push_back(i);
+
+        if (candidates.front() + width <= i)
+            candidates.pop_front();
+
+        if (i + 1 >= width)
+            out[i + 1 - width] = value(candidates.front());
+    }
+    return out;
+}
+
+// Swing at i: value(i) strictly better than both the `window` bars before
+// (extreme[i - window]) and after (extreme[i + 1])
+template <typename Value, typename Better>
+std::vector<size_t> FindSwings(size_t count, int window, Value value, Better better)
+{
+    std::vector<size_t> swings;
+    if (window <= 0 || count < (size_t)window * 2 + 1)
+        return swings;
+
+    size_t w = (size_t)window;
+    std::vector<double> extreme = SlidingExtreme(count, w, value, better);
+
+    for (size_t i = w; i < count - w; ++i)
+    {
+        double v = value(i);
+        if (better(v, extreme[i - w]) && better(v, extreme[i + 1]))
+            swings.push_back(i);
+    }
+    return swings;
+}
+
+// Same swings for a compile-time window: each candidate against its 2 * Window
+// neighbours directly (a fixed, unrolled trip count), as IncrementalSRLevels
+// checks them
+template <int Window, typename Value, typename Better>
+std::vector<size_t> FindSwingsFixed(size_t count, Value value, Better better)
+{
+    std::vector<size_t> swings;
+    constexpr size_t w = (size_t)Window;
+    if (count < w * 2 + 1)
+        return swings;
+
+    for (size_t i = w; i < count - w; ++i)
+    {
+        const double v = value(i);
+        bool swing = true;
+        for (size_t k = 1; k <= w; ++k)
+            swing = swing && better(v, value(i - k)) && better(v, value(i + k));
+        if (swing)
+            swings.push_back(i);
+    }
+    return swings;
+}
+
+bool Greater(double a, double b) { return a > b; }
+bool Less(double a, double b) { return a < b; }
+
+template <typename Bars, typename P>
+std::vector<size_t> SwingHighs(const Bars& bars, const P& p)
+{
+    auto high = [&bars](size_t i) { return bars.High(i); };
+    if constexpr (P::fixed)
+        return FindSwingsFixed<P::swingWindow>(bars.count, high, Greater);
+    else
+        return FindSwings(bars.count, p.swingWindow, high, Greater);
+}
+
+template <typename Bars, typename P>
+std::vector<size_t> SwingLows(const Bars& bars, const P& p)
+{
+    auto low = [&bars](size_t i) { return bars.Low(i); };
+    if constexpr (P::fixed)
+        return FindSwingsFixed<P::swingWindow>(bars.count, low, Less);
+    else
+        return FindSwings(bars.count, p.swingWindow, low, Less);
+}
+
+template <typename Bars>
+int Touches(double level, const Bars& bars, double threshold_price)
+{
+    int touches = 0;
+    for (size_t i = 0; i < bars.count; ++i)
+    {
+        if (std::fabs(bars.High(i) - level) <= threshold_price ||
+            std::fabs(bars.Low(i) - level) <= threshold_price)
+            ++touches;
+    }
+    return touches;
+}
+
+// Score from the window's touch count; recent_bars are its newest
+// recentBars bars (Recent = recent_bars.count when known at compile time)
+template <size_t Recent, typename Bars, typename P>
+double RecentScoreOver(double level, int touches, const Bars& recent_bars, LevelType type, const P& params)
+{
+    const double threshold_price = params.touchPrice;
+    const size_t recent = Recent ? Recent : recent_bars.count;
+
+    double score = touches * 20.0;
+
+    bool recent_touch = false;
+    for (size_t i = 0; i < recent; ++i)
+        recent_touch |= std::fabs(recent_bars.High(i) - level) <= threshold_price ||
+                        std::fabs(recent_bars.Low(i) - level) <= threshold_price;
+    if (recent_touch)
+        score += 50.0;
+
+    // Strong rejection (large wick at level) in the recent bars
+    for (size_t i = 0; i < recent; ++i)
+    {
+        const double open = recent_bars.Open(i), close = recent_bars.Close(i);
+        double body = std::fabs(close - open);
+
+        if (type == kSupport) {
+            const double low = recent_bars.Low(i);
+            double lower_wick = close > open ? open - low : close - low;
+            if (std::fabs(low - level) <= threshold_price && lower_wick > body * params.wickBodyRatio) {
+                score += 20.0;
+                break;
+            }
+        } else {
+            const double high = recent_bars.High(i);
+            double upper_wick = close < open ? high - close : high - open;
+            if (std::fabs(high - level) <= threshold_price && upper_wick > body * params.wickBodyRatio) {
+                score += 20.0;
+                break;
+            }
+        }
+    }
+
+    return std::min(score, 100.0);
+}
+
+// A full window's recent bars have the set's constant count
+template <typename Bars, typename P>
+double RecentScore(double level, int touches, const Bars& recent_bars, LevelType type, const P& params)
+{
+    if constexpr (P::fixed) {
+        if (recent_bars.count == (size_t)P::recentBars)
+            return RecentScoreOver<(size_t)P::recentBars>(level, touches, recent_bars, type, params);
+    }
+    return RecentScoreOver<0>(level, touches, recent_bars, type, params);
+}
+
+template <typename Bars, typename P>
+double Score(double level, const Bars& bars, LevelType type, const P& params)
+{
+    size_t recent = std::min(bars.count, (size_t)std::max(params.recentBars, 0));
+    return RecentScore(level, Touches(level, bars, params.touchPrice), bars.Tail(recent), type, params);
+}
+
+template <typename Bars, typename P>
+std::vector<SRLevel> Detect(const Bars& bars, const P& params)
+{
+    std::vector<size_t> swing_highs = SwingHighs(bars, params);
+    std::vector<size_t> swing_lows = SwingLows(bars, params);
+
+    std::vector<double> resistance_prices;
+    resistance_prices.reserve(swing_highs.size());
+    for (size_t i : swing_highs)
+        resistance_prices.push_back(bars.High(i));
+
+    std::vector<double> support_prices;
+    support_prices.reserve(swing_lows.size());
+    for (size_t i : swing_lows)
+        support_prices.push_back(bars.Low(i));
+
+    std::vector<double> clustered_resistance = ClusterLevels(std::move(resistance_prices), params.clusterPrice);
+    std::vector<double> clustered_support = ClusterLevels(std::move(support_prices), params.clusterPrice);
+
+    std::vector<SRLevel> levels;
+    levels.reserve(clustered_support.size() + clustered_resistance.size());
+
+    auto add_levels = [&](const std::vector<double>& prices, LevelType type) {
+        for (double price : prices)
+        {
+            double score = Score(price, bars, type, params);
+            if (score >= params.minScore)
+                levels.push_back(SRLevel{ RoundTo(price, 5), RoundTo(score, 1), type });
+        }
+    };
+    add_levels(clustered_support, kSupport);
+    add_levels(clustered_resistance, kResistance);
+
+    std::stable_sort(levels.begin(), levels.end(),
+                     [](const SRLevel& a, const SRLevel& b) { return a.score > b.score; });
+
+    return levels;
+}
+
+} // namespace
+
+SRParams DefaultSRParams(double pip_value)
+{
+    SRParams params;
+    params.swingWindow = 5;
+    params.clusterPips = 10.0;
+    params.touchPips = 10.0;
+    params.minScore = 60.0;
+    params.pipValue = pip_value;
+    params.recentBars = 20;
+    params.wickBodyRatio = 1.5;
+    return params;
+}
+
+std::vector<size_t> FindSwingHighs(const OHLCVBar* bars, size_t count, int window)
+{
+    return FindSwings(count, window, [bars](size_t i) { return bars[i].high; }, Greater);
+}
+
+std::vector<size_t> FindSwingLows(const OHLCVBar* bars, size_t count, int window)
+{
+    return FindSwings(count, window, [bars](size_t i) { return bars[i].low; }, Less);
+}
+
+std::vector<double> ClusterLevels(std::vector<double> prices, double threshold_price)
+{
+    std::vector<double> clustered;
+    if (prices.empty())
+        return clustered;
+
+    std::sort(prices.begin(), prices.end());
+
+    double sum = prices[0];
+    size_t members = 1;
+    double last = prices[0];
+
+    for (size_t i = 1; i < prices.size(); ++i)
+    {
+        if (prices[i] - last <= threshold_price) {
+            sum += prices[i];
+            ++members;
+        } else {
+            clustered.push_back(sum / (double)members);
+            sum = prices[i];
+            members = 1;
+        }
+        last = prices[i];
+    }
+    clustered.push_back(sum / (double)members);
+
+    return clustered;
+}
+
+int CountTouches(double level, const OHLCVBar* bars, size_t count, double threshold_price)
+{
+    return Touches(level, PackedBars{ bars, count }, threshold_price);
+}
+
+double ScoreLevel(double level, const OHLCVBar* bars, size_t count,
+                  LevelType type, const SRParams& params)
+{
+    return DispatchSR(SelectSRVariant(params), params, [&](const auto& p) {
+        return Score(level, PackedBars{ bars, count }, type, p);
+    });
+}
+
+double ScoreLevel(double level, int touches, const BarColumns& recent,
+                  LevelType type, const SRParams& params)
+{
+    return ScoreLevel(level, touches, recent, type, params, SelectSRVariant(params));
+}
+
+double ScoreLevel(double level, int touches, const BarColumns& recent,
+                  LevelType type, const SRParams& params, PipelineVariant variant)
+{
+    return DispatchSR(variant, params, [&](const auto& p) {
+        return RecentScore(level, touches, ColumnBars{ recent, recent.count }, type, p);
+    });
+}
+
+std::vector<SRLevel> DetectSRLevels(const OHLCVBar* bars, size_t count, const SRParams& params)
+{
+    return DispatchSR(SelectSRVariant(params), params, [&](const auto& p) {
+        return Detect(PackedBars{ bars, count }, p);
+    });
+}
+
+std::vector<SRLevel> DetectSRLevels(const BarColumns& bars, const SRParams& params)
+{
+    return DispatchSR(SelectSRVariant(params), params, [&](const auto& p) {
+        return Detect(ColumnBars{ bars, bars.count }, p);
+    });
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,91 @@
+//=============================================================================
+//  core/sr_levels.h
+//  Native Support/Resistance detection (mirrors volarix4/core/sr_levels.py)
+//
+//  Same rules as the Python pipeline - strict swing highs/lows, chained
+//  clustering of sorted swing prices, touch/recency/wick scoring - but in
+//  O(n) per pass over the bars (packed array or SoA columns):
+//  - swings: sliding window max/min with a monotonic deque (direct
+//    neighbour checks for a compile-time window, see pipeline_variants.h)
+//  - clustering: one pass over the sorted prices with a running sum
+//  - scoring: one tight loop over the bars per level
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "bar.h"
+#include "bar_columns.h"
+
+namespace volarix4::core {
+
+enum PipelineVariant : int;     // pipeline_variants.h
+
+enum LevelType : int
+{
+    kSupport = 0,
+    kResistance = 1
+};
+
+#pragma pack(push, 1)
+// S/R detection parameters (C ABI - also passed in from MQL5)
+struct SRParams
+{
+    int swingWindow;          // Bars on each side of a swing point (5)
+    double clusterPips;       // Max gap between swing prices in one cluster (10)
+    double touchPips;         // Max distance of a high/low to count as touch (10)
+    double minScore;          // Minimum level score to keep (60)
+    double pipValue;          // 0.0001, or 0.01 for JPY pairs
+    int recentBars;           // Bars checked for recent touch / strong wick (20)
+    double wickBodyRatio;     // Wick-to-body ratio for a strong rejection (1.5)
+};
+
+// Detected level (C ABI - 20 bytes)
+struct SRLevel
+{
+    double level;             // Price, rounded to 5 decimals
+    double score;             // 0-100, rounded to 1 decimal
+    int type;                 // LevelType
+};
+#pragma pack(pop)
+
+// Defaults matching SR_CONFIG / detect_sr_levels()
+SRParams DefaultSRParams(double pip_value = 0.0001);
+
+// Indices i with high[i] strictly above the `window` highs on each side
+std::vector<size_t> FindSwingHighs(const OHLCVBar* bars, size_t count, int window);
+
+// Indices i with low[i] strictly below the `window` lows on each side
+std::vector<size_t> FindSwingLows(const OHLCVBar* bars, size_t count, int window);
+
+// Sort prices and merge neighbours no more than threshold_price apart
+// (chained, like cluster_levels); returns each cluster's mean, ascending
+std::vector<double> ClusterLevels(std::vector<double> prices, double threshold_price);
+
+// Bars whose high or low is within threshold_price of level
+int CountTouches(double level, const OHLCVBar* bars, size_t count, double threshold_price);
+
+// Score 0-100: 20 per touch, +50 for a touch in the last recentBars bars,
+// +20 for a strong rejection wick at the level in the last recentBars bars
+double ScoreLevel(double level, const OHLCVBar* bars, size_t count,
+                  LevelType type, const SRParams& params);
+
+// Same score from a touch count already known for the whole window;
+// recent holds the window's newest recentBars bars
+double ScoreLevel(double level, int touches, const BarColumns& recent,
+                  LevelType type, const SRParams& params);
+
+// Same, with the parameter set SelectSRVariant(params) picked once for a
+// run of calls on the same params
+double ScoreLevel(double level, int touches, const BarColumns& recent,
+                  LevelType type, const SRParams& params, PipelineVariant variant);
+
+// Full detect_sr_levels(): supports then resistances, filtered by minScore,
+// rounded, stable-sorted by score descending
+std::vector<SRLevel> DetectSRLevels(const OHLCVBar* bars, size_t count, const SRParams& params);
+
+// Same, read in place from columns (e.g. the bar store)
+std::vector<SRLevel> DetectSRLevels(const BarColumns& bars, const SRParams& params);
+
+} // namespace volarix4::core
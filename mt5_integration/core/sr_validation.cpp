@@ -0,0 +1,141 @@
+//=============================================================================
+//  core/sr_validation.cpp
+//  Broken S/R level filter (mirrors volarix4/core/sr_validation.py)
+//=============================================================================
+#include "sr_validation.h"
+
+#include <limits>
+
+#include "helpers.h"
+
+namespace volarix4::core {
+
+namespace {
+
+constexpr size_t kBreakLookbackBars = 10;
+
+// Lowest and highest of the last 10 closes. NaN closes break nothing (every
+// comparison is false), so they are skipped; no closes leave +-infinity.
+template <typename CloseAt>
+void RecentCloseRange(CloseAt close_at, size_t count, double* lowest, double* highest)
+{
+    *lowest = std::numeric_limits<double>::infinity();
+    *highest = -std::numeric_limits<double>::infinity();
+    for (size_t i = count > kBreakLookbackBars ? count - kBreakLookbackBars : 0; i < count; ++i) {
+        const double close = close_at(i);
+        if (close < *lowest)
+            *lowest = close;
+        if (close > *highest)
+            *highest = close;
+    }
+}
+
+} // namespace
+
+bool SRLevelValidator::IsLevelBroken(double level, LevelType type,
+                                     const OHLCVBar* bars, size_t count) const
+{
+    const double distance = invalidation_pips_ * pip_value_;
+    const size_t first = count > kBreakLookbackBars ? count - kBreakLookbackBars : 0;
+
+    for (size_t i = first; i < count; ++i)
+    {
+        if (type == kSupport ? bars[i].close < level - distance
+                             : bars[i].close > level + distance)
+            return true;
+    }
+    return false;
+}
+
+bool SRLevelValidator::IsLevelBroken(double level, LevelType type,
+                                     const double* close, size_t count) const
+{
+    const double distance = invalidation_pips_ * pip_value_;
+    const size_t first = count > kBreakLookbackBars ? count - kBreakLookbackBars : 0;
+
+    for (size_t i = first; i < count; ++i)
+    {
+        if (type == kSupport ? close[i] < level - distance
+                             : close[i] > level + distance)
+            return true;
+    }
+    return false;
+}
+
+void SRLevelValidator::MarkBrokenLevel(double level, Clock::time_point when)
+{
+    const double key = RoundTo(level, 5);
+    broken_[key] = when;
+    expiry_.emplace(when, key);
+}
+
+bool SRLevelValidator::IsLevelInCooldown(double level, Clock::time_point now)
+{
+    Expire(now);
+    return broken_.count(RoundTo(level, 5)) != 0;
+}
+
+bool SRLevelValidator::Expired(Clock::time_point broken_at, Clock::time_point now) const
+{
+    std::chrono::duration<double, std::ratio<3600>> since_break = now - broken_at;
+    return !(since_break.count() < cooldown_hours_);
+}
+
+void SRLevelValidator::Expire(Clock::time_point now)
+{
+    // Hours since a break only shrink from the top of the heap down, so the
+    // first live break still cooling down ends the sweep
+    while (!expiry_.empty()) {
+        const Break& top = expiry_.top();
+        auto it = broken_.find(top.second);
+        if (it != broken_.end() && it->second == top.first) {
+            if (!Expired(top.first, now))
+                return;
+            broken_.erase(it);
+        }
+        expiry_.pop();
+    }
+}
+
+std::vector<SRLevel> SRLevelValidator::Validate(const std::vector<SRLevel>& levels, double lowest_close,
+                                                double highest_close)
+{
+    std::vector<SRLevel> valid;
+    valid.reserve(levels.size());
+    const Clock::time_point now = Clock::now();
+    const double distance = invalidation_pips_ * pip_value_;
+
+    for (const SRLevel& level : levels)
+    {
+        if (IsLevelInCooldown(level.level, now))
+            continue;
+
+        // Some recent close beyond the level <=> the most extreme one is
+        if ((LevelType)level.type == kSupport ? lowest_close < level.level - distance
+                                              : highest_close > level.level + distance) {
+            MarkBrokenLevel(level.level, now);
+            continue;
+        }
+
+        valid.push_back(level);
+    }
+    return valid;
+}
+
+std::vector<SRLevel> SRLevelValidator::ValidateLevels(const std::vector<SRLevel>& levels,
+                                                      const OHLCVBar* bars, size_t count)
+{
+    double lowest, highest;
+    RecentCloseRange([&](size_t i) { return bars[i].close; }, count, &lowest, &highest);
+    return Validate(levels, lowest, highest);
+}
+
+std::vector<SRLevel> SRLevelValidator::ValidateLevels(const std::vector<SRLevel>& levels,
+                                                      const BarColumns& bars)
+{
+    double lowest, highest;
+    RecentCloseRange([&](size_t i) { return bars.close[i]; }, bars.count, &lowest, &highest);
+    return Validate(levels, lowest, highest);
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,83 @@
+//=============================================================================
+//  core/sr_validation.h
+//  Broken S/R level filter (mirrors volarix4/core/sr_validation.py)
+//
+//  A level is broken when one of the last 10 closes is more than
+//  invalidationPips through it; broken levels are skipped for cooldownHours
+//  (keyed by the level rounded to 5 decimals).
+//
+//  The pipeline (signal_pipeline.cpp) builds a fresh validator per request,
+//  like the API, so its cooldown map only ever holds the levels broken in
+//  that call. What each call saves is the break test: ValidateLevels reads
+//  the lowest and highest of the recent closes once, then tests every level
+//  against them with one comparison instead of rescanning the 10 closes per
+//  level (BM_ValidateLevels in bench/bench_kernels.cpp).
+//
+//  Broken levels are indexed by price (an ordered map from the rounded
+//  level to its break time) for the cooldown lookup and by break time (a
+//  min-heap) for expiry - with one cooldown for every level, the oldest
+//  break is the first to expire. A re-marked level leaves its old heap
+//  entry behind, which is discarded when it reaches the top. Both stay
+//  O(log n) should a caller keep one validator across many calls.
+//=============================================================================
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "bar.h"
+#include "bar_columns.h"
+#include "sr_levels.h"
+
+namespace volarix4::core {
+
+class SRLevelValidator
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SRLevelValidator(double pip_value = 0.0001, double cooldown_hours = 24.0,
+                     double invalidation_pips = 15.0)
+        : pip_value_(pip_value), cooldown_hours_(cooldown_hours),
+          invalidation_pips_(invalidation_pips) {}
+
+    // Close beyond the level by more than invalidation_pips in the last 10 bars
+    bool IsLevelBroken(double level, LevelType type, const OHLCVBar* bars, size_t count) const;
+    bool IsLevelBroken(double level, LevelType type, const double* close, size_t count) const;
+
+    void MarkBrokenLevel(double level, Clock::time_point when);
+
+    // Still cooling down after a break; entries expired at now are dropped
+    // (now must not go backwards between calls)
+    bool IsLevelInCooldown(double level, Clock::time_point now);
+
+    // Levels that are neither cooling down nor broken by recent price action,
+    // in their original order
+    std::vector<SRLevel> ValidateLevels(const std::vector<SRLevel>& levels,
+                                        const OHLCVBar* bars, size_t count);
+    std::vector<SRLevel> ValidateLevels(const std::vector<SRLevel>& levels, const BarColumns& bars);
+
+    size_t BrokenLevelCount() const { return broken_.size(); }
+
+private:
+    using Break = std::pair<Clock::time_point, double>;         // (broken at, rounded level)
+
+    bool Expired(Clock::time_point broken_at, Clock::time_point now) const;
+    void Expire(Clock::time_point now);
+
+    std::vector<SRLevel> Validate(const std::vector<SRLevel>& levels, double lowest_close,
+                                  double highest_close);
+
+    double pip_value_;
+    double cooldown_hours_;
+    double invalidation_pips_;
+    std::map<double, Clock::time_point> broken_;                // Rounded level -> broken at
+    std::priority_queue<Break, std::vector<Break>, std::greater<Break>> expiry_;   // Oldest first
+};
+
+} // namespace volarix4::core
@@ -0,0 +1,169 @@
+//=============================================================================
+//  core/tick_file.cpp
+//  Columnar tick history file (.v4ticks) for real-tick exit replay: written
+//  from tick columns, read through a read-only memory mapping
+//=============================================================================
+#include "tick_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace volarix4::core {
+
+namespace {
+
+uint64_t AlignColumn(uint64_t offset)
+{
+    return (offset + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+}
+
+uint64_t IndexCount(uint64_t ticks, uint64_t stride)
+{
+    return (ticks + stride - 1) / stride;
+}
+
+} // namespace
+
+bool WriteTickFile(const std::string& path, std::string_view symbol, const TickColumns& ticks,
+                   std::string* error)
+{
+    for (size_t i = 1; i < ticks.count; ++i) {
+        if (ticks.timeMsc[i] < ticks.timeMsc[i - 1]) {
+            *error = "Ticks are not in time order at tick " + std::to_string(i);
+            return false;
+        }
+    }
+
+    TickFileHeader header{};
+    header.magic = kTickFileMagic;
+    header.version = kTickFileVersion;
+    header.headerBytes = sizeof(TickFileHeader);
+    header.indexStride = kTickFileIndexStride;
+    header.tickCount = ticks.count;
+    header.firstTimeMsc = ticks.count ? ticks.timeMsc[0] : 0;
+    header.lastTimeMsc = ticks.count ? ticks.timeMsc[ticks.count - 1] : 0;
+    std::memcpy(header.symbol, symbol.data(), std::min(symbol.size(), sizeof(header.symbol) - 1));
+
+    uint64_t offset = AlignColumn(sizeof(TickFileHeader));
+    for (int c = 0; c < kTickFileColumns; ++c) {
+        header.columnOffset[c] = offset;
+        offset = AlignColumn(offset + ticks.count * sizeof(double));
+    }
+    header.indexOffset = offset;
+    header.indexCount = IndexCount(ticks.count, kTickFileIndexStride);
+    header.fileBytes = offset + header.indexCount * sizeof(int64_t);
+
+    std::vector<int64_t> index(header.indexCount);
+    for (size_t k = 0; k < index.size(); ++k)
+        index[k] = ticks.timeMsc[k * kTickFileIndexStride];
+
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            *error = "Cannot write tick file: " + temp;
+            return false;
+        }
+
+        static const char kPadding[kColumnAlignment] = {};
+        uint64_t written = 0;
+        auto write = [&](const void* data, uint64_t size, uint64_t at) {
+            out.write(kPadding, (std::streamsize)(at - written));
+            out.write(static_cast<const char*>(data), (std::streamsize)size);
+            written = at + size;
+        };
+
+        const void* columns[kTickFileColumns] = { ticks.timeMsc, ticks.bid, ticks.ask };
+        write(&header, sizeof(header), 0);
+        for (int c = 0; c < kTickFileColumns; ++c)
+            write(columns[c], ticks.count * sizeof(double), header.columnOffset[c]);
+        write(index.data(), index.size() * sizeof(int64_t), header.indexOffset);
+
+        out.close();
+        if (!out) {
+            *error = "Cannot write tick file: " + temp;
+            std::error_code ec;
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        *error = "Cannot replace tick file " + path + ": " + ec.message();
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool MappedTickFile::Open(const std::string& path, std::string* error)
+{
+    Close();
+    if (!file_.Open(path, sizeof(TickFileHeader), "tick file", error))
+        return false;
+    const uint8_t* base = file_.Data();
+    const size_t bytes = file_.Size();
+
+    // Everything the views point at must lie inside the mapping
+    TickFileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    const uint64_t column_bytes = header.tickCount * sizeof(double);
+    bool valid = header.magic == kTickFileMagic && header.version == kTickFileVersion &&
+                 header.headerBytes == sizeof(TickFileHeader) && header.indexStride > 0 &&
+                 header.fileBytes == bytes && header.tickCount <= bytes / sizeof(double) &&
+                 header.indexCount == IndexCount(header.tickCount, header.indexStride) &&
+                 header.indexOffset % sizeof(int64_t) == 0 &&
+                 header.indexOffset <= bytes &&
+                 header.indexCount <= (bytes - header.indexOffset) / sizeof(int64_t);
+    for (int c = 0; c < kTickFileColumns && valid; ++c)
+        valid = header.columnOffset[c] % sizeof(double) == 0 && header.columnOffset[c] <= bytes &&
+                column_bytes <= bytes - header.columnOffset[c];
+    if (!valid) {
+        Close();
+        *error = "Not a tick file (bad header): " + path;
+        return false;
+    }
+
+    ticks_.timeMsc = reinterpret_cast<const long long*>(base + header.columnOffset[kTickFileTime]);
+    ticks_.bid = reinterpret_cast<const double*>(base + header.columnOffset[kTickFileBid]);
+    ticks_.ask = reinterpret_cast<const double*>(base + header.columnOffset[kTickFileAsk]);
+    ticks_.count = (size_t)header.tickCount;
+    index_ = reinterpret_cast<const int64_t*>(base + header.indexOffset);
+    index_count_ = (size_t)header.indexCount;
+    index_stride_ = header.indexStride;
+    symbol_ = std::string(header.symbol, std::find(header.symbol, header.symbol + sizeof(header.symbol), '\0'));
+
+    if (ticks_.count > 0 && (ticks_.timeMsc[0] != header.firstTimeMsc ||
+                             ticks_.timeMsc[ticks_.count - 1] != header.lastTimeMsc)) {
+        Close();
+        *error = "Not a tick file (time range does not match): " + path;
+        return false;
+    }
+    return true;
+}
+
+void MappedTickFile::Close()
+{
+    file_.Close();
+    ticks_ = TickColumns();
+    index_ = nullptr;
+    index_count_ = 0;
+    symbol_.clear();
+}
+
+size_t MappedTickFile::LowerBound(long long time_msc) const
+{
+    // Index entries before time_msc pick the block; equal times may start in
+    // the block before the first entry that reaches time_msc
+    const size_t entry = (size_t)(std::lower_bound(index_, index_ + index_count_, (int64_t)time_msc) - index_);
+    const size_t first = entry == 0 ? 0 : (entry - 1) * index_stride_;
+    const size_t end = std::min(ticks_.count, entry * index_stride_ + 1);
+    return (size_t)(std::lower_bound(ticks_.timeMsc + first, ticks_.timeMsc + end, time_msc) - ticks_.timeMsc);
+}
+
+} // namespace volarix4::core
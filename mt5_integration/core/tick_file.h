@@ -0,0 +1,129 @@
+//=============================================================================
+//  core/tick_file.h
+//  Columnar tick history file (.v4ticks) for real-tick exit replay: written
+//  from tick columns, read through a read-only memory mapping
+//
+//  Same layout idea as the bar file (bar_file.h), with millisecond times
+//  (MqlTick.time_msc) and a bid and an ask column:
+//
+//    TickFileHeader                256 bytes
+//    time_msc int64[tickCount]     each column starts on a 64-byte boundary
+//    bid      double[tickCount]
+//    ask      double[tickCount]
+//    index    int64[indexCount]    time_msc of tick k * indexStride
+//
+//  Times ascend (equal times allowed: several ticks per millisecond). Years
+//  of EURUSD ticks are gigabytes, which is why the replay never loads a
+//  file: it walks the mapped columns once, bar by bar.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "bar_columns.h"
+#include "mapped_file.h"
+
+namespace volarix4::core {
+
+constexpr uint32_t kTickFileMagic = 0x4B543456;     // "V4TK"
+constexpr uint32_t kTickFileVersion = 1;
+constexpr uint32_t kTickFileIndexStride = 4096;
+
+enum TickFileColumn : int
+{
+    kTickFileTime = 0,
+    kTickFileBid,
+    kTickFileAsk,
+    kTickFileColumns
+};
+
+// Read-only view of count ticks, oldest first
+struct TickColumns
+{
+    const long long* timeMsc = nullptr;
+    const double* bid = nullptr;
+    const double* ask = nullptr;
+    size_t count = 0;
+
+    TickColumns Slice(size_t first, size_t length) const
+    {
+        return TickColumns{ timeMsc + first, bid + first, ask + first, length };
+    }
+};
+
+// Owned, aligned tick columns
+struct TickBuffer
+{
+    AlignedVector<long long> timeMsc;
+    AlignedVector<double> bid;
+    AlignedVector<double> ask;
+
+    void Append(long long time_msc, double bid_price, double ask_price)
+    {
+        timeMsc.push_back(time_msc);
+        bid.push_back(bid_price);
+        ask.push_back(ask_price);
+    }
+
+    TickColumns View() const { return TickColumns{ timeMsc.data(), bid.data(), ask.data(), timeMsc.size() }; }
+};
+
+struct TickFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerBytes;                       // sizeof(TickFileHeader)
+    uint32_t indexStride;
+    uint64_t tickCount;
+    int64_t firstTimeMsc;                       // 0 for an empty file
+    int64_t lastTimeMsc;
+    uint64_t columnOffset[kTickFileColumns];    // Byte offsets from the file start
+    uint64_t indexOffset;
+    uint64_t indexCount;
+    uint64_t fileBytes;
+    char symbol[32];                            // NUL-padded
+    uint8_t reserved[136];
+};
+
+static_assert(sizeof(TickFileHeader) == 256, "TickFileHeader is part of the file format");
+
+// Write ticks (oldest first, non-decreasing times) to path. False with
+// *error on unsorted ticks or an I/O failure; an existing file is only
+// replaced once the new one is complete.
+bool WriteTickFile(const std::string& path, std::string_view symbol, const TickColumns& ticks,
+                   std::string* error);
+
+// Read-only mapping of a tick file. Move-only; the view returned by Ticks()
+// lives as long as the object.
+class MappedTickFile
+{
+public:
+    MappedTickFile() = default;
+
+    // Map path and check its header against the file size. False with
+    // *error for a missing, truncated or foreign file.
+    bool Open(const std::string& path, std::string* error);
+    void Close();
+
+    bool IsOpen() const { return file_.IsOpen(); }
+
+    const TickColumns& Ticks() const { return ticks_; }
+    std::string_view Symbol() const { return symbol_; }
+
+    // Index of the first tick at or after time_msc (Ticks().count if none)
+    size_t LowerBound(long long time_msc) const;
+
+private:
+    MappedFile file_;
+    TickColumns ticks_;
+    const int64_t* index_ = nullptr;
+    size_t index_count_ = 0;
+    size_t index_stride_ = kTickFileIndexStride;
+    std::string symbol_;
+};
+
+} // namespace volarix4::core
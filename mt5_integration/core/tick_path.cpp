@@ -0,0 +1,78 @@
+//=============================================================================
+//  core/tick_path.cpp
+//  Intrabar exit resolution for the native backtest: synthetic OHLC price
+//  paths and real-tick replay (replaces tests/backtest_engine/tick_generator.py)
+//=============================================================================
+#include "tick_path.h"
+
+#include <algorithm>
+
+namespace volarix4::core {
+
+void BarPath(double open, double high, double low, double close, PathModel model, double path[4])
+{
+    const bool low_first = model == kPathOlhc || (model == kPathByDirection && close >= open);
+    path[0] = open;
+    path[1] = low_first ? low : high;
+    path[2] = low_first ? high : low;
+    path[3] = close;
+}
+
+ExitSimulator::ExitSimulator(const BrokerSimulator& broker, ExitModel model, PathModel path,
+                             const TickColumns* ticks)
+    : broker_(broker), model_(model), path_(path), ticks_(ticks)
+{
+}
+
+bool ExitSimulator::UpdateOnPath(Trade& trade, long long time, double open, double high, double low,
+                                 double close) const
+{
+    double path[4];
+    BarPath(open, high, low, close, path_, path);
+    bool updated = false;
+    for (int k = 0; k < 4 && !trade.IsClosed(); ++k)
+        updated = broker_.UpdateTradeAtPrice(trade, time, path[k], k > 0) || updated;
+    return updated;
+}
+
+bool ExitSimulator::Update(Trade& trade, const BarColumns& bars, size_t i, long long bar_seconds)
+{
+    const long long time = bars.time[i];
+    switch (model_) {
+        case kExitOpenOnly:
+            return broker_.UpdateTradeAtPrice(trade, time, bars.open[i], false);
+        case kExitPricePath:
+            return UpdateOnPath(trade, time, bars.open[i], bars.high[i], bars.low[i], bars.close[i]);
+        case kExitTicks:
+            break;
+        default:
+            return broker_.UpdateTrade(trade, time, bars.high[i], bars.low[i], bars.close[i]);
+    }
+
+    // The bar's ticks: from its open time up to the next bar's (or
+    // bar_seconds after it for the newest bar)
+    const long long begin_msc = time * 1000;
+    const long long end_msc = (i + 1 < bars.count ? bars.time[i + 1] : time + bar_seconds) * 1000;
+    const TickColumns& ticks = *ticks_;
+    if (cursor_ > 0 && cursor_ <= ticks.count && ticks.timeMsc[cursor_ - 1] >= begin_msc)
+        cursor_ = 0;       // Bars went back in time (a new run on the same simulator)
+    cursor_ = (size_t)(std::lower_bound(ticks.timeMsc + cursor_, ticks.timeMsc + ticks.count, begin_msc) - ticks.timeMsc);
+
+    size_t end = cursor_;
+    while (end < ticks.count && ticks.timeMsc[end] < end_msc)
+        ++end;
+    if (end == cursor_) {
+        ++bars_without_ticks_;
+        return UpdateOnPath(trade, time, bars.open[i], bars.high[i], bars.low[i], bars.close[i]);
+    }
+
+    bool updated = false;
+    for (size_t t = cursor_; t < end && !trade.IsClosed(); ++t) {
+        updated = broker_.UpdateTradeAtPrice(trade, ticks.timeMsc[t] / 1000, ticks.bid[t], false) || updated;
+        ++ticks_replayed_;
+    }
+    cursor_ = end;
+    return updated;
+}
+
+} // namespace volarix4::core
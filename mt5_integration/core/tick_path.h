@@ -0,0 +1,74 @@
+//=============================================================================
+//  core/tick_path.h
+//  Intrabar exit resolution for the native backtest: synthetic OHLC price
+//  paths and real-tick replay (replaces tests/backtest_engine/tick_generator.py)
+//
+//  broker_sim.py only sees a bar's high and low, so when a bar reaches both
+//  the SL and a TP it assumes the SL came first. The other exit models walk
+//  a price path through the bar instead and fill whichever level the path
+//  reaches first:
+//  - open only: one tick at the bar's open (MT5 "Open prices only")
+//  - price path: open, both extremes, close - O-H-L-C, O-L-H-C, or by bar
+//    direction like MT5's OHLC modelling (a bullish bar dips first)
+//  - ticks: the real ticks inside the bar, from a mapped tick file
+//    (tick_file.h); a bar the file has no ticks for falls back to the path
+//  Prices are bids, like the bars: the spread stays in the cost model.
+//  Paths are deterministic and the tick replay only moves forward, so a run
+//  over years of ticks reads each tick once.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+
+#include "bar_columns.h"
+#include "broker_sim.h"
+#include "tick_file.h"
+
+namespace volarix4::core {
+
+enum ExitModel : int
+{
+    kExitBarRange = 0,          // broker_sim.py: bar high/low, SL first
+    kExitOpenOnly,
+    kExitPricePath,
+    kExitTicks
+};
+
+enum PathModel : int
+{
+    kPathByDirection = 0,       // Close >= open: O-L-H-C, else O-H-L-C
+    kPathOhlc,
+    kPathOlhc
+};
+
+// The four points of a bar's synthetic path
+void BarPath(double open, double high, double low, double close, PathModel model, double path[4]);
+
+class ExitSimulator
+{
+public:
+    // ticks is only read by kExitTicks and must outlive the simulator
+    ExitSimulator(const BrokerSimulator& broker, ExitModel model, PathModel path,
+                  const TickColumns* ticks = nullptr);
+
+    // Update the open trade with bar i of bars (update_trade() for
+    // kExitBarRange); bar_seconds bounds the newest bar's ticks. Bars must
+    // come in ascending order. True if anything was closed.
+    bool Update(Trade& trade, const BarColumns& bars, size_t i, long long bar_seconds);
+
+    size_t TicksReplayed() const { return ticks_replayed_; }
+    size_t BarsWithoutTicks() const { return bars_without_ticks_; }
+
+private:
+    bool UpdateOnPath(Trade& trade, long long time, double open, double high, double low, double close) const;
+
+    const BrokerSimulator& broker_;
+    ExitModel model_;
+    PathModel path_;
+    const TickColumns* ticks_;
+    size_t cursor_ = 0;          // First tick not before the last bar replayed
+    size_t ticks_replayed_ = 0;
+    size_t bars_without_ticks_ = 0;
+};
+
+} // namespace volarix4::core
@@ -0,0 +1,52 @@
+//=============================================================================
+//  core/trade_setup.cpp
+//  SL/TP calculation (mirrors volarix4/core/trade_setup.py)
+//=============================================================================
+#include "trade_setup.h"
+
+#include <cmath>
+
+#include "helpers.h"
+
+namespace volarix4::core {
+
+TradeLevels CalculateSlTp(double entry, double level, SignalDirection direction,
+                          double pip_value, const RiskParams& params)
+{
+    const double sl_distance = params.slPipsBeyond * pip_value;
+    const double* r = params.tpRatios;
+
+    double sl, risk_pips, tp1, tp2, tp3;
+    if (direction == kDirectionBuy) {
+        sl = level - sl_distance;
+        risk_pips = (entry - sl) / pip_value;
+        tp1 = entry + (r[0] * (entry - sl));
+        tp2 = entry + (r[1] * (entry - sl));
+        tp3 = entry + (r[2] * (entry - sl));
+    } else {
+        sl = level + sl_distance;
+        risk_pips = (sl - entry) / pip_value;
+        tp1 = entry - (r[0] * (sl - entry));
+        tp2 = entry - (r[1] * (sl - entry));
+        tp3 = entry - (r[2] * (sl - entry));
+    }
+
+    const double reward = std::fabs(tp2 - entry) / pip_value;
+    const double risk_reward = risk_pips > 0 ? reward / risk_pips : 0.0;
+
+    TradeLevels levels;
+    levels.sl = RoundTo(sl, 5);
+    levels.tp1 = RoundTo(tp1, 5);
+    levels.tp2 = RoundTo(tp2, 5);
+    levels.tp3 = RoundTo(tp3, 5);
+    levels.slPips = RoundTo(risk_pips, 1);
+    levels.riskReward = RoundTo(risk_reward, 2);
+    return levels;
+}
+
+bool PassesRiskLimits(const TradeLevels& levels, const RiskParams& params)
+{
+    return !(levels.slPips > params.maxSlPips) && !(levels.riskReward < params.minRiskReward);
+}
+
+} // namespace volarix4::core
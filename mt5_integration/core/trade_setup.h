@@ -0,0 +1,38 @@
+//=============================================================================
+//  core/trade_setup.h
+//  SL/TP calculation (mirrors volarix4/core/trade_setup.py)
+//=============================================================================
+#pragma once
+
+#include "trend_filter.h"
+
+namespace volarix4::core {
+
+// RISK_CONFIG
+struct RiskParams
+{
+    double slPipsBeyond = 10.0;
+    double maxSlPips = 25.0;
+    double minRiskReward = 1.5;
+    double tpRatios[3] = { 1.0, 2.0, 3.0 };
+    double tpPercents[3] = { 0.50, 0.30, 0.20 };
+};
+
+struct TradeLevels
+{
+    double sl;                // Rounded to 5 decimals
+    double tp1, tp2, tp3;     // Rounded to 5 decimals
+    double slPips;            // Rounded to 1 decimal
+    double riskReward;        // TP2 reward / risk, rounded to 2 decimals
+};
+
+// calculate_sl_tp(): SL slPipsBeyond pips beyond the level, TPs at tpRatios
+// multiples of the risk from entry
+TradeLevels CalculateSlTp(double entry, double level, SignalDirection direction,
+                          double pip_value, const RiskParams& params = RiskParams());
+
+// calculate_trade_setup()'s risk gate: SL within maxSlPips and R:R at least
+// minRiskReward
+bool PassesRiskLimits(const TradeLevels& levels, const RiskParams& params = RiskParams());
+
+} // namespace volarix4::core
@@ -0,0 +1,213 @@
+//=============================================================================
+//  core/trend_filter.cpp
+//  Dual-EMA trend filter (mirrors volarix4/core/trend_filter.py)
+//=============================================================================
+#include "trend_filter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <string_view>
+
+#include "helpers.h"
+#include "pipeline_variants.h"
+
+namespace volarix4::core {
+
+const char* TrendName(Trend trend)
+{
+    switch (trend)
+    {
+    case kUptrend:   return "UPTREND";
+    case kDowntrend: return "DOWNTREND";
+    default:         return "SIDEWAYS";
+    }
+}
+
+namespace {
+
+// pandas ewm(adjust=False): com = (span - 1) / 2, alpha = 1 / (1 + com),
+// and each step re-normalises by (old_wt + new_wt) with old_wt = 1 - alpha
+template <typename CloseAt, typename Weights>
+double Ema(CloseAt close_at, size_t count, const Weights& w)
+{
+    if (count == 0)
+        return 0.0;
+
+    double weighted = close_at(0);
+    for (size_t i = 1; i < count; ++i)
+    {
+        double cur = close_at(i);
+        if (weighted != cur)
+            weighted = (w.oldWeight * weighted + w.alpha * cur) / w.norm;
+    }
+    return weighted;
+}
+
+// Both EMAs in one pass: two independent recurrences per bar, so one
+// chain's latency hides the other's
+template <typename Fast, typename Slow>
+void EmaPair(const double* close, size_t count, const Fast& fw, const Slow& sw, double* fast, double* slow)
+{
+    double f = close[0], s = close[0];
+    for (size_t i = 1; i < count; ++i)
+    {
+        const double cur = close[i];
+        if (f != cur)
+            f = (fw.oldWeight * f + fw.alpha * cur) / fw.norm;
+        if (s != cur)
+            s = (sw.oldWeight * s + sw.alpha * cur) / sw.norm;
+    }
+    *fast = f;
+    *slow = s;
+}
+
+// A value's 5-decimal digits, formatted once for both the reason text
+// (AppendFixed) and the rounded field (RoundTo)
+struct FixedDigits
+{
+    explicit FixedDigits(double value) : rounded(value)
+    {
+        auto written = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 5);
+        length = written.ec == std::errc() ? (size_t)(written.ptr - digits) : 0;
+        if (length > 0 && std::isfinite(value))
+            std::from_chars(digits, digits + length, rounded);
+    }
+
+    std::string_view Text() const { return std::string_view(digits, length); }
+
+    char digits[64];
+    size_t length;
+    double rounded;
+};
+
+} // namespace
+
+// Trend, strength and reason text for the closing price and both EMAs
+TrendInfo ClassifyTrend(double price, double fast, double slow, int ema_fast, int ema_slow)
+{
+    TrendInfo info;
+
+    const FixedDigits price_digits(price), fast_digits(fast), slow_digits(slow);
+    std::string& reason = info.reason;
+    reason.reserve(96);
+    auto value = [&reason](const FixedDigits& digits) { reason += digits.Text(); };
+    auto ema = [&reason](int period) {
+        char digits[16];
+        reason += "EMA";
+        reason.append(digits, std::to_chars(digits, digits + sizeof(digits), period).ptr);
+    };
+
+    double strength = 0.0;
+    if (price > fast && fast > slow) {
+        info.trend = kUptrend;
+        strength = std::min((fast - slow) / slow * 100, 1.0);
+        info.allowBuy = true;
+        reason += "Price (";
+        value(price_digits);
+        reason += ") > ";
+        ema(ema_fast);
+        reason += " (";
+        value(fast_digits);
+        reason += ") > ";
+        ema(ema_slow);
+        reason += " (";
+        value(slow_digits);
+        reason += ")";
+    } else if (price < fast && fast < slow) {
+        info.trend = kDowntrend;
+        strength = std::min((slow - fast) / slow * 100, 1.0);
+        info.allowSell = true;
+        reason += "Price (";
+        value(price_digits);
+        reason += ") < ";
+        ema(ema_fast);
+        reason += " (";
+        value(fast_digits);
+        reason += ") < ";
+        ema(ema_slow);
+        reason += " (";
+        value(slow_digits);
+        reason += ")";
+    } else if (fast < slow) {
+        reason += "EMAs bearish but price (";
+        value(price_digits);
+        reason += ") above ";
+        ema(ema_fast);
+        reason += " (";
+        value(fast_digits);
+        reason += ")";
+    } else if (fast > slow) {
+        reason += "EMAs bullish but price (";
+        value(price_digits);
+        reason += ") below ";
+        ema(ema_fast);
+        reason += " (";
+        value(fast_digits);
+        reason += ")";
+    } else {
+        reason = "EMAs crossed - trend unclear";
+    }
+
+    info.strength = RoundTo(strength, 3);
+    info.emaFast = fast_digits.rounded;
+    info.emaSlow = slow_digits.rounded;
+    info.currentPrice = price_digits.rounded;
+    return info;
+}
+
+double CalculateEma(const OHLCVBar* bars, size_t count, int period)
+{
+    return Ema([bars](size_t i) { return bars[i].close; }, count, RuntimeEmaWeights(period));
+}
+
+double CalculateEma(const double* close, size_t count, int period)
+{
+    return Ema([close](size_t i) { return close[i]; }, count, RuntimeEmaWeights(period));
+}
+
+TrendInfo DetectTrend(const OHLCVBar* bars, size_t count, int ema_fast, int ema_slow)
+{
+    if (count < (size_t)(ema_slow + 10)) {
+        TrendInfo info;
+        info.reason = "Insufficient data (need " + std::to_string(ema_slow + 10) + " bars)";
+        return info;
+    }
+
+    return DispatchTrend(ema_fast, ema_slow, [&](const auto& fast, const auto& slow) {
+        auto close_at = [bars](size_t i) { return bars[i].close; };
+        return ClassifyTrend(bars[count - 1].close, Ema(close_at, count, fast), Ema(close_at, count, slow),
+                             ema_fast, ema_slow);
+    });
+}
+
+TrendInfo DetectTrend(const BarColumns& bars, int ema_fast, int ema_slow)
+{
+    if (bars.count < (size_t)(ema_slow + 10)) {
+        TrendInfo info;
+        info.reason = "Insufficient data (need " + std::to_string(ema_slow + 10) + " bars)";
+        return info;
+    }
+
+    return DispatchTrend(ema_fast, ema_slow, [&](const auto& fast_weights, const auto& slow_weights) {
+        double fast, slow;
+        EmaPair(bars.close, bars.count, fast_weights, slow_weights, &fast, &slow);
+        return ClassifyTrend(bars.close[bars.count - 1], fast, slow, ema_fast, ema_slow);
+    });
+}
+
+TrendValidation ValidateSignalWithTrend(SignalDirection direction, const TrendInfo& trend)
+{
+    TrendValidation result;
+    const char* name = direction == kDirectionBuy ? "BUY" : "SELL";
+    bool allowed = direction == kDirectionBuy ? trend.allowBuy : trend.allowSell;
+
+    result.valid = allowed;
+    if (allowed)
+        result.reason = std::string(name) + " signal aligns with " + TrendName(trend.trend);
+    else
+        result.reason = std::string(name) + " signal rejected - " + trend.reason;
+    return result;
+}
+
+} // namespace volarix4::core
@@ -0,0 +1,64 @@
+//=============================================================================
+//  core/trend_filter.h
+//  Dual-EMA trend filter (mirrors volarix4/core/trend_filter.py)
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "bar.h"
+#include "bar_columns.h"
+
+namespace volarix4::core {
+
+enum Trend : int
+{
+    kSideways = 0,
+    kUptrend = 1,
+    kDowntrend = 2
+};
+
+enum SignalDirection : int
+{
+    kDirectionBuy = 1,
+    kDirectionSell = 2
+};
+
+struct TrendInfo
+{
+    Trend trend = kSideways;
+    double strength = 0.0;       // 0-1, rounded to 3 decimals
+    double emaFast = 0.0;        // Rounded to 5 decimals
+    double emaSlow = 0.0;        // Rounded to 5 decimals
+    double currentPrice = 0.0;   // Rounded to 5 decimals
+    bool allowBuy = false;
+    bool allowSell = false;
+    std::string reason;
+};
+
+struct TrendValidation
+{
+    bool valid = false;
+    std::string reason;
+};
+
+const char* TrendName(Trend trend);
+
+// Last value of close.ewm(span=period, adjust=False).mean(), evaluated with
+// the same recurrence as pandas so the result is bit-identical
+double CalculateEma(const OHLCVBar* bars, size_t count, int period);
+double CalculateEma(const double* close, size_t count, int period);
+
+// Trend of price against both EMA values (unrounded) - DetectTrend's
+// classification, strength and reason text
+TrendInfo ClassifyTrend(double price, double fast, double slow, int ema_fast, int ema_slow);
+
+// UPTREND: price > EMA fast > EMA slow, DOWNTREND: price < fast < slow,
+// otherwise SIDEWAYS. Needs ema_slow + 10 bars.
+TrendInfo DetectTrend(const OHLCVBar* bars, size_t count, int ema_fast = 20, int ema_slow = 50);
+TrendInfo DetectTrend(const BarColumns& bars, int ema_fast = 20, int ema_slow = 50);
+
+TrendValidation ValidateSignalWithTrend(SignalDirection direction, const TrendInfo& trend);
+
+} // namespace volarix4::core
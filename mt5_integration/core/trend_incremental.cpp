@@ -0,0 +1,138 @@
+//=============================================================================
+//  core/trend_incremental.cpp
+//  EMA trend of a sliding window, maintained bar by bar instead of
+//  recomputed over the whole lookback
+//=============================================================================
+#include "trend_incremental.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "pipeline_variants.h"
+
+namespace volarix4::core {
+
+namespace {
+
+constexpr double kEpsilon = std::numeric_limits<double>::epsilon();
+
+// x rounds to the same multiple of 1 / scale as everything within +-margin
+// (the rounding only changes at the half-way points)
+bool RoundingStable(double x, double margin, double scale)
+{
+    const double y = x * scale;
+    return std::fabs(y - std::floor(y) - 0.5) > margin * scale + 1e-6;
+}
+
+} // namespace
+
+void IncrementalTrend::Reset()
+{
+    points_.clear();
+    max_abs_close_ = 0.0;
+}
+
+TrendInfo IncrementalTrend::Update(const BarColumns& window, int ema_fast, int ema_slow)
+{
+    // Too short for a trend: DetectTrend's message, the stream is kept
+    if (window.count < (size_t)(ema_slow + 10))
+        return DetectTrend(window, ema_fast, ema_slow);
+
+    if (ema_fast != ema_fast_ || ema_slow != ema_slow_) {
+        Reset();
+        const RuntimeEmaWeights fast(ema_fast), slow(ema_slow);
+        ema_fast_ = ema_fast;
+        ema_slow_ = ema_slow;
+        fast_alpha_ = fast.alpha;
+        fast_old_ = fast.oldWeight;
+        fast_norm_ = fast.norm;
+        slow_alpha_ = slow.alpha;
+        slow_old_ = slow.oldWeight;
+        slow_norm_ = slow.norm;
+    }
+
+    size_t overlap = 0;
+    if (!points_.empty() && !Continues(window, &overlap))
+        Reset();
+    if (points_.empty())
+        ++rebuilds_;
+
+    while (points_.size() > overlap)
+        points_.pop_front();
+    for (size_t i = overlap; i < window.count; ++i)
+        Append(window.time[i], window.close[i]);
+
+    // Distance from the window's EMAs: the seed gap at the window's oldest
+    // bar, decayed over the window, plus rounding of both recurrences -
+    // at most 4 epsilon * |close| per step, damped like the gap. Doubled
+    // for slack.
+    const Point& oldest = points_.front();
+    const Point& newest = points_.back();
+    const double steps = (double)(window.count - 1);
+    const double rounding = 4.0 * kEpsilon * max_abs_close_;
+    const double fast_bound = 2.0 * (std::pow(fast_old_ / fast_norm_, steps) * std::fabs(oldest.fast - oldest.close) +
+                                     4.0 * rounding / fast_alpha_);
+    const double slow_bound = 2.0 * (std::pow(slow_old_ / slow_norm_, steps) * std::fabs(oldest.slow - oldest.close) +
+                                     4.0 * rounding / slow_alpha_);
+
+    const double price = newest.close, fast = newest.fast, slow = newest.slow;
+    const double slack = 2.0 * kEpsilon * max_abs_close_;
+    bool stable = std::fabs(price - fast) > fast_bound + slack &&
+                  std::fabs(fast - slow) > fast_bound + slow_bound + slack &&
+                  RoundingStable(fast, fast_bound, 1e5) && RoundingStable(slow, slow_bound, 1e5);
+
+    // Trending: the strength (|fast - slow| / slow * 100, capped at 1) keeps
+    // its 3-decimal rounding too
+    const bool trending = (price > fast && fast > slow) || (price < fast && fast < slow);
+    if (stable && trending) {
+        const double strength = std::fabs(fast - slow) / slow * 100.0;
+        const double margin = 101.0 * (fast_bound + slow_bound * std::fabs(fast / slow)) / slow +
+                              16.0 * kEpsilon * strength;
+        stable = slow > 0.0 && RoundingStable(std::min(strength, 1.0), margin, 1e3);
+    }
+
+    if (stable)
+        return ClassifyTrend(price, fast, slow, ema_fast, ema_slow);
+    ++recomputes_;
+    return DetectTrend(window, ema_fast, ema_slow);
+}
+
+// True if window is the live bars with zero or more of the oldest dropped
+// and zero or more new bars appended; *overlap = live bars window keeps
+bool IncrementalTrend::Continues(const BarColumns& window, size_t* overlap) const
+{
+    const Point& newest = points_.back();
+    const long long* end = window.time + window.count;
+    const size_t kept = (size_t)(std::upper_bound(window.time, end, newest.time) - window.time);
+    if (kept == 0 || window.time[kept - 1] != newest.time || window.close[kept - 1] != newest.close)
+        return false;
+
+    const auto first = std::lower_bound(points_.begin(), points_.end(), window.time[0],
+                                        [](const Point& point, long long time) { return point.time < time; });
+    if (first == points_.end() || first->time != window.time[0] ||
+        (size_t)(points_.end() - first) != kept)
+        return false;
+
+    *overlap = kept;
+    return true;
+}
+
+void IncrementalTrend::Append(long long time, double close)
+{
+    max_abs_close_ = std::max(max_abs_close_, std::fabs(close));
+    if (points_.empty()) {
+        points_.push_back(Point{ time, close, close, close });
+        return;
+    }
+
+    // Ema's recurrence
+    double fast = points_.back().fast, slow = points_.back().slow;
+    if (fast != close)
+        fast = (fast_old_ * fast + fast_alpha_ * close) / fast_norm_;
+    if (slow != close)
+        slow = (slow_old_ * slow + slow_alpha_ * close) / slow_norm_;
+    points_.push_back(Point{ time, close, fast, slow });
+}
+
+} // namespace volarix4::core
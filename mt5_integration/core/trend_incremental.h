@@ -0,0 +1,69 @@
+//=============================================================================
+//  core/trend_incremental.h
+//  EMA trend of a sliding window, maintained bar by bar instead of
+//  recomputed over the whole lookback
+//
+//  DetectTrend runs both EMA recurrences over the entire window for every
+//  signal, seeded at the window's oldest close as pandas does. A seed
+//  that moves with the window cannot be updated in O(1), so
+//  IncrementalTrend keeps the stream's EMAs seeded once instead - one
+//  recurrence step per arriving bar - and bounds how far they can be from
+//  the window's: the seeds' difference decays by (1 - alpha) per bar, and
+//  rounding adds at most a few ulps per step, damped the same way.
+//
+//  The stream values are only used when every output of DetectTrend is the
+//  same for anything within that bound: the trend comparisons, the EMAs'
+//  5-decimal rounding and the strength's 3-decimal rounding. Otherwise
+//  (rarely - for EMA 50 over 400 bars the bound is around 1e-9) the window
+//  is recomputed exactly, so results are bit-identical to DetectTrend.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <deque>
+
+#include "bar_columns.h"
+#include "trend_filter.h"
+
+namespace volarix4::core {
+
+class IncrementalTrend
+{
+public:
+    // DetectTrend(window, ema_fast, ema_slow). A window that continues the
+    // previous one (same newest bar, new bars after it, oldest bars
+    // possibly dropped) advances the stream bar by bar; any other window,
+    // or other periods, reseeds it from window.
+    TrendInfo Update(const BarColumns& window, int ema_fast, int ema_slow);
+
+    void Reset();
+
+    size_t Bars() const { return points_.size(); }
+
+    // Reseeds, and Updates answered by the exact recompute, since construction
+    size_t Rebuilds() const { return rebuilds_; }
+    size_t Recomputes() const { return recomputes_; }
+
+private:
+    struct Point
+    {
+        long long time;
+        double close;
+        double fast;                 // Stream EMAs after this bar
+        double slow;
+    };
+
+    bool Continues(const BarColumns& window, size_t* overlap) const;
+    void Append(long long time, double close);
+
+    int ema_fast_ = 0;
+    int ema_slow_ = 0;
+    double fast_alpha_ = 0.0, fast_old_ = 0.0, fast_norm_ = 1.0;
+    double slow_alpha_ = 0.0, slow_old_ = 0.0, slow_norm_ = 1.0;
+    std::deque<Point> points_;       // Live bars, oldest first
+    double max_abs_close_ = 0.0;     // Since the last reseed
+    size_t rebuilds_ = 0;
+    size_t recomputes_ = 0;
+};
+
+} // namespace volarix4::core
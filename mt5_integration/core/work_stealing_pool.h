@@ -0,0 +1,99 @@
+//=============================================================================
+//  core/work_stealing_pool.h
+//  Fork-join pool for batches of independent, uneven tasks
+//
+//  Task indices are dealt out to per-worker deques in contiguous blocks (so
+//  neighbouring tasks, which tend to share cached data, run on the same
+//  worker); a worker takes from the front of its own deque and, once that
+//  is empty, steals from the back of another's. A worker that drew cheap
+//  tasks keeps busy on someone else's expensive ones instead of idling
+//  until the whole batch is done. The deques are mutex-guarded: tasks here
+//  run for milliseconds to seconds, so a lock per pop costs nothing.
+//=============================================================================
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace volarix4::core {
+
+class WorkStealingPool
+{
+public:
+    // Workers for a requested count: 0 or less means one per hardware thread
+    static size_t WorkerCount(int requested)
+    {
+        if (requested > 0)
+            return (size_t)requested;
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware ? hardware : 1;
+    }
+
+    // Run fn(task, worker) for every task in [0, task_count) on `workers`
+    // threads (the caller's thread is worker 0) and return when all are done
+    template <typename Fn>
+    static void Run(size_t task_count, size_t workers, Fn&& fn)
+    {
+        if (task_count == 0)
+            return;
+        workers = workers == 0 ? 1 : (workers > task_count ? task_count : workers);
+
+        std::unique_ptr<Queue[]> queues(new Queue[workers]);
+        for (size_t w = 0; w < workers; ++w) {
+            size_t first = task_count * w / workers;
+            size_t end = task_count * (w + 1) / workers;
+            for (size_t task = first; task < end; ++task)
+                queues[w].tasks.push_back(task);
+        }
+
+        auto work = [&](size_t self) {
+            size_t task;
+            while (Next(queues.get(), workers, self, &task))
+                fn(task, self);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (size_t w = 1; w < workers; ++w)
+            threads.emplace_back(work, w);
+        work(0);
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    // Own deque first (front), then the others' (back), nearest first. No
+    // task is ever added after Run starts, so all empty means done.
+    static bool Next(Queue* queues, size_t workers, size_t self, size_t* task)
+    {
+        for (size_t i = 0; i < workers; ++i)
+        {
+            Queue& queue = queues[(self + i) % workers];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            if (i == 0) {
+                *task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            else {
+                *task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            return true;
+        }
+        return false;
+    }
+};
+
+} // namespace volarix4::core
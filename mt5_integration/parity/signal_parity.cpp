@@ -0,0 +1,230 @@
+//=============================================================================
+//  parity/signal_parity.cpp
+//  Core /signal parity check against committed fixtures (ctest)
+//
+//  Every fixture under tests/fixtures/core_parity holds a bar window, the
+//  strategy parameters and the exact response body the API returns for
+//  them ("expected_response"). The check runs the native pipeline on the
+//  window - UTC session clock, no signal cooldown, like a fresh /signal
+//  request in legacy mode - and requires LocalSignalJson to produce that
+//  body byte for byte. Runs on every platform; the DLL-vs-API comparison
+//  of the same files (tests/test_local_signal_parity.py) needs Windows.
+//
+//  Usage: volarix4_signal_parity <fixture.json|dir>...
+//         volarix4_signal_parity --print <fixture.json>
+//
+//  --print writes the pipeline's response for one fixture to stdout
+//  (tests/create_core_parity_fixtures.py records the fixtures with it).
+//=============================================================================
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bridge/json_reader.h"
+#include "bridge/local_signal_json.h"
+#include "core/bar.h"
+#include "core/signal_pipeline.h"
+
+namespace {
+
+using volarix4::bridge::JsonReader;
+using volarix4::bridge::JsonType;
+using volarix4::bridge::JsonValue;
+using volarix4::core::OHLCVBar;
+using volarix4::core::PipelineResult;
+using volarix4::core::StrategyParams;
+
+struct Fixture
+{
+    std::string symbol = "EURUSD";
+    std::string timeframe = "H1";
+    StrategyParams params = volarix4::core::DefaultStrategyParams();
+    std::vector<OHLCVBar> bars;
+    bool hasExpected = false;
+    std::string expected;
+};
+
+bool ReadFile(const std::string& path, std::string* contents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    *contents = buffer.str();
+    return true;
+}
+
+std::string StringOf(const JsonValue& value)
+{
+    std::string text(value.raw.size() + 1, '\0');
+    text.resize(value.CopyString(text.data(), text.size()));
+    return text;
+}
+
+bool ParamsOf(const JsonValue& value, StrategyParams* params)
+{
+    return JsonReader(value.raw).ForEachMember([&](std::string_view key, const JsonValue& field) {
+        if (key == "min_confidence")                   params->minConfidence = field.AsDouble(params->minConfidence);
+        else if (key == "broken_level_cooldown_hours") params->brokenLevelCooldownHours = field.AsDouble(params->brokenLevelCooldownHours);
+        else if (key == "broken_level_break_pips")     params->brokenLevelBreakPips = field.AsDouble(params->brokenLevelBreakPips);
+        else if (key == "min_edge_pips")               params->minEdgePips = field.AsDouble(params->minEdgePips);
+        else if (key == "spread_pips")                 params->spreadPips = field.AsDouble(params->spreadPips);
+        else if (key == "slippage_pips")               params->slippagePips = field.AsDouble(params->slippagePips);
+        else if (key == "commission_per_side_per_lot") params->commissionPerSidePerLot = field.AsDouble(params->commissionPerSidePerLot);
+        else if (key == "usd_per_pip_per_lot")         params->usdPerPipPerLot = field.AsDouble(params->usdPerPipPerLot);
+        else if (key == "lot_size")                    params->lotSize = field.AsDouble(params->lotSize);
+        return true;
+    });
+}
+
+bool BarsOf(const JsonValue& value, std::vector<OHLCVBar>* bars)
+{
+    if (value.type != JsonType::kArray)
+        return false;
+    bool ok = true;
+    bool parsed = JsonReader(value.raw).ForEachElement([&](const JsonValue& element) {
+        OHLCVBar bar{};
+        int fields = 0;
+        ok = element.type == JsonType::kObject &&
+             JsonReader(element.raw).ForEachMember([&](std::string_view key, const JsonValue& field) {
+                 if (key == "time")        { bar.timestamp = (long long)field.AsDouble(); ++fields; }
+                 else if (key == "open")   { bar.open = field.AsDouble(); ++fields; }
+                 else if (key == "high")   { bar.high = field.AsDouble(); ++fields; }
+                 else if (key == "low")    { bar.low = field.AsDouble(); ++fields; }
+                 else if (key == "close")  { bar.close = field.AsDouble(); ++fields; }
+                 else if (key == "volume") { bar.volume = (int)field.AsDouble(); ++fields; }
+                 return true;
+             }) && fields == 6;
+        if (ok)
+            bars->push_back(bar);
+        return ok;
+    });
+    return parsed && ok;
+}
+
+bool LoadFixture(const std::string& path, Fixture* fixture, std::string* error)
+{
+    std::string text;
+    if (!ReadFile(path, &text)) {
+        *error = "cannot read the file";
+        return false;
+    }
+
+    bool ok = true;
+    bool parsed = JsonReader(text).ForEachMember([&](std::string_view key, const JsonValue& value) {
+        if (key == "symbol")                 fixture->symbol = StringOf(value);
+        else if (key == "timeframe")         fixture->timeframe = StringOf(value);
+        else if (key == "parameters")        ok = ParamsOf(value, &fixture->params);
+        else if (key == "bars")              ok = BarsOf(value, &fixture->bars);
+        else if (key == "expected_response" && value.IsString()) {
+            fixture->expected = StringOf(value);
+            fixture->hasExpected = true;
+        }
+        if (!ok)
+            *error = "malformed \"" + std::string(key) + "\"";
+        return ok;
+    });
+    if (parsed && ok && fixture->bars.empty()) {
+        *error = "no \"bars\" window";
+        return false;
+    }
+    if (!parsed && ok)
+        *error = "malformed JSON";
+    return parsed && ok;
+}
+
+std::string ResponseOf(const Fixture& fixture)
+{
+    PipelineResult result = volarix4::core::RunSignalPipeline(
+        fixture.symbol, fixture.timeframe, fixture.bars.data(), fixture.bars.size(), fixture.params);
+    return volarix4::bridge::LocalSignalJson(result);
+}
+
+// Fixture files named on the command line, or found (sorted) under a directory
+bool CollectFixtures(const std::string& arg, std::vector<std::string>* paths)
+{
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::is_directory(arg, ec)) {
+        paths->push_back(arg);
+        return fs::exists(arg, ec);
+    }
+    std::vector<std::string> found;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(arg, ec))
+        if (entry.is_regular_file() && entry.path().extension() == ".json")
+            found.push_back(entry.path().string());
+    std::sort(found.begin(), found.end());
+    paths->insert(paths->end(), found.begin(), found.end());
+    return !ec;
+}
+
+int Usage()
+{
+    std::fprintf(stderr, "Usage: volarix4_signal_parity <fixture.json|dir>...\n"
+                         "       volarix4_signal_parity --print <fixture.json>\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc == 3 && std::string_view(argv[1]) == "--print") {
+        Fixture fixture;
+        std::string error;
+        if (!LoadFixture(argv[2], &fixture, &error)) {
+            std::fprintf(stderr, "%s: %s\n", argv[2], error.c_str());
+            return 1;
+        }
+        std::fputs(ResponseOf(fixture).c_str(), stdout);
+        return 0;
+    }
+    if (argc < 2)
+        return Usage();
+
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] == '-')
+            return Usage();
+        if (!CollectFixtures(argv[i], &paths)) {
+            std::fprintf(stderr, "No fixtures at %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    int checked = 0, failed = 0;
+    for (const std::string& path : paths)
+    {
+        Fixture fixture;
+        std::string error;
+        if (!LoadFixture(path, &fixture, &error)) {
+            std::fprintf(stderr, "FAIL %s: %s\n", path.c_str(), error.c_str());
+            ++failed;
+            continue;
+        }
+        if (!fixture.hasExpected) {
+            std::printf("skip %s (no expected_response)\n", path.c_str());
+            continue;
+        }
+
+        ++checked;
+        const std::string actual = ResponseOf(fixture);
+        if (actual != fixture.expected) {
+            std::fprintf(stderr, "FAIL %s\n  expected: %s\n  actual:   %s\n",
+                         path.c_str(), fixture.expected.c_str(), actual.c_str());
+            ++failed;
+        } else {
+            std::printf("ok   %s\n", path.c_str());
+        }
+    }
+
+    std::printf("%d checked, %d failed\n", checked, failed);
+    // A run that compared nothing is a broken setup, not a pass
+    return failed == 0 && checked > 0 ? 0 : 1;
+}
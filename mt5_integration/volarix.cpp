@@ -1,9 +1,19 @@
-#include "pch.h"   // only if your project uses precompiled headers
+// #include "pch.h"   // only if your project uses precompiled headers
 #include <windows.h>
 #include <wininet.h>
 #include <string>
-#include <sstream>
 #include <comutil.h>
+#include <atomic>
+#include <charconv>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#include "bridge/bar_codec.h"
+#include "bridge/content_encoding.h"
+#include "bridge/debug_log.h"
+#include "bridge/json_writer.h"
+#include "bridge/signal_payload.h"
 
 #pragma comment(lib, "wininet.lib")
 #pragma comment(lib, "comsuppw.lib")
@@ -14,159 +24,362 @@
 //  Now includes start_time and end_time for historical backtesting support.
 // ============================================================================
 
-extern "C" __declspec(dllexport)
-BSTR __stdcall GetVolariXSignal(const wchar_t* symbol, const wchar_t* startTime, const wchar_t* endTime)
+using volarix4::bridge::BinaryBarWriter;
+using volarix4::bridge::BodyEncoder;
+using volarix4::bridge::BodyEncoding;
+using volarix4::bridge::DebugLog;
+using volarix4::bridge::JsonWriter;
+using volarix4::bridge::LogLevel;
+using volarix4::bridge::SignalPayload;
+using volarix4::bridge::TimestampedBar;
+using volarix4::bridge::kBinaryBarsContentType;
+
+// ----------------------------------------------------------------------------
+// Debug log (queued - see bridge/debug_log.h). The first call points it at
+// the bridge's historical file with every line enabled, as before; callers
+// check DebugEnabled() before formatting.
+// ----------------------------------------------------------------------------
+static DebugLog& BridgeLog()
 {
-    // Convert input wide strings (from MQL5) to std::string
-    // Use wcslen to get actual string length from null-terminated string
-    std::wstring ws_symbol(symbol);
-    std::string sym(ws_symbol.begin(), ws_symbol.end());
+    static DebugLog& log = [] () -> DebugLog& {
+        DebugLog& instance = DebugLog::Instance();
+        instance.Initialize(NULL, "E:\\VolariXBridge_Debug.txt");
+        instance.Configure(std::string(), LogLevel::kDebug);
+        return instance;
+    }();
+    return log;
+}
 
-    std::wstring ws_start(startTime);
-    std::string start_time(ws_start.begin(), ws_start.end());
+static bool DebugEnabled()
+{
+    BridgeLog();
+    return DebugLog::Enabled(LogLevel::kDebug);
+}
 
-    std::wstring ws_end(endTime);
-    std::string end_time(ws_end.begin(), ws_end.end());
+static void DebugLogf(const char* format, ...)
+{
+    char text[DebugLog::kSlotBytes + 1];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    BridgeLog().Write(LogLevel::kDebug, text);
+}
 
-    // DEBUG: Write to a log file to see what we're receiving
-    FILE* log_file = nullptr;
-    fopen_s(&log_file, "E:\\VolariXBridge_Debug.txt", "a");
-    if (log_file) {
-        fprintf(log_file, "=== DLL Called ===\n");
-        fprintf(log_file, "Symbol received (length=%d): %s\n", (int)sym.length(), sym.c_str());
-        fprintf(log_file, "Start time: %s\n", start_time.c_str());
-        fprintf(log_file, "End time: %s\n", end_time.c_str());
-        fclose(log_file);
-    }
+// ----------------------------------------------------------------------------
+// Request bodies of at least this many bytes are streamed (StreamToVolariX,
+// see SetVolariXStreaming); smaller ones go out in one HttpSendRequest.
+// -1 = never stream.
+// ----------------------------------------------------------------------------
+static std::atomic<long long> g_streamThresholdBytes{ 256 * 1024 };
 
-    // ------------------------------------------------------------------------
-    // Build realistic OHLCV data (50 bars)
-    // In production, you would get this data from MT5 history
-    // ------------------------------------------------------------------------
-    std::stringstream bars;
-    bars << "[";
-    for (int i = 0; i < 50; ++i)
-    {
-        double open = 100.0 + i * 0.1;
-        double high = open + 0.5;
-        double low = open - 0.3;
-        double close = open + 0.2;
-        int volume = 10000 + i * 100;
+static bool StreamPayload(size_t bytes)
+{
+    long long threshold = g_streamThresholdBytes.load(std::memory_order_relaxed);
+    return threshold >= 0 && (long long)bytes >= threshold;
+}
 
-        // Use the provided time range to generate timestamps
-        // In production, use actual bar timestamps from MT5
-        bars << "{\"timestamp\":\"" << start_time << "\","
-            << "\"open\":" << open << ","
-            << "\"high\":" << high << ","
-            << "\"low\":" << low << ","
-            << "\"close\":" << close << ","
-            << "\"volume\":" << volume << "}";
-
-        if (i < 49) bars << ",";
-    }
-    bars << "]";
+// ----------------------------------------------------------------------------
+// Request bodies of at least g_compressThresholdBytes go out with
+// Content-Encoding g_compressEncoding (see SetVolariXCompression). Off by
+// default: the local server gains nothing from it.
+// ----------------------------------------------------------------------------
+static std::atomic<int> g_compressEncoding{ (int)BodyEncoding::kIdentity };
+static std::atomic<long long> g_compressThresholdBytes{ 4 * 1024 };
 
-    // ------------------------------------------------------------------------
-    // Build JSON payload with start_time and end_time
-    // ------------------------------------------------------------------------
-    std::string payload =
-        "{\"symbol\":\"" + sym + "\","
-        "\"timeframe\":\"1h\","
-        "\"data\":" + bars.str() + ","
-        "\"start_time\":\"" + start_time + "\","
-        "\"end_time\":\"" + end_time + "\","
-        "\"model_type\":\"transformer\"}";
+static BodyEncoding RequestEncoding(size_t bytes)
+{
+    BodyEncoding encoding = (BodyEncoding)g_compressEncoding.load(std::memory_order_relaxed);
+    if (encoding == BodyEncoding::kIdentity ||
+        (long long)bytes < g_compressThresholdBytes.load(std::memory_order_relaxed))
+        return BodyEncoding::kIdentity;
+    return encoding;
+}
 
-    // DEBUG: Log the payload being sent
-    log_file = nullptr;
-    fopen_s(&log_file, "E:\\VolariXBridge_Debug.txt", "a");
-    if (log_file) {
-        fprintf(log_file, "Payload symbol field: \"%s\"\n", sym.c_str());
-        fprintf(log_file, "Payload length: %d bytes\n", (int)payload.length());
-        // Log first 500 chars of payload to see symbol in JSON
-        std::string preview = payload.substr(0, 500);
-        fprintf(log_file, "Payload preview: %s...\n", preview.c_str());
-        fprintf(log_file, "==================\n\n");
-        fclose(log_file);
+// ----------------------------------------------------------------------------
+// WinINet handles of one request, closed in reverse order
+// ----------------------------------------------------------------------------
+struct RequestHandles
+{
+    HINTERNET internet = NULL;
+    HINTERNET connect = NULL;
+    HINTERNET request = NULL;
+    bool decoding = false;      // WinINet decodes gzip/deflate responses
+
+    ~RequestHandles()
+    {
+        if (request)
+            InternetCloseHandle(request);
+        if (connect)
+            InternetCloseHandle(connect);
+        if (internet)
+            InternetCloseHandle(internet);
     }
+};
 
-    // ------------------------------------------------------------------------
-    // Open internet session
-    // ------------------------------------------------------------------------
-    HINTERNET hInternet = InternetOpenA("VolariXBridge",
+// Open a POST request to the local FastAPI server. NULL, or the error JSON
+// to return.
+static BSTR OpenVolariXRequest(RequestHandles& handles, const char* path)
+{
+    handles.internet = InternetOpenA("VolariXBridge",
         INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
-    if (!hInternet)
+    if (!handles.internet)
         return SysAllocString(L"{\"error\":\"InternetOpen failed\"}");
 
     // Connect to local FastAPI server
-    HINTERNET hConnect = InternetConnectA(hInternet,
+    handles.connect = InternetConnectA(handles.internet,
         "127.0.0.1", 8000,
         NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
-    if (!hConnect)
-    {
-        InternetCloseHandle(hInternet);
+    if (!handles.connect)
         return SysAllocString(L"{\"error\":\"InternetConnect failed\"}");
-    }
 
     // Create POST request
     const char* accept[2] = { "*/*", NULL };
-    HINTERNET hRequest = HttpOpenRequestA(
-        hConnect, "POST", "/signal", "HTTP/1.1", NULL, accept,
+    handles.request = HttpOpenRequestA(
+        handles.connect, "POST", path, "HTTP/1.1", NULL, accept,
         INTERNET_FLAG_RELOAD | INTERNET_FLAG_DONT_CACHE, 0);
-
-    if (!hRequest)
-    {
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
+    if (!handles.request)
         return SysAllocString(L"{\"error\":\"HttpOpenRequest failed\"}");
-    }
 
-    // ------------------------------------------------------------------------
-    // Set headers & send JSON body
-    // ------------------------------------------------------------------------
+    // Accept compressed responses only if WinINet will decode them
+    BOOL decode = TRUE;
+    handles.decoding = InternetSetOptionA(handles.request, INTERNET_OPTION_HTTP_DECODING,
+                                          &decode, sizeof(decode)) != FALSE;
+    return NULL;
+}
+
+static std::string RequestHeaders(const RequestHandles& handles, const char* contentType,
+                                  const char* contentEncoding)
+{
     std::string headers =
-        "Content-Type: application/json\r\n"
+        std::string("Content-Type: ") + contentType + "\r\n"
         "Accept: application/json\r\n";
+    if (contentEncoding)
+        headers += std::string("Content-Encoding: ") + contentEncoding + "\r\n";
+    if (handles.decoding)
+        headers += "Accept-Encoding: gzip, deflate\r\n";
+    return headers;
+}
+
+// Read the response into the thread's buffer (it keeps its capacity, so a
+// large response is not regrown on every call) and return it as BSTR
+// (Unicode string for MQL5), widened byte by byte
+static BSTR ReadVolariXResponse(HINTERNET request)
+{
+    constexpr size_t kReadBytes = 16 * 1024;
+    thread_local std::string response;
+    response.clear();
+
+    for (;;)
+    {
+        size_t size = response.size();
+        response.resize(size + kReadBytes);
+        DWORD bytesRead = 0;
+        BOOL read = InternetReadFile(request, &response[size], (DWORD)kReadBytes, &bytesRead);
+        response.resize(size + (read ? bytesRead : 0));
+        if (!read || bytesRead == 0)
+            break;
+    }
+
+    BSTR result = SysAllocStringLen(NULL, (UINT)response.size());
+    if (result)
+        for (size_t i = 0; i < response.size(); ++i)
+            result[i] = (wchar_t)response[i];
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// POST body to the local FastAPI server and return the response as BSTR
+// (or an error JSON). A body compressed with encoding goes out with its
+// Content-Encoding; if the encoding is not available it is sent as it is.
+// ----------------------------------------------------------------------------
+static BSTR PostToVolariX(const char* path, const char* contentType, BodyEncoding encoding,
+                          const char* body, DWORD bodyLength)
+{
+    RequestHandles handles;
+    if (BSTR error = OpenVolariXRequest(handles, path))
+        return error;
+
+    const char* contentEncoding = NULL;
+    if (encoding != BodyEncoding::kIdentity)
+    {
+        thread_local std::string compressed;
+        if (volarix4::bridge::EncodeBody(BodyEncoder::ThreadLocal(), encoding, body, bodyLength, &compressed))
+        {
+            if (DebugEnabled()) {
+                DebugLogf("Payload compressed (%s): %d -> %d bytes",
+                          volarix4::bridge::ContentEncodingName(encoding), (int)bodyLength,
+                          (int)compressed.size());
+            }
+            contentEncoding = volarix4::bridge::ContentEncodingName(encoding);
+            body = compressed.data();
+            bodyLength = (DWORD)compressed.size();
+        }
+    }
+
+    // Set headers & send body
+    std::string headers = RequestHeaders(handles, contentType, contentEncoding);
 
     BOOL sent = HttpSendRequestA(
-        hRequest,
+        handles.request,
         headers.c_str(),
         (DWORD)headers.length(),
-        (LPVOID)payload.c_str(),
-        (DWORD)payload.length()
+        (LPVOID)body,
+        bodyLength
     );
-
     if (!sent)
-    {
-        InternetCloseHandle(hRequest);
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
         return SysAllocString(L"{\"error\":\"HttpSendRequest failed\"}");
+
+    return ReadVolariXResponse(handles.request);
+}
+
+// ----------------------------------------------------------------------------
+// POST a body that write_body(sink) produces in pieces, each written onto
+// the socket as it is handed to sink(data, size) (HttpSendRequestEx +
+// InternetWriteFile), so the body is never held whole. A known length goes
+// out as Content-Length; contentLength < 0 sends the body with
+// Transfer-Encoding: chunked, one HTTP chunk per piece. With an encoding
+// the pieces are compressed on their way to the socket - always chunked,
+// as the compressed length is not known up front.
+// ----------------------------------------------------------------------------
+template <typename WriteBody>
+static BSTR StreamToVolariX(const char* path, const char* contentType, BodyEncoding encoding,
+                            long long contentLength, WriteBody&& write_body)
+{
+    RequestHandles handles;
+    if (BSTR error = OpenVolariXRequest(handles, path))
+        return error;
+
+    BodyEncoder& encoder = BodyEncoder::ThreadLocal();
+    const bool compress = encoding != BodyEncoding::kIdentity && encoder.Begin(encoding);
+    const bool chunked = compress || contentLength < 0;
+    std::string headers = RequestHeaders(handles, contentType,
+        compress ? volarix4::bridge::ContentEncodingName(encoding) : NULL);
+    if (chunked)
+        headers += "Transfer-Encoding: chunked\r\n";
+
+    INTERNET_BUFFERSA buffers = {};
+    buffers.dwStructSize = sizeof(buffers);
+    buffers.lpcszHeader = headers.c_str();
+    buffers.dwHeadersLength = (DWORD)headers.length();
+    buffers.dwBufferTotal = chunked ? 0 : (DWORD)contentLength;
+    if (!HttpSendRequestExA(handles.request, &buffers, NULL, 0, 0))
+        return SysAllocString(L"{\"error\":\"HttpSendRequestEx failed\"}");
+
+    auto write = [&](const char* data, size_t size) {
+        while (size > 0)
+        {
+            DWORD written = 0;
+            if (!InternetWriteFile(handles.request, data, (DWORD)size, &written) || written == 0)
+                return false;
+            data += written;
+            size -= written;
+        }
+        return true;
+    };
+    auto sink = [&](const char* data, size_t size) {
+        if (!chunked)
+            return write(data, size);
+        char frame[24];
+        char* end = std::to_chars(frame, frame + sizeof(frame) - 2, (unsigned long long)size, 16).ptr;
+        *end++ = '\r';
+        *end++ = '\n';
+        return write(frame, (size_t)(end - frame)) && write(data, size) && write("\r\n", 2);
+    };
+
+    bool body_written;
+    if (compress)
+    {
+        auto compress_sink = [&](const char* data, size_t size) { return encoder.Write(data, size, sink); };
+        body_written = write_body(compress_sink) && encoder.Finish(sink);
+    }
+    else
+        body_written = write_body(sink);
+
+    if (!body_written || (chunked && !write("0\r\n\r\n", 5)))
+        return SysAllocString(L"{\"error\":\"InternetWriteFile failed\"}");
+    if (!HttpEndRequestA(handles.request, NULL, 0, 0))
+        return SysAllocString(L"{\"error\":\"HttpEndRequest failed\"}");
+
+    return ReadVolariXResponse(handles.request);
+}
+
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolariXSignal(const wchar_t* symbol, const wchar_t* startTime, const wchar_t* endTime)
+{
+    // Convert input wide strings (from MQL5) to std::string
+    // Use wcslen to get actual string length from null-terminated string
+    std::wstring ws_symbol(symbol);
+    std::string sym(ws_symbol.begin(), ws_symbol.end());
+
+    std::wstring ws_start(startTime);
+    std::string start_time(ws_start.begin(), ws_start.end());
+
+    std::wstring ws_end(endTime);
+    std::string end_time(ws_end.begin(), ws_end.end());
+
+    // DEBUG: Log what we're receiving
+    if (DebugEnabled()) {
+        DebugLogf("=== DLL Called ===\n"
+                  "Symbol received (length=%d): %s\n"
+                  "Start time: %s\n"
+                  "End time: %s",
+                  (int)sym.length(), sym.c_str(), start_time.c_str(), end_time.c_str());
     }
 
     // ------------------------------------------------------------------------
-    // Read response
+    // Build realistic OHLCV data (50 bars)
+    // In production, you would get this data from MT5 history
     // ------------------------------------------------------------------------
-    char buffer[4096];
-    DWORD bytesRead;
-    std::stringstream ss;
-
-    while (InternetReadFile(hRequest, buffer, sizeof(buffer) - 1, &bytesRead) && bytesRead > 0)
+    JsonWriter& json = JsonWriter::ThreadLocal();
+    json.Reset(1024 + 50 * 140);
+    json.BeginObject()
+        .Field("symbol", sym)
+        .Field("timeframe", "1h")
+        .Key("data").BeginArray();
+    for (int i = 0; i < 50; ++i)
     {
-        buffer[bytesRead] = 0;
-        ss << buffer;
-    }
+        double open = 100.0 + i * 0.1;
+        double high = open + 0.5;
+        double low = open - 0.3;
+        double close = open + 0.2;
+        int volume = 10000 + i * 100;
 
-    InternetCloseHandle(hRequest);
-    InternetCloseHandle(hConnect);
-    InternetCloseHandle(hInternet);
+        // Use the provided time range to generate timestamps
+        // In production, use actual bar timestamps from MT5
+        json.BeginObject()
+            .Field("timestamp", start_time)
+            .Field("open", open)
+            .Field("high", high)
+            .Field("low", low)
+            .Field("close", close)
+            .Field("volume", volume)
+            .EndObject();
+    }
+    json.EndArray();
 
     // ------------------------------------------------------------------------
-    // Return JSON response as BSTR (Unicode string for MQL5)
+    // Finish JSON payload with start_time and end_time
     // ------------------------------------------------------------------------
-    std::string result = ss.str();
-    std::wstring wresult(result.begin(), result.end());
-    return SysAllocString(wresult.c_str());
+    json.Field("start_time", start_time)
+        .Field("end_time", end_time)
+        .Field("model_type", "transformer")
+        .EndObject();
+    const std::string& payload = json.str();
+
+    // DEBUG: Log the payload being sent
+    if (DebugEnabled()) {
+        // First 500 chars of payload to see symbol in JSON
+        std::string preview = payload.substr(0, 500);
+        DebugLogf("Payload symbol field: \"%s\"\n"
+                  "Payload length: %d bytes\n"
+                  "Payload preview: %s...\n"
+                  "==================\n",
+                  sym.c_str(), (int)payload.length(), preview.c_str());
+    }
+
+    return PostToVolariX("/signal", "application/json", RequestEncoding(payload.length()),
+        payload.c_str(), (DWORD)payload.length());
 }
 
 
@@ -175,14 +388,8 @@ BSTR __stdcall GetVolariXSignal(const wchar_t* symbol, const wchar_t* startTime,
 //  Accepts actual OHLCV data from MQL5 instead of generating mock data
 // ============================================================================
 
-struct OHLCVBar {
-    char timestamp[32];
-    double open;
-    double high;
-    double low;
-    double close;
-    double volume;
-};
+// MQL5's bar struct (see bridge/signal_payload.h)
+using OHLCVBar = TimestampedBar;
 
 extern "C" __declspec(dllexport)
 BSTR __stdcall GetVolariXSignalWithBars(
@@ -221,164 +428,230 @@ BSTR __stdcall GetVolariXSignalWithBars(
     bool isMultiTF = (!ctx_tf.empty() && contextBarCount > 0);
 
     // DEBUG: Log what we received
-    FILE* log_file = nullptr;
-    fopen_s(&log_file, "E:\\VolariXBridge_Debug.txt", "a");
-    if (log_file) {
-        fprintf(log_file, "=== GetVolariXSignalWithBars Called (v3.2 - Multi-TF) ===\n");
-        fprintf(log_file, "Symbol: %s (length=%d)\n", sym.c_str(), (int)sym.length());
-        fprintf(log_file, "Execution TF: '%s' (length=%d)\n", exec_tf.c_str(), (int)exec_tf.length());
-        fprintf(log_file, "Context TF: '%s' (length=%d)\n", ctx_tf.c_str(), (int)ctx_tf.length());
-        fprintf(log_file, "Execution bar count: %d\n", barCount);
-        fprintf(log_file, "Context bar count: %d\n", contextBarCount);
-        fprintf(log_file, "Multi-TF mode: %s\n", isMultiTF ? "ENABLED" : "DISABLED");
-        fprintf(log_file, "Start time: %s\n", start_time.c_str());
-        fprintf(log_file, "End time: %s\n", end_time.c_str());
-        fprintf(log_file, "==================\n\n");
-        fclose(log_file);
+    if (DebugEnabled()) {
+        DebugLogf("=== GetVolariXSignalWithBars Called (v3.2 - Multi-TF) ===\n"
+                  "Symbol: %s (length=%d)\n"
+                  "Execution TF: '%s' (length=%d)\n"
+                  "Context TF: '%s' (length=%d)\n"
+                  "Execution bar count: %d\n"
+                  "Context bar count: %d\n"
+                  "Multi-TF mode: %s\n"
+                  "Start time: %s\n"
+                  "End time: %s\n"
+                  "==================\n",
+                  sym.c_str(), (int)sym.length(), exec_tf.c_str(), (int)exec_tf.length(),
+                  ctx_tf.c_str(), (int)ctx_tf.length(), barCount, contextBarCount,
+                  isMultiTF ? "ENABLED" : "DISABLED", start_time.c_str(), end_time.c_str());
     }
 
     // ------------------------------------------------------------------------
-    // Build OHLCV data from actual MT5 bars (execution timeframe)
+    // Build JSON payload with multi-TF support (bridge/signal_payload.h)
     // ------------------------------------------------------------------------
-    std::stringstream bars_json;
-    bars_json << "[";
-    for (int i = 0; i < barCount; ++i)
+    SignalPayload request;
+    request.symbol = sym;
+    request.executionTimeframe = exec_tf;
+    request.contextTimeframe = ctx_tf;
+    request.startTime = start_time;
+    request.endTime = end_time;
+    request.bars = bars;
+    request.barCount = barCount;
+    request.contextBars = contextBars;
+    request.contextBarCount = contextBarCount;
+
+    // Large uploads (backtests with thousands of bars) are serialized chunk
+    // by chunk onto the socket instead of into one multi-megabyte string
+    size_t estimate = 1024 + ((size_t)(barCount > 0 ? barCount : 0) +
+        (size_t)(isMultiTF && contextBars != nullptr ? contextBarCount : 0)) * 140;
+    if (StreamPayload(estimate))
     {
-        bars_json << "{\"timestamp\":\"" << bars[i].timestamp << "\","
-            << "\"open\":" << bars[i].open << ","
-            << "\"high\":" << bars[i].high << ","
-            << "\"low\":" << bars[i].low << ","
-            << "\"close\":" << bars[i].close << ","
-            << "\"volume\":" << bars[i].volume << "}";
-
-        if (i < barCount - 1) bars_json << ",";
-    }
-    bars_json << "]";
-
-    // ------------------------------------------------------------------------
-    // Build context OHLCV data if multi-TF mode
-    // ------------------------------------------------------------------------
-    std::stringstream ctx_bars_json;
-    if (isMultiTF && contextBars != nullptr && contextBarCount > 0)
-    {
-        ctx_bars_json << "[";
-        for (int i = 0; i < contextBarCount; ++i)
-        {
-            ctx_bars_json << "{\"timestamp\":\"" << contextBars[i].timestamp << "\","
-                << "\"open\":" << contextBars[i].open << ","
-                << "\"high\":" << contextBars[i].high << ","
-                << "\"low\":" << contextBars[i].low << ","
-                << "\"close\":" << contextBars[i].close << ","
-                << "\"volume\":" << contextBars[i].volume << "}";
-
-            if (i < contextBarCount - 1) ctx_bars_json << ",";
+        size_t sent = 0, chunks = 0;
+        BSTR response = StreamToVolariX("/signal", "application/json", RequestEncoding(estimate), -1,
+            [&](auto& sink) {
+                return volarix4::bridge::StreamSignalPayload(JsonWriter::ThreadLocal(), request,
+                    volarix4::bridge::kPayloadChunkBytes, [&](const char* data, size_t size) {
+                        sent += size;
+                        ++chunks;
+                        return sink(data, size);
+                    });
+            });
+        if (DebugEnabled()) {
+            DebugLogf("Payload streamed: %lld bytes in %d chunks\n"
+                      "==================\n",
+                      (long long)sent, (int)chunks);
         }
-        ctx_bars_json << "]";
+        return response;
     }
 
-    // ------------------------------------------------------------------------
-    // Build JSON payload with multi-TF support
-    // ------------------------------------------------------------------------
-    std::stringstream payload_stream;
-    payload_stream << "{\"symbol\":\"" << sym << "\","
-        << "\"timeframe\":\"" << exec_tf << "\","  // Backward compat
-        << "\"execution_timeframe\":\"" << exec_tf << "\","  // NEW: Explicit execution TF
-        << "\"data\":" << bars_json.str() << ","
-        << "\"start_time\":\"" << start_time << "\","
-        << "\"end_time\":\"" << end_time << "\","
-        << "\"model_type\":\"statistical\"";  // Changed default to statistical
-
-    // Add multi-TF fields if enabled
-    if (isMultiTF)
-    {
-        payload_stream << ",\"context_timeframe\":\"" << ctx_tf << "\""
-            << ",\"context_data\":" << ctx_bars_json.str();
-    }
-
-    payload_stream << "}";
-    std::string payload = payload_stream.str();
+    const std::string& payload = volarix4::bridge::WriteSignalPayload(JsonWriter::ThreadLocal(), request);
 
     // DEBUG: Log payload preview
-    log_file = nullptr;
-    fopen_s(&log_file, "E:\\VolariXBridge_Debug.txt", "a");
-    if (log_file) {
-        fprintf(log_file, "Payload length: %d bytes\n", (int)payload.length());
-        // Log first 1000 chars of payload to verify multi-TF fields
+    if (DebugEnabled()) {
+        // First 1000 chars of payload to verify multi-TF fields (the log
+        // truncates lines at DebugLog::kSlotBytes)
         std::string preview = payload.length() > 1000 ? payload.substr(0, 1000) + "..." : payload;
-        fprintf(log_file, "Payload preview: %s\n", preview.c_str());
-        fprintf(log_file, "==================\n\n");
-        fclose(log_file);
+        DebugLogf("Payload length: %d bytes\n"
+                  "Payload preview: %s\n"
+                  "==================\n",
+                  (int)payload.length(), preview.c_str());
     }
 
-    // ------------------------------------------------------------------------
-    // Open internet session
-    // ------------------------------------------------------------------------
-    HINTERNET hInternet = InternetOpenA("VolariXBridge",
-        INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
-    if (!hInternet)
-        return SysAllocString(L"{\"error\":\"InternetOpen failed\"}");
+    return PostToVolariX("/signal", "application/json", RequestEncoding(payload.length()),
+        payload.c_str(), (DWORD)payload.length());
+}
 
-    // Connect to local FastAPI server
-    HINTERNET hConnect = InternetConnectA(hInternet,
-        "127.0.0.1", 8000,
-        NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
-    if (!hConnect)
-    {
-        InternetCloseHandle(hInternet);
-        return SysAllocString(L"{\"error\":\"InternetConnect failed\"}");
-    }
 
-    // Create POST request
-    const char* accept[2] = { "*/*", NULL };
-    HINTERNET hRequest = HttpOpenRequestA(
-        hConnect, "POST", "/signal", "HTTP/1.1", NULL, accept,
-        INTERNET_FLAG_RELOAD | INTERNET_FLAG_DONT_CACHE, 0);
+// ============================================================================
+//  Binary version: GetVolariXSignalWithBarsBinary
+//  Same arguments as GetVolariXSignalWithBars, but the bars are sent as packed
+//  little-endian records (see bridge/bar_codec.h) to POST /signal/bars:
+//  48 bytes per bar instead of ~120 bytes of JSON, and no text parsing on
+//  either side. startTime/endTime are only logged - the server derives the
+//  range from the bars.
+// ============================================================================
 
-    if (!hRequest)
-    {
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
-        return SysAllocString(L"{\"error\":\"HttpOpenRequest failed\"}");
-    }
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolariXSignalWithBarsBinary(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,         // Backward compat field (unused)
+    OHLCVBar* bars,
+    int barCount,
+    const wchar_t* startTime,
+    const wchar_t* endTime,
+    const wchar_t* executionTimeframe,
+    const wchar_t* contextTimeframe,    // Empty = single-TF
+    OHLCVBar* contextBars,              // Can be NULL
+    int contextBarCount)                // 0 = single-TF
+{
+    std::wstring ws_symbol(symbol);
+    std::string sym(ws_symbol.begin(), ws_symbol.end());
 
-    // Set headers & send JSON body
-    std::string headers =
-        "Content-Type: application/json\r\n"
-        "Accept: application/json\r\n";
+    std::wstring ws_start(startTime);
+    std::string start_time(ws_start.begin(), ws_start.end());
 
-    BOOL sent = HttpSendRequestA(
-        hRequest,
-        headers.c_str(),
-        (DWORD)headers.length(),
-        (LPVOID)payload.c_str(),
-        (DWORD)payload.length()
-    );
+    std::wstring ws_end(endTime);
+    std::string end_time(ws_end.begin(), ws_end.end());
 
-    if (!sent)
+    std::wstring ws_exec_tf(executionTimeframe);
+    std::string exec_tf(ws_exec_tf.begin(), ws_exec_tf.end());
+
+    std::wstring ws_ctx_tf(contextTimeframe);
+    std::string ctx_tf(ws_ctx_tf.begin(), ws_ctx_tf.end());
+
+    if (barCount < 0)
+        barCount = 0;
+
+    bool isMultiTF = (!ctx_tf.empty() && contextBars != nullptr && contextBarCount > 0);
+    if (!isMultiTF) {
+        ctx_tf.clear();
+        contextBarCount = 0;
+    }
+
+    SignalPayload request;
+    request.symbol = sym;
+    request.executionTimeframe = exec_tf;
+    request.contextTimeframe = ctx_tf;
+    request.bars = bars;
+    request.barCount = barCount;
+    request.contextBars = contextBars;
+    request.contextBarCount = contextBarCount;
+
+    if (!BinaryBarWriter::Fits(sym, exec_tf, ctx_tf))
+        return SysAllocString(L"{\"error\":\"Symbol or timeframe too long\"}");
+
+    // Exact size known up front: large uploads stream with a Content-Length
+    size_t payloadBytes = volarix4::bridge::BinarySignalPayloadBytes(request);
+    if (StreamPayload(payloadBytes))
     {
-        InternetCloseHandle(hRequest);
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
-        return SysAllocString(L"{\"error\":\"HttpSendRequest failed\"}");
+        if (DebugEnabled()) {
+            DebugLogf("=== GetVolariXSignalWithBarsBinary Called (streamed) ===\n"
+                      "Symbol: %s, Execution TF: '%s', Context TF: '%s'\n"
+                      "Execution bar count: %d, Context bar count: %d\n"
+                      "Time range: %s to %s\n"
+                      "Payload length: %lld bytes\n"
+                      "==================\n",
+                      sym.c_str(), exec_tf.c_str(), ctx_tf.c_str(), barCount, contextBarCount,
+                      start_time.c_str(), end_time.c_str(), (long long)payloadBytes);
+        }
+        return StreamToVolariX("/signal/bars", kBinaryBarsContentType, RequestEncoding(payloadBytes),
+            (long long)payloadBytes, [&](auto& sink) {
+                return volarix4::bridge::StreamBinarySignalPayload(BinaryBarWriter::ThreadLocal(), request,
+                    volarix4::bridge::kPayloadChunkBytes, sink);
+            });
     }
 
-    // Read response
-    char buffer[4096];
-    DWORD bytesRead;
-    std::stringstream ss;
+    BinaryBarWriter& writer = BinaryBarWriter::ThreadLocal();
+    volarix4::bridge::WriteBinarySignalPayload(writer, request);
+
+    const std::string& payload = writer.str();
+
+    // DEBUG: Log what we send
+    if (DebugEnabled()) {
+        DebugLogf("=== GetVolariXSignalWithBarsBinary Called ===\n"
+                  "Symbol: %s, Execution TF: '%s', Context TF: '%s'\n"
+                  "Execution bar count: %d, Context bar count: %d\n"
+                  "Time range: %s to %s\n"
+                  "Payload length: %d bytes\n"
+                  "==================\n",
+                  sym.c_str(), exec_tf.c_str(), ctx_tf.c_str(), barCount, contextBarCount,
+                  start_time.c_str(), end_time.c_str(), (int)payload.length());
+    }
 
-    while (InternetReadFile(hRequest, buffer, sizeof(buffer) - 1, &bytesRead) && bytesRead > 0)
-    {
-        buffer[bytesRead] = 0;
-        ss << buffer;
+    return PostToVolariX("/signal/bars", kBinaryBarsContentType, RequestEncoding(payload.length()),
+        payload.data(), (DWORD)payload.length());
+}
+
+
+// ============================================================================
+//  SetVolariXStreaming: request bodies of at least thresholdBytes are
+//  streamed onto the socket in 64 KB pieces as they are serialized (JSON
+//  with Transfer-Encoding: chunked, binary with its Content-Length), so
+//  memory stays flat however many bars are sent. 0 streams every request,
+//  a negative value none. Default 256 KB - about 1800 JSON bars or 5000
+//  binary ones.
+// ============================================================================
+extern "C" __declspec(dllexport)
+void __stdcall SetVolariXStreaming(int thresholdBytes)
+{
+    g_streamThresholdBytes.store(thresholdBytes < 0 ? -1 : thresholdBytes, std::memory_order_relaxed);
+}
+
+
+// ============================================================================
+//  SetVolariXCompression: request bodies of at least thresholdBytes are sent
+//  compressed (encoding 1 = gzip, 2 = zstd, 0 = off - the default) with a
+//  Content-Encoding header; smaller ones are not worth the CPU. Returns 1,
+//  or 0 if this build has no such codec (bodies then go out uncompressed).
+//  Responses are accepted gzip-compressed whenever WinINet can decode them.
+// ============================================================================
+extern "C" __declspec(dllexport)
+int __stdcall SetVolariXCompression(int encoding, int thresholdBytes)
+{
+    if (encoding != (int)BodyEncoding::kGzip && encoding != (int)BodyEncoding::kZstd)
+        encoding = (int)BodyEncoding::kIdentity;
+    g_compressEncoding.store(encoding, std::memory_order_relaxed);
+    g_compressThresholdBytes.store(thresholdBytes < 0 ? 0 : thresholdBytes, std::memory_order_relaxed);
+    return encoding == (int)BodyEncoding::kIdentity ||
+           volarix4::bridge::EncodingAvailable((BodyEncoding)encoding) ? 1 : 0;
+}
+
+
+// ============================================================================
+//  SetVolariXDebugLog: debug log file and verbosity (0 = off, 1 = errors,
+//  2 = info, 3 = debug). Empty/NULL path keeps the current file.
+// ============================================================================
+extern "C" __declspec(dllexport)
+void __stdcall SetVolariXDebugLog(const wchar_t* path, int level)
+{
+    std::string path_str;
+    if (path) {
+        std::wstring ws_path(path);
+        path_str.assign(ws_path.begin(), ws_path.end());
     }
 
-    InternetCloseHandle(hRequest);
-    InternetCloseHandle(hConnect);
-    InternetCloseHandle(hInternet);
+    if (level < (int)LogLevel::kOff)
+        level = (int)LogLevel::kOff;
+    if (level > (int)LogLevel::kDebug)
+        level = (int)LogLevel::kDebug;
 
-    // Return JSON response
-    std::string result = ss.str();
-    std::wstring wresult(result.begin(), result.end());
-    return SysAllocString(wresult.c_str());
+    BridgeLog().Configure(path_str, (LogLevel)level);
 }
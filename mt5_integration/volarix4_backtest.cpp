@@ -0,0 +1,1291 @@
+//=============================================================================
+//  volarix4_backtest.cpp
+//  Native backtest CLI (python -m volarix4_backtest, without the API)
+//
+//  Reads the same backtest_config.json as the Python CLI, loads the bars
+//  from its CSV file (or maps a columnar .v4bars file, core/bar_file.h, and
+//  reads it in place) and runs core/backtest_engine.h - the signal pipeline
+//  in process instead of one /signal request per bar. Single-period runs
+//  write the same trades/equity CSVs and summary as the Python reporter;
+//  walk-forward runs print the same per-year and aggregate summary; grid
+//  searches (core/grid_search.h) stream grid_results.csv as combinations
+//  finish and then write the top N, best_params.json and
+//  best_merged_config.json like grid_search.py. With monte_carlo_simulations
+//  or bootstrap_samples set, single and walk-forward runs also resample
+//  their trades (core/monte_carlo.h) and write the report and the
+//  percentile bands. exit_model picks how exits are resolved inside a bar
+//  (core/tick_path.h); "ticks" replays a tick CSV or mapped .v4ticks file.
+//
+//  Usage: volarix4_backtest <backtest_config.json> [--file bars.csv|.v4bars]
+//                           [--output-dir dir] [--save-bars out.v4bars]
+//                           [--ticks ticks.csv|.v4ticks] [--save-ticks out.v4ticks]
+//=============================================================================
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bridge/json_reader.h"
+#include "core/backtest_engine.h"
+#include "core/bar_columns.h"
+#include "core/bar_file.h"
+#include "core/bar_validation.h"
+#include "core/grid_search.h"
+#include "core/helpers.h"
+#include "core/monte_carlo.h"
+#include "core/tick_file.h"
+#include "core/work_stealing_pool.h"
+
+using namespace volarix4::core;
+using volarix4::bridge::JsonReader;
+using volarix4::bridge::JsonType;
+using volarix4::bridge::JsonValue;
+
+namespace {
+
+// backtest_config.json fields the native engine uses (config.py names)
+struct CliConfig
+{
+    BacktestConfig backtest = DefaultBacktestConfig();
+    std::string mode = "grid_search";
+    std::string source = "mt5";
+    std::string filePath;
+    std::string outputDir = "./backtest_results";
+    long long startTime = 0;            // 0 = unbounded
+    long long endTime = 0;
+    size_t barLimit = 0;                // "bars": newest N (0 = all)
+    std::vector<int> testYears;
+    int trainYearsLookback = 2;
+    bool useOptimizedMode = true;
+    bool saveTradesCsv = true;
+    bool saveEquityCurve = true;
+    bool hasGrid = false;
+    std::vector<GridAxis> grid;
+    std::string objective = "profit_factor";
+    size_t topN = 20;
+    int nJobs = -1;
+    bool runBestAfter = false;
+    size_t monteCarloSimulations = 0;   // Trade-order permutations (0 = no analysis)
+    size_t bootstrapSamples = 0;        // Bootstrap resamples
+    uint64_t monteCarloSeed = 42;
+    std::string tickFile;               // Ticks for exit_model "ticks"
+    std::string text;                   // The config as read (best_merged_config.json)
+};
+
+//=============================================================================
+//  Dates
+//=============================================================================
+long long DaysFromCivil(long long year, unsigned month, unsigned day)
+{
+    year -= month <= 2;
+    const long long era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = (unsigned)(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (long long)doe - 719468;
+}
+
+bool ParseFixedInt(std::string_view text, size_t pos, size_t width, int* value)
+{
+    if (pos + width > text.size())
+        return false;
+    auto result = std::from_chars(text.data() + pos, text.data() + pos + width, *value);
+    return result.ec == std::errc() && result.ptr == text.data() + pos + width;
+}
+
+// "YYYY-MM-DD", "YYYY-MM-DD HH:MM[:SS]" (or 'T') as a wall-clock time read
+// as UTC - the CSV's clock, which is what the pipeline's session filter
+// sees through the Python backtest too - or plain Unix seconds
+bool ParseTime(std::string_view text, long long* unix_time)
+{
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\r'))
+        text.remove_suffix(1);
+    while (!text.empty() && text.front() == ' ')
+        text.remove_prefix(1);
+
+    if (text.size() < 10 || text[4] != '-') {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), *unix_time);
+        return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    if (!ParseFixedInt(text, 0, 4, &year) || !ParseFixedInt(text, 5, 2, &month) ||
+        text[7] != '-' || !ParseFixedInt(text, 8, 2, &day) || month < 1 || month > 12 ||
+        day < 1 || day > 31)
+        return false;
+    if (text.size() > 10) {
+        if ((text[10] != ' ' && text[10] != 'T') || !ParseFixedInt(text, 11, 2, &hour) ||
+            text.size() < 16 || text[13] != ':' || !ParseFixedInt(text, 14, 2, &minute))
+            return false;
+        if (text.size() > 16 && (text[16] != ':' || !ParseFixedInt(text, 17, 2, &second)))
+            return false;
+    }
+    *unix_time = DaysFromCivil(year, (unsigned)month, (unsigned)day) * 86400 +
+                 hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+//=============================================================================
+//  Config
+//=============================================================================
+bool ReadFile(const std::string& path, std::string* contents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    *contents = buffer.str();
+    return true;
+}
+
+std::string StringOf(const JsonValue& value)
+{
+    std::string text(value.raw.size() + 1, '\0');
+    text.resize(value.CopyString(text.data(), text.size()));
+    return text;
+}
+
+// Whole numbers of a flat array ("[2023, 2024]")
+std::vector<int> IntArrayOf(const JsonValue& value)
+{
+    std::vector<int> numbers;
+    if (value.type != JsonType::kArray)
+        return numbers;
+    const char* p = value.raw.data();
+    const char* end = p + value.raw.size();
+    while (p < end) {
+        if ((*p >= '0' && *p <= '9') || *p == '-') {
+            int number = 0;
+            auto result = std::from_chars(p, end, number);
+            if (result.ec == std::errc()) {
+                numbers.push_back(number);
+                p = result.ptr;
+                continue;
+            }
+        }
+        ++p;
+    }
+    return numbers;
+}
+
+// {"min_confidence": [0.6, 0.7], ...}: one axis per member, numbers only
+bool GridOf(const JsonValue& value, std::vector<GridAxis>* grid, std::string* error)
+{
+    bool ok = true;
+    bool parsed = JsonReader(value.raw).ForEachMember([&](std::string_view name, const JsonValue& values) {
+        GridAxis axis;
+        axis.name = std::string(name);
+        std::string_view raw = values.raw;
+        if (values.type == JsonType::kArray && raw.size() > 2) {
+            raw = raw.substr(1, raw.size() - 2);
+            for (size_t start = 0; start <= raw.size();) {
+                size_t comma = raw.find(',', start);
+                std::string_view item = raw.substr(start, comma == std::string_view::npos ? raw.npos : comma - start);
+                while (!item.empty() && std::string_view(" \t\r\n").find(item.front()) != std::string_view::npos)
+                    item.remove_prefix(1);
+                while (!item.empty() && std::string_view(" \t\r\n").find(item.back()) != std::string_view::npos)
+                    item.remove_suffix(1);
+                double number = 0.0;
+                auto result = std::from_chars(item.data(), item.data() + item.size(), number);
+                if (item.empty() || result.ec != std::errc() || result.ptr != item.data() + item.size()) {
+                    ok = false;
+                    break;
+                }
+                axis.values.push_back(number);
+                axis.labels.emplace_back(item);
+                if (comma == std::string_view::npos)
+                    break;
+                start = comma + 1;
+            }
+        }
+        if (!ok || axis.values.empty()) {
+            *error = "Grid values must be a non-empty list of numbers: " + axis.name;
+            ok = false;
+            return false;
+        }
+        grid->push_back(std::move(axis));
+        return true;
+    });
+    if (!parsed && ok)
+        *error = "Malformed grid";
+    return parsed && ok;
+}
+
+bool LoadConfig(const std::string& path, CliConfig* config, std::string* error)
+{
+    std::string& text = config->text;
+    if (!ReadFile(path, &text)) {
+        *error = "Cannot read config file: " + path;
+        return false;
+    }
+
+    BacktestConfig& backtest = config->backtest;
+    StrategyParams& params = backtest.params;
+    bool ok = true;
+    bool parsed = JsonReader(text).ForEachMember([&](std::string_view key, const JsonValue& value) {
+        // Optional strategy fields left null keep the API's defaults
+        if (value.type == JsonType::kNull)
+            return true;
+        auto number = [&](double fallback) { return value.AsDouble(fallback); };
+        auto flag = [&]() { return value.type == JsonType::kBool && value.raw == "true"; };
+
+        if (key == "symbol")                              backtest.symbol = StringOf(value);
+        else if (key == "timeframe")                      backtest.timeframe = StringOf(value);
+        else if (key == "mode")                           config->mode = StringOf(value);
+        else if (key == "source")                         config->source = StringOf(value);
+        else if (key == "file_path")                      config->filePath = StringOf(value);
+        else if (key == "output_dir")                     config->outputDir = StringOf(value);
+        else if (key == "bars")                           config->barLimit = (size_t)number(0.0);
+        else if (key == "test_years")                     config->testYears = IntArrayOf(value);
+        else if (key == "train_years_lookback")           config->trainYearsLookback = (int)number(2.0);
+        else if (key == "use_optimized_mode")             config->useOptimizedMode = flag();
+        else if (key == "lookback_bars")                  backtest.lookbackBars = (size_t)number(400.0);
+        else if (key == "warmup_bars")                    backtest.warmupBars = (size_t)number(400.0);
+        else if (key == "min_confidence")                 params.minConfidence = number(params.minConfidence);
+        else if (key == "broken_level_cooldown_hours")    params.brokenLevelCooldownHours = number(params.brokenLevelCooldownHours);
+        else if (key == "broken_level_break_pips")        params.brokenLevelBreakPips = number(params.brokenLevelBreakPips);
+        else if (key == "min_edge_pips")                  params.minEdgePips = number(params.minEdgePips);
+        else if (key == "spread_pips")                    params.spreadPips = number(params.spreadPips);
+        else if (key == "slippage_pips")                  params.slippagePips = number(params.slippagePips);
+        else if (key == "commission_per_side_per_lot")    params.commissionPerSidePerLot = number(params.commissionPerSidePerLot);
+        else if (key == "usd_per_pip_per_lot")            params.usdPerPipPerLot = number(params.usdPerPipPerLot);
+        else if (key == "lot_size")                       params.lotSize = number(params.lotSize);
+        else if (key == "initial_balance_usd")            backtest.initialBalanceUsd = number(backtest.initialBalanceUsd);
+        else if (key == "save_trades_csv")                config->saveTradesCsv = flag();
+        else if (key == "save_equity_curve")              config->saveEquityCurve = flag();
+        else if (key == "objective")                      config->objective = StringOf(value);
+        else if (key == "top_n")                          config->topN = (size_t)number(20.0);
+        else if (key == "n_jobs")                         config->nJobs = (int)number(-1.0);
+        else if (key == "run_best_after")                 config->runBestAfter = flag();
+        else if (key == "monte_carlo_simulations")        config->monteCarloSimulations = (size_t)number(0.0);
+        else if (key == "bootstrap_samples")              config->bootstrapSamples = (size_t)number(0.0);
+        else if (key == "monte_carlo_seed")               config->monteCarloSeed = (uint64_t)number(42.0);
+        else if (key == "grid") {
+            config->hasGrid = value.type == JsonType::kObject;
+            if (config->hasGrid && !GridOf(value, &config->grid, error)) {
+                ok = false;
+                return false;
+            }
+        }
+        else if (key == "tick_file")                      config->tickFile = StringOf(value);
+        else if (key == "exit_model") {
+            std::string model = StringOf(value);
+            if (model == "bar")
+                backtest.exitModel = kExitBarRange;
+            else if (model == "open_only")
+                backtest.exitModel = kExitOpenOnly;
+            else if (model == "price_path")
+                backtest.exitModel = kExitPricePath;
+            else if (model == "ticks")
+                backtest.exitModel = kExitTicks;
+            else {
+                *error = "Invalid exit_model: " + model;
+                ok = false;
+                return false;
+            }
+        }
+        else if (key == "path_model") {
+            std::string model = StringOf(value);
+            if (model == "direction")
+                backtest.pathModel = kPathByDirection;
+            else if (model == "ohlc")
+                backtest.pathModel = kPathOhlc;
+            else if (model == "olhc")
+                backtest.pathModel = kPathOlhc;
+            else {
+                *error = "Invalid path_model: " + model;
+                ok = false;
+                return false;
+            }
+        }
+        else if (key == "fill_at") {
+            std::string fill = StringOf(value);
+            if (fill == "next_open")
+                backtest.fillAt = kFillNextOpen;
+            else if (fill == "signal_close")
+                backtest.fillAt = kFillSignalClose;
+            else {
+                *error = "Invalid fill_at: " + fill;
+                ok = false;
+                return false;
+            }
+        }
+        else if (key == "start_date" || key == "end_date") {
+            long long time = 0;
+            if (!ParseTime(StringOf(value), &time)) {
+                *error = "Invalid " + std::string(key) + ": " + StringOf(value);
+                ok = false;
+                return false;
+            }
+            (key == "start_date" ? config->startTime : config->endTime) = time;
+        }
+        return true;
+    });
+
+    if (!parsed && ok)
+        *error = "Malformed JSON in " + path;
+    return parsed && ok;
+}
+
+//=============================================================================
+//  Bars
+//=============================================================================
+std::vector<std::string_view> SplitCsvLine(std::string_view line)
+{
+    std::vector<std::string_view> fields;
+    size_t start = 0;
+    for (;;) {
+        size_t comma = line.find(',', start);
+        std::string_view field = line.substr(start, comma - start);
+        if (field.size() >= 2 && field.front() == '"' && field.back() == '"')
+            field = field.substr(1, field.size() - 2);
+        fields.push_back(field);
+        if (comma == std::string_view::npos)
+            return fields;
+        start = comma + 1;
+    }
+}
+
+bool ParseDouble(std::string_view text, double* value)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '+'))
+        text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\r'))
+        text.remove_suffix(1);
+    auto result = std::from_chars(text.data(), text.data() + text.size(), *value);
+    return !text.empty() && result.ec == std::errc();
+}
+
+// data_source.py's CSV layout: a header with time, open, high, low, close,
+// volume (any order, extra columns ignored); sorted by time after loading
+bool LoadCsv(const std::string& path, ColumnBuffer* bars, std::string* error)
+{
+    std::string text;
+    if (!ReadFile(path, &text)) {
+        *error = "Cannot read bars file: " + path;
+        return false;
+    }
+
+    static const char* kColumns[6] = { "time", "open", "high", "low", "close", "volume" };
+    size_t columns[6];
+    std::vector<OHLCVBar> rows;
+
+    size_t pos = 0;
+    bool header = true;
+    size_t line_number = 0;
+    while (pos < text.size()) {
+        size_t newline = text.find('\n', pos);
+        std::string_view line(text.data() + pos,
+                              (newline == std::string::npos ? text.size() : newline) - pos);
+        pos = newline == std::string::npos ? text.size() : newline + 1;
+        ++line_number;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;
+
+        std::vector<std::string_view> fields = SplitCsvLine(line);
+        if (header) {
+            for (size_t c = 0; c < 6; ++c) {
+                auto it = std::find(fields.begin(), fields.end(), kColumns[c]);
+                if (it == fields.end()) {
+                    *error = "CSV missing required column: " + std::string(kColumns[c]);
+                    return false;
+                }
+                columns[c] = (size_t)(it - fields.begin());
+            }
+            header = false;
+            continue;
+        }
+
+        OHLCVBar bar{};
+        double volume = 0.0;
+        bool valid = true;
+        for (size_t c = 0; c < 6 && valid; ++c)
+            valid = columns[c] < fields.size();
+        valid = valid && ParseTime(fields[columns[0]], &bar.timestamp) &&
+                ParseDouble(fields[columns[1]], &bar.open) &&
+                ParseDouble(fields[columns[2]], &bar.high) &&
+                ParseDouble(fields[columns[3]], &bar.low) &&
+                ParseDouble(fields[columns[4]], &bar.close) &&
+                ParseDouble(fields[columns[5]], &volume);
+        if (!valid) {
+            *error = path + ":" + std::to_string(line_number) + ": malformed bar";
+            return false;
+        }
+        bar.volume = (int)volume;
+        rows.push_back(bar);
+    }
+
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const OHLCVBar& a, const OHLCVBar& b) { return a.timestamp < b.timestamp; });
+    bars->Assign(rows.data(), rows.size());
+    return true;
+}
+
+// start_date / end_date (inclusive) and the newest `bars`, like
+// DataSource.load()
+BarColumns FilterBars(const BarColumns& bars, const CliConfig& config)
+{
+    size_t first = 0, end = bars.count;
+    if (config.startTime)
+        first = (size_t)(std::lower_bound(bars.time, bars.time + bars.count, config.startTime) - bars.time);
+    if (config.endTime)
+        end = (size_t)(std::upper_bound(bars.time, bars.time + bars.count, config.endTime) - bars.time);
+    if (end < first)
+        end = first;
+    BarColumns filtered = bars.Slice(first, end - first);
+    return config.barLimit ? filtered.Tail(config.barLimit) : filtered;
+}
+
+// A tick CSV: bid, ask and either time_msc (MqlTick.time_msc) or time
+// ("YYYY-MM-DD HH:MM:SS[.fff]", read like the bar times); sorted by time
+// after loading
+bool LoadTickCsv(const std::string& path, TickBuffer* ticks, std::string* error)
+{
+    std::string text;
+    if (!ReadFile(path, &text)) {
+        *error = "Cannot read tick file: " + path;
+        return false;
+    }
+
+    struct Row
+    {
+        long long timeMsc;
+        double bid;
+        double ask;
+    };
+    std::vector<Row> rows;
+    size_t time_column = 0, bid_column = 0, ask_column = 0;
+    bool milliseconds = false;
+
+    size_t pos = 0;
+    bool header = true;
+    size_t line_number = 0;
+    while (pos < text.size()) {
+        size_t newline = text.find('\n', pos);
+        std::string_view line(text.data() + pos,
+                              (newline == std::string::npos ? text.size() : newline) - pos);
+        pos = newline == std::string::npos ? text.size() : newline + 1;
+        ++line_number;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;
+
+        std::vector<std::string_view> fields = SplitCsvLine(line);
+        if (header) {
+            auto column = [&](std::string_view name, size_t* index) {
+                auto it = std::find(fields.begin(), fields.end(), name);
+                *index = (size_t)(it - fields.begin());
+                return it != fields.end();
+            };
+            milliseconds = column("time_msc", &time_column);
+            if ((!milliseconds && !column("time", &time_column)) || !column("bid", &bid_column) ||
+                !column("ask", &ask_column)) {
+                *error = "Tick CSV needs time (or time_msc), bid and ask columns: " + path;
+                return false;
+            }
+            header = false;
+            continue;
+        }
+
+        Row row{};
+        bool valid = time_column < fields.size() && bid_column < fields.size() && ask_column < fields.size() &&
+                     ParseDouble(fields[bid_column], &row.bid) && ParseDouble(fields[ask_column], &row.ask);
+        if (valid && milliseconds) {
+            std::string_view field = fields[time_column];
+            auto result = std::from_chars(field.data(), field.data() + field.size(), row.timeMsc);
+            valid = !field.empty() && result.ec == std::errc();
+        }
+        else if (valid) {
+            // Seconds, then up to three digits of fraction
+            std::string_view field = fields[time_column];
+            const size_t point = field.size() > 19 && field[19] == '.' ? 19 : std::string_view::npos;
+            long long seconds = 0;
+            valid = ParseTime(field.substr(0, point), &seconds);
+            long long fraction = 0;
+            if (valid && point != std::string_view::npos) {
+                for (size_t d = 0; d < 3; ++d) {
+                    const size_t at = point + 1 + d;
+                    const bool digit = at < field.size() && field[at] >= '0' && field[at] <= '9';
+                    fraction = fraction * 10 + (digit ? field[at] - '0' : 0);
+                }
+            }
+            row.timeMsc = seconds * 1000 + fraction;
+        }
+        if (!valid) {
+            *error = path + ":" + std::to_string(line_number) + ": malformed tick";
+            return false;
+        }
+        rows.push_back(row);
+    }
+
+    std::stable_sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.timeMsc < b.timeMsc; });
+    for (const Row& row : rows)
+        ticks->Append(row.timeMsc, row.bid, row.ask);
+    return true;
+}
+
+std::string FormatTickTime(long long time_msc)
+{
+    std::string text = FormatDateTime(time_msc / 1000) + ".";
+    const long long millis = time_msc % 1000;
+    text += (char)('0' + millis / 100);
+    text += (char)('0' + millis / 10 % 10);
+    text += (char)('0' + millis % 10);
+    return text;
+}
+
+const char* ExitModelName(ExitModel model)
+{
+    switch (model) {
+        case kExitOpenOnly: return "open_only";
+        case kExitPricePath: return "price_path";
+        case kExitTicks: return "ticks";
+        default: return "bar";
+    }
+}
+
+//=============================================================================
+//  Reports (reporting.py formats)
+//=============================================================================
+// f"{value:,.2f}"
+std::string Money(double value)
+{
+    std::string fixed;
+    AppendFixed(fixed, value, 2);
+    size_t digits_start = fixed[0] == '-' ? 1 : 0;
+    size_t point = fixed.find('.');
+    if (point == std::string::npos)
+        return fixed;
+    for (size_t i = point; i > digits_start + 3; i -= 3)
+        fixed.insert(i - 3, 1, ',');
+    return fixed;
+}
+
+std::string Fixed(double value, int decimals)
+{
+    std::string text;
+    AppendFixed(text, value, decimals);
+    return text;
+}
+
+std::string Repr(double value)
+{
+    std::string text;
+    AppendPyRepr(text, value);
+    return text;
+}
+
+std::string TimeOrEmpty(long long time) { return time ? FormatDateTime(time) : std::string(); }
+
+std::string CsvField(const std::string& text)
+{
+    if (text.find_first_of(",\"\n") == std::string::npos)
+        return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"')
+            quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+bool SaveTradesCsv(const std::vector<Trade>& trades, const std::string& path)
+{
+    std::ofstream out(path, std::ios::binary);
+    out << "direction,entry_time,entry_price,lot_size,confidence,reason,sl,tp1,tp2,tp3,"
+           "tp1_percent,tp2_percent,tp3_percent,tp1_hit,tp2_hit,tp3_hit,tp1_exit_time,"
+           "tp2_exit_time,tp3_exit_time,exit_time,exit_reason,exit_price,gross_pnl_usd,"
+           "net_pnl_usd,entry_cost_usd,exit_cost_usd,commission_usd\n";
+    auto flag = [](bool value) { return value ? "True" : "False"; };
+    for (const Trade& t : trades) {
+        out << SignalName(t.direction) << ',' << FormatDateTime(t.entryTime) << ','
+            << Repr(t.entryPrice) << ',' << Repr(t.lotSize) << ',' << Repr(t.confidence) << ','
+            << CsvField(t.reason) << ',' << Repr(t.sl) << ',' << Repr(t.tp1) << ','
+            << Repr(t.tp2) << ',' << Repr(t.tp3) << ',' << Repr(t.tp1Percent) << ','
+            << Repr(t.tp2Percent) << ',' << Repr(t.tp3Percent) << ',' << flag(t.tp1Hit) << ','
+            << flag(t.tp2Hit) << ',' << flag(t.tp3Hit) << ',' << TimeOrEmpty(t.tp1ExitTime) << ','
+            << TimeOrEmpty(t.tp2ExitTime) << ',' << TimeOrEmpty(t.tp3ExitTime) << ','
+            << TimeOrEmpty(t.exitTime) << ',' << ExitReasonName(t.exitReason) << ','
+            << Repr(t.exitPrice) << ',' << Repr(t.grossPnlUsd) << ',' << Repr(t.netPnlUsd) << ','
+            << Repr(t.entryCostUsd) << ',' << Repr(t.exitCostUsd) << ',' << Repr(t.commissionUsd)
+            << '\n';
+    }
+    return (bool)out;
+}
+
+bool SaveEquityCsv(const std::vector<EquityPoint>& equity, const std::string& path)
+{
+    std::ofstream out(path, std::ios::binary);
+    out << "time,balance,unrealized_pnl,equity\n";
+    for (const EquityPoint& point : equity)
+        out << FormatDateTime(point.time) << ',' << Repr(point.balance) << ','
+            << Repr(point.unrealizedPnl) << ',' << Repr(point.equity) << '\n';
+    return (bool)out;
+}
+
+std::string Summary(const BacktestResult& result, const BacktestConfig& config)
+{
+    const BacktestMetrics& m = result.metrics;
+    const std::string rule(70, '='), thin(70, '-');
+    std::ostringstream out;
+    out << rule << "\nBACKTEST RESULTS SUMMARY\n" << rule << '\n'
+        << "Symbol: " << config.symbol << "\nTimeframe: " << config.timeframe << "\n\n"
+        << "SIGNAL STATISTICS\n" << thin << '\n'
+        << "Total Signals Generated: " << result.totalSignals << '\n'
+        << "  BUY Signals: " << result.buySignals << '\n'
+        << "  SELL Signals: " << result.sellSignals << '\n'
+        << "  HOLD Signals: " << result.holdSignals << "\n\n"
+        << "TRADE STATISTICS\n" << thin << '\n'
+        << "Total Trades: " << m.totalTrades << '\n'
+        << "Winning Trades: " << m.winningTrades << '\n'
+        << "Losing Trades: " << m.losingTrades << '\n'
+        << "Win Rate: " << Fixed(m.winRate * 100, 2) << "%\n\n"
+        << "PROFIT/LOSS\n" << thin << '\n'
+        << "Net Profit: $" << Money(m.netProfitUsd) << '\n'
+        << "Gross Profit: $" << Money(m.grossProfitUsd) << '\n'
+        << "Gross Loss: $" << Money(m.grossLossUsd) << '\n'
+        << "Profit Factor: " << Fixed(m.profitFactor, 2) << '\n'
+        << "Return: " << Fixed(m.returnPct, 2) << "%\n\n"
+        << "RISK METRICS\n" << thin << '\n'
+        << "Max Drawdown: $" << Money(m.maxDrawdownUsd) << " (" << Fixed(m.maxDrawdownPct, 2) << "%)\n\n"
+        << "ACCOUNT BALANCE\n" << thin << '\n'
+        << "Final Balance: $" << Money(m.finalBalance) << '\n' << rule << '\n';
+    return out.str();
+}
+
+std::string WalkForwardSummary(const WalkForwardResult& result, const CliConfig& config)
+{
+    const WalkForwardAggregate& agg = result.aggregate;
+    const std::string rule(70, '='), thin(70, '-');
+    std::ostringstream out;
+    out << rule << "\nWALK-FORWARD TESTING SUMMARY\n" << rule << '\n'
+        << "Symbol: " << config.backtest.symbol << "\nTimeframe: " << config.backtest.timeframe << '\n'
+        << "Test Years: [";
+    for (size_t i = 0; i < config.testYears.size(); ++i)
+        out << (i ? ", " : "") << config.testYears[i];
+    out << "]\nTrain Years Lookback: " << config.trainYearsLookback << "\n\n"
+        << "RESULTS BY YEAR\n" << thin << '\n';
+    for (const WalkForwardYear& year : result.years) {
+        const BacktestMetrics& m = year.result.metrics;
+        out << year.year << ":\n"
+            << "  Trades: " << m.totalTrades << '\n'
+            << "  Win Rate: " << Fixed(m.winRate * 100, 2) << "%\n"
+            << "  Net Profit: $" << Money(m.netProfitUsd) << '\n'
+            << "  Return: " << Fixed(m.returnPct, 2) << "%\n";
+    }
+    out << "\nAGGREGATE METRICS (All Years)\n" << thin << '\n'
+        << "Total Years Tested: " << agg.totalYears << '\n'
+        << "Total Trades: " << agg.totalTrades << '\n'
+        << "Avg Trades/Year: " << Fixed(agg.avgTradesPerYear, 1) << '\n'
+        << "Winning Trades: " << agg.winningTrades << '\n'
+        << "Losing Trades: " << agg.losingTrades << '\n'
+        << "Win Rate: " << Fixed(agg.winRate * 100, 2) << "%\n"
+        << "Profit Factor: " << Fixed(agg.profitFactor, 2) << "\n\n"
+        << "Aggregate Net Profit: $" << Money(agg.netProfitUsd) << '\n'
+        << "Avg Net Profit/Year: $" << Money(agg.avgNetProfitPerYear) << '\n'
+        << "Aggregate Return: " << Fixed(agg.returnPct, 2) << "%\n"
+        << rule << '\n';
+    return out.str();
+}
+
+// datetime.now().strftime("%Y%m%d_%H%M%S")
+std::string Timestamp()
+{
+    std::time_t now = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    return stamp;
+}
+
+// f"{symbol}_{timeframe}_{timestamp}"
+std::string FilePrefix(const BacktestConfig& config)
+{
+    return config.symbol + "_" + config.timeframe + "_" + Timestamp();
+}
+
+//=============================================================================
+//  Monte Carlo (tests/backtest.py's report, plus bootstrap and bands)
+//=============================================================================
+bool MonteCarloEnabled(const CliConfig& config)
+{
+    return config.monteCarloSimulations > 0 || config.bootstrapSamples > 0;
+}
+
+MonteCarloSettings MonteCarloSettingsOf(const CliConfig& config)
+{
+    MonteCarloSettings settings;
+    settings.permutations = config.monteCarloSimulations;
+    settings.bootstraps = config.bootstrapSamples;
+    settings.seed = config.monteCarloSeed;
+    settings.workers = WorkStealingPool::WorkerCount(config.nJobs);
+    settings.initialBalance = config.backtest.initialBalanceUsd;
+    return settings;
+}
+
+std::vector<double> NetPnl(const std::vector<Trade>& trades)
+{
+    std::vector<double> pnl;
+    pnl.reserve(trades.size());
+    for (const Trade& trade : trades)
+        pnl.push_back(trade.netPnlUsd);
+    return pnl;
+}
+
+std::string Interpretation(double observed, double median)
+{
+    const double ratio = median > 0 ? observed / median : 1.0;
+    if (ratio < 0.8)
+        return "Lucky sequence (obs < median)";
+    if (ratio > 1.2)
+        return "Unlucky sequence (obs > median)";
+    return "Typical sequence";
+}
+
+std::string MonteCarloReport(const MonteCarloResult& result)
+{
+    const std::string rule(70, '='), thin(70, '-');
+    std::ostringstream out;
+    out << rule << "\nMONTE CARLO ANALYSIS\n" << rule << '\n'
+        << "Trades: " << result.trades << '\n'
+        << "Observed Max DD: $" << Money(result.observedMaxDrawdown) << '\n'
+        << "Observed Net P&L: $" << Money(result.observedFinalPnl) << '\n';
+
+    auto section = [&](const char* title, const MonteCarloDistribution& d, bool final_pnl) {
+        if (d.simulations == 0)
+            return;
+        out << '\n' << title << " (N=" << d.simulations << ")\n" << thin << '\n'
+            << "MC Median Max DD: $" << Money(d.medianMaxDrawdown) << '\n'
+            << "MC 95th Percentile DD: $" << Money(d.p95MaxDrawdown) << '\n'
+            << "MC Maximum DD: $" << Money(d.maxMaxDrawdown) << '\n';
+        if (final_pnl)
+            out << "MC Median Net P&L: $" << Money(d.medianFinalPnl) << '\n'
+                << "MC 5th-95th Percentile Net P&L: $" << Money(d.p5FinalPnl) << " to $"
+                << Money(d.p95FinalPnl) << '\n';
+        out << "P(final PnL < 0): " << Fixed(d.probLoss * 100, 1) << "%\n"
+            << "P(DD > observed): " << Fixed(d.probDrawdownExceedsObserved * 100, 1) << "%\n"
+            << "Interpretation: " << Interpretation(result.observedMaxDrawdown, d.medianMaxDrawdown) << '\n';
+    };
+    section("TRADE ORDER RESHUFFLE", result.permutation, false);
+    section("BOOTSTRAP RESAMPLE", result.bootstrap, true);
+    out << rule << '\n';
+    return out.str();
+}
+
+// One row per method and band point: the balance and drawdown percentiles
+bool SaveMonteCarloBands(const MonteCarloResult& result, const MonteCarloSettings& settings,
+                         const std::string& path)
+{
+    std::ofstream out(path, std::ios::binary);
+    out << "method,trades";
+    for (const char* series : { "equity", "drawdown" })
+        for (double percent : settings.bandPercentiles)
+            out << ',' << series << "_p" << (percent == std::floor(percent) ? std::to_string((int)percent) : Repr(percent));
+    out << '\n';
+
+    auto rows = [&](const char* method, const MonteCarloDistribution& d) {
+        if (d.simulations == 0)
+            return;
+        for (size_t point = 0; point < result.bandTrades.size(); ++point) {
+            out << method << ',' << result.bandTrades[point];
+            for (const auto* bands : { &d.equityBands, &d.drawdownBands })
+                for (const std::vector<double>& band : *bands)
+                    out << ',' << Repr(band[point]);
+            out << '\n';
+        }
+    };
+    rows("permutation", result.permutation);
+    rows("bootstrap", result.bootstrap);
+    return (bool)out;
+}
+
+// Analyse trades and write prefix_monte_carlo.txt / prefix_mc_bands.csv
+bool RunMonteCarloCli(const std::vector<Trade>& trades, const CliConfig& config,
+                      const std::string& prefix, MonteCarloResult* result)
+{
+    const MonteCarloSettings settings = MonteCarloSettingsOf(config);
+    const auto started = std::chrono::steady_clock::now();
+    std::string error;
+    if (!RunMonteCarlo(NetPnl(trades), settings, result, &error)) {
+        std::fprintf(stderr, "Monte Carlo analysis failed: %s\n", error.c_str());
+        return false;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    const std::string report = MonteCarloReport(*result);
+    std::ofstream(prefix + "_monte_carlo.txt", std::ios::binary) << report;
+    std::printf("Saved Monte Carlo report to: %s_monte_carlo.txt\n", prefix.c_str());
+    if (result->trades > 0 && SaveMonteCarloBands(*result, settings, prefix + "_mc_bands.csv"))
+        std::printf("Saved Monte Carlo bands to: %s_mc_bands.csv\n", prefix.c_str());
+    std::printf("\n%s%zu simulations over %zu trades in %.1f ms on %zu workers\n", report.c_str(),
+                settings.permutations + settings.bootstraps, result->trades, ms, settings.workers);
+    return true;
+}
+
+// The per-year reshuffle table of tests/analysis/MONTE_CARLO_ANALYSIS.md,
+// averaged over the years
+std::string WalkForwardMonteCarloTable(const WalkForwardResult& walk_forward,
+                                       const std::vector<MonteCarloResult>& years)
+{
+    const std::string rule(70, '='), thin(70, '-');
+    std::ostringstream out;
+    out << rule << "\nMONTE CARLO BY YEAR (trade order reshuffle, USD)\n" << rule << '\n'
+        << "Year    Trades  Observed DD   Median DD     95th DD       P(DD > obs)\n" << thin << '\n';
+    double sums[4] = {};
+    size_t counted = 0;
+    for (size_t i = 0; i < years.size(); ++i) {
+        const MonteCarloResult& mc = years[i];
+        const MonteCarloDistribution& d = mc.permutation;
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-7d %-7zu %-13s %-13s %-13s %s%%\n", walk_forward.years[i].year,
+                      mc.trades, Money(mc.observedMaxDrawdown).c_str(), Money(d.medianMaxDrawdown).c_str(),
+                      Money(d.p95MaxDrawdown).c_str(), Fixed(d.probDrawdownExceedsObserved * 100, 1).c_str());
+        out << line;
+        if (mc.trades > 0) {
+            sums[0] += mc.observedMaxDrawdown;
+            sums[1] += d.medianMaxDrawdown;
+            sums[2] += d.p95MaxDrawdown;
+            sums[3] += d.probDrawdownExceedsObserved;
+            ++counted;
+        }
+    }
+    if (counted > 0) {
+        const double n = (double)counted;
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-7s %-7s %-13s %-13s %-13s %s%%\n", "Average", "",
+                      Money(sums[0] / n).c_str(), Money(sums[1] / n).c_str(), Money(sums[2] / n).c_str(),
+                      Fixed(sums[3] / n * 100, 1).c_str());
+        out << thin << '\n' << line;
+    }
+    out << rule << '\n';
+    return out.str();
+}
+
+//=============================================================================
+//  Grid search (grid_search.py outputs)
+//=============================================================================
+// str(params): {'min_confidence': 0.6, 'min_edge_pips': 2.0}
+std::string ParamsText(const std::vector<GridAxis>& grid, const GridResult& result)
+{
+    std::string text = "{";
+    for (size_t a = 0; a < grid.size(); ++a) {
+        if (a)
+            text += ", ";
+        text += "'" + grid[a].name + "': " + grid[a].labels[result.choice[a]];
+    }
+    return text + "}";
+}
+
+std::string GridCsvHeader(const std::vector<GridAxis>& grid)
+{
+    std::string header;
+    for (const GridAxis& axis : grid)
+        header += "param_" + axis.name + ",";
+    return header + "metric_total_trades,metric_total_years,metric_avg_trades_per_year,"
+                    "metric_winning_trades,metric_losing_trades,metric_win_rate,"
+                    "metric_aggregate_net_profit,metric_aggregate_gross_profit,"
+                    "metric_aggregate_gross_loss,metric_profit_factor,metric_aggregate_return_pct,"
+                    "metric_avg_net_profit_per_year,metric_years_tested\n";
+}
+
+// Without trades the aggregate only has the keys walk_forward.py keeps
+std::string GridCsvRow(const std::vector<GridAxis>& grid, const GridResult& result)
+{
+    const WalkForwardAggregate& agg = result.aggregate;
+    std::string row;
+    for (size_t a = 0; a < grid.size(); ++a)
+        row += grid[a].labels[result.choice[a]] + ",";
+
+    const bool full = agg.totalTrades > 0 || agg.totalYears == 0;
+    std::string years = "[";
+    for (size_t i = 0; i < agg.yearsTested.size(); ++i)
+        years += (i ? ", " : "") + std::to_string(agg.yearsTested[i]);
+    years += "]";
+
+    auto optional = [&](const std::string& text) { return full ? text : std::string(); };
+    row += std::to_string(agg.totalTrades) + "," + std::to_string(agg.totalYears) + "," +
+           (full ? Repr(agg.avgTradesPerYear) : "0") + "," +
+           optional(std::to_string(agg.winningTrades)) + "," + optional(std::to_string(agg.losingTrades)) + "," +
+           optional(Repr(agg.winRate)) + "," + (full ? Repr(agg.netProfitUsd) : "0") + "," +
+           optional(Repr(agg.grossProfitUsd)) + "," + optional(Repr(agg.grossLossUsd)) + "," +
+           optional(Repr(agg.profitFactor)) + "," + (full ? Repr(agg.returnPct) : "0") + "," +
+           optional(Repr(agg.avgNetProfitPerYear)) + "," + optional(CsvField(years)) + "\n";
+    return row;
+}
+
+// The config with the best values, as a walk-forward config (no grid)
+std::string MergedConfigJson(const CliConfig& config, const GridResult& best)
+{
+    std::string json = "{";
+    bool first = true;
+    auto member = [&](std::string_view key, const std::string& value) {
+        json += first ? "\n  \"" : ",\n  \"";
+        json.append(key.data(), key.size());
+        json += "\": " + value;
+        first = false;
+    };
+
+    JsonReader(config.text).ForEachMember([&](std::string_view key, const JsonValue& value) {
+        if (key == "grid" || key == "mode")
+            return true;
+        for (size_t a = 0; a < config.grid.size(); ++a) {
+            if (key == config.grid[a].name)
+                return true;
+        }
+        member(key, value.IsString() ? "\"" + std::string(value.raw) + "\"" : std::string(value.raw));
+        return true;
+    });
+    member("mode", "\"walk_forward\"");
+    for (size_t a = 0; a < config.grid.size(); ++a)
+        member(config.grid[a].name, config.grid[a].labels[best.choice[a]]);
+    return json + "\n}\n";
+}
+
+int RunGridSearchCli(const BarColumns& bars, const TickColumns& ticks, CliConfig& config)
+{
+    if (config.testYears.empty()) {
+        std::fprintf(stderr, "Grid search needs test_years: every combination is scored by walk-forward\n");
+        return 1;
+    }
+
+    GridSearchSettings settings;
+    settings.testYears = config.testYears;
+    settings.trainYearsLookback = config.trainYearsLookback;
+    settings.historyWindows = config.useOptimizedMode;
+    settings.workers = WorkStealingPool::WorkerCount(config.nJobs);
+    settings.ticks = &ticks;
+
+    const std::string rule(70, '=');
+    const size_t total = GridCombinationCount(config.grid);
+    std::printf("%s\nGRID SEARCH OPTIMIZATION\n%s\nObjective: %s\nParallel workers: %zu\n"
+                "Total combinations to test: %zu\n%s\n",
+                rule.c_str(), rule.c_str(), config.objective.c_str(), settings.workers, total, rule.c_str());
+
+    const std::filesystem::path output_dir = std::filesystem::path(config.outputDir) / ("grid_search_" + Timestamp());
+    std::error_code ec;
+    std::filesystem::create_directories(output_dir, ec);
+
+    // All results, streamed in completion order
+    std::ofstream stream(output_dir / "grid_results.csv", std::ios::binary);
+    stream << GridCsvHeader(config.grid) << std::flush;
+
+    auto on_result = [&](const GridResult& result, size_t completed, size_t count) {
+        const std::string params = ParamsText(config.grid, result);
+        if (!result.ok) {
+            std::printf("[%zu/%zu] Failed %s: %s\n", completed, count, params.c_str(), result.error.c_str());
+            return;
+        }
+        stream << GridCsvRow(config.grid, result) << std::flush;
+        std::printf("[%zu/%zu] Completed %s -> %s = %s\n", completed, count, params.c_str(),
+                    config.objective.c_str(), Fixed(GridObjective(result.aggregate, config.objective), 4).c_str());
+        std::fflush(stdout);
+    };
+
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<GridResult> results;
+    size_t feature_computations = 0;
+    std::string error;
+    if (!RunGridSearch(bars, config.backtest, config.grid, settings, on_result, &results, &error,
+                       &feature_computations)) {
+        std::fprintf(stderr, "Grid search failed: %s\n", error.c_str());
+        return 1;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    stream.close();
+
+    // Sorted by the objective, best first (stable, like sorted())
+    std::vector<const GridResult*> ranked;
+    for (const GridResult& result : results)
+        if (result.ok)
+            ranked.push_back(&result);
+    std::stable_sort(ranked.begin(), ranked.end(), [&](const GridResult* a, const GridResult* b) {
+        return GridObjective(a->aggregate, config.objective) > GridObjective(b->aggregate, config.objective);
+    });
+
+    const size_t top_n = std::min(config.topN, ranked.size());
+    std::ofstream top(output_dir / ("top_" + std::to_string(top_n) + "_results.csv"), std::ios::binary);
+    top << GridCsvHeader(config.grid);
+    for (size_t i = 0; i < top_n; ++i)
+        top << GridCsvRow(config.grid, *ranked[i]);
+    top.close();
+
+    std::printf("%s\nGRID SEARCH COMPLETE\n%s\n", rule.c_str(), rule.c_str());
+    std::printf("Output files saved to: %s\n", output_dir.string().c_str());
+    std::printf("%zu combinations in %.1f ms (%zu signal windows analysed, shared by all combinations)\n",
+                total, ms, feature_computations);
+    if (ranked.empty())
+        return 1;
+
+    const GridResult& best = *ranked[0];
+    std::string best_params = "{";
+    for (size_t a = 0; a < config.grid.size(); ++a)
+        best_params += std::string(a ? "," : "") + "\n  \"" + config.grid[a].name + "\": " +
+                       config.grid[a].labels[best.choice[a]];
+    std::ofstream(output_dir / "best_params.json", std::ios::binary) << best_params << "\n}\n";
+    std::ofstream(output_dir / "best_merged_config.json", std::ios::binary) << MergedConfigJson(config, best);
+
+    const size_t shown = std::min<size_t>(5, ranked.size());
+    std::printf("\n%s\nTOP %zu PARAMETER COMBINATIONS\n%s\nObjective: %s\n\n", rule.c_str(), shown,
+                rule.c_str(), config.objective.c_str());
+    for (size_t i = 0; i < shown; ++i) {
+        const GridResult& result = *ranked[i];
+        std::printf("%zu. %s = %s\n   Parameters: %s\n   Total Trades: %zu\n   Win Rate: %s%%\n\n", i + 1,
+                    config.objective.c_str(), Fixed(GridObjective(result.aggregate, config.objective), 4).c_str(),
+                    ParamsText(config.grid, result).c_str(), result.aggregate.totalTrades,
+                    Fixed(result.aggregate.winRate * 100, 2).c_str());
+    }
+    std::printf("%s\n", rule.c_str());
+
+    if (config.runBestAfter) {
+        BacktestConfig best_config = config.backtest;
+        for (size_t a = 0; a < config.grid.size(); ++a)
+            SetBacktestParam(&best_config, config.grid[a].name, config.grid[a].values[best.choice[a]]);
+
+        SignalCooldownTracker cooldown;
+        BacktestOptions options;
+        options.cooldown = &cooldown;
+        options.ticks = &ticks;
+        WalkForwardResult walk_forward;
+        if (!RunWalkForward(bars, best_config, config.testYears, config.trainYearsLookback,
+                            config.useOptimizedMode, options, &walk_forward, &error)) {
+            std::fprintf(stderr, "Walk-forward with the best parameters failed: %s\n", error.c_str());
+            return 1;
+        }
+        CliConfig best_cli = config;
+        best_cli.backtest = best_config;
+        std::printf("\n%s", WalkForwardSummary(walk_forward, best_cli).c_str());
+    }
+    return 0;
+}
+
+int Usage()
+{
+    std::fprintf(stderr, "Usage: volarix4_backtest <backtest_config.json> [--file bars.csv|.v4bars] "
+                         "[--output-dir dir] [--save-bars out.v4bars] [--ticks ticks.csv|.v4ticks] "
+                         "[--save-ticks out.v4ticks]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string config_path, file_override, output_override, save_bars, tick_override, save_ticks;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "--file" || arg == "--output-dir") && i + 1 < argc)
+            (arg == "--file" ? file_override : output_override) = argv[++i];
+        else if (arg == "--save-bars" && i + 1 < argc)
+            save_bars = argv[++i];
+        else if ((arg == "--ticks" || arg == "--save-ticks") && i + 1 < argc)
+            (arg == "--ticks" ? tick_override : save_ticks) = argv[++i];
+        else if (!arg.empty() && arg[0] != '-' && config_path.empty())
+            config_path = argv[i];
+        else
+            return Usage();
+    }
+    if (config_path.empty())
+        return Usage();
+
+    CliConfig config;
+    std::string error;
+    if (!LoadConfig(config_path, &config, &error)) {
+        std::fprintf(stderr, "Failed to load config file: %s\n", error.c_str());
+        return 1;
+    }
+    if (!file_override.empty()) {
+        config.filePath = file_override;
+        config.source = std::filesystem::path(file_override).extension() == ".v4bars" ? "v4bars" : "csv";
+    }
+    if (!output_override.empty())
+        config.outputDir = output_override;
+    if (!tick_override.empty())
+        config.tickFile = tick_override;
+
+    // Bars come from a file here; MT5 and Parquet sources stay with the Python CLI
+    if ((config.source != "csv" && config.source != "v4bars") || config.filePath.empty()) {
+        std::fprintf(stderr, "The native backtest reads CSV or .v4bars bars: set \"source\": \"csv\" "
+                             "or \"v4bars\" and \"file_path\" (or pass --file)\n");
+        return 1;
+    }
+
+    const auto load_started = std::chrono::steady_clock::now();
+    ColumnBuffer storage;
+    MappedBarFile mapped;
+    BarColumns loaded;
+    if (config.source == "v4bars") {
+        if (!mapped.Open(config.filePath, &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        if (mapped.Symbol() != config.backtest.symbol || mapped.Timeframe() != config.backtest.timeframe) {
+            std::fprintf(stderr, "%s holds %s %s bars, the config asks for %s %s\n", config.filePath.c_str(),
+                         std::string(mapped.Symbol()).c_str(), std::string(mapped.Timeframe()).c_str(),
+                         config.backtest.symbol.c_str(), config.backtest.timeframe.c_str());
+            return 1;
+        }
+        loaded = mapped.Bars();
+    }
+    else {
+        if (!LoadCsv(config.filePath, &storage, &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        loaded = storage.View();
+    }
+    const BarColumns bars = FilterBars(loaded, config);
+    if (bars.count == 0) {
+        std::fprintf(stderr, "No bars loaded from %s\n", config.filePath.c_str());
+        return 1;
+    }
+    std::printf("Loaded %zu bars (%s to %s) in %.1f ms\n", bars.count, FormatDateTime(bars.time[0]).c_str(),
+                FormatDateTime(bars.time[bars.count - 1]).c_str(),
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_started).count());
+
+    if (!save_bars.empty()) {
+        if (!WriteBarFile(save_bars, config.backtest.symbol, config.backtest.timeframe, bars, &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        std::printf("Saved %zu bars to: %s\n", bars.count, save_bars.c_str());
+    }
+
+    // Ticks are read for tick exits and for --save-ticks (e.g. CSV to .v4ticks)
+    TickBuffer tick_storage;
+    MappedTickFile mapped_ticks;
+    TickColumns ticks;
+    if (config.backtest.exitModel == kExitTicks || !save_ticks.empty()) {
+        if (config.tickFile.empty()) {
+            std::fprintf(stderr, "exit_model \"ticks\" and --save-ticks need \"tick_file\" (or --ticks)\n");
+            return 1;
+        }
+        const auto ticks_started = std::chrono::steady_clock::now();
+        if (std::filesystem::path(config.tickFile).extension() == ".v4ticks") {
+            if (!mapped_ticks.Open(config.tickFile, &error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            if (mapped_ticks.Symbol() != config.backtest.symbol) {
+                std::fprintf(stderr, "%s holds %s ticks, the config asks for %s\n", config.tickFile.c_str(),
+                             std::string(mapped_ticks.Symbol()).c_str(), config.backtest.symbol.c_str());
+                return 1;
+            }
+            ticks = mapped_ticks.Ticks();
+        }
+        else {
+            if (!LoadTickCsv(config.tickFile, &tick_storage, &error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            ticks = tick_storage.View();
+        }
+        const double tick_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - ticks_started).count();
+        if (ticks.count > 0)
+            std::printf("Loaded %zu ticks (%s to %s) in %.1f ms\n", ticks.count, FormatTickTime(ticks.timeMsc[0]).c_str(),
+                        FormatTickTime(ticks.timeMsc[ticks.count - 1]).c_str(), tick_ms);
+        else
+            std::printf("Loaded 0 ticks from %s\n", config.tickFile.c_str());
+
+        if (!save_ticks.empty()) {
+            if (!WriteTickFile(save_ticks, config.backtest.symbol, ticks, &error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            std::printf("Saved %zu ticks to: %s\n", ticks.count, save_ticks.c_str());
+        }
+    }
+
+    if (config.mode == "grid_search" && config.hasGrid)
+        return RunGridSearchCli(bars, ticks, config);
+
+    // One tracker for the whole run, like the API process serving it
+    SignalCooldownTracker cooldown;
+    BacktestOptions options;
+    options.cooldown = &cooldown;
+    options.ticks = &ticks;
+    const auto started = std::chrono::steady_clock::now();
+    auto elapsed_ms = [&]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    };
+
+    if (!config.testYears.empty()) {
+        options.workers = WorkStealingPool::WorkerCount(config.nJobs);
+        WalkForwardResult result;
+        if (!RunWalkForward(bars, config.backtest, config.testYears, config.trainYearsLookback,
+                            config.useOptimizedMode, options, &result, &error)) {
+            std::fprintf(stderr, "Walk-forward testing failed: %s\n", error.c_str());
+            return 1;
+        }
+        const double ms = elapsed_ms();
+        std::printf("\n%s\nWalk-forward finished in %.1f ms (%zu years on %zu workers)\n",
+                    WalkForwardSummary(result, config).c_str(), ms, result.years.size(),
+                    std::min(options.workers, std::max<size_t>(result.years.size(), 1)));
+        if (!MonteCarloEnabled(config))
+            return 0;
+
+        // Each year on its own, then all years' trades as one sequence
+        std::vector<MonteCarloResult> years(result.years.size());
+        std::vector<Trade> all_trades;
+        const MonteCarloSettings settings = MonteCarloSettingsOf(config);
+        for (size_t i = 0; i < result.years.size(); ++i) {
+            const std::vector<Trade>& trades = result.years[i].result.trades;
+            if (!RunMonteCarlo(NetPnl(trades), settings, &years[i], &error)) {
+                std::fprintf(stderr, "Monte Carlo analysis failed: %s\n", error.c_str());
+                return 1;
+            }
+            all_trades.insert(all_trades.end(), trades.begin(), trades.end());
+        }
+        std::printf("\n%s", WalkForwardMonteCarloTable(result, years).c_str());
+
+        std::error_code ec;
+        std::filesystem::create_directories(config.outputDir, ec);
+        const std::string prefix = (std::filesystem::path(config.outputDir) /
+                                    (FilePrefix(config.backtest) + "_walk_forward")).string();
+        MonteCarloResult combined;
+        return RunMonteCarloCli(all_trades, config, prefix, &combined) ? 0 : 1;
+    }
+
+    BacktestResult result;
+    if (!RunBacktest(bars, config.backtest, options, &result, &error)) {
+        std::fprintf(stderr, "Backtest failed: %s\n", error.c_str());
+        return 1;
+    }
+    const double ms = elapsed_ms();
+
+    std::error_code ec;
+    std::filesystem::create_directories(config.outputDir, ec);
+    const std::string prefix = (std::filesystem::path(config.outputDir) / FilePrefix(config.backtest)).string();
+    const std::string summary = Summary(result, config.backtest);
+
+    if (config.saveTradesCsv && !result.trades.empty() && SaveTradesCsv(result.trades, prefix + "_trades.csv"))
+        std::printf("Saved trades to: %s_trades.csv\n", prefix.c_str());
+    if (config.saveEquityCurve && !result.equityCurve.empty() && SaveEquityCsv(result.equityCurve, prefix + "_equity.csv"))
+        std::printf("Saved equity curve to: %s_equity.csv\n", prefix.c_str());
+    std::ofstream(prefix + "_summary.txt", std::ios::binary) << summary;
+    std::printf("Saved summary to: %s_summary.txt\n", prefix.c_str());
+
+    std::printf("\n%s\nBacktest finished in %.1f ms (%zu signal evaluations)\n", summary.c_str(), ms,
+                result.totalSignals);
+    if (config.backtest.exitModel == kExitTicks)
+        std::printf("Exits: ticks (%zu ticks replayed, %zu bars without ticks on the price path)\n",
+                    result.ticksReplayed, result.barsWithoutTicks);
+    else if (config.backtest.exitModel != kExitBarRange)
+        std::printf("Exits: %s\n", ExitModelName(config.backtest.exitModel));
+
+    MonteCarloResult monte_carlo;
+    if (MonteCarloEnabled(config) && !RunMonteCarloCli(result.trades, config, prefix, &monte_carlo))
+        return 1;
+    return 0;
+}
@@ -3,7 +3,8 @@
 //  C++ DLL Bridge for MT5 -> Volarix 4 FastAPI
 //
 //  Sends OHLCV data to Volarix 4 API and returns JSON response
-//  Single-TF only (no multi-TF complexity)
+//  Single-TF requests; the local pipeline can add a higher-TF context
+//  resampled in-process from the stored bars (GetVolarix4SignalWithContext)
 //=============================================================================
 
 // NOTE: If your project uses precompiled headers, uncomment the next line:
@@ -12,38 +13,421 @@
 #include <windows.h>
 #include <wininet.h>
 #include <string>
+#include <algorithm>
+#include <mutex>
 #include <sstream>
-#include <iomanip>
+#include <vector>
 #include <comutil.h>
 
+#include "bridge/bar_streams.h"
+#include "bridge/debug_log.h"
+#include "bridge/endpoint_pool.h"
+#include "bridge/http_session.h"
+#include "bridge/json_writer.h"
+#include "bridge/latency_stats.h"
+#include "bridge/local_signal_json.h"
+#include "bridge/response_cache.h"
+#include "bridge/signal_result.h"
+#include "bridge/shm_transport.h"
+#include "bridge/signal_jobs.h"
+#include "bridge/signal_subscriptions.h"
+#include "core/bar.h"
+#include "core/bar_file.h"
+#include "core/bar_store.h"
+#include "core/helpers.h"
+#include "core/htf_context.h"
+#include "core/signal_pipeline.h"
+#include "core/sr_incremental.h"
+#include "core/sr_levels.h"
+
 #pragma comment(lib, "wininet.lib")
 #pragma comment(lib, "comsuppw.lib")
 
-// OHLCV Bar structure (must match MT5 definition)
-// CRITICAL: MQL5 uses tight packing with NO PADDING (total: 44 bytes)
-#pragma pack(push, 1)  // No padding - tight packing to match MQL5
-struct OHLCVBar
+using volarix4::bridge::BarStreamTracker;
+using volarix4::bridge::BridgeStats;
+using volarix4::bridge::CallTimings;
+using volarix4::bridge::DebugLog;
+using volarix4::bridge::EndpointPool;
+using volarix4::bridge::HttpError;
+using volarix4::bridge::HttpErrorJson;
+using volarix4::bridge::HttpSessionPool;
+using volarix4::bridge::IsEndpointFailure;
+using volarix4::bridge::JsonWriter;
+using volarix4::bridge::LatencyPhase;
+using volarix4::bridge::LocalSignalJson;
+using volarix4::bridge::LogLevel;
+using volarix4::bridge::ParseApiUrl;
+using volarix4::bridge::ParseSignalResult;
+using volarix4::bridge::PostAttempt;
+using volarix4::bridge::QpcNow;
+using volarix4::bridge::ResponseCache;
+using volarix4::bridge::ScopedPhase;
+using volarix4::bridge::ShmTransport;
+using volarix4::bridge::SignalJobQueue;
+using volarix4::bridge::SignalResult;
+using volarix4::bridge::SignalSubscriptions;
+using volarix4::bridge::SubscriptionTable;
+using volarix4::core::BarColumns;
+using volarix4::core::BarStore;
+using volarix4::core::HtfContext;
+using volarix4::core::HtfContextCache;
+using volarix4::core::SRLevelsCache;
+using volarix4::core::OHLCVBar;
+using volarix4::core::PipelineResult;
+using volarix4::core::SignalCooldownTracker;
+using volarix4::core::SRLevel;
+using volarix4::core::SRParams;
+using volarix4::core::StrategyParams;
+
+//=============================================================================
+//  Helper: Write debug log (queued - see bridge/debug_log.h). Callers that
+//  format a message first check DebugLog::Enabled() for the same level.
+//=============================================================================
+static const char* const kDefaultDebugLogPath = "E:\\Volarix4Bridge_Debug.txt";
+
+static void WriteDebugLog(const char* message, LogLevel level = LogLevel::kDebug)
 {
-    long long timestamp; // Unix timestamp (8 bytes) - use long long to ensure 8 bytes
-    double open;         // 8 bytes
-    double high;         // 8 bytes
-    double low;          // 8 bytes
-    double close;        // 8 bytes
-    int volume;          // 4 bytes
-};                       // Total: exactly 44 bytes (no padding)
-#pragma pack(pop)
+    DebugLog::Instance().Write(level, message);
+}
+
+//=============================================================================
+//  Signal request parameters (copied out of the MQL5 arguments so a request
+//  can outlive the call that created it - see SubmitVolarix4Signal)
+//=============================================================================
+struct SignalParams
+{
+    std::string symbol;
+    std::string timeframe;
+    long long barTime;
+    int lookbackBars;
+    std::string apiUrl;
+    double minConfidence;
+    double brokenLevelCooldownHours;
+    double brokenLevelBreakPips;
+    double minEdgePips;
+    double spreadPips;
+    double slippagePips;
+    double commissionPerSidePerLot;
+    double usdPerPipPerLot;
+    double lotSize;
+};
+
+//=============================================================================
+//  Helper: Narrow an MQL5 (UTF-16) string
+//=============================================================================
+static std::string ToNarrow(const wchar_t* text)
+{
+    if (!text)
+        return std::string();
+    std::wstring ws_text(text);
+    return std::string(ws_text.begin(), ws_text.end());
+}
 
 //=============================================================================
-//  Helper: Write debug log
+//  Helper: Convert a UTF-8/ASCII JSON string to BSTR for MQL5. This is the
+//  last step of every export, so it also commits the thread's call timings
+//  (a no-op for exports that did not start one).
 //=============================================================================
-void WriteDebugLog(const char* message)
+static BSTR ToBstr(const std::string& text)
 {
-    FILE* log_file = nullptr;
-    fopen_s(&log_file, "E:\\Volarix4Bridge_Debug.txt", "a");
-    if (log_file) {
-        fprintf(log_file, "%s\n", message);
-        fclose(log_file);
+    BSTR result;
+    {
+        ScopedPhase phase(LatencyPhase::kBstr);
+        std::wstring ws_text(text.begin(), text.end());
+        result = SysAllocString(ws_text.c_str());
+    }
+    BridgeStats::Instance().Commit(CallTimings::Current());
+    return result;
+}
+
+//=============================================================================
+//  Helper: Split a comma-separated MQL5 string list ("EURUSD, GBPUSD")
+//=============================================================================
+static std::vector<std::string> SplitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos)
+            end = list.size();
+
+        size_t first = list.find_first_not_of(' ', start);
+        size_t last = list.find_last_not_of(' ', end == 0 ? 0 : end - 1);
+        if (first != std::string::npos && first < end && last >= first)
+            items.push_back(list.substr(first, last - first + 1));
+
+        start = end + 1;
     }
+    return items;
+}
+
+//=============================================================================
+//  Helper: One POST to one endpoint. http:// URLs use the shared keep-alive
+//  WinINet session, shm://<name> the same-host shared-memory ring.
+//=============================================================================
+static HttpError PostToEndpoint(const std::string& url, const char* path,
+                                const std::string& payload_str,
+                                std::string& response, DWORD* last_error,
+                                DWORD* status_code)
+{
+    if (volarix4::bridge::IsShmUrl(url))
+        return ShmTransport::Instance().Post(volarix4::bridge::ShmEndpointName(url),
+            path,
+            payload_str.c_str(),
+            (DWORD)payload_str.length(),
+            response,
+            last_error,
+            status_code);
+
+    return HttpSessionPool::Instance().Post(ParseApiUrl(url),
+        path,
+        "Content-Type: application/json\r\n",
+        payload_str.c_str(),
+        (DWORD)payload_str.length(),
+        response,
+        last_error,
+        status_code);
+}
+
+static bool CanFailOver(HttpError error, DWORD status)
+{
+    // A request whose response was cut off has reached the server, so it is
+    // not sent to another endpoint
+    return error != HttpError::InternetReadFile && IsEndpointFailure(error, status);
+}
+
+//=============================================================================
+//  Helper: POST a JSON payload to the Volarix 4 API and return the raw
+//  response, or an error JSON on failure (the transport error is also
+//  stored in *error_out and the response's HTTP status in *status_out when
+//  given). apiUrl may list several endpoints
+//  ("http://a:8000, http://b:8000"): every call with the same affinity key
+//  (the symbol, or a batch's symbol list) goes to the same healthy endpoint
+//  and fails over past unhealthy ones in the same order, so one replica
+//  holds a symbol's signal cooldown and stream window. With hedging on a
+//  slow call is duplicated to the next endpoint (see bridge/endpoint_pool.h);
+//  a HOLD from the copy is used at once, anything else only if the pinned
+//  endpoint fails. Stream pushes are never hedged - the replica without the
+//  stream would only answer with a resync request.
+//=============================================================================
+static std::string PostToVolarix4(const std::string& apiUrl, const char* path,
+                                  const std::string& payload_str,
+                                  const std::string& affinity,
+                                  HttpError* error_out = nullptr,
+                                  DWORD* status_out = nullptr)
+{
+    std::vector<std::string> urls = SplitList(apiUrl);
+    if (urls.empty())
+        urls.push_back(apiUrl);
+
+    std::string response;
+    std::string used_url = urls[0];
+    DWORD last_error = 0;
+    DWORD status_code = 0;
+    HttpError http_error = HttpError::None;
+
+    if (urls.size() == 1) {
+        http_error = PostToEndpoint(used_url, path, payload_str, response, &last_error, &status_code);
+    } else {
+        EndpointPool& pool = EndpointPool::Instance();
+        CallTimings& call = CallTimings::Current();
+        std::vector<std::string> plan = pool.Plan(apiUrl, urls,
+            affinity.empty() ? EndpointPool::kNoAffinity : volarix4::bridge::Fnv1a64(affinity.data(), affinity.size()));
+        size_t next = 0;
+
+        double hedge_ms = std::strcmp(path, "/signal/stream") != 0 ? pool.HedgeDelayMs(plan[0]) : 0.0;
+        if (hedge_ms > 0.0) {
+            // The attempts may outlive this call, so they own their payload
+            auto payload = std::make_shared<const std::string>(payload_str);
+            // A hedged HOLD is safe to use early; a BUY/SELL (or a batch)
+            // from the copy could skip the pinned replica's cooldown
+            volarix4::bridge::AcceptFn accept_hedge;
+            if (std::strcmp(path, "/signal") == 0)
+                accept_hedge = [](const PostAttempt& a) {
+                    SignalResult result;
+                    return ParseSignalResult(a.response, &result) &&
+                           result.signal == volarix4::core::kSignalHold;
+                };
+            PostAttempt attempt = pool.Hedge(plan[0], plan[1], hedge_ms,
+                [path, payload](PostAttempt& a) {
+                    a.error = PostToEndpoint(a.url, path, *payload, a.response, &a.lastError, &a.status);
+                },
+                std::move(accept_hedge), &next);
+            call.Absorb(attempt.timings);
+            used_url = attempt.url;
+            http_error = attempt.error;
+            last_error = attempt.lastError;
+            status_code = attempt.status;
+            response = std::move(attempt.response);
+        }
+
+        for (; next < plan.size() && (next == 0 || CanFailOver(http_error, status_code)); ++next)
+        {
+            used_url = plan[next];
+            call.failed = false;
+            const long long start = QpcNow();
+            status_code = 0;
+            http_error = PostToEndpoint(used_url, path, payload_str, response, &last_error, &status_code);
+            if (!IsEndpointFailure(http_error, status_code)) {
+                pool.ReportSuccess(used_url, QpcNow() - start);
+                break;
+            }
+            pool.ReportFailure(used_url);
+            if (!CanFailOver(http_error, status_code))
+                break;
+
+            if (DebugLog::Enabled(LogLevel::kError) && next + 1 < plan.size()) {
+                std::stringstream err_msg;
+                err_msg << "ERROR: " << used_url << path << " failed (error code " << last_error
+                    << ", HTTP status " << status_code << ") - failing over to " << plan[next + 1];
+                WriteDebugLog(err_msg.str().c_str(), LogLevel::kError);
+            }
+        }
+    }
+
+    if (error_out)
+        *error_out = http_error;
+    if (status_out)
+        *status_out = http_error == HttpError::None ? status_code : 0;
+
+    if (http_error != HttpError::None) {
+        if (DebugLog::Enabled(LogLevel::kError)) {
+            std::stringstream err_msg;
+            err_msg << "ERROR: HTTP request to " << used_url << path
+                << " failed. Error code: " << last_error;
+            WriteDebugLog(err_msg.str().c_str(), LogLevel::kError);
+        }
+        return HttpErrorJson(http_error);
+    }
+
+    // Debug log response
+    if (DebugLog::Enabled(LogLevel::kDebug)) {
+        std::stringstream response_msg;
+        response_msg << "API Response (" << response.length() << " bytes): "
+            << response.substr(0, 200) << "..." << std::endl;
+        WriteDebugLog(response_msg.str().c_str());
+    }
+
+    return response;
+}
+
+//=============================================================================
+//  Helper: Append the lookback/strategy/cost fields shared by /signal and
+//  /signal/batch
+//=============================================================================
+static void AppendStrategyParams(JsonWriter& json, const SignalParams& params)
+{
+    json.Field("lookback_bars", params.lookbackBars)
+        .Field("min_confidence", params.minConfidence, 2)
+        .Field("broken_level_cooldown_hours", params.brokenLevelCooldownHours, 1)
+        .Field("broken_level_break_pips", params.brokenLevelBreakPips, 1)
+        .Field("min_edge_pips", params.minEdgePips, 1)
+        .Field("spread_pips", params.spreadPips, 1)
+        .Field("slippage_pips", params.slippagePips, 1)
+        .Field("commission_per_side_per_lot", params.commissionPerSidePerLot, 1)
+        .Field("usd_per_pip_per_lot", params.usdPerPipPerLot, 1)
+        .Field("lot_size", params.lotSize, 2);
+}
+
+//=============================================================================
+//  Helper: Response cache key - the API URL and every strategy/cost param
+//  go into the params hash, so a different server or setting never hits
+//=============================================================================
+static ResponseCache::Key SignalCacheKey(const SignalParams& params)
+{
+    using volarix4::bridge::Fnv1a64;
+
+    const double values[] = {
+        params.minConfidence, params.brokenLevelCooldownHours, params.brokenLevelBreakPips,
+        params.minEdgePips, params.spreadPips, params.slippagePips,
+        params.commissionPerSidePerLot, params.usdPerPipPerLot, params.lotSize
+    };
+    uint64_t hash = Fnv1a64(params.apiUrl.data(), params.apiUrl.size());
+    hash = Fnv1a64(&params.lookbackBars, sizeof(params.lookbackBars), hash);
+    hash = Fnv1a64(values, sizeof(values), hash);
+
+    return ResponseCache::Key{ params.symbol, params.timeframe, params.barTime, hash };
+}
+
+//=============================================================================
+//  Helper: Only HOLD answers are cached - not errors, not a missing bar (it
+//  may arrive later) and not the signal cooldown, which depends on what the
+//  server answered before rather than on the bar. BUY/SELL are never cached
+//  either: the server starts its signal cooldown when it hands one out, and
+//  a replayed BUY/SELL would never reach it
+//=============================================================================
+static bool IsCacheableSignalResponse(const std::string& response)
+{
+    SignalResult result;
+    if (!ParseSignalResult(response, &result))
+        return false;
+    return result.signal == volarix4::core::kSignalHold &&
+           result.reasonCode != volarix4::bridge::kReasonServerError &&
+           result.reasonCode != volarix4::bridge::kReasonDataUnavailable &&
+           result.reasonCode != volarix4::bridge::kReasonSignalCooldown;
+}
+
+//=============================================================================
+//  Helper: POST /signal and return the raw JSON response (or error JSON).
+//  Repeated requests for a closed bar are answered from ResponseCache.
+//=============================================================================
+static std::string RequestVolarix4Signal(const SignalParams& params,
+                                         HttpError* error_out = nullptr)
+{
+    ResponseCache& cache = ResponseCache::Instance();
+    const bool use_cache = cache.Enabled();
+    ResponseCache::Key cache_key;
+    if (use_cache) {
+        cache_key = SignalCacheKey(params);
+        std::string cached;
+        if (cache.Find(cache_key, &cached)) {
+            if (DebugLog::Enabled(LogLevel::kDebug)) {
+                std::stringstream debug_msg;
+                debug_msg << "Response cache hit: " << params.symbol << " " << params.timeframe
+                    << " bar_time=" << params.barTime;
+                WriteDebugLog(debug_msg.str().c_str());
+            }
+            if (error_out)
+                *error_out = HttpError::None;
+            return cached;
+        }
+    }
+
+    // Build complete JSON payload (optimized - only send bar timestamp)
+    const long long serialize_start = QpcNow();
+    JsonWriter& json = JsonWriter::ThreadLocal();
+    json.Reset(512);
+    json.BeginObject()
+        .Field("symbol", params.symbol)
+        .Field("timeframe", params.timeframe)
+        .Field("bar_time", params.barTime);
+    AppendStrategyParams(json, params);
+    json.EndObject();
+    CallTimings::Current().Add(LatencyPhase::kSerialize, QpcNow() - serialize_start);
+
+    const std::string& payload_str = json.str();
+
+    // Debug log
+    if (DebugLog::Enabled(LogLevel::kDebug)) {
+        std::stringstream debug_msg;
+        debug_msg << "=== Volarix 4 API Call (Optimized) ===" << std::endl;
+        debug_msg << "Symbol: " << params.symbol << std::endl;
+        debug_msg << "Timeframe: " << params.timeframe << std::endl;
+        debug_msg << "Bar time: " << params.barTime << std::endl;
+        debug_msg << "Lookback bars: " << params.lookbackBars << std::endl;
+        debug_msg << "Payload size: " << payload_str.length() << " bytes" << std::endl;
+        WriteDebugLog(debug_msg.str().c_str());
+    }
+
+    HttpError http_error = HttpError::None;
+    std::string response = PostToVolarix4(params.apiUrl, "/signal", payload_str, params.symbol, &http_error);
+    if (error_out)
+        *error_out = http_error;
+
+    if (use_cache && http_error == HttpError::None && IsCacheableSignalResponse(response))
+        cache.Insert(cache_key, response);
+    return response;
 }
 
 //=============================================================================
@@ -66,163 +450,1012 @@ BSTR __stdcall GetVolarix4Signal(
     double usdPerPipPerLot,
     double lotSize)
 {
+    CallTimings::Current().Begin();
+
     // Debug: Log call
-    std::stringstream struct_debug;
-    struct_debug << "=== DLL Called (Optimized Mode) ===" << std::endl;
-    struct_debug << "Bar time (Unix): " << barTime << std::endl;
-    struct_debug << "Lookback bars: " << lookbackBars << std::endl;
-    WriteDebugLog(struct_debug.str().c_str());
+    if (DebugLog::Enabled(LogLevel::kDebug)) {
+        std::stringstream struct_debug;
+        struct_debug << "=== DLL Called (Optimized Mode) ===" << std::endl;
+        struct_debug << "Bar time (Unix): " << barTime << std::endl;
+        struct_debug << "Lookback bars: " << lookbackBars << std::endl;
+        WriteDebugLog(struct_debug.str().c_str());
+    }
 
-    // Convert wide strings to std::string
-    std::wstring ws_symbol(symbol);
-    std::string sym(ws_symbol.begin(), ws_symbol.end());
+    SignalParams params{
+        ToNarrow(symbol), ToNarrow(timeframe), barTime, lookbackBars, ToNarrow(apiUrl),
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
 
-    std::wstring ws_tf(timeframe);
-    std::string tf(ws_tf.begin(), ws_tf.end());
+    return ToBstr(RequestVolarix4Signal(params));
+}
 
-    // Build complete JSON payload (optimized - only send bar timestamp)
-    std::stringstream payload;
-    payload << "{"
-        << "\"symbol\":\"" << sym << "\","
-        << "\"timeframe\":\"" << tf << "\","
-        << "\"bar_time\":" << barTime << ","
-        << "\"lookback_bars\":" << lookbackBars << ","
-        << "\"min_confidence\":" << std::fixed << std::setprecision(2) << minConfidence << ","
-        << "\"broken_level_cooldown_hours\":" << std::fixed << std::setprecision(1) << brokenLevelCooldownHours << ","
-        << "\"broken_level_break_pips\":" << std::fixed << std::setprecision(1) << brokenLevelBreakPips << ","
-        << "\"min_edge_pips\":" << std::fixed << std::setprecision(1) << minEdgePips << ","
-        << "\"spread_pips\":" << std::fixed << std::setprecision(1) << spreadPips << ","
-        << "\"slippage_pips\":" << std::fixed << std::setprecision(1) << slippagePips << ","
-        << "\"commission_per_side_per_lot\":" << std::fixed << std::setprecision(1) << commissionPerSidePerLot << ","
-        << "\"usd_per_pip_per_lot\":" << std::fixed << std::setprecision(1) << usdPerPipPerLot << ","
-        << "\"lot_size\":" << std::fixed << std::setprecision(2) << lotSize
-        << "}";
-
-    std::string payload_str = payload.str();
+//=============================================================================
+//  Native DLL Function: GetVolarix4SignalStruct
+//
+//  Same request as GetVolarix4Signal, but the response is parsed in the DLL
+//  into the EA's SignalResult (bridge/signal_result.h) - no BSTR and no JSON
+//  parsing in MQL5. Returns 0 when *result holds a /signal response, -1 for
+//  a NULL result, and -2 when the call failed (transport error, error body
+//  or unparseable response): *result is then HOLD and reasonCode says why.
+//=============================================================================
+extern "C" __declspec(dllexport)
+int __stdcall GetVolarix4SignalStruct(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    long long barTime,
+    int lookbackBars,
+    const wchar_t* apiUrl,
+    double minConfidence,
+    double brokenLevelCooldownHours,
+    double brokenLevelBreakPips,
+    double minEdgePips,
+    double spreadPips,
+    double slippagePips,
+    double commissionPerSidePerLot,
+    double usdPerPipPerLot,
+    double lotSize,
+    SignalResult* result)
+{
+    if (!result)
+        return -1;
 
-    // Debug log
-    std::stringstream debug_msg;
-    debug_msg << "=== Volarix 4 API Call (Optimized) ===" << std::endl;
-    debug_msg << "Symbol: " << sym << std::endl;
-    debug_msg << "Timeframe: " << tf << std::endl;
-    debug_msg << "Bar time: " << barTime << std::endl;
-    debug_msg << "Lookback bars: " << lookbackBars << std::endl;
-    debug_msg << "Payload size: " << payload_str.length() << " bytes" << std::endl;
-    WriteDebugLog(debug_msg.str().c_str());
-
-    //=========================================================================
-    //  Parse API URL to extract host and port
-    //=========================================================================
-    std::wstring ws_apiUrl(apiUrl);
-    std::string api_url_str(ws_apiUrl.begin(), ws_apiUrl.end());
-
-    // Parse URL (expecting format: http://host:port)
-    std::string host = "localhost";
-    int port = 8000;
-
-    size_t proto_end = api_url_str.find("://");
-    if (proto_end != std::string::npos) {
-        std::string url_part = api_url_str.substr(proto_end + 3);
-        size_t port_pos = url_part.find(":");
-        if (port_pos != std::string::npos) {
-            host = url_part.substr(0, port_pos);
-            std::string port_str = url_part.substr(port_pos + 1);
-            port = std::stoi(port_str);
-        } else {
-            host = url_part;
+    CallTimings& call = CallTimings::Current();
+    call.Begin();
+
+    SignalParams params{
+        ToNarrow(symbol), ToNarrow(timeframe), barTime, lookbackBars, ToNarrow(apiUrl),
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
+
+    HttpError http_error = HttpError::None;
+    std::string response = RequestVolarix4Signal(params, &http_error);
+    BridgeStats::Instance().Commit(call);
+
+    if (!ParseSignalResult(response, result)) {
+        // Transport failures come back as the bridge's {"error":...} JSON
+        if (http_error != HttpError::None)
+            result->reasonCode = volarix4::bridge::kReasonTransportError;
+        if (DebugLog::Enabled(LogLevel::kError)) {
+            std::stringstream err_msg;
+            err_msg << "ERROR: /signal response not usable (reason code " << result->reasonCode
+                << "): " << response.substr(0, 200);
+            WriteDebugLog(err_msg.str().c_str(), LogLevel::kError);
         }
+        return -2;
+    }
+
+    return 0;
+}
+
+//=============================================================================
+//  Async DLL Functions: SubmitVolarix4Signal / PollVolarix4Signal
+//
+//  Submit queues the same request GetVolarix4Signal makes on the bridge's
+//  worker pool and returns immediately with a request id (-1 on failure).
+//  Poll returns an empty string while the request is in flight, the /signal
+//  JSON once it has completed (the id is then released), or an error JSON
+//  for an unknown id.
+//=============================================================================
+extern "C" __declspec(dllexport)
+long long __stdcall SubmitVolarix4Signal(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    long long barTime,
+    int lookbackBars,
+    const wchar_t* apiUrl,
+    double minConfidence,
+    double brokenLevelCooldownHours,
+    double brokenLevelBreakPips,
+    double minEdgePips,
+    double spreadPips,
+    double slippagePips,
+    double commissionPerSidePerLot,
+    double usdPerPipPerLot,
+    double lotSize)
+{
+    SignalParams params{
+        ToNarrow(symbol), ToNarrow(timeframe), barTime, lookbackBars, ToNarrow(apiUrl),
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
+
+    // Timed on the worker thread (no BSTR phase - Poll converts later)
+    long long request_id = SignalJobQueue::Instance().Submit([params]() {
+        CallTimings& call = CallTimings::Current();
+        call.Begin();
+        std::string response = RequestVolarix4Signal(params);
+        BridgeStats::Instance().Commit(call);
+        return response;
+    });
+
+    if (DebugLog::Enabled(LogLevel::kDebug)) {
+        std::stringstream debug_msg;
+        debug_msg << "=== Async request submitted: id=" << request_id
+            << " " << params.symbol << " " << params.timeframe
+            << " bar_time=" << barTime << " ===";
+        WriteDebugLog(debug_msg.str().c_str());
     }
 
-    //=========================================================================
-    //  HTTP POST to Volarix 4 API
-    //=========================================================================
+    return request_id;
+}
 
-    // Open internet session
-    HINTERNET hInternet = InternetOpenA("Volarix4Bridge",
-        INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
+extern "C" __declspec(dllexport)
+BSTR __stdcall PollVolarix4Signal(long long requestId)
+{
+    std::string result;
+    switch (SignalJobQueue::Instance().Poll(requestId, result))
+    {
+    case SignalJobQueue::PollState::Pending:
+        return SysAllocString(L"");
+    case SignalJobQueue::PollState::Ready:
+        return ToBstr(result);
+    default:
+        return SysAllocString(L"{\"error\":\"Unknown request id\"}");
+    }
+}
 
-    if (!hInternet) {
-        WriteDebugLog("ERROR: InternetOpen failed");
-        return SysAllocString(L"{\"error\":\"InternetOpen failed\"}");
+//=============================================================================
+//  Push DLL Functions: SubscribeVolarix4Signal / TryGetPushedSignal /
+//  UnsubscribeVolarix4Signal
+//
+//  Instead of a /signal request per candle, the stream (symbol, timeframe,
+//  lookback and strategy/cost params) is registered once and the server
+//  pushes each candle's /signal response as soon as the candle has opened
+//  and the pipeline has run - one long poll per process, answered for all
+//  subscribed charts (see bridge/signal_subscriptions.h).
+//
+//  Subscribe returns a subscription handle (> 0), -1 if the poller could
+//  not be started, -2 if apiUrl has no http:// endpoint or another apiUrl
+//  already has subscriptions in this terminal. TryGetPushedSignal never
+//  blocks: it returns "" until a new response has arrived, then that
+//  /signal JSON once (barTime, when not NULL, receives its bar time), or an
+//  error JSON for an unknown handle. Unsubscribe in OnDeinit - the DLL
+//  cannot unload while the poller runs.
+//=============================================================================
+extern "C" __declspec(dllexport)
+int __stdcall SubscribeVolarix4Signal(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    int lookbackBars,
+    const wchar_t* apiUrl,
+    double minConfidence,
+    double brokenLevelCooldownHours,
+    double brokenLevelBreakPips,
+    double minEdgePips,
+    double spreadPips,
+    double slippagePips,
+    double commissionPerSidePerLot,
+    double usdPerPipPerLot,
+    double lotSize)
+{
+    SignalParams params{
+        ToNarrow(symbol), ToNarrow(timeframe), 0, lookbackBars, ToNarrow(apiUrl),
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
+
+    std::vector<std::string> urls;
+    for (std::string& url : SplitList(params.apiUrl)) {
+        if (!volarix4::bridge::IsShmUrl(url))
+            urls.push_back(std::move(url));
     }
 
-    // Connect to server using parsed host and port
-    HINTERNET hConnect = InternetConnectA(hInternet,
-        host.c_str(),  // Parsed from API URL
-        port,          // Parsed from API URL
-        NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
+    JsonWriter& json = JsonWriter::ThreadLocal();
+    json.Reset(512);
+    json.BeginObject()
+        .Field("symbol", params.symbol)
+        .Field("timeframe", params.timeframe);
+    AppendStrategyParams(json, params);
+    json.EndObject();
+
+    int handle = SignalSubscriptions::Instance().Subscribe(params.apiUrl, std::move(urls), json.str());
 
-    if (!hConnect) {
-        InternetCloseHandle(hInternet);
-        WriteDebugLog("ERROR: InternetConnect failed");
-        return SysAllocString(L"{\"error\":\"InternetConnect failed\"}");
+    if (DebugLog::Enabled(handle > 0 ? LogLevel::kInfo : LogLevel::kError)) {
+        std::stringstream debug_msg;
+        if (handle > 0)
+            debug_msg << "Subscribed " << params.symbol << " " << params.timeframe
+                << " to pushed signals (handle " << handle << ")";
+        else
+            debug_msg << "ERROR: Subscribing " << params.symbol << " " << params.timeframe
+                << " to " << params.apiUrl << " failed (" << handle << ")";
+        WriteDebugLog(debug_msg.str().c_str(), handle > 0 ? LogLevel::kInfo : LogLevel::kError);
     }
 
-    // Open HTTP request
-    LPCSTR acceptTypes[] = { "application/json", NULL };
-    HINTERNET hRequest = HttpOpenRequestA(hConnect,
-        "POST",
-        "/signal",  // Volarix 4 endpoint
-        NULL,
-        NULL,
-        acceptTypes,
-        INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE,
-        0);
+    return handle;
+}
 
-    if (!hRequest) {
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
-        WriteDebugLog("ERROR: HttpOpenRequest failed");
-        return SysAllocString(L"{\"error\":\"HttpOpenRequest failed\"}");
+extern "C" __declspec(dllexport)
+BSTR __stdcall TryGetPushedSignal(int subscription, long long* barTime)
+{
+    std::string response;
+    switch (SignalSubscriptions::Instance().TryGet(subscription, &response, barTime))
+    {
+    case SubscriptionTable::TakeState::kNone:
+        return SysAllocString(L"");
+    case SubscriptionTable::TakeState::kReady:
+        return ToBstr(response);
+    default:
+        return SysAllocString(L"{\"error\":\"Unknown subscription\"}");
     }
+}
 
-    // Set headers
-    std::string headers = "Content-Type: application/json\r\n";
+// 0, or -1 for an unknown handle
+extern "C" __declspec(dllexport)
+int __stdcall UnsubscribeVolarix4Signal(int subscription)
+{
+    return SignalSubscriptions::Instance().Unsubscribe(subscription) ? 0 : -1;
+}
 
-    // Send request
-    BOOL bSent = HttpSendRequestA(hRequest,
-        headers.c_str(),
-        (DWORD)headers.length(),
-        (LPVOID)payload_str.c_str(),
-        (DWORD)payload_str.length());
+//=============================================================================
+//  Batch DLL Function: GetVolarix4SignalsBatch
+//
+//  One POST /signal/batch for several symbols on the same candle. Symbols and
+//  timeframes are comma-separated lists (a single timeframe applies to every
+//  symbol); barTimes holds one Unix timestamp per symbol. Strategy and cost
+//  parameters are shared. Returns the JSON array of /signal responses in the
+//  order given, or an error JSON object.
+//=============================================================================
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4SignalsBatch(
+    const wchar_t* symbols,      // e.g. "EURUSD,GBPUSD,USDJPY"
+    const wchar_t* timeframes,   // e.g. "H1" or "H1,H1,H4"
+    const long long* barTimes,   // One Unix timestamp per symbol
+    int count,                   // Number of symbols / bar times
+    int lookbackBars,
+    const wchar_t* apiUrl,
+    double minConfidence,
+    double brokenLevelCooldownHours,
+    double brokenLevelBreakPips,
+    double minEdgePips,
+    double spreadPips,
+    double slippagePips,
+    double commissionPerSidePerLot,
+    double usdPerPipPerLot,
+    double lotSize)
+{
+    CallTimings::Current().Begin();
 
-    if (!bSent) {
-        InternetCloseHandle(hRequest);
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
+    std::vector<std::string> symbol_list = SplitList(ToNarrow(symbols));
+    std::vector<std::string> timeframe_list = SplitList(ToNarrow(timeframes));
 
-        std::stringstream err_msg;
-        err_msg << "ERROR: HttpSendRequest failed. Error code: " << GetLastError();
-        WriteDebugLog(err_msg.str().c_str());
+    if (count <= 0 || barTimes == nullptr || (int)symbol_list.size() != count ||
+        (timeframe_list.size() != 1 && (int)timeframe_list.size() != count)) {
+        if (DebugLog::Enabled(LogLevel::kError)) {
+            std::stringstream err_msg;
+            err_msg << "ERROR: Batch size mismatch (count=" << count
+                << ", symbols=" << symbol_list.size()
+                << ", timeframes=" << timeframe_list.size() << ")";
+            WriteDebugLog(err_msg.str().c_str(), LogLevel::kError);
+        }
+        return SysAllocString(L"{\"error\":\"Batch size mismatch\"}");
+    }
+
+    SignalParams shared{
+        std::string(), std::string(), 0, lookbackBars, ToNarrow(apiUrl),
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
 
-        return SysAllocString(L"{\"error\":\"HttpSendRequest failed\"}");
+    const long long serialize_start = QpcNow();
+    JsonWriter& json = JsonWriter::ThreadLocal();
+    json.Reset(512 + (size_t)count * 80);
+    json.BeginObject().Key("requests").BeginArray();
+    for (int i = 0; i < count; ++i)
+    {
+        const std::string& tf = timeframe_list.size() == 1 ? timeframe_list[0] : timeframe_list[i];
+        json.BeginObject()
+            .Field("symbol", symbol_list[i])
+            .Field("timeframe", tf)
+            .Field("bar_time", barTimes[i])
+            .EndObject();
     }
+    json.EndArray();
+    AppendStrategyParams(json, shared);
+    json.EndObject();
+    CallTimings::Current().Add(LatencyPhase::kSerialize, QpcNow() - serialize_start);
 
-    // Read response
-    std::string response;
-    char buffer[4096];
-    DWORD bytesRead = 0;
+    const std::string& payload_str = json.str();
+
+    if (DebugLog::Enabled(LogLevel::kDebug)) {
+        std::stringstream debug_msg;
+        debug_msg << "=== Volarix 4 Batch API Call ===" << std::endl;
+        debug_msg << "Symbols: " << count << std::endl;
+        debug_msg << "Payload size: " << payload_str.length() << " bytes" << std::endl;
+        WriteDebugLog(debug_msg.str().c_str());
+    }
+
+    return ToBstr(PostToVolarix4(shared.apiUrl, "/signal/batch", payload_str, ToNarrow(symbols)));
+}
+
+//=============================================================================
+//  Helper: Push the bars the server has not seen yet to /signal/stream
+//
+//  The server keeps a ring buffer per (client id, symbol, timeframe); each
+//  push carries the next sequence number and only bars newer than the last
+//  acknowledged one. If the server reports the stream out of step with a
+//  409 (restart, lost response), the whole window is resent once with
+//  reset=true.
+//=============================================================================
+static std::string RequestVolarix4Stream(const SignalParams& params,
+                                         const OHLCVBar* bars, int barCount)
+{
+    BarStreamTracker& tracker = BarStreamTracker::Instance();
+    std::string key = BarStreamTracker::Key(params.symbol, params.timeframe);
+    long long newest_time = bars[barCount - 1].timestamp;
 
-    while (InternetReadFile(hRequest, buffer, sizeof(buffer) - 1, &bytesRead) && bytesRead > 0)
+    std::string response;
+    for (int attempt = 0; attempt < 2; ++attempt)
     {
-        buffer[bytesRead] = '\0';
-        response += buffer;
+        BarStreamTracker::Cursor cursor = tracker.Get(key);
+
+        // Full resync when never synced, after a server-reported gap, or when
+        // the window no longer overlaps what was sent (EA was idle too long,
+        // or history was reloaded)
+        bool reset = attempt > 0 || !cursor.synced ||
+            bars[0].timestamp > cursor.last_time || newest_time < cursor.last_time;
+
+        int first = 0;
+        if (!reset) {
+            first = barCount;
+            while (first > 0 && bars[first - 1].timestamp > cursor.last_time)
+                --first;
+        }
+        long long seq = reset ? 1 : cursor.seq + 1;
+
+        const long long serialize_start = QpcNow();
+        JsonWriter& json = JsonWriter::ThreadLocal();
+        json.Reset(512 + (size_t)(barCount - first) * 120);
+        json.BeginObject()
+            .Field("client_id", tracker.ClientId())
+            .Field("symbol", params.symbol)
+            .Field("timeframe", params.timeframe)
+            .Field("seq", seq)
+            .Key("reset").Bool(reset)
+            .Key("bars").BeginArray();
+        for (int i = first; i < barCount; ++i)
+        {
+            json.BeginObject()
+                .Field("time", bars[i].timestamp)
+                .Field("open", bars[i].open)
+                .Field("high", bars[i].high)
+                .Field("low", bars[i].low)
+                .Field("close", bars[i].close)
+                .Field("volume", bars[i].volume)
+                .EndObject();
+        }
+        json.EndArray();
+        AppendStrategyParams(json, params);
+        json.EndObject();
+        CallTimings::Current().Add(LatencyPhase::kSerialize, QpcNow() - serialize_start);
+
+        if (DebugLog::Enabled(LogLevel::kDebug)) {
+            std::stringstream debug_msg;
+            debug_msg << "=== Volarix 4 Stream Push: " << key << " seq=" << seq
+                << (reset ? " (full resync)" : "") << " bars=" << (barCount - first)
+                << " payload=" << json.size() << " bytes ===";
+            WriteDebugLog(debug_msg.str().c_str());
+        }
+
+        HttpError http_error = HttpError::None;
+        DWORD status_code = 0;
+        response = PostToVolarix4(params.apiUrl, "/signal/stream", json.str(), params.symbol,
+                                  &http_error, &status_code);
+        if (http_error != HttpError::None)
+            return response;  // Cursor unchanged - the same delta is retried next candle
+
+        if (status_code == HTTP_STATUS_CONFLICT) {
+            tracker.Invalidate(key);
+            continue;
+        }
+
+        tracker.Commit(key, newest_time, seq);
+        return response;
     }
 
-    // Cleanup
-    InternetCloseHandle(hRequest);
-    InternetCloseHandle(hConnect);
-    InternetCloseHandle(hInternet);
+    return response;
+}
 
-    // Debug log response
-    std::stringstream response_msg;
-    response_msg << "API Response (" << response.length() << " bytes): "
-        << response.substr(0, 200) << "..." << std::endl;
-    WriteDebugLog(response_msg.str().c_str());
+//=============================================================================
+//  Stream DLL Function: GetVolarix4SignalStream
+//
+//  Incremental alternative to GetVolarix4Signal for EAs that copy their own
+//  bars: pass the closed-bar window (oldest first, lookbackBars long) every
+//  candle and the bridge sends only the bars the server does not have yet.
+//=============================================================================
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4SignalStream(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    const OHLCVBar* bars,        // Closed bars, oldest first
+    int barCount,                // Window size (e.g., 400)
+    const wchar_t* apiUrl,
+    double minConfidence,
+    double brokenLevelCooldownHours,
+    double brokenLevelBreakPips,
+    double minEdgePips,
+    double spreadPips,
+    double slippagePips,
+    double commissionPerSidePerLot,
+    double usdPerPipPerLot,
+    double lotSize)
+{
+    if (bars == nullptr || barCount <= 0)
+        return SysAllocString(L"{\"error\":\"No bars provided\"}");
+
+    CallTimings::Current().Begin();
+
+    SignalParams params{
+        ToNarrow(symbol), ToNarrow(timeframe), bars[barCount - 1].timestamp, barCount, ToNarrow(apiUrl),
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
+
+    return ToBstr(RequestVolarix4Stream(params, bars, barCount));
+}
+
+//=============================================================================
+//  Native DLL Function: DetectSRLevels
+//
+//  Runs detect_sr_levels() in-process on the EA's bars (oldest first) - no
+//  HTTP hop. params may be NULL for the SR_CONFIG defaults (EURUSD-style pip
+//  value). Writes up to maxLevels levels, best score first, and returns the
+//  number of levels found (which can exceed maxLevels), or -1 on bad input.
+//=============================================================================
+extern "C" __declspec(dllexport)
+int __stdcall DetectSRLevels(
+    const OHLCVBar* bars,
+    int count,
+    const SRParams* params,      // NULL = defaults
+    SRLevel* outLevels,
+    int maxLevels)
+{
+    if (bars == nullptr || count <= 0 || maxLevels < 0 || (outLevels == nullptr && maxLevels > 0))
+        return -1;
+
+    SRParams active = params ? *params : volarix4::core::DefaultSRParams();
+    if (active.pipValue <= 0.0)
+        active.pipValue = 0.0001;
+
+    std::vector<SRLevel> levels = volarix4::core::DetectSRLevels(bars, (size_t)count, active);
+
+    int written = (std::min)((int)levels.size(), maxLevels);
+    for (int i = 0; i < written; ++i)
+        outLevels[i] = levels[i];
+
+    return (int)levels.size();
+}
+
+//=============================================================================
+//  Helper: Local wall-clock seconds for a Unix time. The API session-checks
+//  and formats bar times with datetime.fromtimestamp(), i.e. in the local
+//  time zone of the machine it runs on - the same machine as the terminal.
+//=============================================================================
+static long long LocalWallClock(long long unix_time)
+{
+    __time64_t t = (__time64_t)unix_time;
+    struct tm local;
+    if (_localtime64_s(&local, &t) != 0)
+        return unix_time;
+    return (long long)_mkgmtime64(&local);
+}
+
+//=============================================================================
+//  Helper: Signal cooldown shared by every local call (the API keeps its
+//  tracker for the process lifetime; here it lives as long as the DLL)
+//=============================================================================
+static SignalCooldownTracker& LocalSignalCooldown()
+{
+    static SignalCooldownTracker tracker;
+    return tracker;
+}
+
+//=============================================================================
+//  Native DLL Function: GetVolarix4SignalLocal
+//
+//  Runs the whole /signal pipeline in-process on the EA's closed bars (oldest
+//  first, the last one is the decision bar) - no FastAPI server needed.
+//  Returns the same JSON the server would for the same bars and parameters,
+//  including the signal cooldown, which persists for the life of the DLL.
+//=============================================================================
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4SignalLocal(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    const OHLCVBar* bars,        // Closed bars, oldest first (at least 200)
+    int barCount,
+    double minConfidence,
+    double brokenLevelCooldownHours,
+    double brokenLevelBreakPips,
+    double minEdgePips,
+    double spreadPips,
+    double slippagePips,
+    double commissionPerSidePerLot,
+    double usdPerPipPerLot,
+    double lotSize)
+{
+    if (bars == nullptr || barCount <= 0)
+        return SysAllocString(L"{\"error\":\"No bars provided\"}");
+
+    std::string symbol_str = ToNarrow(symbol);
+    std::string timeframe_str = ToNarrow(timeframe);
+
+    StrategyParams params{
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
+
+    volarix4::core::PipelineOptions options;
+    options.localTime = LocalWallClock;
+    options.cooldown = &LocalSignalCooldown();
+
+    PipelineResult result = volarix4::core::RunSignalPipeline(
+        symbol_str, timeframe_str, bars, (size_t)barCount, params, options);
+
+    const std::string& json = LocalSignalJson(result);
+
+    if (DebugLog::Enabled(LogLevel::kDebug)) {
+        std::stringstream debug_msg;
+        debug_msg << "=== Volarix 4 Local Signal: " << symbol_str << " " << timeframe_str
+            << " bars=" << barCount << " -> " << json.substr(0, 200);
+        WriteDebugLog(debug_msg.str().c_str());
+    }
+
+    return ToBstr(json);
+}
+
+//=============================================================================
+//  Native DLL Function: AppendBars
+//
+//  Adds closed bars (oldest first) to the DLL's bar store for symbol and
+//  timeframe. Bars not newer than the last stored one are skipped, so the EA
+//  can pass its whole CopyRates window every candle. The store keeps the
+//  newest 65536 bars per series as SoA columns that the native
+//  features read in place. Returns the number of bars held for the series,
+//  or -1 on bad input.
+//=============================================================================
+extern "C" __declspec(dllexport)
+int __stdcall AppendBars(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    const OHLCVBar* bars,
+    int count)
+{
+    if (symbol == nullptr || timeframe == nullptr || count < 0 || (bars == nullptr && count > 0))
+        return -1;
+
+    std::string key = BarStore::Key(ToNarrow(symbol), ToNarrow(timeframe));
+    return (int)BarStore::Instance().Append(key, bars, (size_t)count);
+}
+
+//=============================================================================
+//  Native DLL Function: ClearBars
+//
+//  Drops the stored bars of one series (e.g. after a history re-download
+//  changed past bars, which AppendBars would otherwise ignore), together
+//  with the higher-TF context resampled from them and the series' S/R state
+//=============================================================================
+extern "C" __declspec(dllexport)
+void __stdcall ClearBars(
+    const wchar_t* symbol,
+    const wchar_t* timeframe)
+{
+    if (symbol == nullptr || timeframe == nullptr)
+        return;
+
+    std::string symbol_str = ToNarrow(symbol);
+    std::string timeframe_str = ToNarrow(timeframe);
+    BarStore::Instance().Clear(BarStore::Key(symbol_str, timeframe_str));
+    HtfContextCache::Instance().Clear(symbol_str, timeframe_str);
+    SRLevelsCache::Instance().Clear(symbol_str, timeframe_str);
+}
+
+//=============================================================================
+//  Native DLL Function: SaveBarFile
+//
+//  Writes the stored bars of one series to a columnar bar file (see
+//  core/bar_file.h) - e.g. at EA deinit, so the next start preloads its
+//  history from disk instead of querying MT5 for it. The file is replaced
+//  only once the new one is complete. Returns the number of bars written,
+//  or -1 (unknown series, I/O error; details in the debug log).
+//=============================================================================
+extern "C" __declspec(dllexport)
+int __stdcall SaveBarFile(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    const wchar_t* path)
+{
+    if (symbol == nullptr || timeframe == nullptr || path == nullptr)
+        return -1;
+
+    std::string symbol_str = ToNarrow(symbol);
+    std::string timeframe_str = ToNarrow(timeframe);
+    std::string path_str = ToNarrow(path);
+
+    int written = -1;
+    std::string error = "No stored bars for symbol/timeframe";
+    BarStore::Instance().Read(BarStore::Key(symbol_str, timeframe_str), [&](const BarColumns& stored) {
+        if (volarix4::core::WriteBarFile(path_str, symbol_str, timeframe_str, stored, &error))
+            written = (int)stored.count;
+    });
+
+    if (written < 0 && DebugLog::Enabled(LogLevel::kError)) {
+        std::stringstream err_msg;
+        err_msg << "SaveBarFile " << symbol_str << " " << timeframe_str << " failed: " << error;
+        WriteDebugLog(err_msg.str().c_str(), LogLevel::kError);
+    }
+    return written;
+}
+
+//=============================================================================
+//  Native DLL Function: LoadBarFile
+//
+//  Maps a bar file written by SaveBarFile (or the native backtest's
+//  --save-bars) and appends its bars to the store like AppendBars: only
+//  bars newer than the newest stored one are taken, so load first and
+//  append the terminal's recent bars after. The file must hold the same
+//  symbol and timeframe. Returns the number of bars held for the series,
+//  or -1 (missing, corrupt or foreign file; details in the debug log).
+//=============================================================================
+extern "C" __declspec(dllexport)
+int __stdcall LoadBarFile(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    const wchar_t* path)
+{
+    if (symbol == nullptr || timeframe == nullptr || path == nullptr)
+        return -1;
+
+    std::string symbol_str = ToNarrow(symbol);
+    std::string timeframe_str = ToNarrow(timeframe);
+
+    volarix4::core::MappedBarFile file;
+    std::string error;
+    bool loaded = file.Open(ToNarrow(path), &error);
+    if (loaded && (file.Symbol() != symbol_str || file.Timeframe() != timeframe_str)) {
+        error = "File holds " + std::string(file.Symbol()) + " " + std::string(file.Timeframe());
+        loaded = false;
+    }
+    if (!loaded) {
+        if (DebugLog::Enabled(LogLevel::kError)) {
+            std::stringstream err_msg;
+            err_msg << "LoadBarFile " << symbol_str << " " << timeframe_str << " failed: " << error;
+            WriteDebugLog(err_msg.str().c_str(), LogLevel::kError);
+        }
+        return -1;
+    }
+
+    return (int)BarStore::Instance().Append(BarStore::Key(symbol_str, timeframe_str), file.Bars());
+}
+
+//=============================================================================
+//  Native DLL Function: GetVolarix4SignalFromStore
+//
+//  GetVolarix4SignalLocal on the newest lookbackBars stored bars (see
+//  AppendBars), read in place from the store - no bar array crosses the
+//  MQL5 boundary. Same JSON as the server for the same window. The S/R
+//  levels are kept per (symbol, timeframe, lookbackBars) and updated with
+//  the bars appended since the last call instead of detected again over
+//  the whole window.
+//=============================================================================
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4SignalFromStore(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    int lookbackBars,
+    double minConfidence,
+    double brokenLevelCooldownHours,
+    double brokenLevelBreakPips,
+    double minEdgePips,
+    double spreadPips,
+    double slippagePips,
+    double commissionPerSidePerLot,
+    double usdPerPipPerLot,
+    double lotSize)
+{
+    if (lookbackBars <= 0)
+        return SysAllocString(L"{\"error\":\"No bars provided\"}");
+
+    std::string symbol_str = ToNarrow(symbol);
+    std::string timeframe_str = ToNarrow(timeframe);
+
+    StrategyParams params{
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
+
+    // The stream's S/R and EMA state follow the store window by window
+    std::shared_ptr<SRLevelsCache::Stream> stream =
+        SRLevelsCache::Instance().Get(SRLevelsCache::Key(symbol_str, timeframe_str, (size_t)lookbackBars));
+    std::lock_guard<std::mutex> stream_lock(stream->mutex);
+
+    volarix4::core::PipelineOptions options;
+    options.localTime = LocalWallClock;
+    options.cooldown = &LocalSignalCooldown();
+    options.srLevels = &stream->levels;
+    options.trend = &stream->trend;
+
+    PipelineResult result;
+    size_t window = 0;
+    bool found = BarStore::Instance().Read(
+        BarStore::Key(symbol_str, timeframe_str), [&](const BarColumns& stored) {
+            BarColumns bars = stored.Tail((size_t)lookbackBars);
+            window = bars.count;
+            result = volarix4::core::RunSignalPipeline(symbol_str, timeframe_str, bars, params, options);
+        });
+    if (!found || window == 0)
+        return SysAllocString(L"{\"error\":\"No stored bars for symbol/timeframe\"}");
+
+    const std::string& json = LocalSignalJson(result);
+
+    if (DebugLog::Enabled(LogLevel::kDebug)) {
+        std::stringstream debug_msg;
+        debug_msg << "=== Volarix 4 Store Signal: " << symbol_str << " " << timeframe_str
+            << " bars=" << window << " -> " << json.substr(0, 200);
+        WriteDebugLog(debug_msg.str().c_str());
+    }
+
+    return ToBstr(json);
+}
+
+//=============================================================================
+//  Native DLL Function: GetVolarix4SignalWithContext
+//
+//  GetVolarix4SignalFromStore plus a higher-timeframe context (e.g. D1 for
+//  H1 execution bars). The context candles are resampled in the DLL from
+//  the stored execution bars - nothing else is fetched or sent - and the
+//  context trend (EMA 20/50) and S/R levels are computed once per closed
+//  context candle, then reused by every call until the next one closes.
+//  With contextFilter != 0 a BUY is held in a context DOWNTREND and a SELL
+//  in a context UPTREND. The JSON gains a "context" object; until 60
+//  context candles have closed it reports "valid": false and filters
+//  nothing.
+//=============================================================================
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4SignalWithContext(
+    const wchar_t* symbol,
+    const wchar_t* timeframe,
+    const wchar_t* contextTimeframe,  // Higher than timeframe, e.g. L"D1"
+    int lookbackBars,
+    int contextBars,                  // Context candles for trend/levels (e.g. 200)
+    int contextFilter,                // 1 = hold counter-trend signals, 0 = report only
+    double minConfidence,
+    double brokenLevelCooldownHours,
+    double brokenLevelBreakPips,
+    double minEdgePips,
+    double spreadPips,
+    double slippagePips,
+    double commissionPerSidePerLot,
+    double usdPerPipPerLot,
+    double lotSize)
+{
+    if (lookbackBars <= 0 || contextBars <= 0)
+        return SysAllocString(L"{\"error\":\"No bars provided\"}");
+
+    std::string symbol_str = ToNarrow(symbol);
+    std::string timeframe_str = ToNarrow(timeframe);
+    std::string context_str = ToNarrow(contextTimeframe);
+
+    StrategyParams params{
+        minConfidence, brokenLevelCooldownHours, brokenLevelBreakPips, minEdgePips,
+        spreadPips, slippagePips, commissionPerSidePerLot, usdPerPipPerLot, lotSize
+    };
+
+    // The stream's S/R and EMA state follow the store window by window
+    std::shared_ptr<SRLevelsCache::Stream> stream =
+        SRLevelsCache::Instance().Get(SRLevelsCache::Key(symbol_str, timeframe_str, (size_t)lookbackBars));
+    std::lock_guard<std::mutex> stream_lock(stream->mutex);
+
+    volarix4::core::PipelineOptions options;
+    options.localTime = LocalWallClock;
+    options.cooldown = &LocalSignalCooldown();
+    options.srLevels = &stream->levels;
+    options.trend = &stream->trend;
+
+    PipelineResult result;
+    std::shared_ptr<const HtfContext> context;
+    size_t window = 0;
+    bool found = BarStore::Instance().Read(
+        BarStore::Key(symbol_str, timeframe_str), [&](const BarColumns& stored) {
+            context = HtfContextCache::Instance().Get(symbol_str, timeframe_str, context_str,
+                                                      stored, (size_t)contextBars);
+            if (!context)
+                return;
+            if (contextFilter != 0)
+                options.context = context.get();
+
+            BarColumns bars = stored.Tail((size_t)lookbackBars);
+            window = bars.count;
+            result = volarix4::core::RunSignalPipeline(symbol_str, timeframe_str, bars, params, options);
+        });
+    if (found && !context)
+        return SysAllocString(L"{\"error\":\"Context timeframe must be a higher multiple of the timeframe\"}");
+    if (!found || window == 0)
+        return SysAllocString(L"{\"error\":\"No stored bars for symbol/timeframe\"}");
+
+    const std::string& json = LocalSignalJson(result, result.barsValid ? context.get() : nullptr);
+
+    if (DebugLog::Enabled(LogLevel::kDebug)) {
+        std::stringstream debug_msg;
+        debug_msg << "=== Volarix 4 Context Signal: " << symbol_str << " " << timeframe_str
+            << "/" << context_str << " bars=" << window << " context=" << context->barCount
+            << " -> " << json.substr(0, 200);
+        WriteDebugLog(debug_msg.str().c_str());
+    }
+
+    return ToBstr(json);
+}
+
+//=============================================================================
+//  Native DLL Function: SetVolarix4DebugLog
+//
+//  Debug log file and verbosity: 0 = off, 1 = errors, 2 = info (default),
+//  3 = debug (request/response dumps). An empty or NULL path keeps the
+//  current file (E:\\Volarix4Bridge_Debug.txt until changed). Lines already
+//  queued go to the new file.
+//=============================================================================
+extern "C" __declspec(dllexport)
+void __stdcall SetVolarix4DebugLog(
+    const wchar_t* path,
+    int level)
+{
+    if (level < (int)LogLevel::kOff)
+        level = (int)LogLevel::kOff;
+    if (level > (int)LogLevel::kDebug)
+        level = (int)LogLevel::kDebug;
+
+    DebugLog::Instance().Configure(path ? ToNarrow(path) : std::string(), (LogLevel)level);
+}
+
+//=============================================================================
+//  Native DLL Function: GetVolarix4BridgeStats
+//
+//  Latency per endpoint ("host:port/path") since load or the last reset:
+//  call and error counts plus count/p50/p90/p99/max in milliseconds for
+//  serialize, connect, send, ttfb (server time), read, bstr and total.
+//  Async requests have no bstr phase.
+//=============================================================================
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4BridgeStats()
+{
+    return ToBstr(BridgeStats::Instance().Json());
+}
+
+extern "C" __declspec(dllexport)
+void __stdcall ResetVolarix4BridgeStats()
+{
+    BridgeStats::Instance().Reset();
+}
+
+//=============================================================================
+//  Native DLL Function: GetVolarix4SubscriptionStats
+//
+//  Pushed-signal poller: whether it runs, its endpoint and subscriber id,
+//  streams (registered ones), responses pushed / taken / overwritten before
+//  the EA took them, polls, failures and the last error.
+//=============================================================================
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4SubscriptionStats()
+{
+    return ToBstr(SignalSubscriptions::Instance().Json());
+}
+
+//=============================================================================
+//  Native DLL Functions: SetVolarix4Hedging / GetVolarix4EndpointHealth
+//
+//  For an apiUrl listing several endpoints. With hedging on, a call that
+//  has not been answered within the primary endpoint's p95 latency (but no
+//  sooner than minDelayMs) is also sent to the next endpoint and the first
+//  answer wins; the p95 is only used after 20 answered calls. Health: per
+//  endpoint successes, failures, backoff and p95, plus hedge counters.
+//=============================================================================
+extern "C" __declspec(dllexport)
+void __stdcall SetVolarix4Hedging(
+    int enabled,
+    double minDelayMs)
+{
+    EndpointPool::Instance().SetHedging(enabled != 0, minDelayMs);
+}
+
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4EndpointHealth()
+{
+    return ToBstr(EndpointPool::Instance().Json());
+}
+
+//=============================================================================
+//  Native DLL Functions: SetVolarix4ResponseCache / GetVolarix4CacheStats /
+//  ClearVolarix4ResponseCache
+//
+//  Cache of /signal responses per (symbol, timeframe, bar_time, params) -
+//  see bridge/response_cache.h. capacity 0 turns it off; path names a file
+//  that keeps the responses across runs and processes ("" = memory only).
+//  Set returns 0, or -1 if the file could not be opened (the memory cache
+//  is still on).
+//=============================================================================
+extern "C" __declspec(dllexport)
+int __stdcall SetVolarix4ResponseCache(int capacity, const wchar_t* path)
+{
+    if (capacity < 0)
+        return -1;
+
+    std::string file_path = ToNarrow(path);
+    if (!ResponseCache::Instance().Configure((size_t)capacity, file_path)) {
+        if (DebugLog::Enabled(LogLevel::kError)) {
+            std::stringstream err_msg;
+            err_msg << "ERROR: Response cache file " << file_path << " could not be mapped";
+            WriteDebugLog(err_msg.str().c_str(), LogLevel::kError);
+        }
+        return -1;
+    }
+    return 0;
+}
+
+// {"entries":..,"capacity":..,"hits":..,"file_hits":..,"misses":..,"file_slots":..}
+extern "C" __declspec(dllexport)
+BSTR __stdcall GetVolarix4CacheStats()
+{
+    ResponseCache::Stats stats = ResponseCache::Instance().GetStats();
+
+    JsonWriter& json = JsonWriter::ThreadLocal();
+    json.Reset(160);
+    json.BeginObject()
+        .Field("entries", (long long)stats.entries)
+        .Field("capacity", (long long)stats.capacity)
+        .Field("hits", (long long)stats.hits)
+        .Field("file_hits", (long long)stats.fileHits)
+        .Field("misses", (long long)stats.misses)
+        .Field("file_slots", (long long)stats.fileSlots)
+        .EndObject();
+    return ToBstr(json.str());
+}
+
+extern "C" __declspec(dllexport)
+void __stdcall ClearVolarix4ResponseCache()
+{
+    ResponseCache::Instance().Clear();
+}
+
+//=============================================================================
+//  AttachVolarix4Bridge / ShutdownVolarix4Bridge: every EA in the terminal
+//  shares this DLL, so its sessions, pools, job tables and cache file are
+//  process-wide. Each EA attaches in OnInit and calls Shutdown in OnDeinit;
+//  only the last one to leave releases the WinINet session, thread pools,
+//  shared memory channels and cache file. DllMain runs under the loader lock,
+//  where WinINet must not be called and pools must not be waited for, so it
+//  leaves all of this to the process.
+//=============================================================================
+static std::mutex g_attach_mutex;
+static int g_attached_eas = 0;
+
+extern "C" __declspec(dllexport)
+int __stdcall AttachVolarix4Bridge()
+{
+    std::lock_guard<std::mutex> lock(g_attach_mutex);
+    return ++g_attached_eas;
+}
+
+extern "C" __declspec(dllexport)
+void __stdcall ShutdownVolarix4Bridge()
+{
+    std::lock_guard<std::mutex> lock(g_attach_mutex);
+    // An EA that never attached tears down as before
+    if (g_attached_eas > 1) {
+        --g_attached_eas;
+        WriteDebugLog(("ShutdownVolarix4Bridge: " + std::to_string(g_attached_eas)
+            + " EA(s) still attached, state kept").c_str(), LogLevel::kInfo);
+        return;
+    }
+    g_attached_eas = 0;
 
-    // Convert response to BSTR for MQL5
-    std::wstring ws_response(response.begin(), response.end());
-    return SysAllocString(ws_response.c_str());
+    SignalJobQueue::Instance().Shutdown();
+    SignalSubscriptions::Instance().Shutdown();
+    EndpointPool::Instance().Shutdown();
+    HttpSessionPool::Instance().Shutdown();
+    ShmTransport::Instance().Shutdown();
+    ResponseCache::Instance().Shutdown();
+    DebugLog::Instance().Flush("=== Volarix4Bridge.dll shut down ===");
 }
 
 //=============================================================================
@@ -235,10 +1468,18 @@ BOOL APIENTRY DllMain(HMODULE hModule,
     switch (ul_reason_for_call)
     {
     case DLL_PROCESS_ATTACH:
-        WriteDebugLog("=== Volarix4Bridge.dll loaded ===");
+        DebugLog::Instance().Initialize(hModule, kDefaultDebugLogPath);
+        HttpSessionPool::Instance().Initialize("Volarix4Bridge");
+        SignalJobQueue::Instance().Initialize(hModule);
+        SignalSubscriptions::Instance().Initialize(hModule);
+        EndpointPool::Instance().Initialize(hModule);
+        WriteDebugLog("=== Volarix4Bridge.dll loaded ===", LogLevel::kInfo);
         break;
     case DLL_PROCESS_DETACH:
-        WriteDebugLog("=== Volarix4Bridge.dll unloaded ===");
+        // Nothing to tear down under the loader lock: the EA released the
+        // handles with ShutdownVolarix4Bridge, and whatever it did not is
+        // left to the process (the pools are bound to this module, so the
+        // DLL is not unloaded while one of their callbacks runs)
         break;
     }
     return TRUE;
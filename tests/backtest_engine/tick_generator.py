@@ -6,6 +6,9 @@ MT5 Strategy Tester modeling modes:
 - OHLC: 4 ticks per bar (O→H→L→C)
 - 1-minute OHLC: M1 bars synthesized (most realistic)
 - Real ticks: Actual tick data replay
+
+The native backtest resolves exits with the same models in C++
+(mt5_integration/core/tick_path.h: exit_model / path_model).
 """
 
 from abc import ABC, abstractmethod
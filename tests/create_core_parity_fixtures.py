@@ -0,0 +1,153 @@
+"""
+Create the core parity fixtures in tests/fixtures/core_parity/.
+
+Each fixture is a synthetic H1 bar window (seeded, so re-running this script
+writes the same bars) picked to end in one pipeline outcome - a BUY or SELL
+bounce, or one HOLD reason each - plus the strategy parameters and the exact
+response body for them in "expected_response".
+
+The response is recorded from the native pipeline through
+volarix4_signal_parity --print (mt5_integration/parity/signal_parity.cpp).
+ctest then holds the core to these bodies on every platform, and on Windows
+tests/test_local_signal_parity.py checks the same windows DLL vs POST /signal.
+Re-record only after an intended change to the pipeline, and run the
+Windows parity test on the new files before committing them.
+
+Usage:
+    python tests/create_core_parity_fixtures.py [path/to/volarix4_signal_parity]
+"""
+
+import sys
+import os
+import json
+import math
+import random
+import subprocess
+import tempfile
+from pathlib import Path
+
+
+FIXTURE_DIR = Path(__file__).parent / "fixtures" / "core_parity"
+DEFAULT_BIN = Path(__file__).parent.parent / "mt5_integration" / "build" / "volarix4_signal_parity"
+
+# Wednesday 2024-03-06 09:00 UTC, inside the London session
+DECISION_BAR_TIME = 1709715600
+
+PARAMETERS = {
+    "min_confidence": 0.60,
+    "broken_level_cooldown_hours": 48.0,
+    "broken_level_break_pips": 15.0,
+    "min_edge_pips": 4.0,
+    "spread_pips": 1.0,
+    "slippage_pips": 0.5,
+    "commission_per_side_per_lot": 7.0,
+    "usd_per_pip_per_lot": 10.0,
+    "lot_size": 1.0
+}
+
+# name: (description, symbol, seed, bar count, decision bar time, parameter overrides)
+SCENARIOS = {
+    "eurusd_buy_support_bounce": ("BUY on a support bounce", "EURUSD", 1, 400, DECISION_BAR_TIME, {}),
+    "eurusd_sell_resistance_bounce": ("SELL on a resistance bounce", "EURUSD", 3, 400, DECISION_BAR_TIME, {}),
+    "eurusd_hold_no_rejection": ("HOLD: no rejection candle at a level", "EURUSD", 0, 400, DECISION_BAR_TIME, {}),
+    "eurusd_hold_low_confidence": ("HOLD: confidence below min_confidence", "EURUSD", 10, 400, DECISION_BAR_TIME, {}),
+    "eurusd_hold_trend_filter": ("HOLD: SELL against the EMA trend", "EURUSD", 28, 400, DECISION_BAR_TIME, {}),
+    "eurusd_hold_below_ema": ("HOLD: BUY with price below EMA20", "EURUSD", 6, 400, DECISION_BAR_TIME, {}),
+    "eurusd_hold_risk_exceeded": ("HOLD: stop loss wider than the risk limit", "EURUSD", 4, 400, DECISION_BAR_TIME, {}),
+    "eurusd_hold_insufficient_edge": ("HOLD: TP1 does not cover the costs", "EURUSD", 113, 400, DECISION_BAR_TIME, {}),
+    "eurusd_hold_outside_session": ("HOLD: decision bar at 02:00 UTC", "EURUSD", 1, 400,
+                                    DECISION_BAR_TIME - 7 * 3600, {}),
+    "eurusd_custom_parameters": ("SELL that passes only with the lower min_confidence and costs",
+                                 "EURUSD", 11, 400, DECISION_BAR_TIME,
+                                 {"min_confidence": 0.5, "spread_pips": 0.8, "commission_per_side_per_lot": 3.5}),
+    "eurusd_short_window": ("422 body: fewer than 200 bars", "EURUSD", 1, 150, DECISION_BAR_TIME, {}),
+    "usdjpy_buy_support_bounce": ("BUY on a JPY pair (0.01 pip)", "USDJPY", 1, 400, DECISION_BAR_TIME, {}),
+    "usdjpy_sell_resistance_bounce": ("SELL on a JPY pair (0.01 pip)", "USDJPY", 3, 400, DECISION_BAR_TIME, {}),
+}
+
+
+def synthetic_bars(seed, count, last_time, symbol):
+    """count closed H1 bars ending at last_time: mean-reverting around a slow
+    swing so levels form, one candle in eight with a long wick."""
+    pip, base = (0.01, 150.0) if symbol.endswith("JPY") else (0.0001, 1.0850)
+    digits = 3 if symbol.endswith("JPY") else 5
+    rng = random.Random(seed)
+    bars = []
+    close = base
+    for i in range(count):
+        anchor = base + 40 * pip * math.sin(i / 37.0)
+        open_ = close
+        close = open_ + (rng.random() - 0.5) * 16 * pip + (anchor - open_) * 0.08
+        upper = rng.random() * 5 * pip
+        lower = rng.random() * 5 * pip
+        if rng.random() < 0.125:
+            wick = 3 * abs(close - open_) + 6 * pip
+            if rng.random() < 0.5:
+                upper += wick
+            else:
+                lower += wick
+        bars.append({
+            "time": last_time - (count - 1 - i) * 3600,
+            "open": round(open_, digits),
+            "high": round(max(open_, close) + upper, digits),
+            "low": round(min(open_, close) - lower, digits),
+            "close": round(close, digits),
+            "volume": 1000 + int(rng.random() * 4000)
+        })
+    return bars
+
+
+def record_response(binary, fixture):
+    """The pipeline's response body for the fixture (volarix4_signal_parity --print)."""
+    with tempfile.NamedTemporaryFile("w", suffix=".json", delete=False) as f:
+        json.dump(fixture, f)
+        path = f.name
+    try:
+        result = subprocess.run([str(binary), "--print", path], capture_output=True, text=True, check=True)
+        return result.stdout
+    finally:
+        os.unlink(path)
+
+
+def write_fixture(path, fixture):
+    """Pretty-printed, one bar per line."""
+    head = {key: value for key, value in fixture.items() if key != "bars"}
+    lines = json.dumps(head, indent=1).splitlines()
+    lines[-1:] = [' "bars": [']
+    lines[-2] += ","
+    lines += [" " + json.dumps(bar) + "," for bar in fixture["bars"]]
+    lines[-1] = lines[-1][:-1]
+    lines += [" ]", "}"]
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def main():
+    binary = Path(sys.argv[1]) if len(sys.argv) > 1 else DEFAULT_BIN
+    if not binary.exists():
+        print(f"volarix4_signal_parity not found: {binary} (build mt5_integration first)")
+        return 1
+
+    FIXTURE_DIR.mkdir(parents=True, exist_ok=True)
+    for name, (description, symbol, seed, count, last_time, overrides) in SCENARIOS.items():
+        fixture = {
+            "description": description,
+            "source": "tests/create_core_parity_fixtures.py (synthetic bars, seed %d)" % seed,
+            "symbol": symbol,
+            "timeframe": "H1",
+            "parameters": dict(PARAMETERS, **overrides),
+            "bars": synthetic_bars(seed, count, last_time, symbol),
+        }
+        response = record_response(binary, fixture)
+        fixture["expected_response"] = response
+        signal = json.loads(response).get("signal")
+        if signal:
+            fixture["expected_results"] = {"signal": signal}
+
+        write_fixture(FIXTURE_DIR / f"{name}.json", fixture)
+        print(f"{name}: {signal or 'error'} - {description}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
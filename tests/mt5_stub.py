@@ -0,0 +1,40 @@
+"""
+Stand-in MetaTrader5 module for in-process tests.
+
+volarix4.api.main and volarix4.core.data import MetaTrader5 at module level,
+and the package only exists for Windows. Tests that import the app call
+install_mt5_stub() first: where the real package is installed it is used,
+elsewhere (Linux CI) a module with the same names takes its place. The stub
+has no terminal - terminal_info() is None and every fetch fails like MT5
+does without one - so tests must send their bars or monkeypatch fetch_ohlc.
+"""
+
+import sys
+import types
+import importlib.util
+
+
+def install_mt5_stub():
+    """Make `import MetaTrader5` work; returns the real module or the stub."""
+    if "MetaTrader5" in sys.modules:
+        return sys.modules["MetaTrader5"]
+    if importlib.util.find_spec("MetaTrader5") is not None:
+        import MetaTrader5
+        return MetaTrader5
+
+    mt5 = types.ModuleType("MetaTrader5")
+    mt5.__doc__ = "MetaTrader5 stub (tests/mt5_stub.py) - no terminal attached"
+    for name, value in (("TIMEFRAME_M1", 1), ("TIMEFRAME_M5", 5), ("TIMEFRAME_M15", 15),
+                        ("TIMEFRAME_M30", 30), ("TIMEFRAME_H1", 16385), ("TIMEFRAME_H4", 16388),
+                        ("TIMEFRAME_D1", 16408), ("TIMEFRAME_W1", 32769)):
+        setattr(mt5, name, value)
+
+    mt5.initialize = lambda *args, **kwargs: False
+    mt5.shutdown = lambda: None
+    mt5.terminal_info = lambda: None
+    mt5.last_error = lambda: (-10003, "MetaTrader5 stub: no terminal")
+    mt5.copy_rates_from = lambda *args: None
+    mt5.copy_rates_from_pos = lambda *args: None
+
+    sys.modules["MetaTrader5"] = mt5
+    return mt5
@@ -6,6 +6,7 @@ import os
 # Add parent directory to path to allow imports
 sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
 
+import pytest
 import requests
 import json
 import time
@@ -212,6 +213,187 @@ def test_response_times():
     print("✓ Response time performance acceptable")
 
 
+def test_binary_bar_upload():
+    """Test /signal/bars with a binary bar payload."""
+    print("\n[TEST 8] Binary Bar Upload")
+    print("-" * 60)
+
+    from volarix4.utils.bar_codec import BINARY_BARS_CONTENT_TYPE, encode_binary_bars
+
+    # 250 closed H1 bars ending a week ago
+    end_time = (int(time.time()) // 3600 - 168) * 3600
+    bars = [{
+        'time': end_time - (249 - i) * 3600,
+        'open': 1.1000 + i * 0.0001,
+        'high': 1.1010 + i * 0.0001,
+        'low': 1.0990 + i * 0.0001,
+        'close': 1.1005 + i * 0.0001,
+        'volume': 1000
+    } for i in range(250)]
+
+    payload = encode_binary_bars("EURUSD", "H1", bars)
+    headers = {"Content-Type": BINARY_BARS_CONTENT_TYPE}
+    print(f"  Payload: {len(payload)} bytes for {len(bars)} bars")
+
+    response = requests.post(f"{API_URL}/signal/bars", data=payload, headers=headers, timeout=30)
+    assert response.status_code == 200, f"Binary upload failed: {response.status_code} {response.text}"
+    data = response.json()
+    assert data["signal"] in ["BUY", "SELL", "HOLD"], "Invalid signal value"
+    print(f"  Signal: {data['signal']} ({data['reason']})")
+
+    response = requests.post(f"{API_URL}/signal/bars", data=payload[:-1], headers=headers, timeout=10)
+    assert response.status_code == 400, "Truncated payload should be rejected"
+
+    response = requests.post(f"{API_URL}/signal/bars", data=payload, timeout=10)
+    assert response.status_code == 415, "Wrong content type should be rejected"
+
+    print("✓ Binary bar upload passed")
+
+
+# ---------------------------------------------------------------------------
+# In-process tests (pytest only): the app is driven with TestClient, without
+# its startup event, so no server runs and no terminal is connected. They
+# need fastapi and httpx; MetaTrader5 is stubbed where it is not installed
+# (tests/mt5_stub.py), and bars come from the request or fetch_ohlc patched
+# ---------------------------------------------------------------------------
+
+def synthetic_bars(count, end_time=None):
+    """count closed H1 bars ending a week ago (or at end_time), oldest first."""
+    if end_time is None:
+        end_time = (int(time.time()) // 3600 - 168) * 3600
+    return [{
+        'time': end_time - (count - 1 - i) * 3600,
+        'open': 1.1000 + i * 0.0001,
+        'high': 1.1010 + i * 0.0001,
+        'low': 1.0990 + i * 0.0001,
+        'close': 1.1005 + i * 0.0001,
+        'volume': 1000
+    } for i in range(count)]
+
+
+@pytest.fixture
+def client():
+    pytest.importorskip("fastapi")
+    pytest.importorskip("httpx")
+    from tests.mt5_stub import install_mt5_stub
+    install_mt5_stub()
+    from fastapi.testclient import TestClient
+    from volarix4.api.main import create_app
+
+    return TestClient(create_app())
+
+
+def test_batch_keeps_order_and_per_item_errors(client, monkeypatch):
+    """One failing entry becomes a HOLD in its own slot, the others still run."""
+    import pandas as pd
+    from volarix4.core import data
+
+    fetched = []
+
+    def fake_fetch_ohlc(symbol, timeframe, bars, end_time=None):
+        fetched.append(symbol)
+        if symbol == "XXXYYY":
+            raise ValueError("Symbol XXXYYY not found")
+        rows = synthetic_bars(10 if symbol == "GBPUSD" else bars)
+        frame = pd.DataFrame(rows)
+        frame['time'] = pd.to_datetime(frame['time'], unit='s')
+        return frame
+
+    monkeypatch.setattr(data, "fetch_ohlc", fake_fetch_ohlc)
+
+    bar_time = int(time.time()) // 3600 * 3600
+    symbols = ["EURUSD", "XXXYYY", "GBPUSD", "USDJPY"]
+    response = client.post("/signal/batch", json={
+        "requests": [{"symbol": s, "timeframe": "H1", "bar_time": bar_time} for s in symbols],
+        "lookback_bars": 250
+    })
+    assert response.status_code == 200, response.text
+
+    results = response.json()
+    assert fetched == symbols
+    assert len(results) == len(symbols)
+    assert all(r["signal"] in ["BUY", "SELL", "HOLD"] for r in results)
+    assert results[1]["signal"] == "HOLD"
+    assert results[1]["reason"].startswith("Failed to fetch bars from MT5")
+    assert results[2]["signal"] == "HOLD"
+    assert results[2]["reason"].startswith("Bar Validation Failed")
+    for i in (0, 3):
+        assert not results[i]["reason"].startswith(("Failed to fetch", "Bar Validation Failed"))
+
+    assert client.post("/signal/batch", json={"requests": []}).json() == []
+
+
+@pytest.fixture
+def stream_client(client, monkeypatch):
+    """client with an empty bar stream store, so no stream outlives its test."""
+    from volarix4.api import main
+    from volarix4.utils.bar_stream import BarStreamStore
+
+    monkeypatch.setattr(main, "_bar_streams", BarStreamStore())
+    return client
+
+
+def test_stream_append_and_duplicates(stream_client):
+    """Pushes append only bars newer than the window; a retried bar is dropped."""
+    client = stream_client
+    bars = synthetic_bars(251)
+    stream = {"client_id": "test-append", "symbol": "EURUSD", "timeframe": "H1"}
+
+    def buffered():
+        return client.get("/stream/stats").json()["bars"]
+
+    assert buffered() == 0
+    response = client.post("/signal/stream", json=dict(stream, seq=1, reset=True, bars=bars[:250]))
+    assert response.status_code == 200, response.text
+    assert response.json()["signal"] in ["BUY", "SELL", "HOLD"]
+    assert buffered() == 250
+
+    # The last acknowledged bar again plus one new bar: only the new one is
+    # kept (the window holds up to lookback_bars, 400 by default)
+    response = client.post("/signal/stream", json=dict(stream, seq=2, bars=bars[249:251]))
+    assert response.status_code == 200, response.text
+    assert buffered() == 251
+
+    # Nothing new: the window is unchanged but the push is still answered
+    response = client.post("/signal/stream", json=dict(stream, seq=3, bars=[]))
+    assert response.status_code == 200, response.text
+    assert buffered() == 251
+    assert client.get("/stream/stats").json()["streams"] == 1
+
+
+def test_stream_resync_conflict(stream_client):
+    """Out-of-sequence pushes answer 409; each client_id has its own stream."""
+    client = stream_client
+    bars = synthetic_bars(250)
+    stream = {"symbol": "EURUSD", "timeframe": "H1"}
+    first = dict(stream, client_id="test-resync-a")
+
+    # Never synced: the client must reset
+    response = client.post("/signal/stream", json=dict(first, seq=5, bars=bars[-1:]))
+    assert response.status_code == 409
+    body = response.json()
+    assert body["error"] == "Stream resync required"
+    assert body["expected_seq"] is None
+
+    assert client.post("/signal/stream", json=dict(first, seq=1, reset=True, bars=bars)).status_code == 200
+
+    # A skipped push
+    response = client.post("/signal/stream", json=dict(first, seq=3, bars=[]))
+    assert response.status_code == 409
+    assert response.json()["expected_seq"] == 2
+
+    # Another client on the same symbol and timeframe does not see the first
+    # client's stream
+    second = dict(stream, client_id="test-resync-b")
+    response = client.post("/signal/stream", json=dict(second, seq=2, bars=[]))
+    assert response.status_code == 409
+    assert response.json()["expected_seq"] is None
+
+    # The bridge's answer to a 409: the whole window again, with reset
+    assert client.post("/signal/stream", json=dict(first, seq=1, reset=True, bars=bars)).status_code == 200
+    assert client.post("/signal/stream", json=dict(first, seq=2, bars=[])).status_code == 200
+
+
 def run_all_tests():
     """Run all tests."""
     print("\n" + "=" * 70)
@@ -231,6 +413,7 @@ def run_all_tests():
         ("Volarix 3 Compatibility", test_response_format_compatibility),
         ("Multiple Symbols", test_multiple_symbols),
         ("Response Time Performance", test_response_times),
+        ("Binary Bar Upload", test_binary_bar_upload),
     ]
 
     for test_name, test_func in tests:
@@ -0,0 +1,149 @@
+"""
+Content-Encoding Tests - compressed request bodies from VolariXBridge.dll
+
+decode_body is checked against bodies compressed the way
+bridge/content_encoding.h writes them (one gzip member, zstd frames without
+a content size), and ContentEncodingMiddleware is driven as a plain ASGI
+app, so no server or MT5 terminal is needed.
+
+Run tests:
+    pytest tests/test_content_encoding.py -v
+"""
+
+import sys
+import os
+import gzip
+import json
+import zlib
+import asyncio
+import pytest
+
+# Add parent directory to path
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from volarix4.utils import content_encoding
+from volarix4.utils.content_encoding import (
+    ContentEncodingError,
+    ContentEncodingMiddleware,
+    decode_body,
+)
+
+
+BODY = json.dumps({
+    "symbol": "EURUSD",
+    "timeframe": "H1",
+    "data": [{"timestamp": "2024.03.06 09:00:00", "open": 1.085, "high": 1.0862,
+              "low": 1.0841, "close": 1.0855, "volume": 1200}] * 200,
+}).encode()
+
+
+def bridge_gzip(data: bytes) -> bytes:
+    """gzip as BodyEncoder writes it: level 1, one gzip member."""
+    encoder = zlib.compressobj(1, zlib.DEFLATED, 16 + zlib.MAX_WBITS)
+    return encoder.compress(data) + encoder.flush()
+
+
+def test_gzip_round_trip():
+    assert decode_body(bridge_gzip(BODY), "gzip") == BODY
+    assert decode_body(gzip.compress(BODY), " GZIP ") == BODY
+    assert decode_body(BODY, "identity") == BODY
+
+
+def test_gzip_errors():
+    compressed = bridge_gzip(BODY)
+
+    with pytest.raises(ContentEncodingError) as error:
+        decode_body(compressed[:len(compressed) // 2], "gzip")
+    assert error.value.status_code == 400
+
+    with pytest.raises(ContentEncodingError) as error:
+        decode_body(b"not gzip at all", "gzip")
+    assert error.value.status_code == 400
+
+    # Output is capped, whatever the compressed size
+    with pytest.raises(ContentEncodingError) as error:
+        decode_body(gzip.compress(b"\0" * 1_000_000), "gzip", max_bytes=100_000)
+    assert error.value.status_code == 413
+
+
+def test_unsupported_encoding():
+    with pytest.raises(ContentEncodingError) as error:
+        decode_body(BODY, "br")
+    assert error.value.status_code == 415
+
+
+def test_zstd_round_trip():
+    zstandard = pytest.importorskip("zstandard")
+
+    # Streamed like the bridge: no content size in the frame header
+    compressor = zstandard.ZstdCompressor(level=1).compressobj()
+    compressed = compressor.compress(BODY) + compressor.flush()
+    assert decode_body(compressed, "zstd") == BODY
+
+    with pytest.raises(ContentEncodingError) as error:
+        decode_body(compressed, "zstd", max_bytes=len(BODY) - 1)
+    assert error.value.status_code == 413
+
+
+def test_zstd_without_package(monkeypatch):
+    monkeypatch.setattr(content_encoding, "zstandard", None)
+    with pytest.raises(ContentEncodingError) as error:
+        decode_body(b"\x28\xb5\x2f\xfd", "zstd")
+    assert error.value.status_code == 415
+
+
+def run_middleware(headers, chunks, max_bytes=content_encoding.DEFAULT_MAX_DECODED_BYTES):
+    """(what the app received or None, response start, response body)."""
+    seen = {}
+
+    async def app(scope, receive, send):
+        message = await receive()
+        seen["headers"] = dict(scope["headers"])
+        seen["body"] = message["body"]
+        await send({"type": "http.response.start", "status": 200, "headers": []})
+        await send({"type": "http.response.body", "body": b"ok"})
+
+    messages = [{"type": "http.request", "body": chunk, "more_body": i < len(chunks) - 1}
+                for i, chunk in enumerate(chunks)]
+    sent = []
+
+    async def receive():
+        return messages.pop(0) if messages else {"type": "http.disconnect"}
+
+    async def send(message):
+        sent.append(message)
+
+    scope = {"type": "http", "method": "POST", "path": "/signal", "headers": headers}
+    asyncio.run(ContentEncodingMiddleware(app, max_bytes=max_bytes)(scope, receive, send))
+    return seen or None, sent[0], sent[1]["body"]
+
+
+def test_middleware_decodes_chunked_body():
+    compressed = bridge_gzip(BODY)
+    pieces = [compressed[i:i + 1000] for i in range(0, len(compressed), 1000)]
+    headers = [(b"content-type", b"application/json"), (b"content-encoding", b"gzip"),
+               (b"transfer-encoding", b"chunked")]
+
+    seen, start, _ = run_middleware(headers, pieces)
+    assert start["status"] == 200
+    assert seen["body"] == BODY
+    assert b"content-encoding" not in seen["headers"]
+    assert seen["headers"][b"content-length"] == str(len(BODY)).encode()
+
+
+def test_middleware_passes_plain_body_through():
+    seen, start, _ = run_middleware([(b"content-type", b"application/json")], [BODY])
+    assert start["status"] == 200
+    assert seen["body"] == BODY
+
+
+def test_middleware_rejects_bad_body():
+    seen, start, body = run_middleware([(b"content-encoding", b"gzip")], [b"garbage"])
+    assert seen is None
+    assert start["status"] == 400
+    assert json.loads(body)["error"] == "Body Decode Failed"
+
+    seen, start, body = run_middleware([(b"content-encoding", b"gzip")], [bridge_gzip(BODY)],
+                                       max_bytes=len(BODY) // 2)
+    assert seen is None
+    assert start["status"] == 413
@@ -0,0 +1,212 @@
+"""
+Local Signal Parity Tests - GetVolarix4SignalLocal vs POST /signal
+
+The bridge DLL can run the whole signal pipeline in-process
+(GetVolarix4SignalLocal). These tests feed every parity fixture's bar window
+to both the DLL and the API's /signal route (legacy mode, bars in the request)
+and require byte-identical JSON responses - signal, confidence, SL/TP, percents
+and the HOLD reason text.
+
+Fixtures with an "expected_response" (tests/fixtures/core_parity, written by
+tests/create_core_parity_fixtures.py) must also get exactly that body from
+the API; ctest checks the native core against the same files on every
+platform (mt5_integration/parity/signal_parity.cpp).
+
+Requirements:
+- Windows with Volarix4Bridge.dll built (see mt5_integration/README_MT5.md)
+- fastapi and httpx; MetaTrader5 is stubbed where it is not installed
+- Fixtures in tests/fixtures/ (tests/create_core_parity_fixtures.py,
+  tests/extract_bars_from_mt5.py)
+
+Run tests:
+    pytest tests/test_local_signal_parity.py -v
+
+Set VOLARIX4_BRIDGE_DLL if the DLL is not in mt5_integration/.
+"""
+
+import sys
+import os
+import json
+import types
+import ctypes
+import pytest
+from pathlib import Path
+
+# Add parent directory to path
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+
+FIXTURE_DIR = Path(__file__).parent / "fixtures"
+DLL_PATH = Path(os.environ.get(
+    "VOLARIX4_BRIDGE_DLL",
+    Path(__file__).parent.parent / "mt5_integration" / "Volarix4Bridge.dll"
+))
+
+
+class OHLCVBar(ctypes.Structure):
+    """Packed bar record (must match core/bar.h - 44 bytes)"""
+    _pack_ = 1
+    _fields_ = [
+        ("timestamp", ctypes.c_longlong),
+        ("open", ctypes.c_double),
+        ("high", ctypes.c_double),
+        ("low", ctypes.c_double),
+        ("close", ctypes.c_double),
+        ("volume", ctypes.c_int),
+    ]
+
+
+def load_bridge():
+    """Load Volarix4Bridge.dll, or skip when it is not available."""
+    if sys.platform != "win32":
+        pytest.skip("Volarix4Bridge.dll is Windows-only")
+    if not DLL_PATH.exists():
+        pytest.skip(f"Bridge DLL not found: {DLL_PATH}")
+
+    bridge = ctypes.WinDLL(str(DLL_PATH))
+    bridge.GetVolarix4SignalLocal.restype = ctypes.c_void_p
+    bridge.GetVolarix4SignalLocal.argtypes = [
+        ctypes.c_wchar_p, ctypes.c_wchar_p,
+        ctypes.POINTER(OHLCVBar), ctypes.c_int,
+    ] + [ctypes.c_double] * 9
+    return bridge
+
+
+def fixture_names():
+    """Every fixture JSON with a bar window."""
+    if not FIXTURE_DIR.exists():
+        return []
+    return sorted(str(p.relative_to(FIXTURE_DIR)) for p in FIXTURE_DIR.rglob("*.json"))
+
+
+@pytest.fixture(scope="module")
+def bridge():
+    return load_bridge()
+
+
+@pytest.fixture(scope="module")
+def client():
+    """API test client with S/R levels always detected in real time."""
+    pytest.importorskip("fastapi")
+    pytest.importorskip("httpx")
+    from tests.mt5_stub import install_mt5_stub
+    install_mt5_stub()
+    from fastapi.testclient import TestClient
+
+    # The pipeline looks up pre-calculated levels first; a cache that never
+    # hits makes it take the real-time detect_sr_levels path, like the DLL
+    if "volarix4.core.sr_cache" not in sys.modules:
+        class _NoCache:
+            def get_levels_for_bar(self, **kwargs):
+                return None
+
+        sr_cache = types.ModuleType("volarix4.core.sr_cache")
+        sr_cache.get_sr_cache = lambda: _NoCache()
+        sys.modules["volarix4.core.sr_cache"] = sr_cache
+
+    from volarix4.api.main import create_app
+    return TestClient(create_app())
+
+
+def call_local_signal(bridge, fixture):
+    """GetVolarix4SignalLocal on the fixture's bars; returns the JSON text."""
+    bars = fixture["bars"]
+    params = fixture["parameters"]
+
+    array = (OHLCVBar * len(bars))()
+    for i, bar in enumerate(bars):
+        array[i] = OHLCVBar(int(bar["time"]), bar["open"], bar["high"], bar["low"],
+                            bar["close"], int(bar["volume"]))
+
+    ptr = bridge.GetVolarix4SignalLocal(
+        fixture["symbol"], fixture["timeframe"], array, len(bars),
+        params["min_confidence"],
+        params["broken_level_cooldown_hours"],
+        params["broken_level_break_pips"],
+        params["min_edge_pips"],
+        params["spread_pips"],
+        params["slippage_pips"],
+        params["commission_per_side_per_lot"],
+        params["usd_per_pip_per_lot"],
+        params["lot_size"]
+    )
+    try:
+        # The bridge widens the UTF-8 bytes one by one into the BSTR
+        return ctypes.wstring_at(ptr).encode("latin-1").decode("utf-8")
+    finally:
+        ctypes.windll.oleaut32.SysFreeString(ctypes.c_void_p(ptr))
+
+
+def call_api_signal(client, fixture):
+    """POST /signal with the fixture's bars in the request; returns the JSON text."""
+    params = fixture["parameters"]
+    payload = {
+        "symbol": fixture["symbol"],
+        "timeframe": fixture["timeframe"],
+        "data": [{
+            "time": int(bar["time"]),
+            "open": bar["open"],
+            "high": bar["high"],
+            "low": bar["low"],
+            "close": bar["close"],
+            "volume": int(bar["volume"])
+        } for bar in fixture["bars"]],
+    }
+    for key in ("min_confidence", "broken_level_cooldown_hours", "broken_level_break_pips",
+                "min_edge_pips", "spread_pips", "slippage_pips",
+                "commission_per_side_per_lot", "usd_per_pip_per_lot", "lot_size"):
+        payload[key] = params[key]
+
+    response = client.post("/signal", json=payload)
+    assert response.status_code in (200, 422), f"Unexpected status {response.status_code}"
+    return response.text
+
+
+@pytest.mark.parametrize("fixture_name", fixture_names())
+def test_local_signal_matches_api(bridge, client, fixture_name):
+    """DLL and API return the same response for the same bar window."""
+    with open(FIXTURE_DIR / fixture_name, "r") as f:
+        fixture = json.load(f)
+    if "bars" not in fixture:
+        pytest.skip("Fixture has no bar window")
+
+    api_text = call_api_signal(client, fixture)
+    local_text = call_local_signal(bridge, fixture)
+
+    assert json.loads(local_text) == json.loads(api_text), \
+        f"Local signal mismatch:\nAPI:   {api_text}\nLocal: {local_text}"
+    assert local_text == api_text, \
+        f"Local signal JSON formatting differs:\nAPI:   {api_text}\nLocal: {local_text}"
+
+    if "expected_response" in fixture:
+        assert api_text == fixture["expected_response"], \
+            f"API differs from the recorded response:\nAPI:      {api_text}\nRecorded: {fixture['expected_response']}"
+
+    expected = fixture.get("expected_results", {})
+    if expected.get("signal"):
+        assert json.loads(local_text).get("signal") == expected["signal"]
+
+
+def test_local_signal_rejects_short_window(bridge):
+    """Fewer than 200 bars gets the API's 422 Parity Contract body."""
+    fixture = {
+        "symbol": "EURUSD",
+        "timeframe": "H1",
+        "bars": [{"time": 1736478000 + i * 3600, "open": 1.03, "high": 1.031,
+                  "low": 1.029, "close": 1.03, "volume": 100} for i in range(50)],
+        "parameters": {
+            "min_confidence": 0.60, "broken_level_cooldown_hours": 48.0,
+            "broken_level_break_pips": 15.0, "min_edge_pips": 4.0,
+            "spread_pips": 1.0, "slippage_pips": 0.5,
+            "commission_per_side_per_lot": 7.0, "usd_per_pip_per_lot": 10.0,
+            "lot_size": 1.0
+        }
+    }
+
+    result = json.loads(call_local_signal(bridge, fixture))
+    assert result["error"] == "Bar Validation Failed"
+    assert result["message"].startswith("Insufficient bars: got 50, required 200")
+
+
+if __name__ == "__main__":
+    sys.exit(pytest.main([__file__, "-v"]))
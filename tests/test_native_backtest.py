@@ -0,0 +1,325 @@
+"""
+Native Backtest Tests - volarix4_backtest.cpp vs volarix4_backtest/engine.py
+
+The native CLI runs the signal pipeline in process and simulates the trades
+itself. These tests run it on a synthetic H1 series, then replay its signals
+through the Python BacktestEngine and BrokerSimulator (a stub API client
+answers each signal bar with the signal the native run traded) and require
+the same trades, P&L to the last bit, equity curve and summary counts.
+
+Requirements:
+- The native CLI built (see "Native Backtest Engine" in
+  volarix4_backtest/README.md)
+
+Run tests:
+    pytest tests/test_native_backtest.py -v
+
+Set VOLARIX4_BACKTEST_BIN if the binary is not in mt5_integration/.
+"""
+
+import sys
+import os
+import csv
+import json
+import random
+import subprocess
+import pytest
+from datetime import datetime, timedelta, timezone
+from pathlib import Path
+
+# Add parent directory to path
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from volarix4_backtest.api_client import SignalResponse
+from volarix4_backtest.broker_sim import BrokerSimulator
+from volarix4_backtest.config import BacktestConfig
+from volarix4_backtest.data_source import Bar, read_bar_file
+from volarix4_backtest.engine import BacktestEngine
+
+
+MT5_DIR = Path(__file__).parent.parent / "mt5_integration"
+BIN_PATH = Path(os.environ.get(
+    "VOLARIX4_BACKTEST_BIN",
+    MT5_DIR / ("volarix4_backtest.exe" if sys.platform == "win32" else "volarix4_backtest")
+))
+
+TIME_FORMAT = "%Y-%m-%d %H:%M:%S"
+
+
+def synthetic_bars(start, end, seed=7):
+    """Weekday H1 random walk with occasional drift changes."""
+    rng = random.Random(seed)
+    bars = []
+    t, price, drift = start, 1.10, 0
+    while t < end:
+        if t.weekday() < 5:
+            if rng.random() < 0.01:
+                drift = rng.choice([-1, 0, 1])
+            o = price
+            c = round(o + rng.gauss(drift * 0.00005, 0.0012), 5)
+            h = round(max(o, c) + abs(rng.gauss(0, 0.0006)), 5)
+            l = round(min(o, c) - abs(rng.gauss(0, 0.0006)), 5)
+            bars.append(Bar(time=t, open=o, high=h, low=l, close=c, volume=rng.randint(100, 2000)))
+            price = c
+        t += timedelta(hours=1)
+    return bars
+
+
+def write_csv(bars, path):
+    with open(path, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["time", "open", "high", "low", "close", "volume"])
+        for bar in bars:
+            writer.writerow([bar.time.strftime(TIME_FORMAT), repr(bar.open), repr(bar.high),
+                             repr(bar.low), repr(bar.close), bar.volume])
+
+
+class InMemoryDataSource:
+    def __init__(self, bars):
+        self._bars = bars
+
+    def load(self, file_path=None):
+        return self._bars
+
+
+class ReplayApiClient:
+    """Answers each signal bar with the signal the native run traded on it."""
+
+    def __init__(self, signals):
+        self.signals = signals
+        self.requests = 0
+
+    def get_signal_optimized(self, bar_time, **kwargs):
+        self.requests += 1
+        hold = SignalResponse("HOLD", 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.5, 0.3, 0.2, "replay")
+        return self.signals.get(bar_time, hold)
+
+
+@pytest.fixture(scope="module")
+def native_run(tmp_path_factory):
+    if not BIN_PATH.exists():
+        pytest.skip(f"Native backtest not built: {BIN_PATH}")
+
+    work = tmp_path_factory.mktemp("native_backtest")
+    bars = synthetic_bars(datetime(2023, 1, 2), datetime(2024, 1, 1))
+    write_csv(bars, work / "bars.csv")
+
+    config = {
+        "symbol": "EURUSD", "timeframe": "H1", "mode": "single",
+        "source": "csv", "file_path": str(work / "bars.csv"),
+        "lookback_bars": 400, "warmup_bars": 400, "fill_at": "next_open",
+        "output_dir": str(work / "out"),
+    }
+    (work / "config.json").write_text(json.dumps(config))
+
+    run = subprocess.run([str(BIN_PATH), str(work / "config.json")],
+                         capture_output=True, text=True, timeout=120)
+    assert run.returncode == 0, run.stderr
+
+    def read(suffix):
+        path = next((work / "out").glob(f"*_{suffix}"))
+        return path.read_text() if suffix.endswith(".txt") else list(csv.DictReader(open(path)))
+
+    return {
+        "bars": bars,
+        "config": config,
+        "trades": read("trades.csv"),
+        "equity": read("equity.csv"),
+        "summary": read("summary.txt"),
+    }
+
+
+@pytest.fixture(scope="module")
+def python_run(native_run):
+    bars = native_run["bars"]
+    index = {bar.time.strftime(TIME_FORMAT): i for i, bar in enumerate(bars)}
+
+    # next_open: the signal came from the bar before the entry bar
+    signals = {}
+    for t in native_run["trades"]:
+        signal_bar = bars[index[t["entry_time"]] - 1]
+        signals[signal_bar.time] = SignalResponse(
+            t["direction"], float(t["confidence"]), signal_bar.close, float(t["sl"]),
+            float(t["tp1"]), float(t["tp2"]), float(t["tp3"]), float(t["tp1_percent"]),
+            float(t["tp2_percent"]), float(t["tp3_percent"]), t["reason"])
+
+    config = BacktestConfig(**{k: v for k, v in native_run["config"].items() if k != "file_path"})
+    broker = BrokerSimulator(config.spread_pips, config.slippage_pips,
+                             config.commission_per_side_per_lot, config.usd_per_pip_per_lot)
+    client = ReplayApiClient(signals)
+    engine = BacktestEngine(config, InMemoryDataSource(bars), client, broker)
+    return engine.run()
+
+
+def test_trades_match_python_engine(native_run, python_run):
+    native = native_run["trades"]
+    assert len(native) > 20
+    assert len(native) == len(python_run["trades"])
+
+    for row, trade in zip(native, python_run["trades"]):
+        assert row["direction"] == trade.direction
+        assert row["entry_time"] == trade.entry_time.strftime(TIME_FORMAT)
+        assert row["exit_time"] == trade.exit_time.strftime(TIME_FORMAT)
+        assert row["exit_reason"] == trade.exit_reason.value
+        assert row["entry_price"] == repr(trade.entry_price)
+        assert row["exit_price"] == repr(trade.exit_price)
+        assert row["gross_pnl_usd"] == repr(trade.gross_pnl_usd)
+        assert row["net_pnl_usd"] == repr(trade.net_pnl_usd)
+        assert row["commission_usd"] == repr(trade.commission_usd)
+        for tp in ("tp1", "tp2", "tp3"):
+            assert row[f"{tp}_hit"] == str(getattr(trade, f"{tp}_hit"))
+
+
+def test_equity_curve_matches_python_engine(native_run, python_run):
+    native = native_run["equity"]
+    expected = python_run["equity_curve"]
+    assert len(native) == len(expected)
+    for row, point in zip(native, expected):
+        assert row["time"] == point["time"].strftime(TIME_FORMAT)
+        assert row["equity"] == repr(point["equity"])
+
+
+def test_summary_matches_python_engine(native_run, python_run):
+    summary = native_run["summary"]
+    assert f"Total Signals Generated: {python_run['total_signals']}\n" in summary
+    assert f"Total Trades: {python_run['total_trades']}\n" in summary
+    assert f"Win Rate: {python_run['win_rate'] * 100:.2f}%\n" in summary
+    assert f"Net Profit: ${python_run['net_profit_usd']:,.2f}\n" in summary
+    assert f"Profit Factor: {python_run['profit_factor']:.2f}\n" in summary
+    assert (f"Max Drawdown: ${python_run['max_drawdown_usd']:,.2f} "
+            f"({python_run['max_drawdown_pct']:.2f}%)\n") in summary
+    assert f"Final Balance: ${python_run['final_balance']:,.2f}\n" in summary
+
+
+def test_grid_search_matches_walk_forward(tmp_path):
+    """Every grid row scores like a separate walk-forward run with its values."""
+    if not BIN_PATH.exists():
+        pytest.skip(f"Native backtest not built: {BIN_PATH}")
+
+    write_csv(synthetic_bars(datetime(2022, 1, 3), datetime(2024, 1, 1), seed=11), tmp_path / "bars.csv")
+    config = {
+        "mode": "grid_search", "symbol": "EURUSD", "timeframe": "H1",
+        "source": "csv", "file_path": str(tmp_path / "bars.csv"),
+        "test_years": [2023], "train_years_lookback": 1,
+        "grid": {"min_confidence": [0.6, 0.8], "min_edge_pips": [1.5, 2.5]},
+        "objective": "aggregate_net_profit", "n_jobs": 2,
+        "output_dir": str(tmp_path / "out"),
+    }
+    (tmp_path / "grid.json").write_text(json.dumps(config))
+    run = subprocess.run([str(BIN_PATH), str(tmp_path / "grid.json")],
+                         capture_output=True, text=True, timeout=300)
+    assert run.returncode == 0, run.stderr
+
+    output = next((tmp_path / "out").glob("grid_search_*"))
+    rows = list(csv.DictReader(open(output / "grid_results.csv")))
+    assert len(rows) == 4
+    combos = {(row["param_min_confidence"], row["param_min_edge_pips"]) for row in rows}
+    assert combos == {("0.6", "1.5"), ("0.6", "2.5"), ("0.8", "1.5"), ("0.8", "2.5")}
+
+    best = json.loads((output / "best_params.json").read_text())
+    best_row = max(rows, key=lambda row: float(row["metric_aggregate_net_profit"]))
+    assert best == {"min_confidence": float(best_row["param_min_confidence"]),
+                    "min_edge_pips": float(best_row["param_min_edge_pips"])}
+
+    # The merged config is a plain walk-forward config with the best values
+    merged = json.loads((output / "best_merged_config.json").read_text())
+    assert merged["mode"] == "walk_forward" and "grid" not in merged
+    run = subprocess.run([str(BIN_PATH), str(output / "best_merged_config.json")],
+                         capture_output=True, text=True, timeout=120)
+    assert run.returncode == 0, run.stderr
+    assert f"Total Trades: {best_row['metric_total_trades']}\n" in run.stdout
+
+
+def test_bar_file_round_trip(native_run, tmp_path):
+    """--save-bars writes the CSV's bars; a run from the mapped file matches."""
+    config = dict(native_run["config"], output_dir=str(tmp_path / "out"))
+    (tmp_path / "config.json").write_text(json.dumps(config))
+    bar_file = tmp_path / "bars.v4bars"
+    run = subprocess.run([str(BIN_PATH), str(tmp_path / "config.json"), "--save-bars", str(bar_file)],
+                         capture_output=True, text=True, timeout=120)
+    assert run.returncode == 0, run.stderr
+
+    symbol, timeframe, columns = read_bar_file(str(bar_file))
+    assert (symbol, timeframe) == ("EURUSD", "H1")
+    bars = native_run["bars"]
+    assert columns["time"].tolist() == [int(b.time.replace(tzinfo=timezone.utc).timestamp()) for b in bars]
+    for field in ("open", "high", "low", "close"):
+        assert columns[field].tolist() == [getattr(b, field) for b in bars]
+    assert columns["volume"].tolist() == [float(b.volume) for b in bars]
+
+    run = subprocess.run([str(BIN_PATH), str(tmp_path / "config.json"), "--file", str(bar_file),
+                          "--output-dir", str(tmp_path / "mapped")],
+                         capture_output=True, text=True, timeout=120)
+    assert run.returncode == 0, run.stderr
+    trades = list(csv.DictReader(open(next((tmp_path / "mapped").glob("*_trades.csv")))))
+    assert trades == native_run["trades"]
+
+
+def test_monte_carlo_from_trade_list(native_run, tmp_path):
+    """Reshuffles and bootstraps of the run's trades, the same on any n_jobs."""
+    outputs = []
+    for n_jobs in (1, 3):
+        out = tmp_path / f"jobs{n_jobs}"
+        config = dict(native_run["config"], output_dir=str(out), n_jobs=n_jobs,
+                      monte_carlo_simulations=500, bootstrap_samples=300, monte_carlo_seed=7)
+        (tmp_path / "config.json").write_text(json.dumps(config))
+        run = subprocess.run([str(BIN_PATH), str(tmp_path / "config.json")],
+                             capture_output=True, text=True, timeout=120)
+        assert run.returncode == 0, run.stderr
+        outputs.append((next(out.glob("*_monte_carlo.txt")).read_text(),
+                        list(csv.DictReader(open(next(out.glob("*_mc_bands.csv")))))))
+    assert outputs[0] == outputs[1]
+    report, bands = outputs[0]
+
+    # monte_carlo_reshuffle's drawdown: the peak starts at the first trade
+    pnl = [float(t["net_pnl_usd"]) for t in native_run["trades"]]
+    equity, peak, observed = 0.0, None, 0.0
+    for value in pnl:
+        equity += value
+        peak = equity if peak is None else max(peak, equity)
+        observed = max(observed, peak - equity)
+    assert f"Observed Max DD: ${observed:,.2f}\n" in report
+    assert "TRADE ORDER RESHUFFLE (N=500)" in report and "BOOTSTRAP RESAMPLE (N=300)" in report
+    assert f"P(final PnL < 0): {100.0 if equity < 0 else 0.0:.1f}%\n" in report
+
+    percentiles = ("p5", "p25", "p50", "p75", "p95")
+    for method in ("permutation", "bootstrap"):
+        rows = [row for row in bands if row["method"] == method]
+        assert int(rows[-1]["trades"]) == len(pnl)
+        for row in rows:
+            for series in ("equity", "drawdown"):
+                values = [float(row[f"{series}_{p}"]) for p in percentiles]
+                assert values == sorted(values)
+
+    # Every permutation ends on the same balance
+    last = next(row for row in reversed(bands) if row["method"] == "permutation")
+    for p in percentiles:
+        assert float(last[f"equity_{p}"]) == pytest.approx(10000.0 + equity)
+
+
+def test_tick_replay_exits(native_run, tmp_path):
+    """Ticks at each bar open replay as open_only; .v4ticks runs as its CSV."""
+    tick_csv = tmp_path / "ticks.csv"
+    with open(tick_csv, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["time", "bid", "ask"])
+        for bar in native_run["bars"]:
+            writer.writerow([bar.time.strftime(TIME_FORMAT), repr(bar.open), repr(bar.open)])
+
+    def run_exits(name, *args, **settings):
+        out = tmp_path / name
+        config = dict(native_run["config"], output_dir=str(out), **settings)
+        (tmp_path / "config.json").write_text(json.dumps(config))
+        run = subprocess.run([str(BIN_PATH), str(tmp_path / "config.json"), *args],
+                             capture_output=True, text=True, timeout=120)
+        assert run.returncode == 0, run.stderr
+        return run, list(csv.DictReader(open(next(out.glob("*_trades.csv")))))
+
+    _, open_only = run_exits("open_only", exit_model="open_only")
+    tick_file = tmp_path / "ticks.v4ticks"
+    run, replayed = run_exits("csv", "--save-ticks", str(tick_file), exit_model="ticks", tick_file=str(tick_csv))
+    assert replayed == open_only
+    assert "0 bars without ticks" in run.stdout
+
+    _, mapped = run_exits("mapped", exit_model="ticks", tick_file=str(tick_file))
+    assert mapped == replayed
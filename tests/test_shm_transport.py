@@ -0,0 +1,179 @@
+"""
+Shared-Memory Transport Tests - shm:// ring between the bridge and the API
+
+The slot protocol tests drive ShmRing over a plain bytearray, writing the
+client side exactly as bridge/shm_transport.h lays it out, so they run on
+any platform. The end-to-end test serves a named ring with ShmSignalServer
+and sends GetVolarix4Signal through Volarix4Bridge.dll with an shm:// URL.
+
+Requirements (end-to-end test only):
+- Windows with Volarix4Bridge.dll built (see mt5_integration/README_MT5.md)
+
+Run tests:
+    pytest tests/test_shm_transport.py -v
+
+Set VOLARIX4_BRIDGE_DLL if the DLL is not in mt5_integration/.
+"""
+
+import sys
+import os
+import json
+import struct
+import asyncio
+import ctypes
+import threading
+import pytest
+from pathlib import Path
+
+# Add parent directory to path
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from volarix4.utils.shm_transport import (
+    HEADER_BYTES,
+    MAGIC,
+    SLOT_HEADER_BYTES,
+    ShmRing,
+    ShmSignalServer,
+)
+
+
+DLL_PATH = Path(os.environ.get(
+    "VOLARIX4_BRIDGE_DLL",
+    Path(__file__).parent.parent / "mt5_integration" / "Volarix4Bridge.dll"
+))
+
+SLOT_COUNT = 4
+SLOT_BYTES = 1024
+
+
+def make_ring():
+    buffer = bytearray(ShmRing.size(SLOT_COUNT, SLOT_BYTES))
+    ring = ShmRing(buffer, SLOT_COUNT, SLOT_BYTES)
+    ring.initialize()
+    return buffer, ring
+
+
+def client_submit(buffer, index, path, body):
+    """Write a request the way the bridge does (body first, request_seq last)."""
+    base = HEADER_BYTES + index * SLOT_BYTES
+    seq = struct.unpack_from("<I", buffer, base + 4)[0] + 1
+    struct.pack_into("<I", buffer, base + 24, len(path))
+    buffer[base + 32:base + 32 + len(path)] = path.encode()
+    buffer[base + SLOT_HEADER_BYTES:base + SLOT_HEADER_BYTES + len(body)] = body
+    struct.pack_into("<I", buffer, base + 12, len(body))
+    struct.pack_into("<I", buffer, base + 4, seq)
+    return seq
+
+
+def client_response(buffer, index):
+    """(response_seq, status, body) as the bridge reads them."""
+    base = HEADER_BYTES + index * SLOT_BYTES
+    seq = struct.unpack_from("<I", buffer, base + 8)[0]
+    length, status = struct.unpack_from("<II", buffer, base + 16)
+    data = base + SLOT_HEADER_BYTES
+    return seq, status, bytes(buffer[data:data + length])
+
+
+def test_header_matches_bridge_layout():
+    buffer, _ = make_ring()
+    magic, version, slot_count, slot_bytes = struct.unpack_from("<IIII", buffer, 0)
+    assert magic == MAGIC
+    assert version == 1
+    assert (slot_count, slot_bytes) == (SLOT_COUNT, SLOT_BYTES)
+
+
+def test_request_round_trip():
+    buffer, ring = make_ring()
+    assert ring.pending() == []
+
+    body = b'{"symbol":"EURUSD","timeframe":"H1","bar_time":1700000000}'
+    seq = client_submit(buffer, 2, "/signal", body)
+    assert ring.pending() == [2]
+
+    read_seq, path, read_body = ring.read_request(2)
+    assert (read_seq, path, read_body) == (seq, "/signal", body)
+
+    ring.write_response(2, read_seq, 200, b'{"signal":"HOLD"}')
+    assert ring.pending() == []
+    assert client_response(buffer, 2) == (seq, 200, b'{"signal":"HOLD"}')
+
+    # The slot is reusable: the next request on it bumps the sequence again
+    seq2 = client_submit(buffer, 2, "/signal/batch", b"{}")
+    assert seq2 == seq + 1
+    assert ring.pending() == [2]
+
+
+def test_initialize_drops_unanswered_requests():
+    buffer, ring = make_ring()
+    client_submit(buffer, 0, "/signal", b"{}")
+    client_submit(buffer, 3, "/signal", b"{}")
+    assert ring.pending() == [0, 3]
+
+    # A restarted server re-attaches to the mapping and starts clean
+    ShmRing(buffer, SLOT_COUNT, SLOT_BYTES).initialize()
+    assert ring.pending() == []
+
+
+def test_oversized_response_becomes_error():
+    buffer, ring = make_ring()
+    seq = client_submit(buffer, 1, "/signal", b"{}")
+    ring.write_response(1, seq, 200, b"x" * SLOT_BYTES)
+
+    response_seq, status, body = client_response(buffer, 1)
+    assert response_seq == seq
+    assert status == 500
+    assert json.loads(body)["error"] == "Response too large for shared memory slot"
+
+
+def test_signal_through_bridge_dll():
+    """GetVolarix4Signal with apiUrl shm://<name> answered by ShmSignalServer."""
+    if sys.platform != "win32":
+        pytest.skip("Shared-memory transport is Windows-only")
+    if not DLL_PATH.exists():
+        pytest.skip(f"Bridge DLL not found: {DLL_PATH}")
+
+    bridge = ctypes.WinDLL(str(DLL_PATH))
+    bridge.GetVolarix4Signal.restype = ctypes.c_void_p
+    bridge.GetVolarix4Signal.argtypes = [
+        ctypes.c_wchar_p, ctypes.c_wchar_p, ctypes.c_longlong, ctypes.c_int, ctypes.c_wchar_p,
+    ] + [ctypes.c_double] * 9
+    bridge.SetVolarix4ResponseCache.argtypes = [ctypes.c_int, ctypes.c_wchar_p]
+    bridge.SetVolarix4ResponseCache(0, "")
+    oleaut32 = ctypes.WinDLL("oleaut32")
+    oleaut32.SysFreeString.argtypes = [ctypes.c_void_p]
+
+    seen = []
+    answer = {"signal": "HOLD", "confidence": 0.0, "entry": 0.0, "sl": 0.0, "tp1": 0.0,
+              "tp2": 0.0, "tp3": 0.0, "tp1_percent": 0.5, "tp2_percent": 0.3,
+              "tp3_percent": 0.2, "reason": "No significant S/R levels detected"}
+
+    async def dispatch(path, body):
+        seen.append((path, json.loads(body)))
+        return 200, json.dumps(answer, separators=(",", ":")).encode()
+
+    loop = asyncio.new_event_loop()
+    loop_thread = threading.Thread(target=loop.run_forever, daemon=True)
+    loop_thread.start()
+
+    server = ShmSignalServer(f"pytest{os.getpid()}", dispatch, loop)
+    server.start()
+    try:
+        ptr = bridge.GetVolarix4Signal(
+            "EURUSD", "H1", 1700000000, 400, f"shm://{server.name}",
+            0.60, 48.0, 15.0, 4.0, 1.0, 0.5, 7.0, 10.0, 1.0)
+        try:
+            response = json.loads(ctypes.wstring_at(ptr))
+        finally:
+            oleaut32.SysFreeString(ptr)
+    finally:
+        server.stop()
+        loop.call_soon_threadsafe(loop.stop)
+        loop_thread.join(timeout=2.0)
+
+    assert response == answer
+    assert len(seen) == 1
+    path, request = seen[0]
+    assert path == "/signal"
+    assert request["symbol"] == "EURUSD"
+    assert request["bar_time"] == 1700000000
+    assert server.requests_served == 1
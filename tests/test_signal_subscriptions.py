@@ -0,0 +1,136 @@
+"""
+Signal Subscription Tests - SubscriptionHub behind /signal/subscribe and /signal/poll
+
+The hub is driven directly (the scheduler's pending_work/publish calls and
+the bridge's subscribe/poll calls), so no server or MT5 terminal is needed.
+
+Run tests:
+    pytest tests/test_signal_subscriptions.py -v
+"""
+
+import sys
+import os
+import asyncio
+import pytest
+
+# Add parent directory to path
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from volarix4.utils.signal_subscriptions import SubscriptionHub
+
+
+PARAMS = {"lookback_bars": 400, "min_confidence": 0.6, "spread_pips": 1.0}
+RESPONSE = {"signal": "HOLD", "confidence": 0.0, "reason": "No rejection candle"}
+
+
+class FakeClock:
+    def __init__(self):
+        self.now = 1000.0
+
+    def __call__(self):
+        return self.now
+
+
+def test_subscribe_is_idempotent():
+    hub = SubscriptionHub()
+    subscriber, stream = hub.subscribe(None, "EURUSD", "h1", PARAMS)
+    assert hub.subscribe(subscriber, "EURUSD", "H1", dict(PARAMS)) == (subscriber, stream)
+
+    _, other = hub.subscribe(subscriber, "EURUSD", "H1", dict(PARAMS, spread_pips=2.0))
+    assert other != stream
+    assert hub.stats()["streams"] == 2
+
+    # An unknown id (server restart) starts a new subscriber
+    renewed, _ = hub.subscribe("not-a-subscriber", "EURUSD", "H1", PARAMS)
+    assert renewed not in (subscriber, "not-a-subscriber")
+
+
+def test_one_pipeline_run_per_param_set():
+    hub = SubscriptionHub()
+    a, a_stream = hub.subscribe(None, "EURUSD", "H1", PARAMS)
+    b, b_stream = hub.subscribe(None, "EURUSD", "H1", dict(PARAMS))
+    c, _ = hub.subscribe(None, "EURUSD", "H1", dict(PARAMS, min_confidence=0.7))
+    hub.subscribe(None, "GBPUSD", "H1", PARAMS)
+    assert hub.groups() == [("EURUSD", "H1"), ("GBPUSD", "H1")]
+
+    work = hub.pending_work("EURUSD", "H1", 1700000000)
+    assert len(work) == 2
+    params, targets = next(w for w in work if w[0] == PARAMS)
+    assert sorted(targets) == sorted([(a, a_stream), (b, b_stream)])
+
+    assert hub.publish(targets, 1700000000, RESPONSE) == 2
+    # Served streams wait for the next bar, the other param set is still due
+    assert [p for p, _ in hub.pending_work("EURUSD", "H1", 1700000000)] == [dict(PARAMS, min_confidence=0.7)]
+    assert len(hub.pending_work("EURUSD", "H1", 1700003600)) == 2
+
+
+def test_poll_returns_and_acknowledges_events():
+    hub = SubscriptionHub()
+    subscriber, stream = hub.subscribe(None, "EURUSD", "H1", PARAMS)
+    hub.publish([(subscriber, stream)], 1700000000, RESPONSE)
+    hub.publish([(subscriber, stream)], 1700003600, RESPONSE)
+
+    events = asyncio.run(hub.poll(subscriber, 0, timeout=0))
+    assert [e["seq"] for e in events] == [1, 2]
+    assert events[0]["stream_id"] == stream
+    assert events[0]["bar_time"] == 1700000000
+    assert events[0]["response"] == RESPONSE
+
+    # A lost response is repeated until the client acknowledges it
+    assert len(asyncio.run(hub.poll(subscriber, 0, timeout=0))) == 2
+    assert [e["seq"] for e in asyncio.run(hub.poll(subscriber, 1, timeout=0))] == [2]
+    assert asyncio.run(hub.poll(subscriber, 2, timeout=0)) == []
+    assert asyncio.run(hub.poll("unknown", 0, timeout=0)) is None
+
+
+def test_publish_wakes_a_waiting_poll():
+    hub = SubscriptionHub()
+    subscriber, stream = hub.subscribe(None, "EURUSD", "H1", PARAMS)
+
+    async def scenario():
+        poll = asyncio.ensure_future(hub.poll(subscriber, 0, timeout=5.0))
+        await asyncio.sleep(0.01)
+        assert not poll.done()
+        assert hub.stats()["polling"] == 1
+        hub.publish([(subscriber, stream)], 1700000000, RESPONSE)
+        return await asyncio.wait_for(poll, 1.0)
+
+    events = asyncio.run(scenario())
+    assert [e["seq"] for e in events] == [1]
+
+    # Nothing published: the poll times out empty
+    assert asyncio.run(hub.poll(subscriber, 1, timeout=0.01)) == []
+
+
+def test_unsubscribe_and_expiry():
+    clock = FakeClock()
+    hub = SubscriptionHub(idle_seconds=60.0, clock=clock)
+    subscriber, stream = hub.subscribe(None, "EURUSD", "H1", PARAMS)
+    _, other = hub.subscribe(subscriber, "USDJPY", "M15", PARAMS)
+
+    assert hub.unsubscribe(subscriber, stream)
+    assert not hub.unsubscribe(subscriber, stream)
+    assert hub.groups() == [("USDJPY", "M15")]
+    assert hub.publish([(subscriber, stream)], 1700000000, RESPONSE) == 0
+
+    idle, _ = hub.subscribe(None, "EURUSD", "H1", PARAMS)
+    clock.now += 30
+    asyncio.run(hub.poll(subscriber, 0, timeout=0))
+    clock.now += 45
+    assert hub.expire() == 1
+    assert asyncio.run(hub.poll(idle, 0, timeout=0)) is None
+    assert hub.groups() == [("USDJPY", "M15")]
+
+    assert hub.unsubscribe(subscriber)
+    assert not hub.has_streams()
+    assert hub.stats()["subscribers"] == 0
+
+
+def test_event_queue_is_bounded():
+    hub = SubscriptionHub(max_events=3)
+    subscriber, stream = hub.subscribe(None, "EURUSD", "M1", PARAMS)
+    for i in range(5):
+        hub.publish([(subscriber, stream)], 1700000000 + 60 * i, RESPONSE)
+
+    events = asyncio.run(hub.poll(subscriber, 0, timeout=0))
+    assert [e["seq"] for e in events] == [3, 4, 5]
@@ -2,25 +2,35 @@
 
 from fastapi import FastAPI, Request, status
 from fastapi.exceptions import RequestValidationError
+from fastapi.middleware.gzip import GZipMiddleware
 from fastapi.responses import JSONResponse
-from pydantic import BaseModel
+from pydantic import BaseModel, ValidationError
 from typing import Literal
 import MetaTrader5 as mt5
+import asyncio
 import json
+import sys
 import time
 import pandas as pd
 
 # Package imports
-from volarix4.core.data import is_valid_session
+from volarix4.core.data import is_valid_session, latest_bar_time
 from volarix4.core.sr_levels import detect_sr_levels
 from volarix4.core.rejection import find_rejection_candle
 from volarix4.core.trade_setup import calculate_trade_setup
 from volarix4.core.trend_filter import detect_trend, validate_signal_with_trend
 from volarix4.core.sr_validation import SRLevelValidator
 from volarix4.utils.helpers import calculate_pip_value
-from volarix4.config import SR_CONFIG, REJECTION_CONFIG, RISK_CONFIG, BACKTEST_PARITY_CONFIG
+from volarix4.config import SR_CONFIG, REJECTION_CONFIG, RISK_CONFIG, BACKTEST_PARITY_CONFIG, SHM_TRANSPORT_NAME
+from volarix4.config import MAX_DECODED_BODY_BYTES, RESPONSE_GZIP_MIN_BYTES
+from volarix4.config import SUBSCRIPTION_CHECK_SECONDS, SUBSCRIPTION_MAX_POLL_SECONDS, SUBSCRIPTION_IDLE_SECONDS
 from volarix4.utils.logger import setup_logger, log_signal_details
 from volarix4.utils.monitor import monitor
+from volarix4.utils.bar_stream import BarStreamStore
+from volarix4.utils.shm_transport import ShmSignalServer
+from volarix4.utils.bar_codec import BINARY_BARS_CONTENT_TYPE, BarDecodeError, decode_binary_bars
+from volarix4.utils.content_encoding import ContentEncodingMiddleware
+from volarix4.utils.signal_subscriptions import SubscriptionHub
 from volarix4.utils.bar_validation import (
     normalize_and_validate_bars,
     log_bar_validation_summary,
@@ -35,6 +45,17 @@ logger = setup_logger("volarix4", level="INFO")
 from datetime import datetime, timedelta
 _signal_cooldown_tracker = {}
 
+# Incremental bar push ring buffers (/signal/stream)
+_bar_streams = BarStreamStore()
+
+# Same-host shared-memory endpoint (shm://<SHM_TRANSPORT_NAME>), if enabled
+_shm_server = None
+
+# Pushed signals (/signal/subscribe, /signal/poll) and the task that serves
+# them on every new candle
+_subscriptions = SubscriptionHub(idle_seconds=SUBSCRIPTION_IDLE_SECONDS)
+_subscription_task = None
+
 
 class OHLCVBar(BaseModel):
     """OHLCV bar data"""
@@ -76,6 +97,95 @@ class SignalRequest(BaseModel):
     lot_size: float | None = None
 
 
+class BatchSignalItem(BaseModel):
+    """One symbol/timeframe/bar entry of a batched signal request"""
+    symbol: str
+    timeframe: str
+    bar_time: int  # Unix timestamp of bar to generate signal for
+
+
+class BatchSignalRequest(BaseModel):
+    """Request schema for /signal/batch (one entry per symbol, shared params)"""
+    requests: list[BatchSignalItem]
+    lookback_bars: int = 400
+
+    # Strategy parameters (shared by every entry)
+    min_confidence: float | None = None
+    broken_level_cooldown_hours: float | None = None
+    broken_level_break_pips: float | None = None
+    min_edge_pips: float | None = None
+
+    # Cost model parameters (shared by every entry)
+    spread_pips: float | None = None
+    slippage_pips: float | None = None
+    commission_per_side_per_lot: float | None = None
+    usd_per_pip_per_lot: float | None = None
+    lot_size: float | None = None
+
+
+class StreamSignalRequest(BaseModel):
+    """Request schema for /signal/stream (incremental bar push)"""
+    client_id: str = ""  # Pushing bridge instance: streams are per (client_id, symbol, timeframe)
+    symbol: str
+    timeframe: str
+    seq: int  # Push sequence number (1 on reset, then +1 per push)
+    reset: bool = False  # True = bars hold the full window (resync)
+    bars: list[OHLCVBar] = []  # Bars newer than the previous push, oldest first
+    lookback_bars: int = 400  # Window size kept by the server
+
+    # Strategy parameters (optional - same defaults as /signal)
+    min_confidence: float | None = None
+    broken_level_cooldown_hours: float | None = None
+    broken_level_break_pips: float | None = None
+    min_edge_pips: float | None = None
+
+    # Cost model parameters (optional - same defaults as /signal)
+    spread_pips: float | None = None
+    slippage_pips: float | None = None
+    commission_per_side_per_lot: float | None = None
+    usd_per_pip_per_lot: float | None = None
+    lot_size: float | None = None
+
+
+class SubscriptionStream(BaseModel):
+    """One pushed-signal stream: a /signal request without the bar_time"""
+    symbol: str
+    timeframe: str
+    lookback_bars: int = 400
+
+    # Strategy parameters (optional - same defaults as /signal)
+    min_confidence: float | None = None
+    broken_level_cooldown_hours: float | None = None
+    broken_level_break_pips: float | None = None
+    min_edge_pips: float | None = None
+
+    # Cost model parameters (optional - same defaults as /signal)
+    spread_pips: float | None = None
+    slippage_pips: float | None = None
+    commission_per_side_per_lot: float | None = None
+    usd_per_pip_per_lot: float | None = None
+    lot_size: float | None = None
+
+
+class SubscribeRequest(BaseModel):
+    """Request schema for /signal/subscribe"""
+    subscriber_id: str | None = None  # None (or unknown) = start a new subscriber
+    stream: SubscriptionStream
+
+
+class UnsubscribeRequest(BaseModel):
+    """Request schema for /signal/unsubscribe"""
+    subscriber_id: str
+    stream_id: int | None = None  # None = every stream of the subscriber
+
+
+class PollRequest(BaseModel):
+    """Request schema for /signal/poll"""
+    subscriber_id: str
+    after_seq: int = 0  # Highest event seq already taken (acknowledged)
+    timeout_ms: int = 20000  # Wait this long for an event (capped)
+
+
 class SignalResponse(BaseModel):
     """Response schema matching Volarix 3"""
     signal: Literal["BUY", "SELL", "HOLD"]
@@ -176,14 +286,17 @@ def create_app() -> FastAPI:
         if request.method == "POST":
             try:
                 body = await request.body()
-                body_str = body.decode('utf-8')
-                logger.debug(f"  Request Body: {body_str}")
 
                 # Reset body for actual handler
                 async def receive():
                     return {"type": "http.request", "body": body}
                 request._receive = receive
 
+                if request.headers.get("content-type", "").startswith(BINARY_BARS_CONTENT_TYPE):
+                    logger.debug(f"  Request Body: <{len(body)} bytes binary bars>")
+                else:
+                    logger.debug(f"  Request Body: {body.decode('utf-8', errors='replace')}")
+
             except Exception as e:
                 logger.debug(f"  Could not read body: {e}")
 
@@ -195,9 +308,16 @@ def create_app() -> FastAPI:
 
         return response
 
+    # Compression. Added after the request logger, so both wrap it: bodies
+    # are decoded before it reads them, responses gzipped after it logs them.
+    if RESPONSE_GZIP_MIN_BYTES > 0:
+        app.add_middleware(GZipMiddleware, minimum_size=RESPONSE_GZIP_MIN_BYTES)
+    app.add_middleware(ContentEncodingMiddleware, max_bytes=MAX_DECODED_BODY_BYTES)
+
     @app.on_event("startup")
     async def startup_event():
-        """Initialize MT5 connection and pre-load S/R cache on startup"""
+        """Initialize MT5 connection, pre-load S/R cache and start the subscription scheduler on startup"""
+        global _subscription_task
         try:
             print("[STARTUP] Starting Volarix 4 API...", flush=True)
             logger.info("Starting Volarix 4 API...")
@@ -263,6 +383,11 @@ def create_app() -> FastAPI:
             print("=" * 70 + "\n")
             print(flush=True)
 
+            if SHM_TRANSPORT_NAME:
+                start_shm_transport()
+
+            _subscription_task = asyncio.create_task(run_subscription_scheduler())
+
             print("[STARTUP] Startup event completing...", flush=True)
             logger.info("Startup event completed successfully")
             print("[STARTUP] ✓ Startup event completed successfully\n", flush=True)
@@ -275,19 +400,22 @@ def create_app() -> FastAPI:
 
     @app.on_event("shutdown")
     async def shutdown_event():
-        """Close MT5 connection on shutdown"""
+        """Close MT5 connection, the shared-memory transport and the subscription scheduler on shutdown"""
+        global _shm_server, _subscription_task
         logger.info("Shutting down Volarix 4 API...")
+        if _subscription_task is not None:
+            _subscription_task.cancel()
+            _subscription_task = None
+        if _shm_server is not None:
+            _shm_server.stop()
+            _shm_server = None
         if mt5.terminal_info():
             mt5.shutdown()
             logger.info("MT5 connection closed")
 
-    @app.post("/signal", response_model=SignalResponse)
-    async def generate_signal(request: SignalRequest) -> SignalResponse:
+    async def run_signal_pipeline(request: SignalRequest, bars: list[dict] | None = None) -> SignalResponse:
         """
-        Generate trading signal from OHLCV data.
-
-        This endpoint matches Volarix 3 API for drop-in compatibility.
-        Volarix 4 uses pure S/R bounce strategy (no ML models).
+        Signal pipeline shared by /signal, /signal/batch and /signal/bars.
 
         Pipeline:
         1. Convert OHLCV data to DataFrame
@@ -298,6 +426,8 @@ def create_app() -> FastAPI:
 
         Args:
             request: SignalRequest with symbol, timeframe, OHLCV bars
+            bars: Bars already decoded to dicts (binary upload). When given,
+                  bar_time fetching and request.data are skipped.
 
         Returns:
             SignalResponse with trading signal and risk parameters
@@ -334,8 +464,15 @@ def create_app() -> FastAPI:
             logger.info(f"  lot_size: {lot_size}")
             logger.info("=" * 70)
 
-            # Determine if we're using the new optimized approach (bar_time) or legacy (data array)
-            if request.bar_time is not None:
+            # Determine if we're using a binary upload, the new optimized approach (bar_time) or legacy (data array)
+            if bars is not None:
+                # Bars already decoded (binary upload or stream ring buffer)
+                logger.info("PROVIDED BARS MODE: Using pre-decoded bars (binary upload / stream)")
+                bars_dict = bars
+                exec_bar_count = len(bars_dict)
+                mode = "Single-TF (Pre-decoded bars)"
+
+            elif request.bar_time is not None:
                 # New optimized approach: fetch bars using Python
                 logger.info("=" * 70)
                 logger.info("OPTIMIZED MODE: Fetching bars from MT5 using Python")
@@ -1019,6 +1156,333 @@ def create_app() -> FastAPI:
             duration = time.time() - start_time
             print(f"[/signal] Request processed in {duration:.3f}s")
 
+    @app.post("/signal", response_model=SignalResponse)
+    async def generate_signal(request: SignalRequest) -> SignalResponse:
+        """
+        Generate trading signal from OHLCV data.
+
+        This endpoint matches Volarix 3 API for drop-in compatibility.
+        Volarix 4 uses pure S/R bounce strategy (no ML models).
+
+        Args:
+            request: SignalRequest with symbol, timeframe, OHLCV bars
+
+        Returns:
+            SignalResponse with trading signal and risk parameters
+        """
+        return await run_signal_pipeline(request)
+
+    @app.post("/signal/bars", response_model=SignalResponse)
+    async def generate_signal_binary(request: Request) -> SignalResponse:
+        """
+        Generate trading signal from a binary bar upload.
+
+        Fast path for the bridge's GetVolariXSignalWithBarsBinary: the body
+        (Content-Type: application/x-volarix-bars) is a small header with
+        symbol/timeframe/counts followed by packed little-endian bar records,
+        decoded with numpy instead of parsing JSON. Strategy and cost
+        parameters use the BACKTEST_PARITY_CONFIG defaults.
+
+        Args:
+            request: Raw request carrying the binary payload
+
+        Returns:
+            SignalResponse with trading signal and risk parameters
+        """
+        content_type = request.headers.get("content-type", "")
+        if not content_type.startswith(BINARY_BARS_CONTENT_TYPE):
+            return JSONResponse(
+                status_code=status.HTTP_415_UNSUPPORTED_MEDIA_TYPE,
+                content={
+                    "error": "Unsupported Media Type",
+                    "message": f"Expected Content-Type {BINARY_BARS_CONTENT_TYPE}, got '{content_type}'"
+                }
+            )
+
+        try:
+            decoded = decode_binary_bars(await request.body())
+        except BarDecodeError as e:
+            logger.error(f"Binary bar decode failed: {e}")
+            return JSONResponse(
+                status_code=status.HTTP_400_BAD_REQUEST,
+                content={"error": "Binary Decode Failed", "message": str(e)}
+            )
+
+        signal_request = SignalRequest(
+            symbol=decoded["symbol"],
+            timeframe=decoded["timeframe"],
+            context_timeframe=decoded["context_timeframe"] or None,
+            model_type="statistical"
+        )
+        if decoded["context_bars"]:
+            logger.warning(
+                f"Binary upload carried {len(decoded['context_bars'])} context bars "
+                f"({decoded['context_timeframe']}) - ignored, Volarix 4 is single-TF"
+            )
+
+        return await run_signal_pipeline(signal_request, bars=decoded["bars"])
+
+    @app.post("/signal/stream", response_model=SignalResponse)
+    async def generate_signal_stream(request: StreamSignalRequest) -> SignalResponse:
+        """
+        Generate trading signal from an incremental bar push.
+
+        The bridge sends only bars newer than its previous push; the server
+        appends them to the ring buffer of (client_id, symbol, timeframe)
+        and runs the /signal pipeline on the buffered window. An
+        out-of-sequence push returns 409 ("Stream resync required") and the
+        bridge resends the full window with reset=true.
+
+        Args:
+            request: StreamSignalRequest with sequence number and new bars
+
+        Returns:
+            SignalResponse with trading signal and risk parameters
+        """
+        MIN_BARS_REQUIRED = 200
+        capacity = max(request.lookback_bars, MIN_BARS_REQUIRED)
+
+        window = _bar_streams.apply(
+            symbol=request.symbol,
+            timeframe=request.timeframe,
+            seq=request.seq,
+            reset=request.reset,
+            bars=[bar.dict() for bar in request.bars],
+            capacity=capacity,
+            client_id=request.client_id
+        )
+
+        if window is None:
+            expected = _bar_streams.expected_seq(request.symbol, request.timeframe, request.client_id)
+            logger.warning(
+                f"Stream {request.symbol} {request.timeframe} out of step: "
+                f"got seq {request.seq}, expected {expected if expected is not None else 'reset'}"
+            )
+            return JSONResponse(
+                status_code=status.HTTP_409_CONFLICT,
+                content={
+                    "error": "Stream resync required",
+                    "message": f"Got seq {request.seq}, expected {expected if expected is not None else 'a reset'}",
+                    "expected_seq": expected
+                }
+            )
+
+        logger.info(
+            f"Stream push: {request.symbol} {request.timeframe} seq={request.seq} "
+            f"{'(reset) ' if request.reset else ''}+{len(request.bars)} bars -> window {len(window)}"
+        )
+
+        signal_request = SignalRequest(**request.dict(exclude={"client_id", "seq", "reset", "bars"}))
+        return await run_signal_pipeline(signal_request, bars=window)
+
+    @app.post("/signal/batch", response_model=list[SignalResponse])
+    async def generate_signal_batch(batch: BatchSignalRequest) -> list[SignalResponse]:
+        """
+        Generate signals for several symbols in one round-trip.
+
+        Each entry runs through the same pipeline as POST /signal (optimized
+        bar_time mode) with the batch's shared strategy and cost parameters.
+        Results are returned in request order. Entries that fail bar
+        validation come back as HOLD with the validation message as reason.
+
+        Args:
+            batch: BatchSignalRequest with per-symbol entries and shared params
+
+        Returns:
+            List of SignalResponse, one per entry
+        """
+        start_time = time.time()
+        shared_params = batch.dict(exclude={"requests"})
+        results = []
+
+        for item in batch.requests:
+            signal_request = SignalRequest(
+                symbol=item.symbol,
+                timeframe=item.timeframe,
+                bar_time=item.bar_time,
+                **shared_params
+            )
+            response = await generate_signal(signal_request)
+
+            if isinstance(response, JSONResponse):
+                error = json.loads(response.body)
+                response = SignalResponse(
+                    signal="HOLD",
+                    confidence=0.0,
+                    entry=0.0,
+                    sl=0.0,
+                    tp1=0.0,
+                    tp2=0.0,
+                    tp3=0.0,
+                    tp1_percent=RISK_CONFIG["tp1_percent"],
+                    tp2_percent=RISK_CONFIG["tp2_percent"],
+                    tp3_percent=RISK_CONFIG["tp3_percent"],
+                    reason=f"{error.get('error', 'Error')}: {error.get('message', '')}"
+                )
+
+            results.append(response)
+
+        duration = time.time() - start_time
+        print(f"[/signal/batch] {len(results)} signals processed in {duration:.3f}s")
+        return results
+
+    @app.post("/signal/subscribe")
+    async def subscribe_signal(request: SubscribeRequest):
+        """
+        Register a pushed-signal stream.
+
+        From the next candle of the stream's symbol/timeframe on, the
+        subscription scheduler runs the /signal pipeline as soon as the
+        candle opens and queues the response for /signal/poll - once per
+        distinct parameter set, however many subscribers share it.
+
+        Args:
+            request: SubscribeRequest with the subscriber id (None on first
+                     use) and the stream's symbol, timeframe and params
+
+        Returns:
+            {"subscriber_id", "stream_id"} - a new subscriber_id when the
+            one sent is unknown (its other streams must be registered again)
+        """
+        params = request.stream.dict(exclude={"symbol", "timeframe"})
+        subscriber_id, stream_id = _subscriptions.subscribe(
+            request.subscriber_id, request.stream.symbol, request.stream.timeframe, params
+        )
+        logger.info(
+            f"Subscribed {request.stream.symbol} {request.stream.timeframe} "
+            f"(subscriber {subscriber_id[:8]}, stream {stream_id})"
+        )
+        return {"subscriber_id": subscriber_id, "stream_id": stream_id}
+
+    @app.post("/signal/unsubscribe")
+    async def unsubscribe_signal(request: UnsubscribeRequest):
+        """Drop one stream, or the subscriber with all its streams."""
+        removed = _subscriptions.unsubscribe(request.subscriber_id, request.stream_id)
+        return {"subscriber_id": request.subscriber_id, "removed": removed}
+
+    @app.post("/signal/poll")
+    async def poll_signals(request: PollRequest):
+        """
+        Long-poll for pushed signals.
+
+        Returns at once if events newer than after_seq are queued, otherwise
+        when the first one arrives or after timeout_ms (an empty list).
+        Events up to after_seq are acknowledged and dropped.
+
+        Args:
+            request: PollRequest with the subscriber id, the highest seq
+                     taken so far and the wait in milliseconds
+
+        Returns:
+            {"subscriber_id", "signals": [{seq, stream_id, symbol, timeframe,
+            bar_time, response}]}, or 404 for an unknown subscriber
+        """
+        timeout = min(max(request.timeout_ms, 0) / 1000.0, SUBSCRIPTION_MAX_POLL_SECONDS)
+        events = await _subscriptions.poll(request.subscriber_id, request.after_seq, timeout)
+        if events is None:
+            return JSONResponse(
+                status_code=status.HTTP_404_NOT_FOUND,
+                content={
+                    "error": "Unknown subscriber",
+                    "message": "Subscriber expired or server restarted - subscribe again"
+                }
+            )
+        return {"subscriber_id": request.subscriber_id, "signals": events}
+
+    async def run_subscription_pass():
+        """
+        Serve every subscribed (symbol, timeframe) whose newest bar has not
+        been served yet: one pipeline run per distinct parameter set,
+        published to every stream that shares it.
+        """
+        _subscriptions.expire()
+        for symbol, timeframe in _subscriptions.groups():
+            try:
+                bar_time = latest_bar_time(symbol, timeframe)
+            except Exception as e:
+                logger.warning(f"Subscriptions: no bar time for {symbol} {timeframe}: {e}")
+                continue
+            if bar_time is None:
+                continue
+
+            for params, targets in _subscriptions.pending_work(symbol, timeframe, bar_time):
+                signal_request = SignalRequest(symbol=symbol, timeframe=timeframe, bar_time=bar_time, **params)
+                response = await generate_signal(signal_request)
+                if isinstance(response, JSONResponse):
+                    content = json.loads(response.body)
+                else:
+                    content = response.dict()
+                queued = _subscriptions.publish(targets, bar_time, content)
+                logger.info(f"Pushed {symbol} {timeframe} bar_time={bar_time} to {queued} stream(s)")
+
+    async def run_subscription_scheduler():
+        """Check subscribed symbols for a new candle every SUBSCRIPTION_CHECK_SECONDS"""
+        while True:
+            await asyncio.sleep(SUBSCRIPTION_CHECK_SECONDS)
+            if not _subscriptions.has_streams():
+                _subscriptions.expire()
+                continue
+            try:
+                await run_subscription_pass()
+            except Exception as e:
+                logger.error(f"Subscription pass failed: {e}", exc_info=True)
+
+    async def dispatch_shm_request(path: str, body: bytes) -> tuple[int, bytes]:
+        """
+        Run one request from the shared-memory transport through the same
+        route handler the HTTP endpoint uses.
+
+        Args:
+            path: Endpoint path the bridge would have POSTed to
+            body: JSON request body
+
+        Returns:
+            (HTTP status, JSON response bytes) as FastAPI would send them
+        """
+        routes = {
+            "/signal": (SignalRequest, generate_signal),
+            "/signal/stream": (StreamSignalRequest, generate_signal_stream),
+            "/signal/batch": (BatchSignalRequest, generate_signal_batch),
+        }
+        if path not in routes:
+            return 404, json.dumps({"detail": "Not Found"}).encode("utf-8")
+
+        model, handler = routes[path]
+        try:
+            request = model(**json.loads(body))
+        except (ValueError, TypeError, ValidationError) as e:
+            errors = e.errors() if isinstance(e, ValidationError) else str(e)
+            return 422, json.dumps({"detail": errors}, default=str).encode("utf-8")
+
+        result = await handler(request)
+        if isinstance(result, JSONResponse):
+            return result.status_code, bytes(result.body)
+        if isinstance(result, list):
+            content = [item.dict() for item in result]
+        else:
+            content = result.dict()
+        return 200, json.dumps(content, ensure_ascii=False, allow_nan=False,
+                               separators=(",", ":")).encode("utf-8")
+
+    def start_shm_transport():
+        """Serve shm://<SHM_TRANSPORT_NAME> for bridges on this host (Windows only)"""
+        global _shm_server
+        if sys.platform != "win32":
+            logger.warning("SHM_TRANSPORT_NAME is set but shared memory needs Windows - not started")
+            return
+        try:
+            _shm_server = ShmSignalServer(
+                SHM_TRANSPORT_NAME,
+                dispatch_shm_request,
+                asyncio.get_running_loop(),
+                logger=logger
+            )
+            _shm_server.start()
+            logger.info(f"Shared-memory transport listening on shm://{SHM_TRANSPORT_NAME}")
+        except Exception as e:
+            _shm_server = None
+            logger.error(f"Shared-memory transport failed to start: {e}", exc_info=True)
+
     @app.get("/")
     async def root():
         """Root endpoint with API info"""
@@ -1029,6 +1493,12 @@ def create_app() -> FastAPI:
             "description": "S/R Bounce Trading API",
             "endpoints": {
                 "/signal": "POST - Generate trading signal",
+                "/signal/batch": "POST - Generate signals for several symbols in one request",
+                "/signal/bars": "POST - Generate trading signal from a binary bar upload",
+                "/signal/stream": "POST - Generate trading signal from an incremental bar push",
+                "/signal/subscribe": "POST - Register a pushed-signal stream",
+                "/signal/poll": "POST - Long-poll for pushed signals",
+                "/signal/unsubscribe": "POST - Drop a pushed-signal stream",
                 "/health": "GET - Health check",
                 "/docs": "GET - API documentation"
             }
@@ -1052,6 +1522,29 @@ def create_app() -> FastAPI:
         cache = get_sr_cache()
         return cache.get_cache_stats()
 
+    @app.get("/stream/stats")
+    async def stream_stats():
+        """Get incremental bar push ring buffer statistics"""
+        return _bar_streams.stats()
+
+    @app.get("/subscriptions/stats")
+    async def subscription_stats():
+        """Get pushed-signal subscriber and stream counts"""
+        return _subscriptions.stats()
+
+    @app.get("/shm/stats")
+    async def shm_stats():
+        """Get shared-memory transport status"""
+        if _shm_server is None:
+            return {"enabled": False}
+        return {
+            "enabled": True,
+            "url": f"shm://{_shm_server.name}",
+            "slots": _shm_server.slot_count,
+            "slot_bytes": _shm_server.slot_bytes,
+            "requests_served": _shm_server.requests_served
+        }
+
     return app
 
 
@@ -75,6 +75,23 @@ API_HOST = os.getenv("API_HOST", "0.0.0.0")
 API_PORT = int(os.getenv("API_PORT", "8000"))
 DEBUG = os.getenv("DEBUG", "false").lower() == "true"
 
+# Shared-memory transport for bridges on the same host (EA apiUrl
+# "shm://<name>"); empty disables it. Windows only.
+SHM_TRANSPORT_NAME = os.getenv("SHM_TRANSPORT_NAME", "")
+
+# Compression (volarix4/utils/content_encoding.py): gzip/zstd request
+# bodies are decoded up to MAX_DECODED_BODY_BYTES; responses of at least
+# RESPONSE_GZIP_MIN_BYTES are gzipped for clients that accept it (0 = never)
+MAX_DECODED_BODY_BYTES = int(os.getenv("MAX_DECODED_BODY_BYTES", str(64 * 1024 * 1024)))
+RESPONSE_GZIP_MIN_BYTES = int(os.getenv("RESPONSE_GZIP_MIN_BYTES", "1024"))
+
+# Pushed signals (POST /signal/subscribe, /signal/poll): how often the
+# scheduler checks subscribed symbols for a new candle, how long a poll may
+# wait, and how long a subscriber may go without polling before it is dropped
+SUBSCRIPTION_CHECK_SECONDS = float(os.getenv("SUBSCRIPTION_CHECK_SECONDS", "1.0"))
+SUBSCRIPTION_MAX_POLL_SECONDS = float(os.getenv("SUBSCRIPTION_MAX_POLL_SECONDS", "30"))
+SUBSCRIPTION_IDLE_SECONDS = float(os.getenv("SUBSCRIPTION_IDLE_SECONDS", "120"))
+
 # Legacy CONFIG dict for backward compatibility
 CONFIG = {
     "mt5_login": MT5_LOGIN,
@@ -132,6 +132,35 @@ def fetch_ohlc(symbol: str, timeframe: str, bars: int, end_time: Optional[dateti
     return df
 
 
+def latest_bar_time(symbol: str, timeframe: str) -> Optional[int]:
+    """
+    Open time of the symbol's newest bar (the candle in progress) - the
+    bar_time an EA sends to /signal as soon as that candle opens.
+
+    Args:
+        symbol: Trading pair (e.g., "EURUSD")
+        timeframe: MT5 timeframe (e.g., "H1", "M30")
+
+    Returns:
+        Unix timestamp, or None if MT5 has no bars for the symbol
+
+    Raises:
+        Exception if connection fails; ValueError for an invalid timeframe
+    """
+    if not mt5.terminal_info():
+        if not connect_mt5():
+            raise Exception("Failed to connect to MT5")
+
+    mt5_timeframe = _timeframe_to_mt5(timeframe)
+    if mt5_timeframe is None:
+        raise ValueError(f"Invalid timeframe: {timeframe}")
+
+    rates = mt5.copy_rates_from_pos(symbol, mt5_timeframe, 0, 1)
+    if rates is None or len(rates) == 0:
+        return None
+    return int(rates[0]['time'])
+
+
 def is_valid_session(timestamp: pd.Timestamp) -> bool:
     """
     Check if timestamp is within London or NY session (EST).
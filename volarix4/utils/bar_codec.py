@@ -0,0 +1,164 @@
+"""
+Binary Bar Codec - compact bar upload format used by the MT5 bridge
+
+Layout (all little-endian, no padding):
+
+    Header (16 bytes)
+        char[4]  magic              b"VXB1"
+        uint8    symbol_len
+        uint8    timeframe_len
+        uint8    context_timeframe_len
+        uint8    reserved (0)
+        uint32   bar_count
+        uint32   context_bar_count
+    symbol, timeframe, context_timeframe   (ASCII, lengths from header)
+    bar_count records, then context_bar_count records (48 bytes each)
+        int64    time               Unix timestamp (seconds, UTC)
+        float64  open, high, low, close, volume
+
+Mirrors mt5_integration/bridge/bar_codec.h - keep the two in sync.
+"""
+
+import struct
+from typing import Dict, List
+
+import numpy as np
+
+
+BINARY_BARS_CONTENT_TYPE = "application/x-volarix-bars"
+BINARY_BARS_MAGIC = b"VXB1"
+
+_HEADER = struct.Struct("<4sBBBxII")
+
+BAR_RECORD_DTYPE = np.dtype([
+    ("time", "<i8"),
+    ("open", "<f8"),
+    ("high", "<f8"),
+    ("low", "<f8"),
+    ("close", "<f8"),
+    ("volume", "<f8"),
+])
+
+# Volarix 3 EAs label timeframes "1h", "15m", ... - map them to MT5 names
+_V3_TIMEFRAMES = {
+    "1m": "M1",
+    "5m": "M5",
+    "15m": "M15",
+    "30m": "M30",
+    "1h": "H1",
+    "4h": "H4",
+    "1d": "D1",
+    "1w": "W1",
+}
+
+
+class BarDecodeError(ValueError):
+    """Raised when a binary bar payload is malformed"""
+    pass
+
+
+def normalize_timeframe(timeframe: str) -> str:
+    """
+    Normalize a timeframe label to the MT5 form used by the API.
+
+    Args:
+        timeframe: "H1", "h1" or Volarix 3 style "1h"
+
+    Returns:
+        MT5 timeframe string (e.g., "H1"); unknown labels are returned upper-cased
+    """
+    return _V3_TIMEFRAMES.get(timeframe.lower(), timeframe.upper())
+
+
+def _records_to_bars(records: np.ndarray) -> List[Dict]:
+    """Convert packed records to the bar dicts expected by bar_validation."""
+    times = records["time"].tolist()
+    opens = records["open"].tolist()
+    highs = records["high"].tolist()
+    lows = records["low"].tolist()
+    closes = records["close"].tolist()
+    volumes = records["volume"].astype(np.int64).tolist()
+
+    return [
+        {'time': t, 'open': o, 'high': h, 'low': l, 'close': c, 'volume': v}
+        for t, o, h, l, c, v in zip(times, opens, highs, lows, closes, volumes)
+    ]
+
+
+def decode_binary_bars(payload: bytes) -> Dict:
+    """
+    Decode a binary bar upload.
+
+    Args:
+        payload: Raw request body
+
+    Returns:
+        Dict with 'symbol', 'timeframe', 'context_timeframe' (may be empty),
+        'bars' and 'context_bars' (lists of bar dicts, oldest first as sent)
+
+    Raises:
+        BarDecodeError: If the magic, lengths or record count do not match
+    """
+    if len(payload) < _HEADER.size:
+        raise BarDecodeError(f"Payload too short for header ({len(payload)} bytes)")
+
+    magic, symbol_len, tf_len, ctx_tf_len, bar_count, ctx_count = _HEADER.unpack_from(payload, 0)
+    if magic != BINARY_BARS_MAGIC:
+        raise BarDecodeError(f"Bad magic {magic!r} (expected {BINARY_BARS_MAGIC!r})")
+
+    offset = _HEADER.size
+    strings_end = offset + symbol_len + tf_len + ctx_tf_len
+    records_end = strings_end + (bar_count + ctx_count) * BAR_RECORD_DTYPE.itemsize
+    if len(payload) != records_end:
+        raise BarDecodeError(
+            f"Payload is {len(payload)} bytes, header describes {records_end} "
+            f"({bar_count} bars + {ctx_count} context bars)"
+        )
+
+    try:
+        symbol = payload[offset:offset + symbol_len].decode("ascii")
+        offset += symbol_len
+        timeframe = payload[offset:offset + tf_len].decode("ascii")
+        offset += tf_len
+        context_timeframe = payload[offset:offset + ctx_tf_len].decode("ascii")
+    except UnicodeDecodeError as e:
+        raise BarDecodeError(f"Non-ASCII symbol/timeframe: {e}")
+
+    records = np.frombuffer(payload, dtype=BAR_RECORD_DTYPE,
+                            count=bar_count + ctx_count, offset=strings_end)
+
+    return {
+        'symbol': symbol,
+        'timeframe': normalize_timeframe(timeframe),
+        'context_timeframe': normalize_timeframe(context_timeframe) if context_timeframe else "",
+        'bars': _records_to_bars(records[:bar_count]),
+        'context_bars': _records_to_bars(records[bar_count:]),
+    }
+
+
+def encode_binary_bars(symbol: str, timeframe: str, bars: List[Dict],
+                       context_timeframe: str = "", context_bars: List[Dict] = ()) -> bytes:
+    """
+    Encode bars in the binary upload format (for tests and Python clients).
+
+    Args:
+        symbol: Trading symbol
+        timeframe: Execution timeframe
+        bars: Bar dicts with 'time', 'open', 'high', 'low', 'close', 'volume'
+        context_timeframe: Optional context timeframe
+        context_bars: Optional context bar dicts
+
+    Returns:
+        Payload bytes
+    """
+    names = [symbol.encode("ascii"), timeframe.encode("ascii"), context_timeframe.encode("ascii")]
+    if any(len(name) > 255 for name in names):
+        raise BarDecodeError("Symbol/timeframe longer than 255 bytes")
+
+    records = np.zeros(len(bars) + len(context_bars), dtype=BAR_RECORD_DTYPE)
+    for i, bar in enumerate(list(bars) + list(context_bars)):
+        records[i] = (bar['time'], bar['open'], bar['high'], bar['low'], bar['close'], bar['volume'])
+
+    header = _HEADER.pack(BINARY_BARS_MAGIC, len(names[0]), len(names[1]), len(names[2]),
+                          len(bars), len(context_bars))
+    return header + b"".join(names) + records.tobytes()
@@ -0,0 +1,95 @@
+"""
+Bar Stream Store - per-stream ring buffers for incremental bar push
+
+The MT5 bridge (GetVolarix4SignalStream) sends only the bars a stream has not
+seen yet, tagged with a sequence number. The API keeps the latest window of
+bars per (client_id, symbol, timeframe) so each candle costs O(new bars) to
+transfer instead of O(lookback). The client id is random per loaded bridge
+DLL, so two terminals pushing the same symbol and timeframe do not collide.
+
+Protocol:
+- reset=True: replace the stream's window with the bars sent (seq restarts)
+- otherwise: seq must be exactly last_seq + 1, else the stream is out of step
+  (server restart, lost response, skipped push) and the client must resync
+"""
+
+from collections import OrderedDict, deque
+from typing import Deque, Dict, List, Optional, Tuple
+
+
+class _Stream:
+    """Window of bars for one (client_id, symbol, timeframe)"""
+
+    def __init__(self, capacity: int, seq: int):
+        self.bars: Deque[Dict] = deque(maxlen=capacity)
+        self.seq = seq
+
+
+class BarStreamStore:
+    """
+    Ring buffers keyed by (client_id, symbol, timeframe), least recently
+    used evicted.
+
+    Called from async route handlers on the event loop without awaiting in
+    between, so no locking is needed.
+    """
+
+    def __init__(self, max_streams: int = 256):
+        self.max_streams = max_streams
+        self._streams: "OrderedDict[Tuple[str, str, str], _Stream]" = OrderedDict()
+
+    def apply(self, symbol: str, timeframe: str, seq: int, reset: bool,
+              bars: List[Dict], capacity: int, client_id: str = "") -> Optional[List[Dict]]:
+        """
+        Apply one push to a stream.
+
+        Args:
+            symbol: Trading symbol
+            timeframe: Timeframe string
+            seq: Sequence number of this push
+            reset: True for a full resync (bars hold the whole window)
+            bars: New bar dicts, oldest first
+            capacity: Window size (bars kept per stream)
+            client_id: Id of the pushing bridge ("" for bridges that send none)
+
+        Returns:
+            The stream's window after the push (oldest first), or None if the
+            push is out of sequence and the client must resync
+        """
+        key = (client_id, symbol, timeframe.upper())
+        stream = self._streams.get(key)
+
+        if reset:
+            stream = _Stream(capacity, seq)
+            self._streams[key] = stream
+        elif stream is None or seq != stream.seq + 1 or stream.bars.maxlen != capacity:
+            return None
+        else:
+            stream.seq = seq
+
+        self._streams.move_to_end(key)
+        while len(self._streams) > self.max_streams:
+            self._streams.popitem(last=False)
+
+        # Only append bars newer than the window's last bar (duplicates from a
+        # retried push are dropped)
+        last_time = stream.bars[-1]['time'] if stream.bars else None
+        for bar in bars:
+            if last_time is None or bar['time'] > last_time:
+                stream.bars.append(bar)
+                last_time = bar['time']
+
+        return list(stream.bars)
+
+    def expected_seq(self, symbol: str, timeframe: str, client_id: str = "") -> Optional[int]:
+        """Next sequence number the stream accepts (None if unknown)."""
+        stream = self._streams.get((client_id, symbol, timeframe.upper()))
+        return stream.seq + 1 if stream else None
+
+    def stats(self) -> Dict:
+        """Number of live streams and bars held."""
+        return {
+            "streams": len(self._streams),
+            "bars": sum(len(s.bars) for s in self._streams.values()),
+            "max_streams": self.max_streams,
+        }
@@ -0,0 +1,177 @@
+"""
+Content Encoding - compressed request bodies from the MT5 bridge
+
+VolariXBridge.dll sends large bodies gzip- or zstd-compressed when the EA
+turns it on (SetVolariXCompression, see
+mt5_integration/bridge/content_encoding.h) and says so in the
+Content-Encoding header. ContentEncodingMiddleware decodes them before
+anything else reads the body - the request logger and the endpoints only
+ever see the plain JSON or binary bars.
+
+gzip is always available. zstd needs the zstandard package
+(pip install zstandard); without it a zstd body is answered with 415 and
+the bridge's caller can fall back to gzip.
+
+Decoding stops at max_bytes of output (413), so a small compressed body
+cannot expand into gigabytes of memory.
+"""
+
+import io
+import json
+import zlib
+from typing import List
+
+try:
+    import zstandard
+except ImportError:  # Optional - only needed for Content-Encoding: zstd
+    zstandard = None
+
+
+# Largest decoded body accepted (~400,000 JSON bars)
+DEFAULT_MAX_DECODED_BYTES = 64 * 1024 * 1024
+
+
+class ContentEncodingError(ValueError):
+    """A body that cannot be decoded; status_code is the HTTP answer."""
+
+    def __init__(self, status_code: int, message: str):
+        super().__init__(message)
+        self.status_code = status_code
+
+
+def supported_encodings() -> List[str]:
+    """Content-Encoding values decode_body understands."""
+    return ["gzip", "zstd"] if zstandard is not None else ["gzip"]
+
+
+def _gunzip(body: bytes, max_bytes: int) -> bytes:
+    decoder = zlib.decompressobj(wbits=16 + zlib.MAX_WBITS)
+    try:
+        data = decoder.decompress(body, max_bytes + 1)
+    except zlib.error as e:
+        raise ContentEncodingError(400, f"Corrupt gzip body: {e}")
+    if len(data) > max_bytes:
+        raise ContentEncodingError(413, f"Decoded body exceeds {max_bytes} bytes")
+    if not decoder.eof:
+        raise ContentEncodingError(400, "Truncated gzip body")
+    return data
+
+
+def _unzstd(body: bytes, max_bytes: int) -> bytes:
+    # Streamed uploads do not record the content size in the frame, so
+    # read through a stream reader instead of ZstdDecompressor.decompress
+    out = bytearray()
+    try:
+        with zstandard.ZstdDecompressor().stream_reader(io.BytesIO(body)) as reader:
+            while len(out) <= max_bytes:
+                piece = reader.read(max_bytes + 1 - len(out))
+                if not piece:
+                    break
+                out += piece
+    except zstandard.ZstdError as e:
+        raise ContentEncodingError(400, f"Corrupt zstd body: {e}")
+    if len(out) > max_bytes:
+        raise ContentEncodingError(413, f"Decoded body exceeds {max_bytes} bytes")
+    return bytes(out)
+
+
+def decode_body(body: bytes, content_encoding: str,
+                max_bytes: int = DEFAULT_MAX_DECODED_BYTES) -> bytes:
+    """
+    Undo a Content-Encoding header value ("gzip", "zstd", "identity", or a
+    comma-separated list, applied in order - decoded last to first).
+
+    Raises:
+        ContentEncodingError: 415 for an unsupported encoding, 400 for a
+            corrupt body, 413 past max_bytes
+    """
+    codings = [c.strip().lower() for c in content_encoding.split(",") if c.strip()]
+    for coding in reversed(codings):
+        if coding == "identity":
+            continue
+        if coding in ("gzip", "x-gzip"):
+            body = _gunzip(body, max_bytes)
+        elif coding == "zstd" and zstandard is not None:
+            body = _unzstd(body, max_bytes)
+        else:
+            raise ContentEncodingError(415, f"Unsupported Content-Encoding: {coding} "
+                                            f"(supported: {', '.join(supported_encodings())})")
+    return body
+
+
+class ContentEncodingMiddleware:
+    """
+    ASGI middleware: replaces a compressed request body with the decoded
+    one (dropping Content-Encoding and fixing Content-Length) before the
+    application sees the request. Requests without Content-Encoding pass
+    through untouched, body unread.
+    """
+
+    def __init__(self, app, max_bytes: int = DEFAULT_MAX_DECODED_BYTES):
+        self.app = app
+        self.max_bytes = max_bytes
+
+    async def __call__(self, scope, receive, send):
+        if scope["type"] != "http":
+            await self.app(scope, receive, send)
+            return
+
+        content_encoding = ""
+        for name, value in scope["headers"]:
+            if name == b"content-encoding":
+                content_encoding = value.decode("latin-1")
+        if content_encoding.strip().lower() in ("", "identity"):
+            await self.app(scope, receive, send)
+            return
+
+        body = bytearray()
+        while True:
+            message = await receive()
+            if message["type"] == "http.disconnect":
+                return
+            body += message.get("body", b"")
+            if len(body) > self.max_bytes:
+                await self._reject(send, ContentEncodingError(
+                    413, f"Request body exceeds {self.max_bytes} bytes"))
+                return
+            if not message.get("more_body", False):
+                break
+
+        try:
+            decoded = decode_body(bytes(body), content_encoding, self.max_bytes)
+        except ContentEncodingError as e:
+            await self._reject(send, e)
+            return
+
+        headers = [(name, value) for name, value in scope["headers"]
+                   if name not in (b"content-encoding", b"content-length")]
+        headers.append((b"content-length", str(len(decoded)).encode("latin-1")))
+        scope = dict(scope, headers=headers)
+
+        delivered = False
+
+        async def receive_decoded():
+            nonlocal delivered
+            if delivered:
+                return await receive()
+            delivered = True
+            return {"type": "http.request", "body": decoded, "more_body": False}
+
+        await self.app(scope, receive_decoded, send)
+
+    @staticmethod
+    async def _reject(send, error: ContentEncodingError):
+        titles = {400: "Body Decode Failed", 413: "Body Too Large", 415: "Unsupported Content-Encoding"}
+        payload = json.dumps({
+            "error": titles.get(error.status_code, "Body Decode Failed"),
+            "message": str(error),
+        }).encode("utf-8")
+        await send({
+            "type": "http.response.start",
+            "status": error.status_code,
+            "headers": [
+                (b"content-type", b"application/json"),
+                (b"content-length", str(len(payload)).encode("latin-1")),
+            ],
+        })
+        await send({"type": "http.response.body", "body": payload})
@@ -0,0 +1,271 @@
+"""
+Shared-Memory Transport - same-host requests from the MT5 bridge
+
+When the EA's apiUrl is "shm://<name>", the bridge DLL does not use HTTP at
+all: it writes the request (path + JSON body) into a slot of a named
+shared-memory ring, sets a named event and waits for the answer in the same
+slot (see mt5_integration/bridge/shm_transport.h). This module owns that
+ring on the API side: it creates the mapping and events, waits for
+requests on a background thread and runs each one through the API's route
+handlers on the server's event loop.
+
+Protocol (per slot):
+- the client that owns the slot writes path and body, then bumps request_seq
+- the server sees request_seq != response_seq, answers into the slot's data
+  area, stores response_seq = request_seq and sets the slot's event
+- request_seq is only written by clients and response_seq only by the
+  server, so plain aligned 4-byte stores are enough on this side
+
+Windows only (named mappings and events); ShmRing itself works on any
+writable buffer, which is how the tests drive it.
+"""
+
+import asyncio
+import concurrent.futures
+import json
+import mmap
+import struct
+import sys
+import threading
+from typing import Awaitable, Callable, List, Optional, Tuple
+
+# Layout constants (must match bridge/shm_transport.h)
+MAGIC = 0x4D533456                 # "V4SM"
+VERSION = 1
+HEADER_BYTES = 64
+SLOT_HEADER_BYTES = 128
+PATH_BYTES = 96
+DEFAULT_SLOT_COUNT = 16
+DEFAULT_SLOT_BYTES = 64 * 1024
+
+# Header field offsets
+_MAGIC = 0
+_VERSION = 4
+_SLOT_COUNT = 8
+_SLOT_BYTES = 12
+_HEARTBEAT = 16                    # u64, GetTickCount64() ms
+
+# Slot header field offsets
+_OWNER = 0
+_REQUEST_SEQ = 4
+_RESPONSE_SEQ = 8
+_REQUEST_LEN = 12
+_RESPONSE_LEN = 16
+_STATUS = 20
+_PATH_LEN = 24
+_PATH = 32
+
+# Event wait timeout - also how often the heartbeat is refreshed while idle
+_POLL_MS = 100
+
+Dispatch = Callable[[str, bytes], Awaitable[Tuple[int, bytes]]]
+
+
+def mapping_name(name: str) -> str:
+    """Kernel object name of the mapping for shm://<name>"""
+    return f"Local\\Volarix4Shm_{name}"
+
+
+class ShmRing:
+    """Slot ring laid out over a writable buffer (the named mapping)"""
+
+    def __init__(self, buffer, slot_count: int = DEFAULT_SLOT_COUNT,
+                 slot_bytes: int = DEFAULT_SLOT_BYTES):
+        if slot_bytes <= SLOT_HEADER_BYTES:
+            raise ValueError(f"slot_bytes must exceed {SLOT_HEADER_BYTES}")
+        if len(buffer) < self.size(slot_count, slot_bytes):
+            raise ValueError("buffer too small for the ring")
+        self.buffer = buffer
+        self.slot_count = slot_count
+        self.slot_bytes = slot_bytes
+        self.data_bytes = slot_bytes - SLOT_HEADER_BYTES
+
+    @staticmethod
+    def size(slot_count: int = DEFAULT_SLOT_COUNT, slot_bytes: int = DEFAULT_SLOT_BYTES) -> int:
+        """Bytes needed for the header plus slot_count slots"""
+        return HEADER_BYTES + slot_count * slot_bytes
+
+    def _u32(self, offset: int) -> int:
+        return struct.unpack_from("<I", self.buffer, offset)[0]
+
+    def _set_u32(self, offset: int, value: int) -> None:
+        struct.pack_into("<I", self.buffer, offset, value & 0xFFFFFFFF)
+
+    def _slot(self, index: int) -> int:
+        return HEADER_BYTES + index * self.slot_bytes
+
+    def initialize(self) -> None:
+        """
+        Write the header (magic last) and drop requests left over from a
+        previous server on the same mapping.
+        """
+        self._set_u32(_VERSION, VERSION)
+        self._set_u32(_SLOT_COUNT, self.slot_count)
+        self._set_u32(_SLOT_BYTES, self.slot_bytes)
+        for index in range(self.slot_count):
+            base = self._slot(index)
+            self._set_u32(base + _RESPONSE_SEQ, self._u32(base + _REQUEST_SEQ))
+        self._set_u32(_MAGIC, MAGIC)
+
+    def beat(self, now_ms: int) -> None:
+        """Publish the server heartbeat (clients give up when it goes stale)"""
+        struct.pack_into("<Q", self.buffer, _HEARTBEAT, now_ms)
+
+    def pending(self) -> List[int]:
+        """Slots holding a request that has not been answered yet"""
+        pending = []
+        for index in range(self.slot_count):
+            base = self._slot(index)
+            if self._u32(base + _REQUEST_SEQ) != self._u32(base + _RESPONSE_SEQ):
+                pending.append(index)
+        return pending
+
+    def read_request(self, index: int) -> Tuple[int, str, bytes]:
+        """(request_seq, path, body) of a pending slot"""
+        base = self._slot(index)
+        seq = self._u32(base + _REQUEST_SEQ)
+        path_len = min(self._u32(base + _PATH_LEN), PATH_BYTES - 1)
+        body_len = min(self._u32(base + _REQUEST_LEN), self.data_bytes)
+        path = bytes(self.buffer[base + _PATH:base + _PATH + path_len]).decode("utf-8", "replace")
+        data = base + SLOT_HEADER_BYTES
+        body = bytes(self.buffer[data:data + body_len])
+        return seq, path, body
+
+    def write_response(self, index: int, seq: int, status: int, body: bytes) -> None:
+        """Answer request seq of a slot (body first, response_seq last)"""
+        if len(body) > self.data_bytes:
+            status = 500
+            body = json.dumps({
+                "error": "Response too large for shared memory slot",
+                "message": f"{len(body)} bytes, slot holds {self.data_bytes}"
+            }).encode("utf-8")
+
+        base = self._slot(index)
+        data = base + SLOT_HEADER_BYTES
+        self.buffer[data:data + len(body)] = body
+        self._set_u32(base + _RESPONSE_LEN, len(body))
+        self._set_u32(base + _STATUS, status)
+        self._set_u32(base + _RESPONSE_SEQ, seq)
+
+
+class ShmSignalServer:
+    """
+    Serves one shm://<name> endpoint.
+
+    A background thread waits on the request event, and each pending slot is
+    handed to dispatch(path, body) -> (status, response bytes) on the
+    server's event loop, so route handlers keep running on the loop exactly
+    as they do for HTTP requests.
+    """
+
+    def __init__(self, name: str, dispatch: Dispatch, loop: asyncio.AbstractEventLoop,
+                 slot_count: int = DEFAULT_SLOT_COUNT, slot_bytes: int = DEFAULT_SLOT_BYTES,
+                 logger=None):
+        self.name = name
+        self.dispatch = dispatch
+        self.loop = loop
+        self.slot_count = slot_count
+        self.slot_bytes = slot_bytes
+        self.logger = logger
+        self.requests_served = 0
+
+        self._mapping: Optional[mmap.mmap] = None
+        self._ring: Optional[ShmRing] = None
+        self._request_event = None
+        self._response_events: List[int] = []
+        self._thread: Optional[threading.Thread] = None
+        self._stop = threading.Event()
+        self._kernel32 = None
+
+    def start(self) -> None:
+        if sys.platform != "win32":
+            raise RuntimeError("Shared-memory transport requires Windows")
+
+        import ctypes
+        from ctypes import wintypes
+
+        kernel32 = ctypes.WinDLL("kernel32", use_last_error=True)
+        kernel32.CreateEventW.argtypes = [ctypes.c_void_p, wintypes.BOOL, wintypes.BOOL, wintypes.LPCWSTR]
+        kernel32.CreateEventW.restype = wintypes.HANDLE
+        kernel32.SetEvent.argtypes = [wintypes.HANDLE]
+        kernel32.SetEvent.restype = wintypes.BOOL
+        kernel32.WaitForSingleObject.argtypes = [wintypes.HANDLE, wintypes.DWORD]
+        kernel32.WaitForSingleObject.restype = wintypes.DWORD
+        kernel32.CloseHandle.argtypes = [wintypes.HANDLE]
+        kernel32.CloseHandle.restype = wintypes.BOOL
+        kernel32.GetTickCount64.argtypes = []
+        kernel32.GetTickCount64.restype = ctypes.c_ulonglong
+        self._kernel32 = kernel32
+
+        base_name = mapping_name(self.name)
+        size = ShmRing.size(self.slot_count, self.slot_bytes)
+        self._mapping = mmap.mmap(-1, size, tagname=base_name)
+        self._ring = ShmRing(self._mapping, self.slot_count, self.slot_bytes)
+
+        # Auto-reset events: one for requests, one per slot for answers
+        self._request_event = self._create_event(f"{base_name}_req")
+        self._response_events = [
+            self._create_event(f"{base_name}_resp{index}") for index in range(self.slot_count)
+        ]
+
+        self._ring.beat(kernel32.GetTickCount64())
+        self._ring.initialize()
+
+        self._stop.clear()
+        self._thread = threading.Thread(target=self._run, name=f"shm-{self.name}", daemon=True)
+        self._thread.start()
+
+    def stop(self) -> None:
+        self._stop.set()
+        if self._thread is not None:
+            self._thread.join(timeout=2.0)
+            self._thread = None
+
+        if self._ring is not None:
+            self._ring.beat(0)
+        for handle in [self._request_event, *self._response_events]:
+            if handle:
+                self._kernel32.CloseHandle(handle)
+        self._request_event = None
+        self._response_events = []
+        if self._mapping is not None:
+            self._mapping.close()
+            self._mapping = None
+            self._ring = None
+
+    def _create_event(self, name: str):
+        handle = self._kernel32.CreateEventW(None, False, False, name)
+        if not handle:
+            import ctypes
+            raise OSError(ctypes.get_last_error(), f"CreateEventW failed for {name}")
+        return handle
+
+    def _run(self) -> None:
+        kernel32 = self._kernel32
+        ring = self._ring
+        while not self._stop.is_set():
+            ring.beat(kernel32.GetTickCount64())
+            kernel32.WaitForSingleObject(self._request_event, _POLL_MS)
+
+            for index in ring.pending():
+                seq, path, body = ring.read_request(index)
+                status, payload = self._serve(path, body)
+                ring.write_response(index, seq, status, payload)
+                kernel32.SetEvent(self._response_events[index])
+                self.requests_served += 1
+
+    def _serve(self, path: str, body: bytes) -> Tuple[int, bytes]:
+        future = asyncio.run_coroutine_threadsafe(self.dispatch(path, body), self.loop)
+        while True:
+            try:
+                return future.result(timeout=_POLL_MS / 1000.0)
+            except concurrent.futures.TimeoutError:
+                # Keep the heartbeat alive while a slow request runs
+                self._ring.beat(self._kernel32.GetTickCount64())
+                if self._stop.is_set():
+                    future.cancel()
+                    return 503, b'{"error":"Server shutting down"}'
+            except Exception as e:
+                if self.logger:
+                    self.logger.error(f"shm request {path} failed: {e}", exc_info=True)
+                return 500, json.dumps({"error": "Error", "message": str(e)}).encode("utf-8")
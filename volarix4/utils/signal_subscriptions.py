@@ -0,0 +1,224 @@
+"""
+Signal Subscriptions - push delivery of /signal results to the MT5 bridge
+
+Instead of POSTing /signal once per candle per chart, Volarix4Bridge.dll
+(SubscribeVolarix4Signal) registers its (symbol, timeframe, params) streams
+once and holds one long-poll request open on POST /signal/poll. The API's
+subscription scheduler notices a new candle, runs the pipeline once per
+distinct parameter set of that (symbol, timeframe) - however many charts
+subscribed to it - and publishes the result to every matching stream; the
+pending poll returns it at once.
+
+Protocol:
+- subscribe: a subscriber id (created on first use) and a stream id per
+  stream; subscribing the same params again returns the same stream id
+- poll(after_seq): events the subscriber has not acknowledged yet, waiting
+  up to the timeout for one to arrive. after_seq is the highest seq the
+  client has taken, so a poll whose response was lost is simply repeated.
+- an unknown subscriber (server restart, idle expiry) gets None; the client
+  subscribes its streams again
+
+Like BarStreamStore, every method runs on the event loop and only poll()
+awaits, so no locking is needed.
+"""
+
+import asyncio
+import time
+import uuid
+from collections import deque
+from typing import Callable, Deque, Dict, List, Optional, Tuple
+
+
+class _Stream:
+    """One subscribed (symbol, timeframe, params)"""
+
+    def __init__(self, stream_id: int, symbol: str, timeframe: str, params: Dict):
+        self.stream_id = stream_id
+        self.symbol = symbol
+        self.timeframe = timeframe
+        self.params = params
+        self.last_bar_time: Optional[int] = None
+
+
+class _Subscriber:
+    """A bridge: its streams and the events it has not acknowledged"""
+
+    def __init__(self, max_events: int, now: float):
+        self.streams: Dict[int, _Stream] = {}
+        self.events: Deque[Dict] = deque(maxlen=max_events)
+        self.next_stream_id = 1
+        self.next_seq = 1
+        self.last_seen = now
+        self.polling = 0
+        self.waiter: Optional[asyncio.Event] = None
+
+
+def _params_key(params: Dict) -> Tuple:
+    return tuple(sorted(params.items()))
+
+
+class SubscriptionHub:
+    """
+    Subscribers keyed by id; streams grouped by (symbol, timeframe) for the
+    scheduler. Subscribers that have not polled for idle_seconds are dropped
+    by expire().
+    """
+
+    def __init__(self, max_events: int = 256, idle_seconds: float = 120.0,
+                 clock: Callable[[], float] = time.monotonic):
+        self.max_events = max_events
+        self.idle_seconds = idle_seconds
+        self._clock = clock
+        self._subscribers: Dict[str, _Subscriber] = {}
+        self.published = 0
+
+    def subscribe(self, subscriber_id: Optional[str], symbol: str, timeframe: str,
+                  params: Dict) -> Tuple[str, int]:
+        """
+        Register a stream (params: lookback and strategy/cost fields of a
+        SignalRequest). An unknown or missing subscriber_id starts a new
+        subscriber - the client must then re-register its other streams.
+
+        Returns:
+            (subscriber_id, stream_id)
+        """
+        subscriber = self._subscribers.get(subscriber_id) if subscriber_id else None
+        if subscriber is None:
+            subscriber_id = uuid.uuid4().hex
+            subscriber = _Subscriber(self.max_events, self._clock())
+            self._subscribers[subscriber_id] = subscriber
+        subscriber.last_seen = self._clock()
+
+        timeframe = timeframe.upper()
+        for stream in subscriber.streams.values():
+            if stream.symbol == symbol and stream.timeframe == timeframe and stream.params == params:
+                return subscriber_id, stream.stream_id
+
+        stream_id = subscriber.next_stream_id
+        subscriber.next_stream_id += 1
+        subscriber.streams[stream_id] = _Stream(stream_id, symbol, timeframe, dict(params))
+        return subscriber_id, stream_id
+
+    def unsubscribe(self, subscriber_id: str, stream_id: Optional[int] = None) -> bool:
+        """Drop one stream, or the whole subscriber when stream_id is None."""
+        subscriber = self._subscribers.get(subscriber_id)
+        if subscriber is None:
+            return False
+        if stream_id is None:
+            del self._subscribers[subscriber_id]
+            self._wake(subscriber)
+            return True
+        return subscriber.streams.pop(stream_id, None) is not None
+
+    def groups(self) -> List[Tuple[str, str]]:
+        """Every subscribed (symbol, timeframe), each once."""
+        keys = {(s.symbol, s.timeframe)
+                for subscriber in self._subscribers.values() for s in subscriber.streams.values()}
+        return sorted(keys)
+
+    def pending_work(self, symbol: str, timeframe: str,
+                     bar_time: int) -> List[Tuple[Dict, List[Tuple[str, int]]]]:
+        """
+        Streams of (symbol, timeframe) not yet served for bar_time, grouped
+        by params: one (params, [(subscriber_id, stream_id), ...]) per
+        pipeline run the scheduler has to make.
+        """
+        timeframe = timeframe.upper()
+        work: Dict[Tuple, Tuple[Dict, List[Tuple[str, int]]]] = {}
+        for subscriber_id, subscriber in self._subscribers.items():
+            for stream in subscriber.streams.values():
+                if stream.symbol != symbol or stream.timeframe != timeframe or stream.last_bar_time == bar_time:
+                    continue
+                key = _params_key(stream.params)
+                if key not in work:
+                    work[key] = (stream.params, [])
+                work[key][1].append((subscriber_id, stream.stream_id))
+        return list(work.values())
+
+    def publish(self, targets: List[Tuple[str, int]], bar_time: int, response: Dict) -> int:
+        """
+        Queue a /signal response for bar_time on each (subscriber_id,
+        stream_id) and wake their polls. Streams unsubscribed in the
+        meantime are skipped. Returns the number of events queued.
+        """
+        queued = 0
+        for subscriber_id, stream_id in targets:
+            subscriber = self._subscribers.get(subscriber_id)
+            stream = subscriber.streams.get(stream_id) if subscriber else None
+            if stream is None:
+                continue
+            stream.last_bar_time = bar_time
+            subscriber.events.append({
+                "seq": subscriber.next_seq,
+                "stream_id": stream_id,
+                "symbol": stream.symbol,
+                "timeframe": stream.timeframe,
+                "bar_time": bar_time,
+                "response": response,
+            })
+            subscriber.next_seq += 1
+            self._wake(subscriber)
+            queued += 1
+        self.published += queued
+        return queued
+
+    async def poll(self, subscriber_id: str, after_seq: int, timeout: float) -> Optional[List[Dict]]:
+        """
+        Events with seq > after_seq (older ones are acknowledged and
+        dropped), waiting up to timeout seconds while there are none.
+
+        Returns:
+            The events (possibly empty after a timeout), or None for an
+            unknown subscriber
+        """
+        subscriber = self._subscribers.get(subscriber_id)
+        if subscriber is None:
+            return None
+        subscriber.last_seen = self._clock()
+
+        while subscriber.events and subscriber.events[0]["seq"] <= after_seq:
+            subscriber.events.popleft()
+
+        if not subscriber.events and timeout > 0:
+            if subscriber.waiter is None:
+                subscriber.waiter = asyncio.Event()
+            waiter = subscriber.waiter
+            subscriber.polling += 1
+            try:
+                await asyncio.wait_for(waiter.wait(), timeout)
+            except asyncio.TimeoutError:
+                pass
+            finally:
+                subscriber.polling -= 1
+                subscriber.last_seen = self._clock()
+
+        return list(subscriber.events)
+
+    def expire(self) -> int:
+        """Drop subscribers idle for idle_seconds (not while polling)."""
+        cutoff = self._clock() - self.idle_seconds
+        idle = [subscriber_id for subscriber_id, subscriber in self._subscribers.items()
+                if subscriber.polling == 0 and subscriber.last_seen < cutoff]
+        for subscriber_id in idle:
+            del self._subscribers[subscriber_id]
+        return len(idle)
+
+    def has_streams(self) -> bool:
+        return any(subscriber.streams for subscriber in self._subscribers.values())
+
+    def stats(self) -> Dict:
+        """Subscribers, streams, distinct (symbol, timeframe) and events."""
+        return {
+            "subscribers": len(self._subscribers),
+            "streams": sum(len(s.streams) for s in self._subscribers.values()),
+            "groups": len(self.groups()),
+            "pending_events": sum(len(s.events) for s in self._subscribers.values()),
+            "polling": sum(s.polling for s in self._subscribers.values()),
+            "published": self.published,
+        }
+
+    @staticmethod
+    def _wake(subscriber: _Subscriber):
+        if subscriber.waiter is not None:
+            subscriber.waiter.set()
+            subscriber.waiter = None
@@ -34,9 +34,9 @@ def parse_args():
     parser.add_argument("--timeframe", type=str, default="H1", help="Timeframe (H1, M15, D1, etc.)")
 
     # Data source
-    parser.add_argument("--source", type=str, default="mt5", choices=["csv", "parquet", "mt5"],
+    parser.add_argument("--source", type=str, default="mt5", choices=["csv", "parquet", "v4bars", "mt5"],
                         help="Data source type")
-    parser.add_argument("--file", type=str, help="Path to CSV/Parquet file (required for csv/parquet source)")
+    parser.add_argument("--file", type=str, help="Path to CSV/Parquet/.v4bars file (required for file sources)")
     parser.add_argument("--start", type=str, help="Start date (YYYY-MM-DD)")
     parser.add_argument("--end", type=str, help="End date (YYYY-MM-DD)")
     parser.add_argument("--bars", type=int, help="Number of most recent bars to load (alternative to date range)")
@@ -138,7 +138,7 @@ def main():
             end_date = datetime.strptime(args.end, "%Y-%m-%d")
 
         # Validate inputs
-        if args.source in ["csv", "parquet"] and not args.file:
+        if args.source in ["csv", "parquet", "v4bars"] and not args.file:
             logger.error(f"--file is required when using --source={args.source}")
             return 1
 
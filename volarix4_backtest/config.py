@@ -23,8 +23,8 @@ class BacktestConfig:
     timeframe: str = "H1"
 
     # Data source configuration
-    source: str = "mt5"  # Data source: "mt5", "csv", or "parquet"
-    file_path: Optional[str] = None  # Path to CSV/Parquet file (required for csv/parquet source)
+    source: str = "mt5"  # Data source: "mt5", "csv", "parquet", or "v4bars"
+    file_path: Optional[str] = None  # Path to CSV/Parquet/.v4bars file (required for file sources)
 
     # Data range (legacy - use test_years for year-based walk-forward)
     start_date: Optional[datetime] = None
@@ -79,6 +79,16 @@ class BacktestConfig:
     n_jobs: int = -1  # Number of parallel workers (-1 = all cores, 1 = sequential)
     run_best_after: bool = False  # Auto-run walk-forward with best params after grid search
 
+    # Monte Carlo settings (native CLI only: single and walk_forward modes)
+    monte_carlo_simulations: int = 0  # Trade-order reshuffles of the run's trades (0 = no analysis)
+    bootstrap_samples: int = 0  # Resamples of the trades with replacement
+    monte_carlo_seed: int = 42  # Same seed, same results on any n_jobs
+
+    # Intrabar exit settings (native CLI only)
+    exit_model: str = "bar"  # "bar", "open_only", "price_path" or "ticks"
+    path_model: str = "direction"  # price_path order: "direction", "ohlc" or "olhc"
+    tick_file: Optional[str] = None  # CSV (time, bid, ask) or .v4ticks, for exit_model="ticks"
+
     def __post_init__(self):
         """Validate configuration after initialization."""
         if self.fill_at not in ["next_open", "signal_close"]:
@@ -4,12 +4,51 @@ This module loads bars from local files or MT5, but does NOT call any
 strategy logic (volarix4.core.*). It only provides raw bar data.
 """
 
+import mmap
+import struct
 from dataclasses import dataclass
 from datetime import datetime
-from typing import Iterator, Optional, List
+from typing import Iterator, Optional, List, Dict, Tuple
 import pandas as pd
 
 
+# Columnar bar file written by the native code (mt5_integration/core/bar_file.h)
+BAR_FILE_MAGIC = 0x46423456  # "V4BF"
+BAR_FILE_VERSION = 1
+BAR_FILE_COLUMNS = ["time", "open", "high", "low", "close", "volume"]
+_BAR_FILE_HEADER = struct.Struct("<IIIIQqq6QQQQ32s16s96x")
+
+
+def read_bar_file(file_path: str) -> Tuple[str, str, Dict[str, memoryview]]:
+    """Map a .v4bars file read-only.
+
+    Returns:
+        (symbol, timeframe, columns): columns maps each field name to a
+        zero-copy view of the mapping ("time" as int64 unix seconds, the
+        others as float64)
+
+    Raises:
+        ValueError: If the file is truncated or not a bar file
+    """
+    with open(file_path, "rb") as f:
+        mapped = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+    if len(mapped) < _BAR_FILE_HEADER.size:
+        raise ValueError(f"Not a bar file (too short): {file_path}")
+    (magic, version, header_bytes, _stride, count, _first, _last, *rest) = _BAR_FILE_HEADER.unpack_from(mapped)
+    offsets, (_index_offset, _index_count, file_bytes, symbol, timeframe) = rest[:6], rest[6:]
+    if (magic != BAR_FILE_MAGIC or version != BAR_FILE_VERSION or header_bytes != _BAR_FILE_HEADER.size
+            or file_bytes != len(mapped) or any(offset + count * 8 > len(mapped) for offset in offsets)):
+        raise ValueError(f"Not a bar file (bad header): {file_path}")
+
+    view = memoryview(mapped)
+    columns = {
+        name: view[offset:offset + count * 8].cast("q" if name == "time" else "d")
+        for name, offset in zip(BAR_FILE_COLUMNS, offsets)
+    }
+    return symbol.rstrip(b"\0").decode(), timeframe.rstrip(b"\0").decode(), columns
+
+
 @dataclass
 class Bar:
     """Represents a single OHLCV bar."""
@@ -39,6 +78,8 @@ class BarDataSource:
     Supports:
     - CSV files (time, open, high, low, close, volume)
     - Parquet files
+    - Columnar .v4bars files written by the native code (bridge bar store,
+      native backtest --save-bars)
     - MT5 via volarix4.core.data.fetch_ohlc (but only for data loading, NOT strategy)
     """
 
@@ -55,13 +96,13 @@ class BarDataSource:
         """Initialize data source.
 
         Args:
-            source: "csv", "parquet", or "mt5"
+            source: "csv", "parquet", "v4bars", or "mt5"
             symbol: Trading symbol (e.g., "EURUSD")
             timeframe: Timeframe (e.g., "H1", "M15", "D1")
             start_date: Start date for filtering (optional)
             end_date: End date for filtering (optional)
             bars: Number of most recent bars to load (alternative to date range)
-            file_path: Path to CSV/Parquet file (optional, stored for later use)
+            file_path: Path to CSV/Parquet/.v4bars file (optional, stored for later use)
         """
         self.source = source
         self.symbol = symbol
@@ -95,10 +136,14 @@ class BarDataSource:
             if not path:
                 raise ValueError("file_path required for Parquet source")
             df = self._load_parquet(path)
+        elif self.source == "v4bars":
+            if not path:
+                raise ValueError("file_path required for v4bars source")
+            df = self._load_bar_file(path)
         elif self.source == "mt5":
             df = self._load_mt5()
         else:
-            raise ValueError(f"Invalid source: {self.source}. Must be 'csv', 'parquet', or 'mt5'")
+            raise ValueError(f"Invalid source: {self.source}. Must be 'csv', 'parquet', 'v4bars', or 'mt5'")
 
         # Apply date filtering
         df = self._filter_by_dates(df)
@@ -148,6 +193,18 @@ class BarDataSource:
 
         return df[required]
 
+    def _load_bar_file(self, file_path: str) -> pd.DataFrame:
+        """Load bars from a columnar .v4bars file (already sorted by time)."""
+        symbol, timeframe, columns = read_bar_file(file_path)
+        if symbol != self.symbol or timeframe != self.timeframe:
+            raise ValueError(f"Bar file holds {symbol} {timeframe}, not {self.symbol} {self.timeframe}")
+
+        # Times are the bars' wall clock stored as unix seconds
+        df = pd.DataFrame({name: columns[name].tolist() for name in BAR_FILE_COLUMNS})
+        df['time'] = pd.to_datetime(df['time'], unit='s')
+        df['volume'] = df['volume'].astype('int64')
+        return df
+
     def _load_mt5(self) -> pd.DataFrame:
         """Load bars from MT5.
 